@@ -101,13 +101,74 @@ tryagain:
 	return true;
 }
 
+bool CommandQueueMT::_grow() {
+
+	if (executing || command_mem_size >= COMMAND_MEM_MAX_SIZE) {
+		return false;
+	}
+
+	// Copy the pending commands, oldest first, to the start of a buffer
+	// twice as large, dropping the wrap marker if there is one.
+	uint32_t new_size = command_mem_size * 2;
+	uint8_t *new_mem = (uint8_t *)memalloc(new_size);
+
+	uint32_t src = dealloc_ptr;
+	uint32_t dst = 0;
+	uint32_t new_read_ptr = 0;
+	bool read_found = false;
+
+	while (src != write_ptr) {
+
+		if (src == read_ptr) {
+			new_read_ptr = dst;
+			read_found = true;
+		}
+
+		uint32_t size = *(uint32_t *)&command_mem[src];
+		if (size == 0) {
+			src = 0;
+			continue;
+		}
+
+		uint32_t total = (size >> 1) + 8;
+		memcpy(&new_mem[dst], &command_mem[src], total);
+		src += total;
+		dst += total;
+	}
+
+	if (!read_found) {
+		new_read_ptr = dst;
+	}
+
+	memfree(command_mem);
+	command_mem = new_mem;
+	command_mem_size = new_size;
+	dealloc_ptr = 0;
+	read_ptr = new_read_ptr;
+	write_ptr = dst;
+
+	return true;
+}
+
+void CommandQueueMT::reset_stats() {
+
+	lock();
+	sync_count = 0;
+	max_used = write_ptr >= dealloc_ptr ? write_ptr - dealloc_ptr : command_mem_size - dealloc_ptr + write_ptr;
+	unlock();
+}
+
 CommandQueueMT::CommandQueueMT(bool p_sync) {
 
 	read_ptr = 0;
 	write_ptr = 0;
 	dealloc_ptr = 0;
+	executing = false;
+	sync_count = 0;
+	max_used = 0;
 	mutex = Mutex::create();
-	command_mem = (uint8_t *)memalloc(COMMAND_MEM_SIZE);
+	command_mem_size = COMMAND_MEM_SIZE;
+	command_mem = (uint8_t *)memalloc(command_mem_size);
 
 	for (int i = 0; i < SYNC_SEMAPHORES; i++) {
 
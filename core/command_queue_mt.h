@@ -247,6 +247,7 @@
 	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                                 \
 		CMD_RET_TYPE(N) *cmd = allocate_and_lock<CMD_RET_TYPE(N)>();                           \
+		sync_count++;                                                                          \
 		cmd->instance = p_instance;                                                            \
 		cmd->method = p_method;                                                                \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
@@ -265,6 +266,7 @@
 	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
 		SyncSemaphore *ss = _alloc_sync_sem();                                        \
 		CMD_SYNC_TYPE(N) *cmd = allocate_and_lock<CMD_SYNC_TYPE(N)>();                \
+		sync_count++;                                                                 \
 		cmd->instance = p_instance;                                                   \
 		cmd->method = p_method;                                                       \
 		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
@@ -317,13 +319,18 @@ class CommandQueueMT {
 	enum {
 		COMMAND_MEM_SIZE_KB = 256,
 		COMMAND_MEM_SIZE = COMMAND_MEM_SIZE_KB * 1024,
+		COMMAND_MEM_MAX_SIZE = COMMAND_MEM_SIZE * 64,
 		SYNC_SEMAPHORES = 8
 	};
 
 	uint8_t *command_mem;
+	uint32_t command_mem_size;
 	uint32_t read_ptr;
 	uint32_t write_ptr;
 	uint32_t dealloc_ptr;
+	bool executing;
+	uint32_t sync_count;
+	uint32_t max_used;
 	SyncSemaphore sync_sems[SYNC_SEMAPHORES];
 	Mutex *mutex;
 	Semaphore *sync;
@@ -341,7 +348,7 @@ class CommandQueueMT {
 			if ((dealloc_ptr - write_ptr) <= alloc_size) {
 
 				// There is no more room, try to deallocate something
-				if (dealloc_one()) {
+				if (dealloc_one() || _grow()) {
 					goto tryagain;
 				}
 				return NULL;
@@ -349,20 +356,20 @@ class CommandQueueMT {
 		} else if (write_ptr >= dealloc_ptr) {
 			// ahead of dealloc_ptr, check that there is room
 
-			if ((COMMAND_MEM_SIZE - write_ptr) < alloc_size + sizeof(uint32_t)) {
+			if ((command_mem_size - write_ptr) < alloc_size + sizeof(uint32_t)) {
 				// no room at the end, wrap down;
 
 				if (dealloc_ptr == 0) { // don't want write_ptr to become dealloc_ptr
 
 					// There is no more room, try to deallocate something
-					if (dealloc_one()) {
+					if (dealloc_one() || _grow()) {
 						goto tryagain;
 					}
 					return NULL;
 				}
 
 				// if this happens, it's a bug
-				ERR_FAIL_COND_V((COMMAND_MEM_SIZE - write_ptr) < 8, NULL);
+				ERR_FAIL_COND_V((command_mem_size - write_ptr) < 8, NULL);
 				// zero means, wrap to beginning
 
 				uint32_t *p = (uint32_t *)&command_mem[write_ptr];
@@ -381,6 +388,11 @@ class CommandQueueMT {
 		// allocate the command
 		T *cmd = memnew_placement(&command_mem[write_ptr], T);
 		write_ptr += size;
+
+		uint32_t used = write_ptr >= dealloc_ptr ? write_ptr - dealloc_ptr : command_mem_size - dealloc_ptr + write_ptr;
+		if (used > max_used) {
+			max_used = used;
+		}
 		return cmd;
 	}
 
@@ -424,9 +436,13 @@ class CommandQueueMT {
 
 		read_ptr += size;
 
+		// The buffer must not be reallocated while the command runs
+		// unlocked, its arguments are passed by reference.
+		executing = true;
 		if (p_lock) unlock();
 		cmd->call();
 		if (p_lock) lock();
+		executing = false;
 
 		cmd->post();
 		cmd->~CommandBase();
@@ -441,6 +457,7 @@ class CommandQueueMT {
 	void wait_for_flush();
 	SyncSemaphore *_alloc_sync_sem();
 	bool dealloc_one();
+	bool _grow();
 
 public:
 	/* NORMAL PUSH COMMANDS */
@@ -470,6 +487,13 @@ public:
 		unlock();
 	}
 
+	// Statistics since the last reset_stats(): commands that blocked the
+	// caller until executed, and the peak amount of queue memory in use.
+	uint32_t get_sync_count() const { return sync_count; }
+	uint32_t get_max_used() const { return max_used; }
+	uint32_t get_size() const { return command_mem_size; }
+	void reset_stats();
+
 	CommandQueueMT(bool p_sync);
 	~CommandQueueMT();
 };
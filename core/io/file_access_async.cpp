@@ -0,0 +1,638 @@
+/*************************************************************************/
+/*  file_access_async.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "file_access_async.h"
+
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+#include "core/sort_array.h"
+
+FileAccessAsync *FileAccessAsync::singleton = NULL;
+
+FileAccessAsync *FileAccessAsync::get_singleton() {
+
+	return singleton;
+}
+
+void FileAccessAsync::_start_threads() {
+
+	//called with the mutex locked, the threads are only created once something is requested
+#ifndef NO_THREADS
+	if (threads.size()) {
+		return;
+	}
+
+	//requests mostly wait on the disk, so use a few threads even on single core machines
+	int thread_count = CLAMP(OS::get_singleton()->get_processor_count(), 2, int(MAX_THREADS));
+	for (int i = 0; i < thread_count; i++) {
+		threads.push_back(Thread::create(_thread_function, this));
+	}
+#endif
+}
+
+void FileAccessAsync::_dispatch(int p_count) {
+
+#ifdef NO_THREADS
+	//no worker threads, run the requests right away
+	Vector<OpenFile> open_files;
+	uint32_t version = write_version;
+
+	while (true) {
+
+		Request *request = _pop_request();
+		if (!request) {
+			break;
+		}
+		_process_request(request, open_files, version);
+	}
+
+	_close_files(open_files);
+#else
+	for (int i = 0; i < p_count; i++) {
+		semaphore->post();
+	}
+#endif
+}
+
+FileAccessAsync::Request *FileAccessAsync::_pop_request() {
+
+	mutex->lock();
+
+	if (queue.empty()) {
+		//the request this thread was woken up for was cancelled before it started
+		mutex->unlock();
+		return NULL;
+	}
+
+	Request *request = queue.front()->get();
+	queue.pop_front();
+	request->status = STATUS_IN_PROGRESS;
+
+	mutex->unlock();
+
+	return request;
+}
+
+FileAccessAsync::RequestID FileAccessAsync::_queue_request(Request *p_request) {
+
+	mutex->lock();
+
+	if (last_id == 0x7FFFFFFF) {
+		last_id = 0;
+	}
+	p_request->id = ++last_id;
+	requests[p_request->id] = p_request;
+
+	RequestID id = p_request->id;
+
+	if (batch_depth > 0) {
+		p_request->in_batch = true;
+		batch.push_back(p_request);
+		mutex->unlock();
+		return id;
+	}
+
+	_start_threads();
+	queue.push_back(p_request);
+
+	mutex->unlock();
+
+	_dispatch(1);
+
+	return id;
+}
+
+void FileAccessAsync::_close_files(Vector<OpenFile> &r_open_files) {
+
+	for (int i = 0; i < r_open_files.size(); i++) {
+		memdelete(r_open_files[i].file);
+	}
+	r_open_files.clear();
+}
+
+void FileAccessAsync::_process_request(Request *p_request, Vector<OpenFile> &r_open_files, uint32_t &r_write_version) {
+
+	if (r_write_version != write_version) {
+		//something was written since these were opened, don't read from stale buffers
+		_close_files(r_open_files);
+		r_write_version = write_version;
+	}
+
+	Error err = OK;
+
+	if (p_request->type == TYPE_READ) {
+
+		FileAccess *f = NULL;
+
+		for (int i = 0; i < r_open_files.size(); i++) {
+			if (r_open_files[i].path == p_request->path) {
+				OpenFile open_file = r_open_files[i];
+				r_open_files.remove(i);
+				r_open_files.insert(0, open_file);
+				f = open_file.file;
+				break;
+			}
+		}
+
+		if (!f) {
+			f = FileAccess::open(p_request->path, FileAccess::READ, &err);
+			if (f) {
+				if (r_open_files.size() == MAX_OPEN_FILES) {
+					memdelete(r_open_files[MAX_OPEN_FILES - 1].file);
+					r_open_files.remove(MAX_OPEN_FILES - 1);
+				}
+				OpenFile open_file;
+				open_file.path = p_request->path;
+				open_file.file = f;
+				r_open_files.insert(0, open_file);
+			}
+		}
+
+		if (f) {
+
+			int64_t len = f->get_len();
+			int64_t from = MIN(p_request->offset, len);
+			int64_t to = p_request->length < 0 ? len : MIN(len, from + p_request->length);
+
+			PoolVector<uint8_t> data;
+			data.resize(to - from);
+
+			int64_t total = 0;
+			if (to > from) {
+
+				PoolVector<uint8_t>::Write w = data.write();
+				f->seek(from);
+
+				while (total < to - from && !p_request->cancelled) {
+					int read = f->get_buffer(w.ptr() + total, MIN(int64_t(CHUNK_SIZE), to - from - total));
+					if (read <= 0) {
+						break;
+					}
+					total += read;
+				}
+			}
+
+			if (total < to - from) {
+				data.resize(total);
+			}
+
+			p_request->data = data;
+		}
+
+	} else {
+
+		FileAccess *f = FileAccess::open(p_request->path, p_request->offset < 0 ? FileAccess::WRITE : FileAccess::READ_WRITE, &err);
+
+		if (f) {
+
+			if (p_request->offset >= 0) {
+				f->seek(p_request->offset);
+			}
+
+			int64_t size = p_request->data.size();
+			PoolVector<uint8_t>::Read r = p_request->data.read();
+
+			for (int64_t ofs = 0; ofs < size && !p_request->cancelled; ofs += CHUNK_SIZE) {
+				f->store_buffer(r.ptr() + ofs, MIN(int64_t(CHUNK_SIZE), size - ofs));
+				if (f->get_error() != OK) {
+					break;
+				}
+			}
+
+			//buffered data can fail to reach the disk as well
+			f->flush();
+			err = f->get_error();
+
+			memdelete(f);
+		}
+	}
+
+	_finish_request(p_request, err);
+}
+
+void FileAccessAsync::_finish_request(Request *p_request, Error p_error) {
+
+	mutex->lock();
+
+	if (p_request->type == TYPE_WRITE) {
+		write_version++;
+		p_request->data = PoolVector<uint8_t>();
+	}
+
+	if (p_request->cancelled) {
+		p_request->status = STATUS_CANCELLED;
+		p_request->error = ERR_SKIP;
+		p_request->data = PoolVector<uint8_t>();
+	} else {
+		p_request->status = p_error == OK ? STATUS_DONE : STATUS_FAILED;
+		p_request->error = p_error;
+	}
+
+	for (int i = 0; i < p_request->waiters; i++) {
+		p_request->semaphore->post();
+	}
+
+	RequestID id = p_request->id;
+	Error error = p_request->error;
+	CompletionCallback callback = p_request->callback;
+	void *userdata = p_request->userdata;
+
+	bool flush = false;
+
+	if (p_request->released) {
+		_delete_request(p_request);
+	} else {
+		completed.push_back(id);
+		flush = !completed_flush_queued;
+		completed_flush_queued = true;
+	}
+
+	mutex->unlock();
+
+	if (callback) {
+		callback(userdata, id, error);
+	}
+
+	if (flush) {
+		call_deferred("_flush_completed");
+	}
+}
+
+void FileAccessAsync::_delete_request(Request *p_request) {
+
+	if (p_request->semaphore) {
+		memdelete(p_request->semaphore);
+	}
+	memdelete(p_request);
+}
+
+void FileAccessAsync::_flush_completed() {
+
+	mutex->lock();
+	Vector<RequestID> ids = completed;
+	completed.clear();
+	completed_flush_queued = false;
+	mutex->unlock();
+
+	for (int i = 0; i < ids.size(); i++) {
+		emit_signal("request_completed", ids[i]);
+	}
+}
+
+void FileAccessAsync::_thread_function(void *p_self) {
+
+	FileAccessAsync *self = (FileAccessAsync *)p_self;
+
+	Vector<OpenFile> open_files;
+	uint32_t version = 0;
+
+	while (true) {
+
+		self->semaphore->wait();
+
+		if (self->exit_threads) {
+			break;
+		}
+
+		Request *request = self->_pop_request();
+		if (request) {
+			self->_process_request(request, open_files, version);
+		}
+	}
+
+	_close_files(open_files);
+}
+
+FileAccessAsync::RequestID FileAccessAsync::read(const String &p_path, int64_t p_offset, int64_t p_length, CompletionCallback p_callback, void *p_userdata) {
+
+	ERR_FAIL_COND_V(p_path.empty(), INVALID_REQUEST_ID);
+	ERR_FAIL_COND_V(p_offset < 0, INVALID_REQUEST_ID);
+
+	Request *request = memnew(Request);
+	request->type = TYPE_READ;
+	request->path = p_path;
+	request->offset = p_offset;
+	request->length = p_length;
+	request->callback = p_callback;
+	request->userdata = p_userdata;
+
+	return _queue_request(request);
+}
+
+FileAccessAsync::RequestID FileAccessAsync::write(const String &p_path, const PoolVector<uint8_t> &p_data, int64_t p_offset, CompletionCallback p_callback, void *p_userdata) {
+
+	ERR_FAIL_COND_V(p_path.empty(), INVALID_REQUEST_ID);
+
+	Request *request = memnew(Request);
+	request->type = TYPE_WRITE;
+	request->path = p_path;
+	request->offset = p_offset;
+	request->length = p_data.size();
+	request->data = p_data;
+	request->callback = p_callback;
+	request->userdata = p_userdata;
+
+	return _queue_request(request);
+}
+
+FileAccessAsync::RequestID FileAccessAsync::_read(const String &p_path, int64_t p_offset, int64_t p_length) {
+
+	return read(p_path, p_offset, p_length);
+}
+
+FileAccessAsync::RequestID FileAccessAsync::_write(const String &p_path, const PoolVector<uint8_t> &p_data, int64_t p_offset) {
+
+	return write(p_path, p_data, p_offset);
+}
+
+void FileAccessAsync::begin_batch() {
+
+	mutex->lock();
+	batch_depth++;
+	mutex->unlock();
+}
+
+void FileAccessAsync::end_batch() {
+
+	mutex->lock();
+
+	if (batch_depth == 0) {
+		mutex->unlock();
+		ERR_EXPLAIN("end_batch() called without begin_batch()");
+		ERR_FAIL();
+	}
+
+	batch_depth--;
+
+	int count = 0;
+
+	if (batch_depth == 0 && batch.size()) {
+
+		//requests for the same file are taken in order, so workers reading it keep moving forward
+		count = batch.size();
+		SortArray<Request *, RequestSort> sorter;
+		sorter.sort(batch.ptrw(), count);
+
+		_start_threads();
+
+		for (int i = 0; i < count; i++) {
+			batch[i]->in_batch = false;
+			queue.push_back(batch[i]);
+		}
+		batch.clear();
+	}
+
+	mutex->unlock();
+
+	if (count) {
+		_dispatch(count);
+	}
+}
+
+FileAccessAsync::Status FileAccessAsync::get_status(RequestID p_id) const {
+
+	mutex->lock();
+	Request *const *request = requests.getptr(p_id);
+	Status status = request ? (*request)->status : STATUS_INVALID;
+	mutex->unlock();
+
+	return status;
+}
+
+Error FileAccessAsync::get_error(RequestID p_id) const {
+
+	mutex->lock();
+	Request *const *request = requests.getptr(p_id);
+	Error error = ERR_INVALID_PARAMETER;
+	if (request) {
+		Status status = (*request)->status;
+		error = status == STATUS_PENDING || status == STATUS_IN_PROGRESS ? ERR_BUSY : (*request)->error;
+	}
+	mutex->unlock();
+
+	return error;
+}
+
+PoolVector<uint8_t> FileAccessAsync::get_data(RequestID p_id) const {
+
+	mutex->lock();
+	Request *const *request = requests.getptr(p_id);
+	PoolVector<uint8_t> data;
+	if (request && (*request)->status == STATUS_DONE) {
+		data = (*request)->data;
+	}
+	mutex->unlock();
+
+	return data;
+}
+
+Error FileAccessAsync::wait(RequestID p_id) {
+
+	mutex->lock();
+
+	Request **requestp = requests.getptr(p_id);
+	if (!requestp) {
+		mutex->unlock();
+		ERR_FAIL_V(ERR_INVALID_PARAMETER);
+	}
+
+	Request *request = *requestp;
+
+	if (request->in_batch) {
+		mutex->unlock();
+		ERR_EXPLAIN("Can't wait for a request before its batch is submitted with end_batch()");
+		ERR_FAIL_V(ERR_BUSY);
+	}
+
+	if (request->status == STATUS_PENDING || request->status == STATUS_IN_PROGRESS) {
+
+		if (!request->semaphore) {
+			request->semaphore = Semaphore::create();
+		}
+		request->waiters++;
+		Semaphore *semaphore = request->semaphore;
+
+		mutex->unlock();
+		semaphore->wait();
+		mutex->lock();
+
+		request->waiters--;
+	}
+
+	Error error = request->error;
+
+	mutex->unlock();
+
+	return error;
+}
+
+bool FileAccessAsync::cancel(RequestID p_id) {
+
+	mutex->lock();
+
+	Request **requestp = requests.getptr(p_id);
+	if (!requestp) {
+		mutex->unlock();
+		return false;
+	}
+
+	Request *request = *requestp;
+
+	if (request->status == STATUS_PENDING) {
+
+		if (request->in_batch) {
+			batch.erase(request);
+			request->in_batch = false;
+		} else {
+			queue.erase(request);
+		}
+		request->cancelled = true;
+
+		mutex->unlock();
+
+		_finish_request(request, ERR_SKIP);
+		return true;
+	}
+
+	bool in_progress = request->status == STATUS_IN_PROGRESS;
+	if (in_progress) {
+		//checked by the worker between chunks
+		request->cancelled = true;
+	}
+
+	mutex->unlock();
+
+	return in_progress;
+}
+
+void FileAccessAsync::release(RequestID p_id) {
+
+	mutex->lock();
+
+	Request **requestp = requests.getptr(p_id);
+	if (!requestp) {
+		mutex->unlock();
+		ERR_FAIL();
+	}
+
+	Request *request = *requestp;
+
+	if (request->waiters) {
+		mutex->unlock();
+		ERR_EXPLAIN("Can't release a request that is being waited for");
+		ERR_FAIL();
+	}
+
+	requests.erase(p_id);
+
+	if (request->status == STATUS_PENDING || request->status == STATUS_IN_PROGRESS) {
+		//still runs, but is deleted as soon as it completes
+		request->released = true;
+	} else {
+		_delete_request(request);
+	}
+
+	mutex->unlock();
+}
+
+void FileAccessAsync::_bind_methods() {
+
+	ClassDB::bind_method(D_METHOD("read", "path", "offset", "length"), &FileAccessAsync::_read, DEFVAL(0), DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("write", "path", "data", "offset"), &FileAccessAsync::_write, DEFVAL(-1));
+	ClassDB::bind_method(D_METHOD("begin_batch"), &FileAccessAsync::begin_batch);
+	ClassDB::bind_method(D_METHOD("end_batch"), &FileAccessAsync::end_batch);
+	ClassDB::bind_method(D_METHOD("get_status", "id"), &FileAccessAsync::get_status);
+	ClassDB::bind_method(D_METHOD("get_error", "id"), &FileAccessAsync::get_error);
+	ClassDB::bind_method(D_METHOD("get_data", "id"), &FileAccessAsync::get_data);
+	ClassDB::bind_method(D_METHOD("wait", "id"), &FileAccessAsync::wait);
+	ClassDB::bind_method(D_METHOD("cancel", "id"), &FileAccessAsync::cancel);
+	ClassDB::bind_method(D_METHOD("release", "id"), &FileAccessAsync::release);
+
+	ClassDB::bind_method(D_METHOD("_flush_completed"), &FileAccessAsync::_flush_completed);
+
+	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "id")));
+
+	BIND_ENUM_CONSTANT(STATUS_INVALID);
+	BIND_ENUM_CONSTANT(STATUS_PENDING);
+	BIND_ENUM_CONSTANT(STATUS_IN_PROGRESS);
+	BIND_ENUM_CONSTANT(STATUS_DONE);
+	BIND_ENUM_CONSTANT(STATUS_FAILED);
+	BIND_ENUM_CONSTANT(STATUS_CANCELLED);
+
+	BIND_CONSTANT(INVALID_REQUEST_ID);
+}
+
+FileAccessAsync::FileAccessAsync() {
+
+	singleton = this;
+
+	mutex = Mutex::create();
+	semaphore = Semaphore::create();
+	exit_threads = false;
+	batch_depth = 0;
+	last_id = 0;
+	completed_flush_queued = false;
+	write_version = 0;
+}
+
+FileAccessAsync::~FileAccessAsync() {
+
+	exit_threads = true;
+	for (int i = 0; i < threads.size(); i++) {
+		semaphore->post();
+	}
+	for (int i = 0; i < threads.size(); i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+
+	//released requests that never ran are only referenced by the queue or the batch
+	for (List<Request *>::Element *E = queue.front(); E; E = E->next()) {
+		if (E->get()->released) {
+			_delete_request(E->get());
+		}
+	}
+	for (int i = 0; i < batch.size(); i++) {
+		if (batch[i]->released) {
+			_delete_request(batch[i]);
+		}
+	}
+
+	const RequestID *id = NULL;
+	while ((id = requests.next(id))) {
+		_delete_request(requests[*id]);
+	}
+
+	memdelete(semaphore);
+	memdelete(mutex);
+
+	singleton = NULL;
+}
@@ -0,0 +1,190 @@
+/*************************************************************************/
+/*  file_access_async.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef FILE_ACCESS_ASYNC_H
+#define FILE_ACCESS_ASYNC_H
+
+#include "core/hash_map.h"
+#include "core/list.h"
+#include "core/object.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/pool_vector.h"
+
+class FileAccess;
+
+// Reads and writes whole or partial files on a small pool of worker threads,
+// through regular FileAccess instances (so res://, user:// and pack files work
+// as usual). Requests run concurrently and in no particular order, a write
+// followed by a read of the same file must wait for the write to complete.
+class FileAccessAsync : public Object {
+
+	GDCLASS(FileAccessAsync, Object);
+
+public:
+	enum Status {
+		STATUS_INVALID,
+		STATUS_PENDING,
+		STATUS_IN_PROGRESS,
+		STATUS_DONE,
+		STATUS_FAILED,
+		STATUS_CANCELLED,
+	};
+
+	enum {
+		INVALID_REQUEST_ID = -1
+	};
+
+	typedef int RequestID;
+
+	// Called on the worker thread that completed (or cancelled) the request.
+	typedef void (*CompletionCallback)(void *p_userdata, RequestID p_id, Error p_error);
+
+private:
+	enum {
+		CHUNK_SIZE = 65536, // cancellation is checked between chunks
+		MAX_THREADS = 8,
+		MAX_OPEN_FILES = 8, // kept open by each worker for further reads
+	};
+
+	enum Type {
+		TYPE_READ,
+		TYPE_WRITE,
+	};
+
+	struct Request {
+
+		RequestID id;
+		Type type;
+		String path;
+		int64_t offset;
+		int64_t length;
+		PoolVector<uint8_t> data;
+		volatile Status status;
+		Error error;
+		volatile bool cancelled;
+		bool released;
+		bool in_batch;
+		CompletionCallback callback;
+		void *userdata;
+		Semaphore *semaphore; // created by the first wait()
+		int waiters;
+
+		Request() {
+			id = INVALID_REQUEST_ID;
+			type = TYPE_READ;
+			offset = 0;
+			length = -1;
+			status = STATUS_PENDING;
+			error = OK;
+			cancelled = false;
+			released = false;
+			in_batch = false;
+			callback = NULL;
+			userdata = NULL;
+			semaphore = NULL;
+			waiters = 0;
+		}
+	};
+
+	struct RequestSort {
+		bool operator()(const Request *p_a, const Request *p_b) const {
+			return p_a->path == p_b->path ? p_a->offset < p_b->offset : p_a->path < p_b->path;
+		}
+	};
+
+	struct OpenFile {
+		String path;
+		FileAccess *file;
+	};
+
+	static FileAccessAsync *singleton;
+
+	Mutex *mutex;
+	Semaphore *semaphore;
+	Vector<Thread *> threads;
+	bool exit_threads;
+
+	HashMap<RequestID, Request *> requests;
+	List<Request *> queue;
+	Vector<Request *> batch;
+	int batch_depth;
+	RequestID last_id;
+
+	Vector<RequestID> completed;
+	bool completed_flush_queued;
+	volatile uint32_t write_version; // open files are reopened after any write
+
+	RequestID _queue_request(Request *p_request);
+	Request *_pop_request();
+	void _start_threads();
+	void _dispatch(int p_count);
+	void _process_request(Request *p_request, Vector<OpenFile> &r_open_files, uint32_t &r_write_version);
+	void _finish_request(Request *p_request, Error p_error);
+	void _delete_request(Request *p_request);
+	void _flush_completed();
+
+	static void _close_files(Vector<OpenFile> &r_open_files);
+	static void _thread_function(void *p_self);
+
+	RequestID _read(const String &p_path, int64_t p_offset, int64_t p_length);
+	RequestID _write(const String &p_path, const PoolVector<uint8_t> &p_data, int64_t p_offset);
+
+protected:
+	static void _bind_methods();
+
+public:
+	static FileAccessAsync *get_singleton();
+
+	// A negative length reads until the end of the file.
+	RequestID read(const String &p_path, int64_t p_offset = 0, int64_t p_length = -1, CompletionCallback p_callback = NULL, void *p_userdata = NULL);
+	// A negative offset replaces the file, otherwise the data is written into the existing file at that offset.
+	RequestID write(const String &p_path, const PoolVector<uint8_t> &p_data, int64_t p_offset = -1, CompletionCallback p_callback = NULL, void *p_userdata = NULL);
+
+	// Requests made until the matching end_batch() are submitted together, ordered by file and offset.
+	void begin_batch();
+	void end_batch();
+
+	Status get_status(RequestID p_id) const;
+	Error get_error(RequestID p_id) const;
+	PoolVector<uint8_t> get_data(RequestID p_id) const;
+	Error wait(RequestID p_id);
+	bool cancel(RequestID p_id);
+	void release(RequestID p_id);
+
+	FileAccessAsync();
+	~FileAccessAsync();
+};
+
+VARIANT_ENUM_CAST(FileAccessAsync::Status);
+
+#endif // FILE_ACCESS_ASYNC_H
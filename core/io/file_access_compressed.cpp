@@ -30,8 +30,67 @@
 
 #include "file_access_compressed.h"
 
+#include "core/io/marshalls.h"
+#include "core/os/copymem.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/print_string.h"
 
+int FileAccessCompressed::default_block_size = 65536;
+int FileAccessCompressed::block_cache_size = 4;
+
+Mutex *FileAccessCompressed::read_ahead_mutex = NULL;
+Semaphore *FileAccessCompressed::read_ahead_semaphore = NULL;
+Thread *FileAccessCompressed::read_ahead_thread = NULL;
+List<const FileAccessCompressed *> FileAccessCompressed::read_ahead_queue;
+bool FileAccessCompressed::read_ahead_exit = false;
+
+void FileAccessCompressed::_read_ahead_thread_func(void *p_userdata) {
+
+	while (true) {
+
+		read_ahead_semaphore->wait();
+
+		read_ahead_mutex->lock();
+		if (read_ahead_exit) {
+			read_ahead_mutex->unlock();
+			break;
+		}
+		const FileAccessCompressed *fac = read_ahead_queue.front()->get();
+		read_ahead_queue.pop_front();
+		read_ahead_mutex->unlock();
+
+		//the owner does not touch these until read_ahead_done is posted
+		fac->read_ahead_data.resize(fac->block_size);
+		Compression::decompress(fac->read_ahead_data.ptrw(), fac->block_size, fac->read_ahead_comp.ptr(), fac->read_ahead_comp.size(), fac->cmode);
+		fac->read_ahead_done->post();
+	}
+}
+
+void FileAccessCompressed::initialize() {
+#ifndef NO_THREADS
+	read_ahead_mutex = Mutex::create();
+	read_ahead_semaphore = Semaphore::create();
+#endif
+}
+
+void FileAccessCompressed::finalize() {
+#ifndef NO_THREADS
+	if (read_ahead_thread) {
+		read_ahead_mutex->lock();
+		read_ahead_exit = true;
+		read_ahead_mutex->unlock();
+		read_ahead_semaphore->post();
+		Thread::wait_to_finish(read_ahead_thread);
+		memdelete(read_ahead_thread);
+		read_ahead_thread = NULL;
+	}
+	memdelete(read_ahead_semaphore);
+	read_ahead_semaphore = NULL;
+	memdelete(read_ahead_mutex);
+	read_ahead_mutex = NULL;
+#endif
+}
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, int p_block_size) {
 
 	magic = p_magic.ascii().get_data();
@@ -43,7 +102,7 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	}
 
 	cmode = p_mode;
-	block_size = p_block_size;
+	block_size = p_block_size > 0 ? p_block_size : default_block_size;
 }
 
 #define WRITE_FIT(m_bytes)                                  \
@@ -64,6 +123,11 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	cmode = (Compression::Mode)f->get_32();
 	block_size = f->get_32();
 	read_total = f->get_32();
+	if (block_size == 0) {
+		f = NULL; //the caller still owns the base file
+		ERR_EXPLAIN("Can't open compressed file '" + p_base->get_path() + "' with block size 0, it is corrupted.");
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
+	}
 	int bc = (read_total / block_size) + 1;
 	int acc_ofs = f->get_position() + bc * 4;
 	int max_bs = 0;
@@ -78,21 +142,182 @@ Error FileAccessCompressed::open_after_magic(FileAccess *p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
 
-	Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
-	read_block = 0;
+	block_cache.resize(MAX(block_cache_size, 1));
+	for (int i = 0; i < block_cache.size(); i++) {
+		block_cache.write[i].block = -1;
+		block_cache.write[i].last_used = 0;
+	}
+	block_cache_tick = 0;
+
+	read_block = -1;
+	_read_block(0);
 	read_pos = 0;
 
 	return OK;
 }
 
+FileAccessCompressed::CachedBlock *FileAccessCompressed::_find_cached_block(int p_block) const {
+
+	for (int i = 0; i < block_cache.size(); i++) {
+		if (block_cache[i].block == p_block) {
+			return &block_cache.write[i];
+		}
+	}
+	return NULL;
+}
+
+void FileAccessCompressed::_read_block(int p_block) const {
+
+	bool sequential = p_block == read_block + 1;
+
+	CachedBlock *cb = _find_cached_block(p_block);
+	if (!cb) {
+
+		//evict the least recently used block
+		cb = &block_cache.write[0];
+		for (int i = 1; i < block_cache.size(); i++) {
+			if (block_cache[i].last_used < cb->last_used) {
+				cb = &block_cache.write[i];
+			}
+		}
+
+		if (read_ahead_pending && read_ahead_block == p_block) {
+			_wait_read_ahead();
+			cb->data = read_ahead_data;
+			read_ahead_data = Vector<uint8_t>();
+		} else {
+			cb->data.resize(block_size);
+			f->seek(read_blocks[p_block].offset);
+			f->get_buffer(comp_buffer.ptrw(), read_blocks[p_block].csize);
+			Compression::decompress(cb->data.ptrw(), block_size, comp_buffer.ptr(), read_blocks[p_block].csize, cmode);
+		}
+		cb->block = p_block;
+	}
+
+	cb->last_used = ++block_cache_tick;
+	read_ptr = cb->data.ptr();
+	read_block = p_block;
+	read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+
+	if (sequential && p_block + 1 < read_block_count && !_find_cached_block(p_block + 1)) {
+		_request_read_ahead(p_block + 1);
+	}
+}
+
+void FileAccessCompressed::_request_read_ahead(int p_block) const {
+
+	if (!read_ahead_mutex || block_cache.size() < 2) {
+		return; //no threads, or no room to keep the block around
+	}
+
+	if (read_ahead_pending) {
+		if (read_ahead_block == p_block) {
+			return;
+		}
+		_wait_read_ahead();
+	}
+
+	if (!read_ahead_done) {
+		read_ahead_done = Semaphore::create();
+	}
+
+	//reading stays on this thread, only decompression is moved out
+	read_ahead_comp.resize(read_blocks[p_block].csize);
+	f->seek(read_blocks[p_block].offset);
+	f->get_buffer(read_ahead_comp.ptrw(), read_blocks[p_block].csize);
+	read_ahead_block = p_block;
+	read_ahead_pending = true;
+
+	read_ahead_mutex->lock();
+	if (!read_ahead_thread) {
+		read_ahead_thread = Thread::create(_read_ahead_thread_func, NULL);
+	}
+	read_ahead_queue.push_back(this);
+	read_ahead_mutex->unlock();
+
+	read_ahead_semaphore->post();
+}
+
+void FileAccessCompressed::_wait_read_ahead() const {
+
+	if (read_ahead_pending) {
+		read_ahead_done->wait();
+		read_ahead_pending = false;
+	}
+}
+
+void FileAccessCompressed::BlockCompressor::compress_block(uint32_t p_index, Vector<uint8_t> *p_blocks) {
+
+	uint32_t bc = (size / block_size) + 1;
+	int bl = p_index == (bc - 1) ? size % block_size : block_size;
+
+	Vector<uint8_t> &cblock = p_blocks[p_index];
+	cblock.resize(Compression::get_max_compressed_buffer_size(bl, mode));
+	int s = Compression::compress(cblock.ptrw(), &src[p_index * block_size], bl, mode);
+	cblock.resize(s);
+}
+
+Vector<uint8_t> FileAccessCompressed::_encode(const String &p_magic, const uint8_t *p_src, uint32_t p_size, Compression::Mode p_mode, uint32_t p_block_size, bool p_threaded) {
+
+	int bc = (p_size / p_block_size) + 1;
+
+	BlockCompressor compressor;
+	compressor.src = p_src;
+	compressor.size = p_size;
+	compressor.block_size = p_block_size;
+	compressor.mode = p_mode;
+
+	//blocks are independent, so they can all be compressed in parallel
+	Vector<Vector<uint8_t> > cblocks;
+	cblocks.resize(bc);
+	if (p_threaded && bc > 2) {
+		thread_process_array(bc, &compressor, &BlockCompressor::compress_block, cblocks.ptrw());
+	} else {
+		for (int i = 0; i < bc; i++) {
+			compressor.compress_block(i, cblocks.ptrw());
+		}
+	}
+
+	CharString mgc = p_magic.utf8();
+	int total = mgc.length() * 2 + 12 + bc * 4;
+	for (int i = 0; i < bc; i++) {
+		total += cblocks[i].size();
+	}
+
+	Vector<uint8_t> ret;
+	ret.resize(total);
+	uint8_t *w = ret.ptrw();
+
+	copymem(w, mgc.get_data(), mgc.length()); //header 4
+	w += mgc.length();
+	encode_uint32(p_mode, w); //compression mode 4
+	encode_uint32(p_block_size, w + 4); //block size 4
+	encode_uint32(p_size, w + 8); //uncompressed size 4
+	w += 12;
+	for (int i = 0; i < bc; i++) {
+		encode_uint32(cblocks[i].size(), w); //compressed block sizes
+		w += 4;
+	}
+	for (int i = 0; i < bc; i++) {
+		copymem(w, cblocks[i].ptr(), cblocks[i].size());
+		w += cblocks[i].size();
+	}
+	copymem(w, mgc.get_data(), mgc.length()); //magic at the end too
+
+	return ret;
+}
+
+Vector<uint8_t> FileAccessCompressed::compress_buffer(const String &p_magic, const uint8_t *p_src, uint32_t p_size, Compression::Mode p_mode, int p_block_size) {
+
+	FileAccessCompressed fac;
+	fac.configure(p_magic, p_mode, p_block_size);
+	return _encode(fac.magic, p_src, p_size, p_mode, fac.block_size, false);
+}
+
 Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 
 	ERR_FAIL_COND_V(p_mode_flags == READ_WRITE, ERR_UNAVAILABLE);
@@ -131,7 +356,12 @@ Error FileAccessCompressed::_open(const String &p_path, int p_mode_flags) {
 			return ERR_FILE_UNRECOGNIZED;
 		}
 
-		open_after_magic(f);
+		FileAccess *base = f;
+		err = open_after_magic(base);
+		if (err != OK) {
+			memdelete(base);
+			return err;
+		}
 	}
 
 	return OK;
@@ -144,48 +374,26 @@ void FileAccessCompressed::close() {
 	if (writing) {
 		//save block table and all compressed blocks
 
-		CharString mgc = magic.utf8();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
-		f->store_32(block_size); //write block size 4
-		f->store_32(write_max); //max amount of data written 4
-		int bc = (write_max / block_size) + 1;
-
-		for (int i = 0; i < bc; i++) {
-			f->store_32(0); //compressed sizes, will update later
-		}
-
-		Vector<int> block_sizes;
-		for (int i = 0; i < bc; i++) {
-
-			int bl = i == (bc - 1) ? write_max % block_size : block_size;
-			uint8_t *bp = &write_ptr[i * block_size];
-
-			Vector<uint8_t> cblock;
-			cblock.resize(Compression::get_max_compressed_buffer_size(bl, cmode));
-			int s = Compression::compress(cblock.ptrw(), bp, bl, cmode);
-
-			f->store_buffer(cblock.ptr(), s);
-			block_sizes.push_back(s);
-		}
-
-		f->seek(16); //ok write block sizes
-		for (int i = 0; i < bc; i++)
-			f->store_32(block_sizes[i]);
-		f->seek_end();
-		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
+		Vector<uint8_t> data = _encode(magic, write_ptr, write_max, cmode, block_size, true);
+		f->store_buffer(data.ptr(), data.size());
 
 		buffer.clear();
 
 	} else {
 
+		_wait_read_ahead();
+		read_ahead_comp.clear();
+		read_ahead_data.clear();
 		comp_buffer.clear();
 		buffer.clear();
+		block_cache.clear();
 		read_blocks.clear();
+		read_ptr = NULL;
 	}
 
 	memdelete(f);
 	f = NULL;
+	writing = false; //the object can be opened again for reading
 }
 
 bool FileAccessCompressed::is_open() const {
@@ -205,22 +413,17 @@ void FileAccessCompressed::seek(size_t p_position) {
 	} else {
 
 		ERR_FAIL_COND(p_position > read_total);
-		if (p_position == read_total) {
-			at_end = true;
-		} else {
-
-			int block_idx = p_position / block_size;
-			if (block_idx != read_block) {
 
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
-			}
+		//the end is inside the last block, so get_position() also works there
+		at_end = p_position == read_total;
+		read_eof = false;
 
-			read_pos = p_position % block_size;
+		int block_idx = p_position / block_size;
+		if (block_idx != read_block) {
+			_read_block(block_idx);
 		}
+
+		read_pos = p_position % block_size;
 	}
 }
 
@@ -272,7 +475,9 @@ uint8_t FileAccessCompressed::get_8() const {
 	ERR_FAIL_COND_V(writing, 0);
 	ERR_FAIL_COND_V(!f, 0);
 
-	if (at_end) {
+	if (at_end || read_pos >= read_block_size) {
+		//the last block is empty when the size is a multiple of the block size
+		at_end = true;
 		read_eof = true;
 		return 0;
 	}
@@ -281,17 +486,11 @@ uint8_t FileAccessCompressed::get_8() const {
 
 	read_pos++;
 	if (read_pos >= read_block_size) {
-		read_block++;
 
-		if (read_block < read_block_count) {
-			//read another block of compressed data
-			f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-			Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-			read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		if (read_block + 1 < read_block_count) {
+			_read_block(read_block + 1);
 			read_pos = 0;
-
 		} else {
-			read_block--;
 			at_end = true;
 		}
 	}
@@ -308,24 +507,22 @@ int FileAccessCompressed::get_buffer(uint8_t *p_dst, int p_length) const {
 		return 0;
 	}
 
-	for (int i = 0; i < p_length; i++) {
+	int i = 0;
+	while (i < p_length) {
+
+		int to_copy = MIN(p_length - i, read_block_size - read_pos);
+		copymem(&p_dst[i], &read_ptr[read_pos], to_copy);
+		i += to_copy;
+		read_pos += to_copy;
 
-		p_dst[i] = read_ptr[read_pos];
-		read_pos++;
 		if (read_pos >= read_block_size) {
-			read_block++;
 
-			if (read_block < read_block_count) {
-				//read another block of compressed data
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			if (read_block + 1 < read_block_count) {
+				_read_block(read_block + 1);
 				read_pos = 0;
-
 			} else {
-				read_block--;
 				at_end = true;
-				if (i < p_length - 1)
+				if (i < p_length)
 					read_eof = true;
 				return i;
 			}
@@ -388,6 +585,10 @@ FileAccessCompressed::FileAccessCompressed() :
 		read_block_size(0),
 		read_pos(0),
 		read_total(0),
+		block_cache_tick(0),
+		read_ahead_block(-1),
+		read_ahead_pending(false),
+		read_ahead_done(NULL),
 		magic("GCMP"),
 		f(NULL) {
 }
@@ -396,4 +597,7 @@ FileAccessCompressed::~FileAccessCompressed() {
 
 	if (f)
 		close();
+
+	if (read_ahead_done)
+		memdelete(read_ahead_done);
 }
@@ -32,7 +32,11 @@
 #define FILE_ACCESS_COMPRESSED_H
 
 #include "core/io/compression.h"
+#include "core/list.h"
 #include "core/os/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
 
 class FileAccessCompressed : public FileAccess {
 
@@ -51,8 +55,14 @@ class FileAccessCompressed : public FileAccess {
 		int offset;
 	};
 
+	struct CachedBlock {
+		int block;
+		uint64_t last_used;
+		Vector<uint8_t> data;
+	};
+
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr;
+	mutable const uint8_t *read_ptr;
 	mutable int read_block;
 	int read_block_count;
 	mutable int read_block_size;
@@ -60,12 +70,58 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint32_t read_total;
 
+	//recently decompressed blocks, so seeking back and forth does not decompress again
+	mutable Vector<CachedBlock> block_cache;
+	mutable uint64_t block_cache_tick;
+
+	//the next block is decompressed on the read ahead thread while the current one is read
+	mutable int read_ahead_block;
+	mutable bool read_ahead_pending;
+	mutable Vector<uint8_t> read_ahead_comp;
+	mutable Vector<uint8_t> read_ahead_data;
+	mutable Semaphore *read_ahead_done;
+
+	static Mutex *read_ahead_mutex;
+	static Semaphore *read_ahead_semaphore;
+	static Thread *read_ahead_thread;
+	static List<const FileAccessCompressed *> read_ahead_queue;
+	static bool read_ahead_exit;
+
+	static void _read_ahead_thread_func(void *p_userdata);
+
 	String magic;
 	mutable Vector<uint8_t> buffer;
 	FileAccess *f;
 
+	struct BlockCompressor {
+		const uint8_t *src;
+		uint32_t size;
+		uint32_t block_size;
+		Compression::Mode mode;
+
+		void compress_block(uint32_t p_index, Vector<uint8_t> *p_blocks);
+	};
+
+	static Vector<uint8_t> _encode(const String &p_magic, const uint8_t *p_src, uint32_t p_size, Compression::Mode p_mode, uint32_t p_block_size, bool p_threaded);
+
+	CachedBlock *_find_cached_block(int p_block) const;
+	void _read_block(int p_block) const;
+	void _request_read_ahead(int p_block) const;
+	void _wait_read_ahead() const;
+
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 4096);
+	static int default_block_size;
+	static int block_cache_size;
+
+	static void initialize();
+	static void finalize();
+
+	// A block size of 0 uses default_block_size (compression/formats/block_size).
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 0);
+
+	// Returns p_src encoded exactly as a file written with configure(p_magic, p_mode, p_block_size),
+	// for storing compressed files inside other containers. Runs on the calling thread only.
+	static Vector<uint8_t> compress_buffer(const String &p_magic, const uint8_t *p_src, uint32_t p_size, Compression::Mode p_mode = Compression::MODE_ZSTD, int p_block_size = 0);
 
 	Error open_after_magic(FileAccess *p_base);
 
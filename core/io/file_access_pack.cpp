@@ -30,11 +30,13 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_compressed.h"
 #include "core/version.h"
 
 #include <stdio.h>
 
-#define PACK_VERSION 1
+// Packed files are paged in ahead of the first read up to this size.
+#define PACK_PREFETCH_MAX (4 * 1024 * 1024)
 
 Error PackedData::add_pack(const String &p_path) {
 
@@ -49,7 +51,7 @@ Error PackedData::add_pack(const String &p_path) {
 	return ERR_FILE_UNRECOGNIZED;
 };
 
-void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src) {
+void PackedData::add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_compressed) {
 
 	PathMD5 pmd5(path.md5_buffer());
 	//printf("adding path %ls, %lli, %lli\n", path.c_str(), pmd5.a, pmd5.b);
@@ -63,6 +65,7 @@ void PackedData::add_path(const String &pkg_path, const String &path, uint64_t o
 	for (int i = 0; i < 16; i++)
 		pf.md5[i] = p_md5[i];
 	pf.src = p_src;
+	pf.compressed = p_compressed;
 
 	files[pmd5] = pf;
 
@@ -135,7 +138,7 @@ PackedData::~PackedData() {
 
 bool PackedSourcePCK::try_open_pack(const String &p_path) {
 
-	FileAccess *f = FileAccess::open(p_path, FileAccess::READ);
+	FileAccess *f = FileAccess::open_mapped(p_path);
 	if (!f)
 		return false;
 
@@ -171,10 +174,16 @@ bool PackedSourcePCK::try_open_pack(const String &p_path) {
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // ver_rev
 
-	ERR_EXPLAIN("Pack version unsupported: " + itos(version));
-	ERR_FAIL_COND_V(version != PACK_VERSION, false);
-	ERR_EXPLAIN("Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor));
-	ERR_FAIL_COND_V(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false);
+	if (version < 1 || version > PACK_FORMAT_VERSION) {
+		memdelete(f);
+		ERR_EXPLAIN("Pack version unsupported: " + itos(version));
+		ERR_FAIL_V(false);
+	}
+	if (ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR)) {
+		memdelete(f);
+		ERR_EXPLAIN("Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor));
+		ERR_FAIL_V(false);
+	}
 
 	for (int i = 0; i < 16; i++) {
 		//reserved
@@ -198,17 +207,64 @@ bool PackedSourcePCK::try_open_pack(const String &p_path) {
 		uint64_t size = f->get_64();
 		uint8_t md5[16];
 		f->get_buffer(md5, 16);
-		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this);
+		uint32_t flags = version >= 2 ? f->get_32() : 0;
+		PackedData::get_singleton()->add_path(p_path, path, ofs, size, md5, this, flags & PACK_FILE_COMPRESSED);
 	};
 
+	const uint8_t *data = NULL;
+	if (!mapped_packs.has(p_path)) {
+		f->seek(0);
+		data = f->get_buffer_ptr(f->get_len());
+	}
+
+	if (data) {
+		MappedPack mp;
+		mp.f = f;
+		mp.data = data;
+		mapped_packs[p_path] = mp;
+	} else {
+		memdelete(f);
+	}
+
 	return true;
 };
 
 FileAccess *PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
 
-	return memnew(FileAccessPack(p_path, *p_file));
+	FileAccess *fa;
+
+	Map<String, MappedPack>::Element *E = mapped_packs.find(p_file->pack);
+	if (E) {
+		E->get().f->prefetch(p_file->offset, MIN(p_file->size, (uint64_t)PACK_PREFETCH_MAX));
+		fa = memnew(FileAccessPack(p_path, *p_file, E->get().data));
+	} else {
+		fa = memnew(FileAccessPack(p_path, *p_file));
+	}
+
+	if (p_file->compressed) {
+		//decompress transparently, the compressed file takes ownership of the packed one
+		fa->seek(4); //magic
+		FileAccessCompressed *fac = memnew(FileAccessCompressed);
+		fac->configure(PACK_COMPRESSED_MAGIC);
+		Error err = fac->open_after_magic(fa);
+		if (err != OK) {
+			memdelete(fac);
+			memdelete(fa);
+			return NULL;
+		}
+		return fac;
+	}
+
+	return fa;
 };
 
+PackedSourcePCK::~PackedSourcePCK() {
+
+	for (Map<String, MappedPack>::Element *E = mapped_packs.front(); E; E = E->next()) {
+		memdelete(E->get().f);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
@@ -219,11 +275,16 @@ Error FileAccessPack::_open(const String &p_path, int p_mode_flags) {
 
 void FileAccessPack::close() {
 
-	f->close();
+	if (f) {
+		f->close();
+	}
 }
 
 bool FileAccessPack::is_open() const {
 
+	if (data) {
+		return true;
+	}
 	return f->is_open();
 }
 
@@ -235,7 +296,9 @@ void FileAccessPack::seek(size_t p_position) {
 		eof = false;
 	}
 
-	f->seek(pf.offset + p_position);
+	if (f) {
+		f->seek(pf.offset + p_position);
+	}
 	pos = p_position;
 }
 void FileAccessPack::seek_end(int64_t p_position) {
@@ -263,6 +326,10 @@ uint8_t FileAccessPack::get_8() const {
 		return 0;
 	}
 
+	if (data) {
+		return data[pos++];
+	}
+
 	pos++;
 	return f->get_8();
 }
@@ -278,18 +345,37 @@ int FileAccessPack::get_buffer(uint8_t *p_dst, int p_length) const {
 		to_read = int64_t(pf.size) - int64_t(pos);
 	}
 
+	const uint8_t *src = data ? &data[pos] : NULL;
 	pos += p_length;
 
 	if (to_read <= 0)
 		return 0;
-	f->get_buffer(p_dst, to_read);
+
+	if (src) {
+		memcpy(p_dst, src, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_ptr(uint64_t p_length) const {
+
+	if (!data || pos > pf.size || p_length > pf.size - pos) {
+		return NULL;
+	}
+
+	const uint8_t *ptr = &data[pos];
+	pos += p_length;
+	return ptr;
+}
+
 void FileAccessPack::set_endian_swap(bool p_swap) {
 	FileAccess::set_endian_swap(p_swap);
-	f->set_endian_swap(p_swap);
+	if (f) {
+		f->set_endian_swap(p_swap);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -327,6 +413,15 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		ERR_FAIL_COND(!f);
 	}
 	f->seek(pf.offset);
+	data = NULL;
+	pos = 0;
+	eof = false;
+}
+
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data) :
+		pf(p_file),
+		f(NULL),
+		data(p_pack_data + p_file.offset) {
 	pos = 0;
 	eof = false;
 }
@@ -31,12 +31,22 @@
 #ifndef FILE_ACCESS_PACK_H
 #define FILE_ACCESS_PACK_H
 
+#include "core/hash_map.h"
 #include "core/list.h"
 #include "core/map.h"
 #include "core/os/dir_access.h"
 #include "core/os/file_access.h"
 #include "core/print_string.h"
 
+// Version 2 adds a flags field to every directory entry.
+#define PACK_FORMAT_VERSION 2
+
+enum PackFileFlags {
+	PACK_FILE_COMPRESSED = 1 // stored in the FileAccessCompressed layout, with PACK_COMPRESSED_MAGIC
+};
+
+#define PACK_COMPRESSED_MAGIC "GPKC"
+
 class PackSource;
 
 class PackedData {
@@ -52,6 +62,7 @@ public:
 		uint64_t size;
 		uint8_t md5[16];
 		PackSource *src;
+		bool compressed;
 	};
 
 private:
@@ -88,7 +99,11 @@ private:
 		};
 	};
 
-	Map<PathMD5, PackedFile> files;
+	struct PathMD5Hasher {
+		static _FORCE_INLINE_ uint32_t hash(const PathMD5 &p_md5) { return uint32_t(p_md5.a); } // already uniformly distributed
+	};
+
+	HashMap<PathMD5, PackedFile, PathMD5Hasher> files;
 
 	Vector<PackSource *> sources;
 
@@ -102,7 +117,7 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src); // for PackSource
+	void add_path(const String &pkg_path, const String &path, uint64_t ofs, uint64_t size, const uint8_t *p_md5, PackSource *p_src, bool p_compressed = false); // for PackSource
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
@@ -127,9 +142,20 @@ public:
 
 class PackedSourcePCK : public PackSource {
 
+	// Packs kept open and memory mapped for the whole run, so opening a
+	// packed file doesn't open the pack again and reads don't go through stdio.
+	struct MappedPack {
+		FileAccess *f;
+		const uint8_t *data;
+	};
+
+	Map<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path);
 	virtual FileAccess *get_file(const String &p_path, PackedData::PackedFile *p_file);
+
+	virtual ~PackedSourcePCK();
 };
 
 class FileAccessPack : public FileAccess {
@@ -140,6 +166,7 @@ class FileAccessPack : public FileAccess {
 	mutable bool eof;
 
 	FileAccess *f;
+	const uint8_t *data; // the file contents when the pack is memory mapped
 	virtual Error _open(const String &p_path, int p_mode_flags);
 	virtual uint64_t _get_modified_time(const String &p_file) { return 0; }
 
@@ -157,6 +184,7 @@ public:
 	virtual uint8_t get_8() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const;
 
 	virtual void set_endian_swap(bool p_swap);
 
@@ -170,19 +198,20 @@ public:
 	virtual bool file_exists(const String &p_name);
 
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const uint8_t *p_pack_data);
 	~FileAccessPack();
 };
 
 FileAccess *PackedData::try_open_path(const String &p_path) {
 
 	PathMD5 pmd5(p_path.md5_buffer());
-	Map<PathMD5, PackedFile>::Element *E = files.find(pmd5);
-	if (!E)
+	PackedFile *pf = files.getptr(pmd5);
+	if (!pf)
 		return NULL; //not found
-	if (E->get().offset == 0)
+	if (pf->offset == 0)
 		return NULL; //was erased
 
-	return E->get().src->get_file(p_path, &E->get());
+	return pf->src->get_file(p_path, pf);
 }
 
 bool PackedData::has_path(const String &p_path) {
@@ -30,9 +30,13 @@
 
 #include "pck_packer.h"
 
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
 #include "core/os/file_access.h"
 #include "core/version.h"
 
+#include "thirdparty/misc/md5.h"
+
 static uint64_t _align(uint64_t p_n, int p_alignment) {
 
 	if (p_alignment == 0)
@@ -56,7 +60,7 @@ static void _pad(FileAccess *p_file, int p_bytes) {
 void PCKPacker::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_name", "alignment"), &PCKPacker::pck_start);
-	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path"), &PCKPacker::add_file);
+	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "compress"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush);
 };
 
@@ -71,7 +75,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment) {
 	alignment = p_alignment;
 
 	file->store_32(0x43504447); // MAGIC
-	file->store_32(1); // # version
+	file->store_32(PACK_FORMAT_VERSION); // # version
 	file->store_32(VERSION_MAJOR); // # major
 	file->store_32(VERSION_MINOR); // # minor
 	file->store_32(0); // # revision
@@ -86,7 +90,7 @@ Error PCKPacker::pck_start(const String &p_file, int p_alignment) {
 	return OK;
 };
 
-Error PCKPacker::add_file(const String &p_file, const String &p_src) {
+Error PCKPacker::add_file(const String &p_file, const String &p_src, bool p_compress) {
 
 	FileAccess *f = FileAccess::open(p_src, FileAccess::READ);
 	if (!f) {
@@ -98,6 +102,10 @@ Error PCKPacker::add_file(const String &p_file, const String &p_src) {
 	pf.src_path = p_src;
 	pf.size = f->get_len();
 	pf.offset_offset = 0;
+	pf.compress = p_compress;
+	pf.ofs = 0;
+	pf.stored_size = 0;
+	pf.compressed = false;
 
 	files.push_back(pf);
 
@@ -123,13 +131,15 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->store_pascal_string(files[i].path);
 		files.write[i].offset_offset = file->get_position();
 		file->store_64(0); // offset
-		file->store_64(files[i].size); // size
+		file->store_64(0); // size
 
-		// # empty md5
+		// # md5
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
 		file->store_32(0);
+
+		file->store_32(0); // flags
 	};
 
 	uint64_t ofs = file->get_position();
@@ -140,26 +150,79 @@ Error PCKPacker::flush(bool p_verbose) {
 	const uint32_t buf_max = 65536;
 	uint8_t *buf = memnew_arr(uint8_t, buf_max);
 
+	Map<String, int> stored; // md5 and size of the contents -> first file storing them
+
 	int count = 0;
 	for (int i = 0; i < files.size(); i++) {
 
-		FileAccess *src = FileAccess::open(files[i].src_path, FileAccess::READ);
-		uint64_t to_write = files[i].size;
-		while (to_write > 0) {
+		File &pf = files.write[i];
+		FileAccess *src = FileAccess::open(pf.src_path, FileAccess::READ);
+
+		// hash first, so identical files are only stored once
+		MD5_CTX ctx;
+		MD5Init(&ctx);
+		uint64_t to_read = pf.size;
+		while (to_read > 0) {
 
-			int read = src->get_buffer(buf, MIN(to_write, buf_max));
-			file->store_buffer(buf, read);
-			to_write -= read;
+			int read = src->get_buffer(buf, MIN(to_read, buf_max));
+			MD5Update(&ctx, buf, read);
+			to_read -= read;
 		};
+		MD5Final(&ctx);
+
+		String content_key = String::md5(ctx.digest) + ":" + itos(pf.size);
+		Map<String, int>::Element *E = stored.find(content_key);
+
+		if (E) {
+
+			pf.ofs = files[E->get()].ofs;
+			pf.stored_size = files[E->get()].stored_size;
+			pf.compressed = files[E->get()].compressed;
+		} else {
+
+			pf.ofs = ofs;
+			pf.stored_size = pf.size;
+			src->seek(0);
+
+			if (pf.compress && pf.size > 0) {
+
+				Vector<uint8_t> data;
+				data.resize(pf.size);
+				src->get_buffer(data.ptrw(), pf.size);
+				Vector<uint8_t> cdata = FileAccessCompressed::compress_buffer(PACK_COMPRESSED_MAGIC, data.ptr(), data.size());
+				// keep it raw unless it shrinks noticeably, decompressing is not free
+				if (cdata.size() + data.size() / 16 < data.size()) {
+					data = cdata;
+					pf.compressed = true;
+				}
+				pf.stored_size = data.size();
+				file->store_buffer(data.ptr(), data.size());
+			} else {
+
+				uint64_t to_write = pf.size;
+				while (to_write > 0) {
+
+					int read = src->get_buffer(buf, MIN(to_write, buf_max));
+					file->store_buffer(buf, read);
+					to_write -= read;
+				};
+			}
+
+			uint64_t end = file->get_position();
+			ofs = _align(ofs + pf.stored_size, alignment);
+			_pad(file, ofs - end);
+
+			stored[content_key] = i;
+		}
 
 		uint64_t pos = file->get_position();
-		file->seek(files[i].offset_offset); // go back to store the file's offset
-		file->store_64(ofs);
+		file->seek(pf.offset_offset); // go back to store the file's offset, size and md5
+		file->store_64(pf.ofs);
+		file->store_64(pf.stored_size);
+		file->store_buffer(ctx.digest, 16);
+		file->store_32(pf.compressed ? PACK_FILE_COMPRESSED : 0);
 		file->seek(pos);
 
-		ofs = _align(ofs + files[i].size, alignment);
-		_pad(file, ofs - pos);
-
 		src->close();
 		memdelete(src);
 		count += 1;
@@ -33,6 +33,7 @@
 #include "core/image.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/marshalls.h"
+#include "core/os/copymem.h"
 #include "core/os/dir_access.h"
 #include "core/project_settings.h"
 #include "core/version.h"
@@ -86,9 +87,12 @@ enum {
 	OBJECT_EXTERNAL_RESOURCE_INDEX = 3,
 	//version 2: added 64 bits support for float and int
 	//version 3: changed nodepath encoding
-	FORMAT_VERSION = 3,
+	//version 4: string table stored as a single block, strings shared through it, pool arrays aligned
+	FORMAT_VERSION = 4,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_STRING_TABLE = 4,
+	DATA_ALIGNMENT = 16, // pool arrays start at this alignment from version 4
 
 };
 
@@ -101,22 +105,64 @@ void ResourceInteractiveLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+void ResourceInteractiveLoaderBinary::_advance_alignment() {
+
+	if (ver_format < FORMAT_VERSION_STRING_TABLE)
+		return;
+
+	uint64_t extra = f->get_position() % DATA_ALIGNMENT;
+	if (extra) {
+		uint8_t pad[DATA_ALIGNMENT];
+		f->get_buffer(pad, DATA_ALIGNMENT - extra); //cheaper than a seek for buffered files
+	}
+}
+
+String ResourceInteractiveLoaderBinary::_read_unicode_string(uint32_t p_len) {
+
+	if (p_len == 0)
+		return String();
+
+	// Parse straight from the file mapping when there is one.
+	const char *ptr = (const char *)f->get_buffer_ptr(p_len);
+	if (!ptr) {
+		if ((int)p_len > str_buf.size()) {
+			str_buf.resize(p_len);
+		}
+		f->get_buffer((uint8_t *)str_buf.ptrw(), p_len);
+		ptr = str_buf.ptr();
+	}
+
+	uint32_t len = 0;
+	while (len < p_len && ptr[len]) {
+		len++;
+	}
+
+	String s;
+	s.parse_utf8(ptr, len);
+	return s;
+}
+
 StringName ResourceInteractiveLoaderBinary::_get_string() {
 
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0)
 			return StringName();
-		f->get_buffer((uint8_t *)&str_buf[0], len);
-		String s;
-		s.parse_utf8(&str_buf[0]);
-		return s;
+		return _read_unicode_string(len);
+	}
+
+	return string_map[id];
+}
+
+String ResourceInteractiveLoaderBinary::_get_string_value() {
+
+	uint32_t id = f->get_32();
+	if (id & 0x80000000) {
+		return _read_unicode_string(id & 0x7FFFFFFF);
 	}
 
+	ERR_FAIL_COND_V(id >= (uint32_t)string_map.size(), String());
 	return string_map[id];
 }
 
@@ -153,7 +199,11 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_STRING: {
 
-			r_v = get_unicode_string();
+			if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+				r_v = _get_string_value();
+			} else {
+				r_v = get_unicode_string();
+			}
 		} break;
 		case VARIANT_VECTOR2: {
 
@@ -307,7 +357,17 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 				case OBJECT_INTERNAL_RESOURCE: {
 					uint32_t index = f->get_32();
 					String path = res_path + "::" + itos(index);
-					RES res = ResourceLoader::load(path);
+					RES res;
+					const Map<int, int>::Element *E = internal_index_map.find(index);
+					if (E) {
+						//decoded on first use
+						Error err = _decode_internal_resource(E->get());
+						if (err != OK)
+							return err;
+						res = internal_resources[E->get()].resource;
+					} else {
+						res = ResourceLoader::load(path);
+					}
 					if (res.is_null()) {
 						WARN_PRINT(String("Couldn't load resource: " + path).utf8().get_data());
 					}
@@ -404,6 +464,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_RAW_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<uint8_t> array;
 			array.resize(len);
@@ -417,6 +478,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_INT_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<int> array;
 			array.resize(len);
@@ -438,6 +500,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_REAL_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<real_t> array;
 			array.resize(len);
@@ -463,8 +526,13 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 			PoolVector<String> array;
 			array.resize(len);
 			PoolVector<String>::Write w = array.write();
-			for (uint32_t i = 0; i < len; i++)
-				w[i] = get_unicode_string();
+			if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+				for (uint32_t i = 0; i < len; i++)
+					w[i] = _get_string_value();
+			} else {
+				for (uint32_t i = 0; i < len; i++)
+					w[i] = get_unicode_string();
+			}
 			w = PoolVector<String>::Write();
 			r_v = array;
 
@@ -472,6 +540,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_VECTOR2_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Vector2> array;
 			array.resize(len);
@@ -500,6 +569,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_VECTOR3_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Vector3> array;
 			array.resize(len);
@@ -528,6 +598,7 @@ Error ResourceInteractiveLoaderBinary::parse_variant(Variant &r_v) {
 		case VARIANT_COLOR_ARRAY: {
 
 			uint32_t len = f->get_32();
+			_advance_alignment();
 
 			PoolVector<Color> array;
 			array.resize(len);
@@ -669,13 +740,36 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	s -= external_resources.size();
 
-	if (s >= internal_resources.size()) {
+	if (s != 0 || internal_resources.size() == 0) {
 
 		error = ERR_BUG;
-		ERR_FAIL_COND_V(s >= internal_resources.size(), error);
+		ERR_FAIL_COND_V(s != 0 || internal_resources.size() == 0, error);
 	}
 
-	bool main = s == (internal_resources.size() - 1);
+	//only the main resource is decoded here, internal resources are decoded when first referenced
+	int main = internal_resources.size() - 1;
+	error = _decode_internal_resource(main);
+	if (error)
+		return error;
+
+	stage++;
+
+	f->close();
+	resource = internal_resources[main].resource;
+	resource->set_as_translation_remapped(translation_remapped);
+	error = ERR_FILE_EOF;
+
+	return OK;
+}
+
+Error ResourceInteractiveLoaderBinary::_decode_internal_resource(int p_index) {
+
+	const IntResource &ir = internal_resources[p_index];
+	if (ir.resource.is_valid() || ir.decoding) {
+		return OK; //already decoded, or a circular reference that can't be resolved
+	}
+
+	bool main = p_index == (internal_resources.size() - 1);
 
 	//maybe it is loaded already
 	String path;
@@ -683,7 +777,7 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 	if (!main) {
 
-		path = internal_resources[s].path;
+		path = ir.path;
 		if (path.begins_with("local://")) {
 			path = path.replace_first("local://", "");
 			subindex = path.to_int();
@@ -692,9 +786,8 @@ Error ResourceInteractiveLoaderBinary::poll() {
 
 		if (ResourceCache::has(path)) {
 			//already loaded, don't do anything
-			stage++;
-			error = OK;
-			return error;
+			internal_resources.write[p_index].resource = RES(ResourceCache::get(path));
+			return OK;
 		}
 	} else {
 
@@ -702,25 +795,25 @@ Error ResourceInteractiveLoaderBinary::poll() {
 			path = res_path;
 	}
 
-	uint64_t offset = internal_resources[s].offset;
-
-	f->seek(offset);
+	uint64_t return_ofs = f->get_position();
+	f->seek(ir.offset);
 
 	String t = get_unicode_string();
 
 	Object *obj = ClassDB::instance(t);
 	if (!obj) {
-		error = ERR_FILE_CORRUPT;
+		f->seek(return_ofs);
 		ERR_EXPLAIN(local_path + ":Resource of unrecognized type in file: " + t);
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
 	}
-	ERR_FAIL_COND_V(!obj, ERR_FILE_CORRUPT);
 
 	Resource *r = Object::cast_to<Resource>(obj);
 	if (!r) {
-		error = ERR_FILE_CORRUPT;
+		String obj_class = obj->get_class();
 		memdelete(obj); //bye
-		ERR_EXPLAIN(local_path + ":Resource type in resource field not a resource, type is: " + obj->get_class());
-		ERR_FAIL_COND_V(!r, ERR_FILE_CORRUPT);
+		f->seek(return_ofs);
+		ERR_EXPLAIN(local_path + ":Resource type in resource field not a resource, type is: " + obj_class);
+		ERR_FAIL_V(ERR_FILE_CORRUPT);
 	}
 
 	RES res = RES(r);
@@ -728,44 +821,45 @@ Error ResourceInteractiveLoaderBinary::poll() {
 	r->set_path(path);
 	r->set_subindex(subindex);
 
+	internal_resources.write[p_index].decoding = true;
+
 	int pc = f->get_32();
 
 	//set properties
 
+	Error err = OK;
+
 	for (int i = 0; i < pc; i++) {
 
 		StringName name = _get_string();
 
 		if (name == StringName()) {
-			error = ERR_FILE_CORRUPT;
-			ERR_FAIL_V(ERR_FILE_CORRUPT);
+			ERR_PRINTS(local_path + ":Resource property without a name.");
+			err = ERR_FILE_CORRUPT;
+			break;
 		}
 
 		Variant value;
 
-		error = parse_variant(value);
-		if (error)
-			return error;
+		err = parse_variant(value);
+		if (err)
+			break;
 
 		res->set(name, value);
 	}
-#ifdef TOOLS_ENABLED
-	res->set_edited(false);
-#endif
-	stage++;
 
-	resource_cache.push_back(res);
+	//the caller may be in the middle of parsing another resource, leave the file as it was
+	internal_resources.write[p_index].decoding = false;
+	f->seek(return_ofs);
 
-	if (main) {
+	if (err)
+		return err;
 
-		f->close();
-		resource = res;
-		resource->set_as_translation_remapped(translation_remapped);
-		error = ERR_FILE_EOF;
+#ifdef TOOLS_ENABLED
+	res->set_edited(false);
+#endif
 
-	} else {
-		error = OK;
-	}
+	internal_resources.write[p_index].resource = res;
 
 	return OK;
 }
@@ -775,7 +869,7 @@ int ResourceInteractiveLoaderBinary::get_stage() const {
 }
 int ResourceInteractiveLoaderBinary::get_stage_count() const {
 
-	return external_resources.size() + internal_resources.size();
+	return external_resources.size() + 1;
 }
 
 void ResourceInteractiveLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -803,16 +897,7 @@ static String get_ustring(FileAccess *f) {
 
 String ResourceInteractiveLoaderBinary::get_unicode_string() {
 
-	int len = f->get_32();
-	if (len > str_buf.size()) {
-		str_buf.resize(len);
-	}
-	if (len == 0)
-		return String();
-	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
-	s.parse_utf8(&str_buf[0]);
-	return s;
+	return _read_unicode_string(f->get_32());
 }
 
 void ResourceInteractiveLoaderBinary::get_dependencies(FileAccess *p_f, List<String> *p_dependencies, bool p_add_types) {
@@ -891,10 +976,48 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 
 	uint32_t string_table_size = f->get_32();
 	string_map.resize(string_table_size);
-	for (uint32_t i = 0; i < string_table_size; i++) {
+	if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+
+		//all strings are stored in a single block, null terminated
+		uint32_t block_size = f->get_32();
+		const char *block = (const char *)f->get_buffer_ptr(block_size);
+		if (!block) {
+			if ((int)block_size > str_buf.size()) {
+				str_buf.resize(block_size);
+			}
+			f->get_buffer((uint8_t *)str_buf.ptrw(), block_size);
+			block = str_buf.ptr();
+		}
+
+		uint32_t ofs = 0;
+		for (uint32_t i = 0; i < string_table_size; i++) {
+
+			uint32_t len = 0;
+			while (ofs + len < block_size && block[ofs + len]) {
+				len++;
+			}
+
+			if (ofs + len >= block_size) {
+				error = ERR_FILE_CORRUPT;
+				ERR_EXPLAIN("Corrupt string table: " + local_path);
+				ERR_FAIL();
+			}
+
+			String s;
+			s.parse_utf8(block + ofs, len);
+			string_map.write[i] = s;
+			ofs += len + 1;
+		}
+
+		_advance_padding(block_size);
+
+	} else {
 
-		StringName s = get_unicode_string();
-		string_map.write[i] = s;
+		for (uint32_t i = 0; i < string_table_size; i++) {
+
+			StringName s = get_unicode_string();
+			string_map.write[i] = s;
+		}
 	}
 
 	print_bl("strings: " + itos(string_table_size));
@@ -918,6 +1041,9 @@ void ResourceInteractiveLoaderBinary::open(FileAccess *p_f) {
 		IntResource ir;
 		ir.path = get_unicode_string();
 		ir.offset = f->get_64();
+		if (ir.path.begins_with("local://")) {
+			internal_index_map[ir.path.replace_first("local://", "").to_int()] = internal_resources.size();
+		}
 		internal_resources.push_back(ir);
 	}
 
@@ -1183,10 +1309,26 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 
 	fw->store_32(string_table_size);
 
-	for (uint32_t i = 0; i < string_table_size; i++) {
+	if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+
+		uint32_t block_size = f->get_32();
+		fw->store_32(block_size);
+		Vector<uint8_t> block;
+		block.resize(block_size);
+		f->get_buffer(block.ptrw(), block_size);
+		fw->store_buffer(block.ptr(), block_size);
+		for (uint32_t i = block_size; i % 4; i++) {
+			f->get_8();
+			fw->store_8(0);
+		}
+
+	} else {
+
+		for (uint32_t i = 0; i < string_table_size; i++) {
 
-		String s = get_ustring(f);
-		save_ustring(fw, s);
+			String s = get_ustring(f);
+			save_ustring(fw, s);
+		}
 	}
 
 	//external resources
@@ -1198,7 +1340,7 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 		String path = get_ustring(f);
 
 		bool relative = false;
-		if (!path.begins_with("res://")) {
+		if (path.find("://") == -1 && path.is_rel_path()) {
 			path = local_path.plus_file(path).simplify_path();
 			relative = true;
 		}
@@ -1217,18 +1359,40 @@ Error ResourceFormatLoaderBinary::rename_dependencies(const String &p_path, cons
 		save_ustring(fw, path);
 	}
 
-	int64_t size_diff = (int64_t)fw->get_position() - (int64_t)f->get_position();
+	uint64_t table_ofs = f->get_position();
 
 	//internal resources
 	uint32_t int_resources_size = f->get_32();
+	Vector<String> int_paths;
+	Vector<uint64_t> int_offsets;
+
+	for (uint32_t i = 0; i < int_resources_size; i++) {
+
+		int_paths.push_back(get_ustring(f));
+		int_offsets.push_back(f->get_64());
+	}
+
+	uint64_t data_ofs = f->get_position();
+	uint64_t new_data_ofs = fw->get_position() + (data_ofs - table_ofs);
+	if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+		//resource data starts aligned, keep it that way
+		data_ofs += (DATA_ALIGNMENT - data_ofs % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+		new_data_ofs += (DATA_ALIGNMENT - new_data_ofs % DATA_ALIGNMENT) % DATA_ALIGNMENT;
+		f->seek(data_ofs);
+	}
+
+	int64_t size_diff = (int64_t)new_data_ofs - (int64_t)data_ofs;
+
 	fw->store_32(int_resources_size);
 
 	for (uint32_t i = 0; i < int_resources_size; i++) {
 
-		String path = get_ustring(f);
-		uint64_t offset = f->get_64();
-		save_ustring(fw, path);
-		fw->store_64(offset + size_diff);
+		save_ustring(fw, int_paths[i]);
+		fw->store_64(int_offsets[i] + size_diff);
+	}
+
+	if (ver_format >= FORMAT_VERSION_STRING_TABLE) {
+		ResourceFormatSaverBinaryInstance::pad_to_alignment(fw);
 	}
 
 	//rest of file
@@ -1285,6 +1449,31 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(FileAccess *f, int p_bytes)
 	}
 }
 
+void ResourceFormatSaverBinaryInstance::pad_to_alignment(FileAccess *f) {
+
+	uint64_t extra = f->get_position() % DATA_ALIGNMENT;
+	if (extra) {
+		for (uint64_t i = extra; i < DATA_ALIGNMENT; i++)
+			f->store_8(0);
+	}
+}
+
+void ResourceFormatSaverBinaryInstance::save_string_table(FileAccess *f, const Vector<StringName> &p_strings) {
+
+	Vector<uint8_t> block;
+	for (int i = 0; i < p_strings.size(); i++) {
+		CharString utf8 = String(p_strings[i]).utf8();
+		int ofs = block.size();
+		block.resize(ofs + utf8.length() + 1);
+		copymem(&block.write[ofs], utf8.get_data(), utf8.length() + 1);
+	}
+
+	f->store_32(p_strings.size()); //string table size
+	f->store_32(block.size());
+	f->store_buffer(block.ptr(), block.size());
+	_pad_buffer(f, block.size());
+}
+
 void ResourceFormatSaverBinaryInstance::_write_variant(const Variant &p_property, const PropertyInfo &p_hint) {
 
 	write_variant(f, p_property, resource_set, external_resources, string_map, p_hint);
@@ -1336,7 +1525,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 
 			f->store_32(VARIANT_STRING);
 			String val = p_property;
-			save_unicode_string(f, val);
+			const Map<StringName, int>::Element *E = string_map.find(val);
+			if (E) {
+				f->store_32(E->get());
+			} else {
+				save_unicode_string(f, val, true);
+			}
 
 		} break;
 		case Variant::VECTOR2: {
@@ -1549,6 +1743,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<uint8_t>::Read r = arr.read();
 			f->store_buffer(r.ptr(), len);
 			_pad_buffer(f, len);
@@ -1560,6 +1755,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<int> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<int>::Read r = arr.read();
 			for (int i = 0; i < len; i++)
 				f->store_32(r[i]);
@@ -1571,6 +1767,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<real_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<real_t>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i]);
@@ -1585,7 +1782,12 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			f->store_32(len);
 			PoolVector<String>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
-				save_unicode_string(f, r[i]);
+				const Map<StringName, int>::Element *E = string_map.find(r[i]);
+				if (E) {
+					f->store_32(E->get());
+				} else {
+					save_unicode_string(f, r[i], true);
+				}
 			}
 
 		} break;
@@ -1595,6 +1797,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<Vector3>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -1609,6 +1812,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<Vector2>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -1622,6 +1826,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(FileAccess *f, const Varia
 			PoolVector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(len);
+			pad_to_alignment(f);
 			PoolVector<Color>::Read r = arr.read();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].r);
@@ -1716,6 +1921,29 @@ void ResourceFormatSaverBinaryInstance::_find_resources(const Variant &p_variant
 				_find_resources(v);
 			}
 		} break;
+		case Variant::STRING: {
+			//strings found more than once are shared through the string table
+			String s = p_variant;
+			if (seen_strings.has(s)) {
+				get_string_index(s);
+			} else {
+				seen_strings.insert(s);
+			}
+
+		} break;
+		case Variant::POOL_STRING_ARRAY: {
+
+			PoolVector<String> arr = p_variant;
+			PoolVector<String>::Read r = arr.read();
+			for (int i = 0; i < arr.size(); i++) {
+				if (seen_strings.has(r[i])) {
+					get_string_index(r[i]);
+				} else {
+					seen_strings.insert(r[i]);
+				}
+			}
+
+		} break;
 		case Variant::NODE_PATH: {
 			//take the chance and save node path strings
 			NodePath np = p_variant;
@@ -1855,10 +2083,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const RES &p
 		}
 	}
 
-	f->store_32(strings.size()); //string table size
-	for (int i = 0; i < strings.size(); i++) {
-		save_unicode_string(f, strings[i]);
-	}
+	save_string_table(f, strings);
 
 	// save external resource table
 	f->store_32(external_resources.size()); //amount of external resources
@@ -1924,6 +2149,8 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const RES &p
 		f->store_64(0); //offset in 64 bits
 	}
 
+	pad_to_alignment(f);
+
 	Vector<uint64_t> ofs_table;
 
 	//now actually save the resources
@@ -55,6 +55,8 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	Vector<StringName> string_map;
 
 	StringName _get_string();
+	String _get_string_value();
+	String _read_unicode_string(uint32_t p_len);
 
 	struct ExtResource {
 		String path;
@@ -66,12 +68,22 @@ class ResourceInteractiveLoaderBinary : public ResourceInteractiveLoader {
 	struct IntResource {
 		String path;
 		uint64_t offset;
+		RES resource;
+		bool decoding;
+
+		IntResource() :
+				offset(0),
+				decoding(false) {}
 	};
 
 	Vector<IntResource> internal_resources;
+	Map<int, int> internal_index_map; // subindex -> internal resource
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	void _advance_alignment();
+
+	Error _decode_internal_resource(int p_index);
 
 	Map<String, String> remaps;
 	Error error;
@@ -134,6 +146,7 @@ class ResourceFormatSaverBinaryInstance {
 	Map<NonPersistentKey, RES> non_persistent_map;
 	Map<StringName, int> string_map;
 	Vector<StringName> strings;
+	Set<String> seen_strings;
 
 	Map<RES, int> external_resources;
 	List<RES> saved_resources;
@@ -158,6 +171,8 @@ class ResourceFormatSaverBinaryInstance {
 
 public:
 	Error save(const String &p_path, const RES &p_resource, uint32_t p_flags = 0);
+	static void pad_to_alignment(FileAccess *f);
+	static void save_string_table(FileAccess *f, const Vector<StringName> &p_strings);
 	static void write_variant(FileAccess *f, const Variant &p_property, Set<RES> &resource_set, Map<RES, int> &external_resources, Map<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
 };
 
@@ -198,7 +198,7 @@ bool ResourceFormatImporter::can_be_imported(const String &p_path) const {
 	return ResourceFormatLoader::recognize_path(p_path);
 }
 
-int ResourceFormatImporter::get_import_order(const String &p_path) const {
+Ref<ResourceImporter> ResourceFormatImporter::_get_importer_for_file(const String &p_path) const {
 
 	Ref<ResourceImporter> importer;
 
@@ -215,12 +215,29 @@ int ResourceFormatImporter::get_import_order(const String &p_path) const {
 		importer = get_importer_by_extension(p_path.get_extension().to_lower());
 	}
 
+	return importer;
+}
+
+int ResourceFormatImporter::get_import_order(const String &p_path) const {
+
+	Ref<ResourceImporter> importer = _get_importer_for_file(p_path);
+
 	if (importer.is_valid())
 		return importer->get_import_order();
 
 	return 0;
 }
 
+bool ResourceFormatImporter::can_import_threaded(const String &p_path) const {
+
+	Ref<ResourceImporter> importer = _get_importer_for_file(p_path);
+
+	if (importer.is_valid())
+		return importer->can_import_threaded();
+
+	return false;
+}
+
 bool ResourceFormatImporter::handles_type(const String &p_type) const {
 
 	for (int i = 0; i < importers.size(); i++) {
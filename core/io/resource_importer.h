@@ -47,6 +47,7 @@ class ResourceFormatImporter : public ResourceFormatLoader {
 	};
 
 	Error _get_path_and_type(const String &p_path, PathAndType &r_path_and_type, bool *r_valid = NULL) const;
+	Ref<ResourceImporter> _get_importer_for_file(const String &p_path) const;
 
 	static ResourceFormatImporter *singleton;
 
@@ -73,6 +74,7 @@ public:
 
 	virtual bool can_be_imported(const String &p_path) const;
 	virtual int get_import_order(const String &p_path) const;
+	bool can_import_threaded(const String &p_path) const;
 
 	String get_internal_resource_path(const String &p_path) const;
 	void get_internal_resource_path_list(const String &p_path, List<String> *r_paths);
@@ -103,6 +105,9 @@ public:
 	virtual String get_resource_type() const = 0;
 	virtual float get_priority() const { return 1.0; }
 	virtual int get_import_order() const { return 0; }
+	// Importers that only read their source and write their own files may return true,
+	// the editor then imports several files with them at once on worker threads.
+	virtual bool can_import_threaded() const { return false; }
 
 	struct ImportOption {
 		PropertyInfo option;
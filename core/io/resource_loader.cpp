@@ -356,6 +356,14 @@ RES ResourceLoader::load(const String &p_path, const String &p_type_hint, bool p
 
 	if (!p_no_cache) {
 
+		{
+			//another thread may be loading it already, wait for it instead of loading it twice
+			RES res;
+			if (_wait_for_thread_load(local_path, &res, r_error)) {
+				return res;
+			}
+		}
+
 		{
 			bool success = _add_to_loading_map(local_path);
 			if (!success) {
@@ -468,6 +476,457 @@ bool ResourceLoader::exists(const String &p_path, const String &p_type_hint) {
 	return false;
 }
 
+ResourceLoader::ThreadLoadTask *ResourceLoader::_create_thread_load_task(const String &p_local_path, const String &p_type_hint, bool p_use_sub_threads, bool *r_created) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (task) {
+		if (p_use_sub_threads && !task->dependencies_scanned && !task->started) {
+			task->use_sub_threads = true;
+		}
+		*r_created = false;
+		return task;
+	}
+
+	thread_load_tasks[p_local_path] = ThreadLoadTask();
+	task = thread_load_tasks.getptr(p_local_path);
+	task->local_path = p_local_path;
+	task->type_hint = p_type_hint;
+	task->use_sub_threads = p_use_sub_threads;
+	*r_created = true;
+
+	if (ResourceCache::lock) {
+		ResourceCache::lock->read_lock();
+	}
+
+	Resource **rptr = ResourceCache::resources.getptr(p_local_path);
+	if (rptr) {
+		RES res(*rptr);
+		//same as in load(), it may have just been freed in another thread
+		if (res.is_valid()) {
+			task->resource = res;
+			task->status = THREAD_LOAD_LOADED;
+			task->started = true;
+		}
+	}
+
+	if (ResourceCache::lock) {
+		ResourceCache::lock->read_unlock();
+	}
+
+	return task;
+}
+
+void ResourceLoader::_queue_thread_load_task(const String &p_local_path) {
+
+	thread_load_queue.push_back(p_local_path);
+
+	if (thread_load_threads.empty()) {
+		int thread_count = MAX(1, OS::get_singleton()->get_processor_count() - 1);
+		for (int i = 0; i < thread_count; i++) {
+			thread_load_threads.push_back(Thread::create(_thread_load_function, NULL));
+		}
+	}
+
+	thread_load_semaphore->post();
+}
+
+void ResourceLoader::_release_thread_load_task(const String &p_local_path) {
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task || task->status == THREAD_LOAD_IN_PROGRESS) {
+		return;
+	}
+
+	if (task->requests > 0 || task->dependants > 0 || task->waiters > 0) {
+		return;
+	}
+
+	if (task->semaphore) {
+		memdelete(task->semaphore);
+	}
+	thread_load_tasks.erase(p_local_path);
+}
+
+RES ResourceLoader::_run_thread_load_task(const String &p_local_path, const String &p_type_hint, Error *r_error) {
+
+	Error err = OK;
+	RES res = load(p_local_path, p_type_hint, false, &err);
+	if (res.is_null() && err == OK) {
+		err = ERR_CANT_OPEN;
+	}
+	if (r_error) {
+		*r_error = err;
+	}
+
+	MutexLock lock(thread_load_mutex);
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	ERR_FAIL_COND_V(!task, res);
+
+	task->resource = res;
+	task->error = err;
+	task->status = res.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+
+	for (int i = 0; i < task->waiters; i++) {
+		task->semaphore->post();
+	}
+
+	for (Set<String>::Element *E = task->waiting_dependants.front(); E; E = E->next()) {
+		ThreadLoadTask *dependant = thread_load_tasks.getptr(E->get());
+		if (!dependant || dependant->pending_dependencies == 0) {
+			continue;
+		}
+		dependant->pending_dependencies--;
+		if (dependant->pending_dependencies == 0 && !dependant->started) {
+			_queue_thread_load_task(E->get());
+		}
+	}
+	task->waiting_dependants.clear();
+
+	//dependencies are in the cache now and referenced by this resource, no need to hold them
+	Set<String> dependencies = task->dependencies;
+	task->dependencies.clear();
+	for (Set<String>::Element *E = dependencies.front(); E; E = E->next()) {
+		ThreadLoadTask *dependency = thread_load_tasks.getptr(E->get());
+		if (dependency) {
+			dependency->dependants--;
+			_release_thread_load_task(E->get());
+		}
+	}
+
+	_release_thread_load_task(p_local_path);
+
+	return res;
+}
+
+bool ResourceLoader::_thread_load_waits_for(const String &p_local_path, const String &p_target) {
+
+	List<String> stack;
+	Set<String> visited;
+	stack.push_back(p_local_path);
+
+	while (stack.size()) {
+
+		String path = stack.back()->get();
+		stack.pop_back();
+
+		if (path == p_target) {
+			return true;
+		}
+		if (visited.has(path)) {
+			continue;
+		}
+		visited.insert(path);
+
+		const ThreadLoadTask *task = thread_load_tasks.getptr(path);
+		if (!task || task->status != THREAD_LOAD_IN_PROGRESS) {
+			continue;
+		}
+
+		for (const Set<String>::Element *E = task->dependencies.front(); E; E = E->next()) {
+			stack.push_back(E->get());
+		}
+	}
+
+	return false;
+}
+
+void ResourceLoader::_scan_thread_load_dependencies(const String &p_local_path) {
+
+	List<String> dependencies;
+	get_dependencies(p_local_path, &dependencies);
+
+	MutexLock lock(thread_load_mutex);
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task || task->started) {
+		return; //loaded inline while scanning
+	}
+
+	for (List<String>::Element *E = dependencies.front(); E; E = E->next()) {
+
+		String path = E->get().get_slice("::", 0);
+		if (path.is_rel_path())
+			path = "res://" + path;
+		else
+			path = ProjectSettings::get_singleton()->localize_path(path);
+
+		if (path == p_local_path || task->dependencies.has(path)) {
+			continue;
+		}
+
+		bool created = false;
+		ThreadLoadTask *dependency = _create_thread_load_task(path, "", true, &created);
+
+		if (!created && dependency->status == THREAD_LOAD_IN_PROGRESS && _thread_load_waits_for(path, p_local_path)) {
+			continue; //cyclic, don't wait on it and let the loader report it
+		}
+
+		task->dependencies.insert(path);
+		dependency->dependants++;
+
+		if (dependency->status == THREAD_LOAD_IN_PROGRESS) {
+			task->pending_dependencies++;
+			dependency->waiting_dependants.insert(p_local_path);
+			if (created) {
+				_queue_thread_load_task(path);
+			}
+		}
+	}
+
+	if (task->pending_dependencies == 0) {
+		_queue_thread_load_task(p_local_path);
+	}
+}
+
+bool ResourceLoader::_wait_for_thread_load(const String &p_local_path, RES *r_resource, Error *r_error) {
+
+	if (!thread_load_mutex) {
+		return false;
+	}
+
+	thread_load_mutex->lock();
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(p_local_path);
+	if (!task || task->status != THREAD_LOAD_IN_PROGRESS) {
+		thread_load_mutex->unlock();
+		return false;
+	}
+
+	Thread::ID caller = Thread::get_caller_id();
+
+	if (!task->started) {
+		//nobody picked it up yet, load it here rather than waiting for a worker
+		task->started = true;
+		task->loader_thread = caller;
+		String type_hint = task->type_hint;
+		thread_load_mutex->unlock();
+
+		*r_resource = _run_thread_load_task(p_local_path, type_hint, r_error);
+		return true;
+	}
+
+	if (task->loader_thread == caller) {
+		//nested load from within the task, let the loading map catch cycles
+		thread_load_mutex->unlock();
+		return false;
+	}
+
+	//don't wait on a thread that is itself waiting on us
+	Thread::ID owner = task->loader_thread;
+	for (uint32_t i = 0; i < thread_load_waiting.size(); i++) {
+		const String *waiting_for = thread_load_waiting.getptr(owner);
+		if (!waiting_for) {
+			break;
+		}
+		const ThreadLoadTask *waiting_task = thread_load_tasks.getptr(*waiting_for);
+		if (!waiting_task) {
+			break;
+		}
+		owner = waiting_task->loader_thread;
+		if (owner == caller) {
+			thread_load_mutex->unlock();
+			if (r_error) {
+				*r_error = ERR_CYCLIC_LINK;
+			}
+			*r_resource = RES();
+			ERR_EXPLAIN("Resource: '" + p_local_path + "' is already being loaded. Cyclic reference?");
+			ERR_FAIL_V(true);
+		}
+	}
+
+	if (!task->semaphore) {
+		task->semaphore = Semaphore::create();
+	}
+	task->waiters++;
+	thread_load_waiting[caller] = p_local_path;
+	Semaphore *semaphore = task->semaphore;
+
+	thread_load_mutex->unlock();
+
+	semaphore->wait();
+
+	thread_load_mutex->lock();
+
+	thread_load_waiting.erase(caller);
+	task = thread_load_tasks.getptr(p_local_path);
+	task->waiters--;
+	*r_resource = task->resource;
+	if (r_error) {
+		*r_error = task->error;
+	}
+	_release_thread_load_task(p_local_path);
+
+	thread_load_mutex->unlock();
+
+	return true;
+}
+
+void ResourceLoader::_thread_load_function(void *p_userdata) {
+
+	while (true) {
+
+		thread_load_semaphore->wait();
+
+		thread_load_mutex->lock();
+
+		if (thread_load_exit) {
+			thread_load_mutex->unlock();
+			break;
+		}
+
+		if (thread_load_queue.empty()) {
+			thread_load_mutex->unlock();
+			continue;
+		}
+
+		String local_path = thread_load_queue.front()->get();
+		thread_load_queue.pop_front();
+
+		ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+		if (!task || task->started) {
+			thread_load_mutex->unlock();
+			continue; //loaded inline meanwhile
+		}
+
+		if (task->use_sub_threads && !task->dependencies_scanned) {
+			//queue the dependencies first, this task is queued again once they are loaded
+			task->dependencies_scanned = true;
+			thread_load_mutex->unlock();
+			_scan_thread_load_dependencies(local_path);
+			continue;
+		}
+
+		task->started = true;
+		task->loader_thread = Thread::get_caller_id();
+		String type_hint = task->type_hint;
+
+		thread_load_mutex->unlock();
+
+		_run_thread_load_task(local_path, type_hint, NULL);
+	}
+}
+
+Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads) {
+
+	String local_path;
+	if (p_path.is_rel_path())
+		local_path = "res://" + p_path;
+	else
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	bool created = false;
+
+	if (!thread_load_mutex) {
+		//no threads, load it right away
+		ThreadLoadTask *task = _create_thread_load_task(local_path, p_type_hint, false, &created);
+		task->requests++;
+		if (task->status == THREAD_LOAD_IN_PROGRESS) {
+			task->started = true;
+			Error err = OK;
+			task->resource = load(local_path, p_type_hint, false, &err);
+			task->error = task->resource.is_valid() ? OK : (err != OK ? err : ERR_CANT_OPEN);
+			task->status = task->resource.is_valid() ? THREAD_LOAD_LOADED : THREAD_LOAD_FAILED;
+		}
+		return OK;
+	}
+
+	MutexLock lock(thread_load_mutex);
+
+	ThreadLoadTask *task = _create_thread_load_task(local_path, p_type_hint, p_use_sub_threads, &created);
+	task->requests++;
+
+	if (created && task->status == THREAD_LOAD_IN_PROGRESS) {
+		_queue_thread_load_task(local_path);
+	}
+
+	return OK;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+
+	String local_path;
+	if (p_path.is_rel_path())
+		local_path = "res://" + p_path;
+	else
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	MutexLock lock(thread_load_mutex);
+
+	const ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task || task->requests == 0) {
+		if (r_progress) {
+			*r_progress = 0;
+		}
+		return THREAD_LOAD_INVALID_RESOURCE;
+	}
+
+	if (r_progress) {
+		if (task->status != THREAD_LOAD_IN_PROGRESS) {
+			*r_progress = 1.0;
+		} else {
+			int loaded = 0;
+			for (const Set<String>::Element *E = task->dependencies.front(); E; E = E->next()) {
+				const ThreadLoadTask *dependency = thread_load_tasks.getptr(E->get());
+				if (!dependency || dependency->status != THREAD_LOAD_IN_PROGRESS) {
+					loaded++;
+				}
+			}
+			*r_progress = float(loaded) / float(task->dependencies.size() + 1);
+		}
+	}
+
+	return task->status;
+}
+
+RES ResourceLoader::load_threaded_get(const String &p_path, Error *r_error) {
+
+	String local_path;
+	if (p_path.is_rel_path())
+		local_path = "res://" + p_path;
+	else
+		local_path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->lock();
+	}
+
+	ThreadLoadTask *task = thread_load_tasks.getptr(local_path);
+	if (!task || task->requests == 0) {
+		if (thread_load_mutex) {
+			thread_load_mutex->unlock();
+		}
+		if (r_error) {
+			*r_error = ERR_INVALID_PARAMETER;
+		}
+		ERR_EXPLAIN("Attempted to retrieve a resource that was not requested for threaded loading: " + local_path);
+		ERR_FAIL_V(RES());
+	}
+
+	if (task->status == THREAD_LOAD_IN_PROGRESS) {
+		//our request keeps the task alive while waiting
+		thread_load_mutex->unlock();
+		RES res;
+		_wait_for_thread_load(local_path, &res, NULL);
+		thread_load_mutex->lock();
+		task = thread_load_tasks.getptr(local_path);
+	}
+
+	RES res = task->resource;
+	if (r_error) {
+		*r_error = task->error;
+	}
+
+	task->requests--;
+	_release_thread_load_task(local_path);
+
+	if (thread_load_mutex) {
+		thread_load_mutex->unlock();
+	}
+
+	return res;
+}
+
 Ref<ResourceInteractiveLoader> ResourceLoader::load_interactive(const String &p_path, const String &p_type_hint, bool p_no_cache, Error *r_error) {
 
 	if (r_error)
@@ -972,14 +1431,42 @@ void ResourceLoader::remove_custom_loaders() {
 Mutex *ResourceLoader::loading_map_mutex = NULL;
 HashMap<ResourceLoader::LoadingMapKey, int, ResourceLoader::LoadingMapKeyHasher> ResourceLoader::loading_map;
 
+Mutex *ResourceLoader::thread_load_mutex = NULL;
+HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
+HashMap<Thread::ID, String> ResourceLoader::thread_load_waiting;
+List<String> ResourceLoader::thread_load_queue;
+Semaphore *ResourceLoader::thread_load_semaphore = NULL;
+Vector<Thread *> ResourceLoader::thread_load_threads;
+bool ResourceLoader::thread_load_exit = false;
+
 void ResourceLoader::initialize() {
 #ifndef NO_THREADS
 	loading_map_mutex = Mutex::create();
+	thread_load_mutex = Mutex::create();
+	thread_load_semaphore = Semaphore::create();
 #endif
 }
 
 void ResourceLoader::finalize() {
 #ifndef NO_THREADS
+	//stop the workers first, they may still be using the mutexes below
+	thread_load_mutex->lock();
+	thread_load_exit = true;
+	thread_load_mutex->unlock();
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		thread_load_semaphore->post();
+	}
+	for (int i = 0; i < thread_load_threads.size(); i++) {
+		Thread::wait_to_finish(thread_load_threads[i]);
+		memdelete(thread_load_threads[i]);
+	}
+	thread_load_threads.clear();
+	thread_load_queue.clear();
+	memdelete(thread_load_semaphore);
+	thread_load_semaphore = NULL;
+	memdelete(thread_load_mutex);
+	thread_load_mutex = NULL;
+
 	const LoadingMapKey *K = NULL;
 	while ((K = loading_map.next(K))) {
 		ERR_PRINTS("Exited while resource is being loaded: " + K->path);
@@ -988,6 +1475,15 @@ void ResourceLoader::finalize() {
 	memdelete(loading_map_mutex);
 	loading_map_mutex = NULL;
 #endif
+
+	const String *E = NULL;
+	while ((E = thread_load_tasks.next(E))) {
+		ThreadLoadTask &task = thread_load_tasks[*E];
+		if (task.semaphore) {
+			memdelete(task.semaphore);
+		}
+	}
+	thread_load_tasks.clear();
 }
 
 ResourceLoadErrorNotify ResourceLoader::err_notify = NULL;
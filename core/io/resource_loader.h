@@ -31,8 +31,10 @@
 #ifndef RESOURCE_LOADER_H
 #define RESOURCE_LOADER_H
 
+#include "core/os/semaphore.h"
 #include "core/os/thread.h"
 #include "core/resource.h"
+#include "core/set.h"
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
 */
@@ -97,6 +99,15 @@ class ResourceLoader {
 		MAX_LOADERS = 64
 	};
 
+public:
+	enum ThreadLoadStatus {
+		THREAD_LOAD_INVALID_RESOURCE,
+		THREAD_LOAD_IN_PROGRESS,
+		THREAD_LOAD_FAILED,
+		THREAD_LOAD_LOADED
+	};
+
+private:
 	static Ref<ResourceFormatLoader> loader[MAX_LOADERS];
 	static int loader_count;
 	static bool timestamp_on_load;
@@ -143,11 +154,66 @@ class ResourceLoader {
 	static void _remove_from_loading_map(const String &p_path);
 	static void _remove_from_loading_map_and_thread(const String &p_path, Thread::ID p_thread);
 
+	//threaded loading, one task per local path shared by every request for it
+	struct ThreadLoadTask {
+		String local_path;
+		String type_hint;
+		ThreadLoadStatus status;
+		Error error;
+		RES resource;
+		bool use_sub_threads;
+		bool dependencies_scanned;
+		bool started; //picked up by a worker or loaded inline by another load
+		Thread::ID loader_thread;
+		int requests; //load_threaded_request() calls not yet matched by load_threaded_get()
+		int dependants; //unfinished tasks that depend on this one
+		int pending_dependencies;
+		Set<String> dependencies;
+		Set<String> waiting_dependants;
+		Semaphore *semaphore; //posted once per waiter when the task finishes
+		int waiters;
+
+		ThreadLoadTask() {
+			status = THREAD_LOAD_IN_PROGRESS;
+			error = OK;
+			use_sub_threads = false;
+			dependencies_scanned = false;
+			started = false;
+			loader_thread = 0;
+			requests = 0;
+			dependants = 0;
+			pending_dependencies = 0;
+			semaphore = NULL;
+			waiters = 0;
+		}
+	};
+
+	static Mutex *thread_load_mutex;
+	static HashMap<String, ThreadLoadTask> thread_load_tasks;
+	static HashMap<Thread::ID, String> thread_load_waiting; //task each thread is blocked on, to detect cycles
+	static List<String> thread_load_queue;
+	static Semaphore *thread_load_semaphore;
+	static Vector<Thread *> thread_load_threads;
+	static bool thread_load_exit;
+
+	static ThreadLoadTask *_create_thread_load_task(const String &p_local_path, const String &p_type_hint, bool p_use_sub_threads, bool *r_created);
+	static void _queue_thread_load_task(const String &p_local_path);
+	static RES _run_thread_load_task(const String &p_local_path, const String &p_type_hint, Error *r_error);
+	static void _scan_thread_load_dependencies(const String &p_local_path);
+	static void _release_thread_load_task(const String &p_local_path);
+	static bool _thread_load_waits_for(const String &p_local_path, const String &p_target);
+	static bool _wait_for_thread_load(const String &p_local_path, RES *r_resource, Error *r_error);
+	static void _thread_load_function(void *p_userdata);
+
 public:
 	static Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static RES load(const String &p_path, const String &p_type_hint = "", bool p_no_cache = false, Error *r_error = NULL);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
+	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false);
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = NULL);
+	static RES load_threaded_get(const String &p_path, Error *r_error = NULL);
+
 	static void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions);
 	static void add_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader, bool p_at_front = false);
 	static void remove_resource_format_loader(Ref<ResourceFormatLoader> p_format_loader);
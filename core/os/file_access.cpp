@@ -39,6 +39,7 @@
 #include "thirdparty/misc/sha256.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = { 0, 0 };
+FileAccess::CreateFunc FileAccess::create_mapped_func = NULL;
 
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = NULL;
 
@@ -121,6 +122,31 @@ FileAccess *FileAccess::open(const String &p_path, int p_mode_flags, Error *r_er
 	return ret;
 }
 
+FileAccess *FileAccess::open_mapped(const String &p_path, Error *r_error) {
+
+	if (create_mapped_func) {
+
+		FileAccess *ret = create_mapped_func();
+		if (p_path.begins_with("res://")) {
+			ret->_set_access_type(ACCESS_RESOURCES);
+		} else if (p_path.begins_with("user://")) {
+			ret->_set_access_type(ACCESS_USERDATA);
+		} else {
+			ret->_set_access_type(ACCESS_FILESYSTEM);
+		}
+
+		if (ret->_open(p_path, READ) == OK) {
+			if (r_error)
+				*r_error = OK;
+			return ret;
+		}
+		memdelete(ret);
+	}
+
+	// Not mappable (or inside a pack), read it the usual way.
+	return open(p_path, READ, r_error);
+}
+
 FileAccess::CreateFunc FileAccess::get_create_func(AccessType p_access) {
 
 	return create_func[p_access];
@@ -68,6 +68,7 @@ private:
 
 	AccessType _access_type;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static CreateFunc create_mapped_func; /** read only file access that maps whole files in memory, if the platform has one */
 	template <class T>
 	static FileAccess *_create_builtin() {
 
@@ -110,6 +111,8 @@ public:
 	virtual real_t get_real() const;
 
 	virtual int get_buffer(uint8_t *p_dst, int p_length) const; ///< get an array of bytes
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const { return NULL; } ///< get an array of bytes without copying, valid while the file is open; NULL if unsupported
+	virtual void prefetch(size_t p_position, size_t p_length) const {} ///< hint that a range of the file will be read soon
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -153,6 +156,7 @@ public:
 	static FileAccess *create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 	static FileAccess *create_for_path(const String &p_path);
 	static FileAccess *open(const String &p_path, int p_mode_flags, Error *r_error = NULL); /// Create a file access (for the current platform) this is the only portable way of accessing files.
+	static FileAccess *open_mapped(const String &p_path, Error *r_error = NULL); /// Open for reading, memory mapped when the platform supports it.
 	static CreateFunc get_create_func(AccessType p_access);
 	static bool exists(const String &p_name); ///< return true if a file exists
 	static uint64_t get_modified_time(const String &p_file);
@@ -173,6 +177,12 @@ public:
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+	template <class T>
+	static void make_mapped_default() {
+
+		create_mapped_func = _create_builtin<T>;
+	}
+
 	FileAccess();
 	virtual ~FileAccess() {}
 };
@@ -488,6 +488,22 @@ int OS::get_processor_count() const {
 	return 1;
 }
 
+int OS::dir_watch_create() {
+
+	return -1;
+}
+
+int OS::dir_watch_add(int p_watcher, const String &p_path, bool p_removals_only) {
+
+	return -1;
+}
+
+void OS::dir_watch_poll(int p_watcher, List<DirWatchEvent> *r_events) {
+}
+
+void OS::dir_watch_free(int p_watcher) {
+}
+
 Error OS::native_video_play(String p_path, float p_volume, String p_audio_track, String p_subtitle_track) {
 
 	return FAILED;
@@ -457,6 +457,18 @@ public:
 
 	virtual String get_unique_id() const;
 
+	/* Directory change notifications, dir_watch_create() returns -1 where they are not supported */
+	struct DirWatchEvent {
+		int watch;
+		bool watch_removed; //the directory is gone and so is its watch
+		bool overflow; //events were lost, watch is meaningless
+	};
+
+	virtual int dir_watch_create();
+	virtual int dir_watch_add(int p_watcher, const String &p_path, bool p_removals_only = false);
+	virtual void dir_watch_poll(int p_watcher, List<DirWatchEvent> *r_events);
+	virtual void dir_watch_free(int p_watcher);
+
 	virtual Error native_video_play(String p_path, float p_volume, String p_audio_track, String p_subtitle_track);
 	virtual bool native_video_is_playing() const;
 	virtual void native_video_pause();
@@ -0,0 +1,138 @@
+/*************************************************************************/
+/*  thread_work_pool.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "thread_work_pool.h"
+
+#include "core/os/os.h"
+#include "core/safe_refcount.h"
+
+void ThreadWorkPool::_thread_func(void *p_ud) {
+
+	ThreadWorkPool *pool = (ThreadWorkPool *)p_ud;
+
+	while (true) {
+		pool->work_sem->wait();
+		if (pool->exit) {
+			break;
+		}
+		_process(pool->task);
+		pool->done_sem->post();
+	}
+}
+
+void ThreadWorkPool::_process(Task *p_task) {
+
+	while (true) {
+		uint32_t index = atomic_increment(&p_task->next) - 1;
+		if (index >= p_task->count) {
+			break;
+		}
+		p_task->process(p_task->userdata, index);
+	}
+}
+
+void ThreadWorkPool::init(int p_threads) {
+
+	ERR_FAIL_COND(threads.size() > 0);
+
+	if (p_threads < 0) {
+		p_threads = OS::get_singleton()->get_processor_count() - 1;
+	}
+
+#ifndef NO_THREADS
+	if (p_threads > 0) {
+		exit = false;
+		work_sem = Semaphore::create();
+		done_sem = Semaphore::create();
+		for (int i = 0; i < p_threads; i++) {
+			threads.push_back(Thread::create(_thread_func, this));
+		}
+	}
+#endif
+}
+
+void ThreadWorkPool::finish() {
+
+	if (threads.size() == 0) {
+		return;
+	}
+
+	exit = true;
+	for (int i = 0; i < threads.size(); i++) {
+		work_sem->post();
+	}
+	for (int i = 0; i < threads.size(); i++) {
+		Thread::wait_to_finish(threads[i]);
+		memdelete(threads[i]);
+	}
+	threads.clear();
+
+	memdelete(work_sem);
+	memdelete(done_sem);
+	work_sem = NULL;
+	done_sem = NULL;
+}
+
+void ThreadWorkPool::do_work(uint32_t p_count, void (*p_process)(void *, uint32_t), void *p_userdata) {
+
+	Task t;
+	t.process = p_process;
+	t.userdata = p_userdata;
+	t.count = p_count;
+	t.next = 0;
+
+	int helpers = MIN(threads.size(), int(p_count) - 1);
+	if (helpers > 0) {
+		task = &t;
+		for (int i = 0; i < helpers; i++) {
+			work_sem->post();
+		}
+		_process(&t);
+		for (int i = 0; i < helpers; i++) {
+			done_sem->wait();
+		}
+		task = NULL;
+	} else {
+		_process(&t);
+	}
+}
+
+ThreadWorkPool::ThreadWorkPool() {
+
+	work_sem = NULL;
+	done_sem = NULL;
+	task = NULL;
+	exit = false;
+}
+
+ThreadWorkPool::~ThreadWorkPool() {
+
+	finish();
+}
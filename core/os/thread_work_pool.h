@@ -0,0 +1,96 @@
+/*************************************************************************/
+/*  thread_work_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef THREAD_WORK_POOL_H
+#define THREAD_WORK_POOL_H
+
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/vector.h"
+
+// Persistent worker threads for splitting per frame work into many small
+// items. Unlike thread_process_array(), no thread is created per call: the
+// workers sleep on a semaphore between calls, and the calling thread takes
+// items too. Items are handed out through an atomic counter, so they may run
+// in any order and must not depend on each other.
+class ThreadWorkPool {
+
+	struct Task {
+		void (*process)(void *, uint32_t);
+		void *userdata;
+		uint32_t count;
+		uint32_t next;
+	};
+
+	template <class C, class M, class U>
+	struct MethodData {
+		C *instance;
+		M method;
+		U userdata;
+
+		static void process(void *p_data, uint32_t p_index) {
+			MethodData *data = (MethodData *)p_data;
+			(data->instance->*data->method)(p_index, data->userdata);
+		}
+	};
+
+	Vector<Thread *> threads;
+	Semaphore *work_sem;
+	Semaphore *done_sem;
+	Task *task;
+	bool exit;
+
+	static void _thread_func(void *p_ud);
+	static void _process(Task *p_task);
+
+public:
+	// -1 uses one thread less than the processor count, leaving a core for the caller.
+	void init(int p_threads = -1);
+	void finish();
+
+	void do_work(uint32_t p_count, void (*p_process)(void *, uint32_t), void *p_userdata);
+
+	template <class C, class M, class U>
+	void do_work(uint32_t p_count, C *p_instance, M p_method, U p_userdata) {
+
+		MethodData<C, M, U> data;
+		data.instance = p_instance;
+		data.method = p_method;
+		data.userdata = p_userdata;
+		do_work(p_count, &MethodData<C, M, U>::process, &data);
+	}
+
+	int get_thread_count() const { return threads.size(); }
+
+	ThreadWorkPool();
+	~ThreadWorkPool();
+};
+
+#endif // THREAD_WORK_POOL_H
@@ -32,6 +32,7 @@
 
 #include "core/bind/core_bind.h"
 #include "core/core_string_names.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_network.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
@@ -1187,6 +1188,11 @@ ProjectSettings::ProjectSettings() {
 	Compression::gzip_level = GLOBAL_DEF("compression/formats/gzip/compression_level", Z_DEFAULT_COMPRESSION);
 	custom_prop_info["compression/formats/gzip/compression_level"] = PropertyInfo(Variant::INT, "compression/formats/gzip/compression_level", PROPERTY_HINT_RANGE, "-1,9,1");
 
+	FileAccessCompressed::default_block_size = GLOBAL_DEF("compression/formats/block_size", 65536);
+	custom_prop_info["compression/formats/block_size"] = PropertyInfo(Variant::INT, "compression/formats/block_size", PROPERTY_HINT_RANGE, "4096,1048576,4096");
+	FileAccessCompressed::block_cache_size = GLOBAL_DEF("compression/formats/block_cache_size", 4);
+	custom_prop_info["compression/formats/block_cache_size"] = PropertyInfo(Variant::INT, "compression/formats/block_cache_size", PROPERTY_HINT_RANGE, "1,64,1");
+
 	// Would ideally be defined in an Android-specific file, but then it doesn't appear in the docs
 	GLOBAL_DEF("android/modules", "");
 
@@ -0,0 +1,211 @@
+/*************************************************************************/
+/*  radix_sort.h                                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "core/os/memory.h"
+#include "core/sort_array.h"
+#include "core/typedefs.h"
+
+#include <string.h>
+
+// Sorts by an unsigned 64 bits key, extracted once per element with the
+// KeyOf functor, using an LSD radix sort over a contiguous key/index array.
+// Byte passes where all keys are equal are skipped.
+//
+// The sorter keeps its buffers and the resulting order between calls. When
+// the same number of elements is sorted again, the previous order is tried
+// first and kept if the keys are still sorted under it, which is the common
+// case for lists rebuilt every frame from a mostly static scene.
+template <class T, class KeyOf>
+class RadixSort {
+
+	enum {
+		SMALL_SORT_THRESHOLD = 64
+	};
+
+	struct Item {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	struct ItemCompare {
+		_FORCE_INLINE_ bool operator()(const Item &A, const Item &B) const {
+			return A.key < B.key;
+		}
+	};
+
+	Item *items;
+	Item *temp;
+	T *values;
+	uint32_t *last_order;
+	int capacity;
+	int last_count;
+
+	void _reserve(int p_count) {
+
+		if (p_count <= capacity) {
+			return;
+		}
+
+		capacity = next_power_of_2(p_count);
+		items = (Item *)memrealloc(items, capacity * sizeof(Item));
+		temp = (Item *)memrealloc(temp, capacity * sizeof(Item));
+		values = (T *)memrealloc(values, capacity * sizeof(T));
+		last_order = (uint32_t *)memrealloc(last_order, capacity * sizeof(uint32_t));
+	}
+
+	bool _sort_by_last_order(T *p_array, int p_count) {
+
+		uint64_t prev = 0;
+		for (int i = 0; i < p_count; i++) {
+			uint32_t index = last_order[i];
+			uint64_t k = key_of(p_array[index]);
+			if (k < prev) {
+				return false;
+			}
+			prev = k;
+			items[i].key = k;
+			items[i].index = index;
+		}
+		return true;
+	}
+
+	void _radix_sort(int p_count) {
+
+		uint32_t histogram[8][256];
+		memset(histogram, 0, sizeof(histogram));
+
+		for (int i = 0; i < p_count; i++) {
+			uint64_t k = items[i].key;
+			for (int b = 0; b < 8; b++) {
+				histogram[b][(k >> (b * 8)) & 0xFF]++;
+			}
+		}
+
+		Item *src = items;
+		Item *dst = temp;
+
+		for (int b = 0; b < 8; b++) {
+
+			uint32_t *h = histogram[b];
+			if (h[(src[0].key >> (b * 8)) & 0xFF] == uint32_t(p_count)) {
+				continue; // All keys share this byte.
+			}
+
+			uint32_t offset = 0;
+			for (int i = 0; i < 256; i++) {
+				uint32_t c = h[i];
+				h[i] = offset;
+				offset += c;
+			}
+
+			for (int i = 0; i < p_count; i++) {
+				dst[h[(src[i].key >> (b * 8)) & 0xFF]++] = src[i];
+			}
+
+			SWAP(src, dst);
+		}
+
+		if (src != items) {
+			memcpy(items, src, p_count * sizeof(Item));
+		}
+	}
+
+public:
+	KeyOf key_of;
+
+	// Maps a float to a key that sorts in the same order.
+	static _FORCE_INLINE_ uint32_t float_key(float p_value) {
+
+		union {
+			float f;
+			uint32_t u;
+		} c;
+		c.f = p_value;
+		return (c.u & 0x80000000) ? ~c.u : (c.u | 0x80000000);
+	}
+
+	void sort(T *p_array, int p_count) {
+
+		if (p_count < 2) {
+			return;
+		}
+
+		_reserve(p_count);
+
+		if (p_count != last_count || !_sort_by_last_order(p_array, p_count)) {
+
+			for (int i = 0; i < p_count; i++) {
+				items[i].key = key_of(p_array[i]);
+				items[i].index = i;
+			}
+
+			if (p_count < SMALL_SORT_THRESHOLD) {
+				SortArray<Item, ItemCompare> sorter;
+				sorter.sort(items, p_count);
+			} else {
+				_radix_sort(p_count);
+			}
+		}
+
+		for (int i = 0; i < p_count; i++) {
+			last_order[i] = items[i].index;
+			values[i] = p_array[items[i].index];
+		}
+		for (int i = 0; i < p_count; i++) {
+			p_array[i] = values[i];
+		}
+		last_count = p_count;
+	}
+
+	RadixSort() {
+
+		items = NULL;
+		temp = NULL;
+		values = NULL;
+		last_order = NULL;
+		capacity = 0;
+		last_count = 0;
+	}
+
+	~RadixSort() {
+
+		if (items) {
+			memfree(items);
+			memfree(temp);
+			memfree(values);
+			memfree(last_order);
+		}
+	}
+};
+
+#endif // RADIX_SORT_H
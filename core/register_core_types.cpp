@@ -38,6 +38,8 @@
 #include "core/func_ref.h"
 #include "core/input_map.h"
 #include "core/io/config_file.h"
+#include "core/io/file_access_async.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/marshalls.h"
@@ -81,6 +83,8 @@ static _JSON *_json = NULL;
 
 static IP *ip = NULL;
 
+static FileAccessAsync *file_access_async = NULL;
+
 static _Geometry *_geometry = NULL;
 
 extern Mutex *_global_mutex;
@@ -100,6 +104,7 @@ void register_core_types() {
 
 	StringName::setup();
 	ResourceLoader::initialize();
+	FileAccessCompressed::initialize();
 
 	register_global_constants();
 	register_variant_methods();
@@ -191,6 +196,8 @@ void register_core_types() {
 
 	ip = IP::create();
 
+	file_access_async = memnew(FileAccessAsync);
+
 	_geometry = memnew(_Geometry);
 
 	_resource_loader = memnew(_ResourceLoader);
@@ -212,6 +219,7 @@ void register_core_singletons() {
 
 	ClassDB::register_class<ProjectSettings>();
 	ClassDB::register_virtual_class<IP>();
+	ClassDB::register_virtual_class<FileAccessAsync>();
 	ClassDB::register_class<_Geometry>();
 	ClassDB::register_class<_ResourceLoader>();
 	ClassDB::register_class<_ResourceSaver>();
@@ -227,6 +235,7 @@ void register_core_singletons() {
 
 	Engine::get_singleton()->add_singleton(Engine::Singleton("ProjectSettings", ProjectSettings::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("IP", IP::get_singleton()));
+	Engine::get_singleton()->add_singleton(Engine::Singleton("FileAccessAsync", FileAccessAsync::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("Geometry", _Geometry::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("ResourceLoader", _ResourceLoader::get_singleton()));
 	Engine::get_singleton()->add_singleton(Engine::Singleton("ResourceSaver", _ResourceSaver::get_singleton()));
@@ -270,7 +279,10 @@ void unregister_core_types() {
 	if (ip)
 		memdelete(ip);
 
+	memdelete(file_access_async);
+
 	ResourceLoader::finalize();
+	FileAccessCompressed::finalize();
 
 	ObjectDB::cleanup();
 
@@ -319,6 +319,11 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) = 0;
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) = 0;
 
+	// Sampling profiler, optional. Stacks are collapsed root-first with ';' separators (flamegraph format).
+	virtual void profiling_sampling_start(uint64_t p_interval_usec) {}
+	virtual void profiling_sampling_stop() {}
+	virtual void profiling_get_sampled_stacks(Map<String, uint64_t> *r_stacks) const {}
+
 	virtual void *alloc_instance_binding_data(Object *p_object) { return NULL; } //optional, not used by all languages
 	virtual void free_instance_binding_data(void *p_data) {} //optional, not used by all languages
 	virtual void refcount_incremented_instance_binding(Object *p_object) {} //optional, not used by all languages
@@ -37,7 +37,17 @@
 
 CharType VariantParser::StreamFile::get_char() {
 
-	return f->get_8();
+	if (readahead_pointer == readahead_filled) {
+		int filled = f->get_buffer(readahead_buffer, READAHEAD_SIZE);
+		readahead_pointer = 0;
+		readahead_filled = MAX(filled, 0);
+		if (readahead_filled == 0) {
+			eof = true;
+			return 0;
+		}
+	}
+
+	return readahead_buffer[readahead_pointer++];
 }
 
 bool VariantParser::StreamFile::is_utf8() const {
@@ -46,14 +56,29 @@ bool VariantParser::StreamFile::is_utf8() const {
 }
 bool VariantParser::StreamFile::is_eof() const {
 
-	return f->eof_reached();
+	return eof;
+}
+
+size_t VariantParser::StreamFile::get_position() const {
+
+	return f->get_position() - (readahead_filled - readahead_pointer);
+}
+
+void VariantParser::StreamFile::seek(size_t p_position) {
+
+	f->seek(p_position);
+	readahead_pointer = 0;
+	readahead_filled = 0;
+	eof = false;
+	saved = 0;
 }
 
 CharType VariantParser::StreamString::get_char() {
 
-	if (pos >= s.length())
+	if (pos >= s.length()) {
+		pos = s.length() + 1; //reading past the end is what is_eof() reports, as with files
 		return 0;
-	else
+	} else
 		return s[pos++];
 }
 
@@ -85,6 +110,81 @@ const char *VariantParser::tk_name[TK_MAX] = {
 	"ERROR"
 };
 
+// Reads the rest of a number starting with p_char into r_num, the first character after it is left in p_stream->saved.
+// Returns whether the number is a float.
+static bool _read_number(VariantParser::Stream *p_stream, CharType p_char, StringBuffer<> &r_num) {
+
+#define READING_SIGN 0
+#define READING_INT 1
+#define READING_DEC 2
+#define READING_EXP 3
+#define READING_DONE 4
+	int reading = READING_INT;
+
+	if (p_char == '-') {
+		r_num += '-';
+		p_char = p_stream->get_char();
+	}
+
+	CharType c = p_char;
+	bool exp_sign = false;
+	bool exp_beg = false;
+	bool is_float = false;
+
+	while (true) {
+
+		switch (reading) {
+			case READING_INT: {
+
+				if (c >= '0' && c <= '9') {
+					//pass
+				} else if (c == '.') {
+					reading = READING_DEC;
+					is_float = true;
+				} else if (c == 'e') {
+					reading = READING_EXP;
+					is_float = true;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_DEC: {
+
+				if (c >= '0' && c <= '9') {
+
+				} else if (c == 'e') {
+					reading = READING_EXP;
+				} else {
+					reading = READING_DONE;
+				}
+
+			} break;
+			case READING_EXP: {
+
+				if (c >= '0' && c <= '9') {
+					exp_beg = true;
+
+				} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
+					exp_sign = true;
+
+				} else {
+					reading = READING_DONE;
+				}
+			} break;
+		}
+
+		if (reading == READING_DONE)
+			break;
+		r_num += c;
+		c = p_stream->get_char();
+	}
+
+	p_stream->saved = c;
+
+	return is_float;
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
 
 	while (true) {
@@ -155,8 +255,10 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						r_token.type = TK_EOF;
 						return OK;
 					}
-					if (ch == '\n')
+					if (ch == '\n') {
+						line++;
 						break;
+					}
 				}
 
 				break;
@@ -200,7 +302,8 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 			};
 			case '"': {
 
-				String str;
+				StringBuffer<> str;
+				bool ascii = true;
 				while (true) {
 
 					CharType ch = p_stream->get_char();
@@ -273,20 +376,25 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							} break;
 						}
 
+						ascii = ascii && res < 128;
 						str += res;
 
 					} else {
 						if (ch == '\n')
 							line++;
+						ascii = ascii && ch < 128;
 						str += ch;
 					}
 				}
 
-				if (p_stream->is_utf8()) {
-					str.parse_utf8(str.ascii(true).get_data());
+				if (p_stream->is_utf8() && !ascii) {
+					String utf8;
+					utf8.parse_utf8(str.as_string().ascii(true).get_data());
+					r_token.value = utf8;
+				} else {
+					r_token.value = str.as_string();
 				}
 				r_token.type = TK_STRING;
-				r_token.value = str;
 				return OK;
 
 			} break;
@@ -300,73 +408,7 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					//a number
 
 					StringBuffer<> num;
-#define READING_SIGN 0
-#define READING_INT 1
-#define READING_DEC 2
-#define READING_EXP 3
-#define READING_DONE 4
-					int reading = READING_INT;
-
-					if (cchar == '-') {
-						num += '-';
-						cchar = p_stream->get_char();
-					}
-
-					CharType c = cchar;
-					bool exp_sign = false;
-					bool exp_beg = false;
-					bool is_float = false;
-
-					while (true) {
-
-						switch (reading) {
-							case READING_INT: {
-
-								if (c >= '0' && c <= '9') {
-									//pass
-								} else if (c == '.') {
-									reading = READING_DEC;
-									is_float = true;
-								} else if (c == 'e') {
-									reading = READING_EXP;
-									is_float = true;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_DEC: {
-
-								if (c >= '0' && c <= '9') {
-
-								} else if (c == 'e') {
-									reading = READING_EXP;
-								} else {
-									reading = READING_DONE;
-								}
-
-							} break;
-							case READING_EXP: {
-
-								if (c >= '0' && c <= '9') {
-									exp_beg = true;
-
-								} else if ((c == '-' || c == '+') && !exp_sign && !exp_beg) {
-									exp_sign = true;
-
-								} else {
-									reading = READING_DONE;
-								}
-							} break;
-						}
-
-						if (reading == READING_DONE)
-							break;
-						num += c;
-						c = p_stream->get_char();
-					}
-
-					p_stream->saved = c;
+					bool is_float = _read_number(p_stream, cchar, num);
 
 					r_token.type = TK_NUMBER;
 
@@ -440,6 +482,25 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &strings,
 	return OK;
 }
 
+static CharType _get_nonspace_char(VariantParser::Stream *p_stream, int &line) {
+
+	CharType c;
+	if (p_stream->saved) {
+		c = p_stream->saved;
+		p_stream->saved = 0;
+	} else {
+		c = p_stream->get_char();
+	}
+
+	while (c > 0 && c <= 32) {
+		if (c == '\n')
+			line++;
+		c = p_stream->get_char();
+	}
+
+	return c;
+}
+
 template <class T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str) {
 
@@ -450,30 +511,55 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	// Separators and numbers are read straight from the stream, large pool arrays are mostly made of them.
+	// Anything else goes through get_token().
+
 	bool first = true;
 	while (true) {
 
 		if (!first) {
-			get_token(p_stream, token, line, r_err_str);
-			if (token.type == TK_COMMA) {
+			CharType c = _get_nonspace_char(p_stream, line);
+			if (c == ',') {
 				//do none
-			} else if (token.type == TK_PARENTHESIS_CLOSE) {
+			} else if (c == ')') {
 				break;
 			} else {
-				r_err_str = "Expected ',' or ')' in constructor";
-				return ERR_PARSE_ERROR;
+				p_stream->saved = c;
+				get_token(p_stream, token, line, r_err_str);
+				if (token.type == TK_COMMA) {
+					//do none
+				} else if (token.type == TK_PARENTHESIS_CLOSE) {
+					break;
+				} else {
+					r_err_str = "Expected ',' or ')' in constructor";
+					return ERR_PARSE_ERROR;
+				}
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
 
-		if (first && token.type == TK_PARENTHESIS_CLOSE) {
-			break;
-		} else if (token.type != TK_NUMBER) {
-			r_err_str = "Expected float in constructor";
-			return ERR_PARSE_ERROR;
-		}
+		CharType c = _get_nonspace_char(p_stream, line);
+		if (c == '-' || (c >= '0' && c <= '9')) {
+
+			StringBuffer<> num;
+			if (_read_number(p_stream, c, num)) {
+				r_construct.push_back(num.as_double());
+			} else {
+				r_construct.push_back(num.as_int());
+			}
+		} else {
+
+			p_stream->saved = c;
+			get_token(p_stream, token, line, r_err_str);
 
-		r_construct.push_back(token.value);
+			if (first && token.type == TK_PARENTHESIS_CLOSE) {
+				break;
+			} else if (token.type != TK_NUMBER) {
+				r_err_str = "Expected float in constructor";
+				return ERR_PARSE_ERROR;
+			}
+
+			r_construct.push_back(token.value);
+		}
 		first = false;
 	}
 
@@ -1510,8 +1596,10 @@ Error VariantParser::parse_tag_assign_eof(Stream *p_stream, int &line, String &r
 				if (p_stream->is_eof()) {
 					return ERR_FILE_EOF;
 				}
-				if (ch == '\n')
+				if (ch == '\n') {
+					line++;
 					break;
+				}
 			}
 			continue;
 		}
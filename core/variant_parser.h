@@ -52,13 +52,32 @@ public:
 
 	struct StreamFile : public Stream {
 
+	private:
+		enum {
+			READAHEAD_SIZE = 4096
+		};
+
+		uint8_t readahead_buffer[READAHEAD_SIZE];
+		uint32_t readahead_pointer;
+		uint32_t readahead_filled;
+		bool eof;
+
+	public:
 		FileAccess *f;
 
 		virtual CharType get_char();
 		virtual bool is_utf8() const;
 		virtual bool is_eof() const;
 
-		StreamFile() { f = NULL; }
+		size_t get_position() const; // position of the next character to be read, not of the file cursor
+		void seek(size_t p_position);
+
+		StreamFile() {
+			f = NULL;
+			readahead_pointer = 0;
+			readahead_filled = 0;
+			eof = false;
+		}
 	};
 
 	struct StreamString : public Stream {
@@ -1376,11 +1376,11 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 				}
 			}
 
-			bool clear_skeleton_buffer = !storage->config.float_texture_supported;
+			bool clear_skeleton_buffer = storage->config.use_skeleton_software;
 
 			if (p_skeleton) {
 
-				if (storage->config.float_texture_supported) {
+				if (!storage->config.use_skeleton_software) {
 					//use float texture workflow
 					glActiveTexture(GL_TEXTURE0 + storage->config.max_texture_image_units - 1);
 					glBindTexture(GL_TEXTURE_2D, p_skeleton->tex_id);
@@ -1399,88 +1399,24 @@ void RasterizerSceneGLES2::_setup_geometry(RenderList::Element *p_element, Raste
 						transform_buffer.resize(s->array_len * 12);
 					}
 
-					const size_t bones_offset = s->attribs[VS::ARRAY_BONES].offset;
-					const size_t bones_stride = s->attribs[VS::ARRAY_BONES].stride;
-					const size_t bone_weight_offset = s->attribs[VS::ARRAY_WEIGHTS].offset;
-					const size_t bone_weight_stride = s->attribs[VS::ARRAY_WEIGHTS].stride;
-
 					{
 						PoolVector<float>::Write write = transform_buffer.write();
-						float *buffer = write.ptr();
-
 						PoolVector<uint8_t>::Read vertex_array_read = s->data.read();
-						const uint8_t *vertex_data = vertex_array_read.ptr();
-
-						for (int i = 0; i < s->array_len; i++) {
-
-							// do magic
-
-							size_t bones[4];
-							float bone_weight[4];
-
-							if (s->attribs[VS::ARRAY_BONES].type == GL_UNSIGNED_BYTE) {
-								// read as byte
-								const uint8_t *bones_ptr = vertex_data + bones_offset + (i * bones_stride);
-								bones[0] = bones_ptr[0];
-								bones[1] = bones_ptr[1];
-								bones[2] = bones_ptr[2];
-								bones[3] = bones_ptr[3];
-							} else {
-								// read as short
-								const uint16_t *bones_ptr = (const uint16_t *)(vertex_data + bones_offset + (i * bones_stride));
-								bones[0] = bones_ptr[0];
-								bones[1] = bones_ptr[1];
-								bones[2] = bones_ptr[2];
-								bones[3] = bones_ptr[3];
-							}
-
-							if (s->attribs[VS::ARRAY_WEIGHTS].type == GL_FLOAT) {
-								// read as float
-								const float *weight_ptr = (const float *)(vertex_data + bone_weight_offset + (i * bone_weight_stride));
-								bone_weight[0] = weight_ptr[0];
-								bone_weight[1] = weight_ptr[1];
-								bone_weight[2] = weight_ptr[2];
-								bone_weight[3] = weight_ptr[3];
-							} else {
-								// read as half
-								const uint16_t *weight_ptr = (const uint16_t *)(vertex_data + bone_weight_offset + (i * bone_weight_stride));
-								bone_weight[0] = (weight_ptr[0] / (float)0xFFFF);
-								bone_weight[1] = (weight_ptr[1] / (float)0xFFFF);
-								bone_weight[2] = (weight_ptr[2] / (float)0xFFFF);
-								bone_weight[3] = (weight_ptr[3] / (float)0xFFFF);
-							}
-
-							Transform transform;
-
-							Transform bone_transforms[4] = {
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[0]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[1]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[2]),
-								storage->skeleton_bone_get_transform(p_element->instance->skeleton, bones[3]),
-							};
-
-							transform.origin =
-									bone_weight[0] * bone_transforms[0].origin +
-									bone_weight[1] * bone_transforms[1].origin +
-									bone_weight[2] * bone_transforms[2].origin +
-									bone_weight[3] * bone_transforms[3].origin;
-
-							transform.basis =
-									bone_transforms[0].basis * bone_weight[0] +
-									bone_transforms[1].basis * bone_weight[1] +
-									bone_transforms[2].basis * bone_weight[2] +
-									bone_transforms[3].basis * bone_weight[3];
-
-							float row[3][4] = {
-								{ transform.basis[0][0], transform.basis[0][1], transform.basis[0][2], transform.origin[0] },
-								{ transform.basis[1][0], transform.basis[1][1], transform.basis[1][2], transform.origin[1] },
-								{ transform.basis[2][0], transform.basis[2][1], transform.basis[2][2], transform.origin[2] },
-							};
-
-							size_t transform_buffer_offset = i * 12;
-
-							copymem(&buffer[transform_buffer_offset], row, sizeof(row));
-						}
+
+						SoftwareSkinning::SkinJob job;
+						job.bones = p_skeleton->bone_data.ptr();
+						job.bone_count = p_skeleton->size;
+						job.vertex_data = vertex_array_read.ptr();
+						job.vertex_count = s->array_len;
+						job.bones_offset = s->attribs[VS::ARRAY_BONES].offset;
+						job.bones_stride = s->attribs[VS::ARRAY_BONES].stride;
+						job.bones_16_bits = s->attribs[VS::ARRAY_BONES].type != GL_UNSIGNED_BYTE;
+						job.weights_offset = s->attribs[VS::ARRAY_WEIGHTS].offset;
+						job.weights_stride = s->attribs[VS::ARRAY_WEIGHTS].stride;
+						job.weights_float = s->attribs[VS::ARRAY_WEIGHTS].type == GL_FLOAT;
+						job.result = write.ptr();
+
+						storage->resources.software_skinning->skin(job, storage->config.use_skeleton_dual_quaternion ? SoftwareSkinning::MODE_DUAL_QUATERNION : SoftwareSkinning::MODE_LINEAR);
 					}
 
 					storage->_update_skeleton_transform_buffer(transform_buffer, s->array_len * 12);
@@ -2390,7 +2326,7 @@ void RasterizerSceneGLES2::_render_render_list(RenderList::Element **p_elements,
 
 			if (skeleton) {
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON, true);
-				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, !storage->config.float_texture_supported);
+				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, storage->config.use_skeleton_software);
 			} else {
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON, false);
 				state.scene_shader.set_conditional(SceneShaderGLES2::USE_SKELETON_SOFTWARE, false);
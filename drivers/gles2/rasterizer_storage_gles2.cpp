@@ -31,6 +31,7 @@
 #include "rasterizer_storage_gles2.h"
 
 #include "core/math/transform.h"
+#include "core/os/os.h"
 #include "core/project_settings.h"
 #include "rasterizer_canvas_gles2.h"
 #include "rasterizer_scene_gles2.h"
@@ -5675,9 +5676,26 @@ void RasterizerStorageGLES2::initialize() {
 
 	config.force_vertex_shading = GLOBAL_GET("rendering/quality/shading/force_vertex_shading");
 	config.use_fast_texture_filter = GLOBAL_GET("rendering/quality/filters/use_nearest_mipmap_filter");
+
+	config.use_skeleton_software = !config.float_texture_supported || bool(GLOBAL_GET("rendering/quality/skinning/force_software_skinning"));
+	config.use_skeleton_dual_quaternion = GLOBAL_GET("rendering/quality/skinning/software_skinning_dual_quaternion");
+
+	resources.software_skinning = NULL;
+	if (config.use_skeleton_software) {
+		int threads = 0;
+		if (GLOBAL_GET("rendering/threads/parallel_skinning")) {
+			threads = CLAMP(OS::get_singleton()->get_processor_count() - 1, 0, 7);
+		}
+		resources.software_skinning = memnew(SoftwareSkinning(threads));
+	}
 }
 
 void RasterizerStorageGLES2::finalize() {
+
+	if (resources.software_skinning) {
+		memdelete(resources.software_skinning);
+		resources.software_skinning = NULL;
+	}
 }
 
 void RasterizerStorageGLES2::_copy_screen() {
@@ -35,6 +35,7 @@
 #include "core/self_list.h"
 #include "servers/visual/rasterizer.h"
 #include "servers/visual/shader_language.h"
+#include "servers/visual/software_skinning.h"
 #include "shader_compiler_gles2.h"
 #include "shader_gles2.h"
 
@@ -80,6 +81,9 @@ public:
 
 		bool force_vertex_shading;
 
+		bool use_skeleton_software; // blend bone matrices per vertex on the CPU, when there are no float textures or when forced
+		bool use_skeleton_dual_quaternion;
+
 		bool use_rgba_2d_shadows;
 		bool use_rgba_3d_shadows;
 
@@ -116,6 +120,8 @@ public:
 		GLuint skeleton_transform_buffer;
 		PoolVector<float> skeleton_transform_cpu_buffer;
 
+		SoftwareSkinning *software_skinning;
+
 	} resources;
 
 	mutable struct Shaders {
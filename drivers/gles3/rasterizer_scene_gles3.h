@@ -34,6 +34,7 @@
 /* Must come before shaders or the Windows build fails... */
 #include "rasterizer_storage_gles3.h"
 
+#include "core/radix_sort.h"
 #include "drivers/gles3/shaders/cube_to_dp.glsl.gen.h"
 #include "drivers/gles3/shaders/effect_blur.glsl.gen.h"
 #include "drivers/gles3/shaders/exposure.glsl.gen.h"
@@ -719,62 +720,59 @@ public:
 			alpha_element_count = 0;
 		}
 
-		//should eventually be replaced by radix
+		struct KeyBySortKey {
 
-		struct SortByKey {
-
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->sort_key < B->sort_key;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return A->sort_key;
 			}
 		};
 
+		RadixSort<Element *, KeyBySortKey> key_sorter;
+
 		void sort_by_key(bool p_alpha) {
 
-			SortArray<Element *, SortByKey> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				key_sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
-				sorter.sort(elements, element_count);
+				key_sorter.sort(elements, element_count);
 			}
 		}
 
-		struct SortByDepth {
+		struct KeyByDepth {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				return A->instance->depth < B->instance->depth;
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				return RadixSort<Element *, KeyByDepth>::float_key(A->instance->depth);
 			}
 		};
 
+		RadixSort<Element *, KeyByDepth> depth_sorter;
+
 		void sort_by_depth(bool p_alpha) { //used for shadows
 
-			SortArray<Element *, SortByDepth> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				depth_sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
-				sorter.sort(elements, element_count);
+				depth_sorter.sort(elements, element_count);
 			}
 		}
 
-		struct SortByReverseDepthAndPriority {
+		struct KeyByReverseDepthAndPriority {
 
-			_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
-				uint32_t layer_A = uint32_t(A->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				uint32_t layer_B = uint32_t(B->sort_key >> SORT_KEY_PRIORITY_SHIFT);
-				if (layer_A == layer_B) {
-					return A->instance->depth > B->instance->depth;
-				} else {
-					return layer_A < layer_B;
-				}
+			_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+				uint64_t layer = A->sort_key >> SORT_KEY_PRIORITY_SHIFT;
+				uint32_t depth = RadixSort<Element *, KeyByReverseDepthAndPriority>::float_key(A->instance->depth);
+				return (layer << 32) | uint32_t(~depth);
 			}
 		};
 
+		RadixSort<Element *, KeyByReverseDepthAndPriority> reverse_depth_sorter;
+
 		void sort_by_reverse_depth_and_priority(bool p_alpha) { //used for alpha
 
-			SortArray<Element *, SortByReverseDepthAndPriority> sorter;
 			if (p_alpha) {
-				sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
+				reverse_depth_sorter.sort(&elements[max_elements - alpha_element_count], alpha_element_count);
 			} else {
-				sorter.sort(elements, element_count);
+				reverse_depth_sorter.sort(elements, element_count);
 			}
 		}
 
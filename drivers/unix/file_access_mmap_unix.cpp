@@ -0,0 +1,251 @@
+/*************************************************************************/
+/*  file_access_mmap_unix.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "file_access_mmap_unix.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+Error FileAccessMmapUnix::_open(const String &p_path, int p_mode_flags) {
+
+	close();
+
+	ERR_FAIL_COND_V(p_mode_flags != READ, ERR_UNAVAILABLE);
+
+	path_src = p_path;
+	path = fix_path(p_path);
+
+	int fd = ::open(path.utf8().get_data(), O_RDONLY);
+	if (fd < 0) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	length = st.st_size;
+	if (length > 0) {
+		void *mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (mapped == MAP_FAILED) {
+			::close(fd);
+			length = 0;
+			return ERR_FILE_CANT_OPEN;
+		}
+		data = (uint8_t *)mapped;
+	}
+
+	// The mapping stays valid after the descriptor is closed.
+	::close(fd);
+
+	pos = 0;
+	last_error = OK;
+	opened = true;
+	return OK;
+}
+
+void FileAccessMmapUnix::close() {
+
+	if (data) {
+		munmap(data, length);
+		data = NULL;
+	}
+	length = 0;
+	pos = 0;
+	opened = false;
+}
+
+bool FileAccessMmapUnix::is_open() const {
+
+	return opened;
+}
+
+String FileAccessMmapUnix::get_path() const {
+
+	return path_src;
+}
+
+String FileAccessMmapUnix::get_path_absolute() const {
+
+	return path;
+}
+
+void FileAccessMmapUnix::seek(size_t p_position) {
+
+	ERR_FAIL_COND(!opened);
+
+	last_error = OK;
+	pos = p_position;
+}
+
+void FileAccessMmapUnix::seek_end(int64_t p_position) {
+
+	ERR_FAIL_COND(!opened);
+
+	seek(length + p_position);
+}
+
+size_t FileAccessMmapUnix::get_position() const {
+
+	return pos;
+}
+
+size_t FileAccessMmapUnix::get_len() const {
+
+	return length;
+}
+
+bool FileAccessMmapUnix::eof_reached() const {
+
+	return last_error == ERR_FILE_EOF;
+}
+
+uint8_t FileAccessMmapUnix::get_8() const {
+
+	ERR_FAIL_COND_V(!opened, 0);
+
+	if (pos >= length) {
+		last_error = ERR_FILE_EOF;
+		return 0;
+	}
+	return data[pos++];
+}
+
+int FileAccessMmapUnix::get_buffer(uint8_t *p_dst, int p_length) const {
+
+	ERR_FAIL_COND_V(!opened, -1);
+
+	int to_read = p_length;
+	if (pos >= length) {
+		to_read = 0;
+	} else if (pos + to_read > length) {
+		to_read = length - pos;
+	}
+	if (to_read < p_length) {
+		last_error = ERR_FILE_EOF;
+	}
+
+	if (to_read > 0) {
+		memcpy(p_dst, &data[pos], to_read);
+		pos += to_read;
+	}
+	return to_read;
+}
+
+const uint8_t *FileAccessMmapUnix::get_buffer_ptr(uint64_t p_length) const {
+
+	ERR_FAIL_COND_V(!opened, NULL);
+
+	if (pos > length || p_length > length - pos) {
+		return NULL;
+	}
+
+	const uint8_t *ptr = &data[pos];
+	pos += p_length;
+	return ptr;
+}
+
+void FileAccessMmapUnix::prefetch(size_t p_position, size_t p_length) const {
+
+	if (!data || p_position >= length) {
+		return;
+	}
+
+	p_length = MIN(p_length, length - p_position);
+
+	// The advice must start on a page boundary.
+	size_t page = sysconf(_SC_PAGESIZE);
+	size_t from = p_position & ~(page - 1);
+	posix_madvise(data + from, p_length + (p_position - from), POSIX_MADV_WILLNEED);
+}
+
+Error FileAccessMmapUnix::get_error() const {
+
+	return last_error;
+}
+
+void FileAccessMmapUnix::flush() {
+
+	ERR_FAIL();
+}
+
+void FileAccessMmapUnix::store_8(uint8_t p_dest) {
+
+	ERR_FAIL();
+}
+
+void FileAccessMmapUnix::store_buffer(const uint8_t *p_src, int p_length) {
+
+	ERR_FAIL();
+}
+
+bool FileAccessMmapUnix::file_exists(const String &p_path) {
+
+	struct stat st;
+	String filename = fix_path(p_path);
+	return stat(filename.utf8().get_data(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+uint64_t FileAccessMmapUnix::_get_modified_time(const String &p_file) {
+
+	String file = fix_path(p_file);
+	struct stat st;
+	int err = stat(file.utf8().get_data(), &st);
+
+	if (!err) {
+		return st.st_mtime;
+	} else {
+		ERR_EXPLAIN("Failed to get modified time for: " + p_file);
+		ERR_FAIL_V(0);
+	}
+}
+
+FileAccessMmapUnix::FileAccessMmapUnix() {
+
+	data = NULL;
+	length = 0;
+	pos = 0;
+	last_error = OK;
+	opened = false;
+}
+
+FileAccessMmapUnix::~FileAccessMmapUnix() {
+
+	close();
+}
+
+#endif
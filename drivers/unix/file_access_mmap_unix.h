@@ -0,0 +1,85 @@
+/*************************************************************************/
+/*  file_access_mmap_unix.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef FILE_ACCESS_MMAP_UNIX_H
+#define FILE_ACCESS_MMAP_UNIX_H
+
+#include "core/os/file_access.h"
+
+#if defined(UNIX_ENABLED)
+
+// Read only file access that maps the whole file in memory. Reads are plain
+// copies from the mapping, and get_buffer_ptr() returns pointers into it.
+class FileAccessMmapUnix : public FileAccess {
+
+	uint8_t *data;
+	size_t length;
+	mutable size_t pos;
+	mutable Error last_error;
+	bool opened;
+	String path;
+	String path_src;
+
+public:
+	virtual Error _open(const String &p_path, int p_mode_flags);
+	virtual void close();
+	virtual bool is_open() const;
+
+	virtual String get_path() const;
+	virtual String get_path_absolute() const;
+
+	virtual void seek(size_t p_position);
+	virtual void seek_end(int64_t p_position = 0);
+	virtual size_t get_position() const;
+	virtual size_t get_len() const;
+
+	virtual bool eof_reached() const;
+
+	virtual uint8_t get_8() const;
+	virtual int get_buffer(uint8_t *p_dst, int p_length) const;
+	virtual const uint8_t *get_buffer_ptr(uint64_t p_length) const;
+	virtual void prefetch(size_t p_position, size_t p_length) const;
+
+	virtual Error get_error() const;
+
+	virtual void flush();
+	virtual void store_8(uint8_t p_dest);
+	virtual void store_buffer(const uint8_t *p_src, int p_length);
+
+	virtual bool file_exists(const String &p_path);
+
+	virtual uint64_t _get_modified_time(const String &p_file);
+
+	FileAccessMmapUnix();
+	virtual ~FileAccessMmapUnix();
+};
+
+#endif
+#endif // FILE_ACCESS_MMAP_UNIX_H
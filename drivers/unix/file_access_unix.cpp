@@ -173,6 +173,7 @@ void FileAccessUnix::seek_end(int64_t p_position) {
 
 	ERR_FAIL_COND(!f);
 
+	last_error = OK;
 	if (fseek(f, p_position, SEEK_END))
 		check_errors();
 }
@@ -235,7 +236,9 @@ Error FileAccessUnix::get_error() const {
 void FileAccessUnix::flush() {
 
 	ERR_FAIL_COND(!f);
-	fflush(f);
+	if (fflush(f) != 0) {
+		last_error = ERR_FILE_CANT_WRITE;
+	}
 }
 
 void FileAccessUnix::store_8(uint8_t p_dest) {
@@ -246,7 +249,10 @@ void FileAccessUnix::store_8(uint8_t p_dest) {
 
 void FileAccessUnix::store_buffer(const uint8_t *p_src, int p_length) {
 	ERR_FAIL_COND(!f);
-	ERR_FAIL_COND((int)fwrite(p_src, 1, p_length, f) != p_length);
+	if ((int)fwrite(p_src, 1, p_length, f) != p_length) {
+		last_error = ERR_FILE_CANT_WRITE; //eg. the disk is full
+		ERR_FAIL();
+	}
 }
 
 bool FileAccessUnix::file_exists(const String &p_path) {
@@ -35,6 +35,7 @@
 #include "core/os/thread_dummy.h"
 #include "core/project_settings.h"
 #include "drivers/unix/dir_access_unix.h"
+#include "drivers/unix/file_access_mmap_unix.h"
 #include "drivers/unix/file_access_unix.h"
 #include "drivers/unix/mutex_posix.h"
 #include "drivers/unix/net_socket_posix.h"
@@ -53,6 +54,13 @@
 #include <sys/sysctl.h>
 #endif
 
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/inotify.h>
+
+//anything that can change the files listed in a directory, or their modification times
+#define DIR_WATCH_MASK (IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR)
+#endif
+
 #include <assert.h>
 #include <dlfcn.h>
 #include <errno.h>
@@ -144,6 +152,7 @@ void OS_Unix::initialize_core() {
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_RESOURCES);
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_USERDATA);
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
+	FileAccess::make_mapped_default<FileAccessMmapUnix>();
 	//FileAccessBufferedFA<FileAccessUnix>::make_default();
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_RESOURCES);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_USERDATA);
@@ -480,6 +489,66 @@ int OS_Unix::get_processor_count() const {
 	return sysconf(_SC_NPROCESSORS_CONF);
 }
 
+int OS_Unix::dir_watch_create() {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+	return inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+	return -1;
+#endif
+}
+
+int OS_Unix::dir_watch_add(int p_watcher, const String &p_path, bool p_removals_only) {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+	ERR_FAIL_COND_V(p_watcher == -1, -1);
+
+	uint32_t mask = p_removals_only ? (IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR) : DIR_WATCH_MASK;
+	//watching the same directory again gives the same watch, this also updates renamed directories
+	return inotify_add_watch(p_watcher, p_path.utf8().get_data(), mask);
+#else
+	return -1;
+#endif
+}
+
+void OS_Unix::dir_watch_poll(int p_watcher, List<DirWatchEvent> *r_events) {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+	ERR_FAIL_COND(p_watcher == -1);
+
+	char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+	while (true) {
+
+		ssize_t len = read(p_watcher, buffer, sizeof(buffer));
+		if (len <= 0) {
+			break; //nothing left to read
+		}
+
+		for (char *ptr = buffer; ptr < buffer + len;) {
+
+			const struct inotify_event *event = (const struct inotify_event *)ptr;
+			ptr += sizeof(struct inotify_event) + event->len;
+
+			DirWatchEvent ev;
+			ev.watch = event->wd;
+			ev.watch_removed = event->mask & IN_IGNORED;
+			ev.overflow = event->mask & IN_Q_OVERFLOW;
+			r_events->push_back(ev);
+		}
+	}
+#endif
+}
+
+void OS_Unix::dir_watch_free(int p_watcher) {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+	if (p_watcher != -1) {
+		close(p_watcher);
+	}
+#endif
+}
+
 String OS_Unix::get_user_data_dir() const {
 
 	String appname = get_safe_dir_name(ProjectSettings::get_singleton()->get("application/config/name"));
@@ -100,6 +100,11 @@ public:
 
 	virtual int get_processor_count() const;
 
+	virtual int dir_watch_create();
+	virtual int dir_watch_add(int p_watcher, const String &p_path, bool p_removals_only = false);
+	virtual void dir_watch_poll(int p_watcher, List<DirWatchEvent> *r_events);
+	virtual void dir_watch_free(int p_watcher);
+
 	virtual void debug_break();
 	virtual void initialize_debugging();
 
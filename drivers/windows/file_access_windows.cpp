@@ -202,6 +202,7 @@ void FileAccessWindows::seek(size_t p_position) {
 void FileAccessWindows::seek_end(int64_t p_position) {
 
 	ERR_FAIL_COND(!f);
+	last_error = OK;
 	if (fseek(f, p_position, SEEK_END))
 		check_errors();
 	prev_op = 0;
@@ -273,7 +274,9 @@ Error FileAccessWindows::get_error() const {
 void FileAccessWindows::flush() {
 
 	ERR_FAIL_COND(!f);
-	fflush(f);
+	if (fflush(f) != 0) {
+		last_error = ERR_FILE_CANT_WRITE;
+	}
 	if (prev_op == WRITE)
 		prev_op = 0;
 }
@@ -302,7 +305,10 @@ void FileAccessWindows::store_buffer(const uint8_t *p_src, int p_length) {
 		}
 		prev_op = WRITE;
 	}
-	ERR_FAIL_COND(fwrite(p_src, 1, p_length, f) != p_length);
+	if (fwrite(p_src, 1, p_length, f) != p_length) {
+		last_error = ERR_FILE_CANT_WRITE; //eg. the disk is full
+		ERR_FAIL();
+	}
 }
 
 bool FileAccessWindows::file_exists(const String &p_name) {
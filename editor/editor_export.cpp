@@ -31,10 +31,13 @@
 #include "editor_export.h"
 
 #include "core/io/config_file.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/io/zip_io.h"
 #include "core/os/file_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/project_settings.h"
 #include "core/script_language.h"
 #include "core/version.h"
@@ -57,6 +60,7 @@ static int _get_pad(int p_alignment, int p_n) {
 }
 
 #define PCK_PADDING 16
+#define PCK_BATCH_SIZE (32 * 1024 * 1024)
 
 bool EditorExportPreset::_set(const StringName &p_name, const Variant &p_value) {
 
@@ -311,35 +315,91 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 
 	PackData *pd = (PackData *)p_userdata;
 
-	SavedData sd;
-	sd.path_utf8 = p_path.utf8();
-	sd.ofs = pd->f->get_position();
-	sd.size = p_data.size();
-
-	pd->f->store_buffer(p_data.ptr(), p_data.size());
-	int pad = _get_pad(PCK_PADDING, sd.size);
-	for (int i = 0; i < pad; i++) {
-		pd->f->store_8(0);
-	}
-
-	{
-		MD5_CTX ctx;
-		MD5Init(&ctx);
-		MD5Update(&ctx, (unsigned char *)p_data.ptr(), p_data.size());
-		MD5Final(&ctx);
-		sd.md5.resize(16);
-		for (int i = 0; i < 16; i++) {
-			sd.md5.write[i] = ctx.digest[i];
-		}
-	}
+	PendingPackFile pf;
+	pf.path = p_path;
+	pf.data = p_data;
+	pf.compressed = false;
+	pd->pending.push_back(pf);
+	pd->pending_size += p_data.size();
 
-	pd->file_ofs.push_back(sd);
+	if (pd->pending_size >= PCK_BATCH_SIZE) {
+		_flush_pack_files(pd);
+	}
 
 	pd->ep->step(TTR("Storing File:") + " " + p_path, 2 + p_file * 100 / p_total, false);
 
 	return OK;
 }
 
+void EditorExportPlatform::PackData::process_pending_file(uint32_t p_index, void *p_userdata) {
+
+	PendingPackFile &pf = pending.write[p_index];
+
+	MD5_CTX ctx;
+	MD5Init(&ctx);
+	MD5Update(&ctx, (unsigned char *)pf.data.ptr(), pf.data.size());
+	MD5Final(&ctx);
+	pf.md5.resize(16);
+	for (int i = 0; i < 16; i++) {
+		pf.md5.write[i] = ctx.digest[i];
+	}
+
+	if (compress && pf.data.size() > 0) {
+		Vector<uint8_t> cdata = FileAccessCompressed::compress_buffer(PACK_COMPRESSED_MAGIC, pf.data.ptr(), pf.data.size());
+		//keep it raw unless it shrinks noticeably, decompressing is not free
+		if (cdata.size() + pf.data.size() / 16 < pf.data.size()) {
+			pf.data = cdata;
+			pf.compressed = true;
+		}
+	}
+}
+
+void EditorExportPlatform::_flush_pack_files(PackData *p_pack_data) {
+
+	PackData *pd = p_pack_data;
+	if (pd->pending.empty()) {
+		return;
+	}
+
+	thread_process_array(pd->pending.size(), pd, &PackData::process_pending_file, (void *)NULL);
+
+	for (int i = 0; i < pd->pending.size(); i++) {
+
+		const PendingPackFile &pf = pd->pending[i];
+
+		SavedData sd;
+		sd.path_utf8 = pf.path.utf8();
+		sd.md5 = pf.md5;
+
+		String content_key = String::md5(pf.md5.ptr()) + ":" + itos(pf.data.size()) + (pf.compressed ? "c" : "");
+		Map<String, int>::Element *E = pd->saved_by_content.find(content_key);
+		if (E) {
+			//same contents already stored under another path, point to them
+			const SavedData &existing = pd->file_ofs[E->get()];
+			sd.ofs = existing.ofs;
+			sd.size = existing.size;
+			sd.compressed = existing.compressed;
+		} else {
+			sd.ofs = pd->f->get_position();
+			sd.size = pf.data.size();
+			sd.compressed = pf.compressed;
+
+			pd->f->store_buffer(pf.data.ptr(), pf.data.size());
+			int pad = _get_pad(PCK_PADDING, sd.size);
+			for (int j = 0; j < pad; j++) {
+				pd->f->store_8(0);
+			}
+
+			pd->saved_by_content[content_key] = pd->file_ofs.size();
+		}
+
+		pd->file_ofs.push_back(sd);
+	}
+
+	pd->pending.clear();
+	pd->pending_size = 0;
+}
+
 Error EditorExportPlatform::_save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total) {
 
 	String path = p_path.replace_first("res://", "");
@@ -894,8 +954,13 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	pd.ep = &ep;
 	pd.f = ftmp;
 	pd.so_files = p_so_files;
+	pd.compress = GLOBAL_GET("editor/compress_pck_on_export");
+	pd.pending_size = 0;
 
 	Error err = export_project_files(p_preset, _save_pack_file, &pd, _add_shared_object);
+	if (err == OK) {
+		_flush_pack_files(&pd);
+	}
 
 	memdelete(ftmp); //close tmp file
 
@@ -907,7 +972,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 	FileAccess *f = FileAccess::open(p_path, FileAccess::WRITE);
 	ERR_FAIL_COND_V(!f, ERR_CANT_CREATE)
 	f->store_32(0x43504447); //GDPK
-	f->store_32(1); //pack version
+	f->store_32(PACK_FORMAT_VERSION); //pack version
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(0); //hmph
@@ -929,6 +994,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		header_size += 8; // offset to file _with_ header size included
 		header_size += 8; // size of file
 		header_size += 16; // md5
+		header_size += 4; // flags
 	}
 
 	size_t header_padding = _get_pad(PCK_PADDING, header_size);
@@ -947,6 +1013,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, c
 		f->store_64(pd.file_ofs[i].ofs + header_padding + header_size);
 		f->store_64(pd.file_ofs[i].size); // pay attention here, this is where file is
 		f->store_buffer(pd.file_ofs[i].md5.ptr(), 16); //also save md5 for file
+		f->store_32(pd.file_ofs[i].compressed ? PACK_FILE_COMPRESSED : 0);
 	}
 
 	for (uint32_t j = 0; j < header_padding; j++) {
@@ -1346,6 +1413,8 @@ EditorExport::EditorExport() {
 	save_timer->connect("timeout", this, "_save");
 	block_save = false;
 
+	GLOBAL_DEF("editor/compress_pck_on_export", false);
+
 	singleton = this;
 }
 
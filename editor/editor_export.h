@@ -163,6 +163,7 @@ private:
 
 		uint64_t ofs;
 		uint64_t size;
+		bool compressed;
 		Vector<uint8_t> md5;
 		CharString path_utf8;
 
@@ -171,12 +172,28 @@ private:
 		}
 	};
 
+	struct PendingPackFile {
+
+		String path;
+		Vector<uint8_t> data; //replaced by the compressed data when it is worth it
+		Vector<uint8_t> md5; //of the uncompressed data
+		bool compressed;
+	};
+
 	struct PackData {
 
 		FileAccess *f;
 		Vector<SavedData> file_ofs;
 		EditorProgress *ep;
 		Vector<SharedObject> *so_files;
+
+		//files are hashed and compressed in parallel batches before being written
+		bool compress;
+		Vector<PendingPackFile> pending;
+		uint64_t pending_size;
+		Map<String, int> saved_by_content; //md5 and size -> index in file_ofs, to store identical files once
+
+		void process_pending_file(uint32_t p_index, void *p_userdata);
 	};
 
 	struct ZipData {
@@ -195,6 +212,7 @@ private:
 
 	void gen_debug_flags(Vector<String> &r_flags, int p_flags);
 	static Error _save_pack_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
+	static void _flush_pack_files(PackData *p_pack_data);
 	static Error _save_zip_file(void *p_userdata, const String &p_path, const Vector<uint8_t> &p_data, int p_file, int p_total);
 
 	void _edit_files_with_filter(DirAccess *da, const Vector<String> &p_filters, Set<String> &r_list, bool exclude);
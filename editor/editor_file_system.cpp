@@ -492,6 +492,24 @@ bool EditorFileSystem::_update_scan_actions() {
 	Vector<String> reimports;
 	Vector<String> reloads;
 
+	//testing for reimport hashes the sources and imported files, do all of them in parallel first
+	Vector<ReimportTest> reimport_tests;
+	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
+
+		if (E->get().action == ItemAction::ACTION_FILE_TEST_REIMPORT) {
+			ReimportTest test;
+			test.path = E->get().dir->get_path().plus_file(E->get().file);
+			test.reimport = false;
+			reimport_tests.push_back(test);
+		}
+	}
+
+	if (reimport_tests.size()) {
+		scan_pool.do_work(reimport_tests.size(), this, &EditorFileSystem::_test_for_reimport_threaded, reimport_tests.ptrw());
+	}
+
+	int reimport_test_idx = 0;
+
 	for (List<ItemAction>::Element *E = scan_actions.front(); E; E = E->next()) {
 
 		ItemAction &ia = E->get();
@@ -555,10 +573,11 @@ bool EditorFileSystem::_update_scan_actions() {
 			} break;
 			case ItemAction::ACTION_FILE_TEST_REIMPORT: {
 
+				bool reimport = reimport_tests[reimport_test_idx++].reimport;
 				int idx = ia.dir->find_file_index(ia.file);
 				ERR_CONTINUE(idx == -1);
 				String full_path = ia.dir->get_file_path(idx);
-				if (_test_for_reimport(full_path, false)) {
+				if (reimport) {
 					//must reimport
 					reimports.push_back(full_path);
 				} else {
@@ -601,6 +620,11 @@ bool EditorFileSystem::_update_scan_actions() {
 	return fs_changed;
 }
 
+void EditorFileSystem::_test_for_reimport_threaded(uint32_t p_index, ReimportTest *p_tests) {
+
+	p_tests[p_index].reimport = _test_for_reimport(p_tests[p_index].path, false);
+}
+
 void EditorFileSystem::scan() {
 
 	if (false /*&& bool(Globals::get_singleton()->get("debug/disable_scan"))*/)
@@ -611,6 +635,14 @@ void EditorFileSystem::scan() {
 
 	_update_extensions();
 
+	//everything is scanned and watched again, older notifications don't matter
+	_read_dir_changes();
+	changed_dirs.clear();
+	watch_incomplete = false;
+	watch_lost_events = false;
+	watch_enabled = watcher != -1 && EditorSettings::get_singleton()->get("filesystem/directories/use_change_notifications");
+	watch_import_settings_hash = ResourceFormatImporter::get_singleton()->get_import_settings_hash();
+
 	abort_scan = false;
 	if (!use_threads) {
 		scanning = true;
@@ -659,6 +691,116 @@ EditorFileSystem::ScanProgress EditorFileSystem::ScanProgress::get_sub(int p_cur
 
 void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress) {
 
+	//walk the directories first, then check the files found there in parallel
+	Vector<ScanFile> files;
+	_scan_new_dir_files(p_dir, da, p_progress, files);
+
+	if (files.size()) {
+		scan_pool.do_work(files.size(), this, &EditorFileSystem::_check_new_file, files.ptrw());
+	}
+
+	for (int i = 0; i < files.size(); i++) {
+
+		const ScanFile &sf = files[i];
+		EditorFileSystemDirectory::FileInfo *fi = sf.file;
+		const FileCache *fc = sf.cache;
+
+		if (sf.imported) {
+
+			//is imported
+			if (!sf.changed) {
+
+				fi->type = fc->type;
+				fi->deps = fc->deps;
+				fi->modified_time = fc->modification_time;
+				fi->import_modified_time = fc->import_modification_time;
+
+				fi->import_valid = fc->import_valid;
+				fi->script_class_name = fc->script_class_name;
+				fi->script_class_extends = fc->script_class_extends;
+				fi->script_class_icon_path = fc->script_class_icon_path;
+
+				if (sf.test_reimport) {
+					ItemAction ia;
+					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
+					ia.dir = sf.dir;
+					ia.file = fi->file;
+					scan_actions.push_back(ia);
+				}
+
+				if (fc->type == String()) {
+					fi->type = ResourceLoader::get_resource_type(sf.path);
+					//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
+					//note: I think this should not happen any longer..
+				}
+
+			} else {
+
+				fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(sf.path);
+				fi->script_class_name = _get_global_script_class(fi->type, sf.path, &fi->script_class_extends, &fi->script_class_icon_path);
+				fi->modified_time = 0;
+				fi->import_modified_time = 0;
+				fi->import_valid = ResourceLoader::is_import_valid(sf.path);
+
+				ItemAction ia;
+				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
+				ia.dir = sf.dir;
+				ia.file = fi->file;
+				scan_actions.push_back(ia);
+			}
+		} else {
+
+			if (!sf.changed) {
+				//not imported, so just update type if changed
+				fi->type = fc->type;
+				fi->modified_time = fc->modification_time;
+				fi->deps = fc->deps;
+				fi->import_modified_time = 0;
+				fi->import_valid = true;
+				fi->script_class_name = fc->script_class_name;
+				fi->script_class_extends = fc->script_class_extends;
+				fi->script_class_icon_path = fc->script_class_icon_path;
+			} else {
+				//new or modified time
+				fi->type = ResourceLoader::get_resource_type(sf.path);
+				fi->script_class_name = _get_global_script_class(fi->type, sf.path, &fi->script_class_extends, &fi->script_class_icon_path);
+				fi->deps = _get_dependencies(sf.path);
+				fi->modified_time = sf.modified_time;
+				fi->import_modified_time = 0;
+				fi->import_valid = true;
+			}
+		}
+	}
+}
+
+void EditorFileSystem::_check_new_file(uint32_t p_index, ScanFile *p_files) {
+
+	ScanFile &sf = p_files[p_index];
+	const FileCache *fc = sf.cache;
+
+	sf.modified_time = FileAccess::get_modified_time(sf.path);
+	sf.test_reimport = false;
+
+	if (sf.imported) {
+
+		sf.import_modified_time = 0;
+		if (FileAccess::exists(sf.path + ".import")) {
+			sf.import_modified_time = FileAccess::get_modified_time(sf.path + ".import");
+		}
+
+		sf.changed = !fc || fc->modification_time != sf.modified_time || fc->import_modification_time != sf.import_modified_time || _test_for_reimport(sf.path, true);
+
+		if (!sf.changed && revalidate_import_files) {
+			sf.test_reimport = !ResourceFormatImporter::get_singleton()->are_import_settings_valid(sf.path);
+		}
+	} else {
+
+		sf.changed = !fc || fc->modification_time != sf.modified_time;
+	}
+}
+
+void EditorFileSystem::_scan_new_dir_files(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress, Vector<ScanFile> &r_files) {
+
 	List<String> dirs;
 	List<String> files;
 
@@ -666,6 +808,9 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 
 	p_dir->modified_time = FileAccess::get_modified_time(cd);
 
+	//watch before listing, so nothing added from now on is missed
+	_watch_dir(p_dir);
+
 	da->list_dir_begin();
 	while (true) {
 
@@ -715,7 +860,7 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 				efd->parent = p_dir;
 				efd->name = E->get();
 
-				_scan_new_dir(efd, da, p_progress.get_sub(idx, total));
+				_scan_new_dir_files(efd, da, p_progress.get_sub(idx, total), r_files);
 
 				int idx2 = 0;
 				for (int i = 0; i < p_dir->subdirs.size(); i++) {
@@ -749,93 +894,108 @@ void EditorFileSystem::_scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess
 		EditorFileSystemDirectory::FileInfo *fi = memnew(EditorFileSystemDirectory::FileInfo);
 		fi->file = E->get();
 
-		String path = cd.plus_file(fi->file);
+		ScanFile sf;
+		sf.dir = p_dir;
+		sf.file = fi;
+		sf.path = cd.plus_file(fi->file);
+		sf.imported = import_extensions.has(ext);
+		sf.cache = file_cache.getptr(sf.path);
+		r_files.push_back(sf);
 
-		FileCache *fc = file_cache.getptr(path);
-		uint64_t mt = FileAccess::get_modified_time(path);
+		p_dir->files.push_back(fi);
+		p_progress.update(idx, total);
+	}
+}
 
-		if (import_extensions.has(ext)) {
+void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress) {
 
-			//is imported
-			uint64_t import_mt = 0;
-			if (FileAccess::exists(path + ".import")) {
-				import_mt = FileAccess::get_modified_time(path + ".import");
-			}
+	_read_dir_changes();
+	_watch_import_dir();
 
-			if (fc && fc->modification_time == mt && fc->import_modification_time == import_mt && !_test_for_reimport(path, true)) {
+	bool check_all = !watch_enabled || watch_incomplete || watch_lost_events;
 
-				fi->type = fc->type;
-				fi->deps = fc->deps;
-				fi->modified_time = fc->modification_time;
-				fi->import_modified_time = fc->import_modification_time;
+	//walk the directories first, then check the files found there in parallel
+	Vector<ScanFile> files;
+	_scan_fs_dir_changes(p_dir, p_progress, check_all ? NULL : &changed_dirs, files);
 
-				fi->import_valid = fc->import_valid;
-				fi->script_class_name = fc->script_class_name;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
+	changed_dirs.clear();
+	watch_lost_events = false;
 
-				if (revalidate_import_files && !ResourceFormatImporter::get_singleton()->are_import_settings_valid(path)) {
-					ItemAction ia;
-					ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-					ia.dir = p_dir;
-					ia.file = E->get();
-					scan_actions.push_back(ia);
-				}
+	if (files.size()) {
+		scan_pool.do_work(files.size(), this, &EditorFileSystem::_check_file_changes, files.ptrw());
+	}
 
-				if (fc->type == String()) {
-					fi->type = ResourceLoader::get_resource_type(path);
-					//there is also the chance that file type changed due to reimport, must probably check this somehow here (or kind of note it for next time in another file?)
-					//note: I think this should not happen any longer..
-				}
+	for (int i = 0; i < files.size(); i++) {
 
-			} else {
+		const ScanFile &sf = files[i];
 
-				fi->type = ResourceFormatImporter::get_singleton()->get_resource_type(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->modified_time = 0;
-				fi->import_modified_time = 0;
-				fi->import_valid = ResourceLoader::is_import_valid(path);
+		if (!sf.changed) {
+			continue;
+		}
 
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = E->get();
-				scan_actions.push_back(ia);
-			}
+		ItemAction ia;
+		ia.dir = sf.dir;
+		ia.file = sf.file->file;
+
+		if (sf.imported) {
+			ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
 		} else {
+			sf.file->modified_time = sf.modified_time; //save new time, but test for reload
+			ia.action = ItemAction::ACTION_FILE_RELOAD;
+		}
 
-			if (fc && fc->modification_time == mt) {
-				//not imported, so just update type if changed
-				fi->type = fc->type;
-				fi->modified_time = fc->modification_time;
-				fi->deps = fc->deps;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
-				fi->script_class_name = fc->script_class_name;
-				fi->script_class_extends = fc->script_class_extends;
-				fi->script_class_icon_path = fc->script_class_icon_path;
-			} else {
-				//new or modified time
-				fi->type = ResourceLoader::get_resource_type(path);
-				fi->script_class_name = _get_global_script_class(fi->type, path, &fi->script_class_extends, &fi->script_class_icon_path);
-				fi->deps = _get_dependencies(path);
-				fi->modified_time = mt;
-				fi->import_modified_time = 0;
-				fi->import_valid = true;
+		scan_actions.push_back(ia);
+	}
+}
+
+void EditorFileSystem::_check_file_changes(uint32_t p_index, ScanFile *p_files) {
+
+	ScanFile &sf = p_files[p_index];
+	const EditorFileSystemDirectory::FileInfo *fi = sf.file;
+
+	sf.changed = false;
+
+	if (sf.imported) {
+		//check here if file must be imported or not
+
+		uint64_t mt = FileAccess::get_modified_time(sf.path);
+
+		if (mt != fi->modified_time) {
+			sf.changed = true; //it was modified, must be reimported.
+		} else if (!FileAccess::exists(sf.path + ".import")) {
+			sf.changed = true; //no .import file, obviously reimport
+		} else {
+
+			uint64_t import_mt = FileAccess::get_modified_time(sf.path + ".import");
+			if (import_mt != fi->import_modified_time) {
+				sf.changed = true;
+			} else if (_test_for_reimport(sf.path, true)) {
+				sf.changed = true;
 			}
 		}
 
-		p_dir->files.push_back(fi);
-		p_progress.update(idx, total);
+	} else if (ResourceCache::has(sf.path)) { //test for potential reload
+
+		sf.modified_time = FileAccess::get_modified_time(sf.path);
+		sf.changed = sf.modified_time != fi->modified_time;
 	}
 }
 
-void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress) {
+void EditorFileSystem::_scan_fs_dir_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, const Set<String> *p_changed_dirs, Vector<ScanFile> &r_files) {
+
+	String cd = p_dir->get_path();
+
+	if (p_changed_dirs && !p_changed_dirs->has(cd)) {
+		//nothing happened in here since the last scan, only look further down
+		for (int i = 0; i < p_dir->subdirs.size(); i++) {
+			_scan_fs_dir_changes(p_dir->subdirs[i], p_progress, p_changed_dirs, r_files);
+		}
+		return;
+	}
 
-	uint64_t current_mtime = FileAccess::get_modified_time(p_dir->get_path());
+	uint64_t current_mtime = FileAccess::get_modified_time(cd);
 
 	bool updated_dir = false;
-	String cd = p_dir->get_path();
 
 	if (current_mtime != p_dir->modified_time || using_fat_32) {
 
@@ -898,6 +1058,8 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 					scan_actions.push_back(ia);
 				} else {
 					p_dir->subdirs[idx]->verified = true;
+					//may have been created by update_file() instead of a scan
+					_watch_dir(p_dir->subdirs[idx]);
 				}
 
 			} else {
@@ -959,65 +1121,97 @@ void EditorFileSystem::_scan_fs_changes(EditorFileSystemDirectory *p_dir, const
 			continue;
 		}
 
-		String path = cd.plus_file(p_dir->files[i]->file);
+		ScanFile sf;
+		sf.dir = p_dir;
+		sf.file = p_dir->files[i];
+		sf.path = cd.plus_file(p_dir->files[i]->file);
+		sf.imported = import_extensions.has(p_dir->files[i]->file.get_extension().to_lower());
+		sf.cache = NULL;
+		r_files.push_back(sf);
+	}
 
-		if (import_extensions.has(p_dir->files[i]->file.get_extension().to_lower())) {
-			//check here if file must be imported or not
+	for (int i = 0; i < p_dir->subdirs.size(); i++) {
 
-			uint64_t mt = FileAccess::get_modified_time(path);
+		if (updated_dir && !p_dir->subdirs[i]->verified) {
+			//this directory was removed, add action to remove it
+			ItemAction ia;
+			ia.action = ItemAction::ACTION_DIR_REMOVE;
+			ia.dir = p_dir->subdirs[i];
+			scan_actions.push_back(ia);
+			continue;
+		}
+		_scan_fs_dir_changes(p_dir->get_subdir(i), p_progress, p_changed_dirs, r_files);
+	}
+}
 
-			bool reimport = false;
+void EditorFileSystem::_watch_dir(EditorFileSystemDirectory *p_dir) {
 
-			if (mt != p_dir->files[i]->modified_time) {
-				reimport = true; //it was modified, must be reimported.
-			} else if (!FileAccess::exists(path + ".import")) {
-				reimport = true; //no .import file, obviously reimport
-			} else {
+	if (watcher == -1 || !watch_enabled) {
+		return;
+	}
 
-				uint64_t import_mt = FileAccess::get_modified_time(path + ".import");
-				if (import_mt != p_dir->files[i]->import_modified_time) {
-					reimport = true;
-				} else if (_test_for_reimport(path, true)) {
-					reimport = true;
-				}
-			}
+	String path = p_dir->get_path();
+	int watch = OS::get_singleton()->dir_watch_add(watcher, ProjectSettings::get_singleton()->globalize_path(path));
+	if (watch == -1) {
+		if (!watch_incomplete) {
+			WARN_PRINTS("Can't watch directory for changes, checking all of them instead (the watch limit may be too low): " + path);
+		}
+		watch_incomplete = true;
+		return;
+	}
 
-			if (reimport) {
+	watched_dirs[watch] = path;
+}
 
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_TEST_REIMPORT;
-				ia.dir = p_dir;
-				ia.file = p_dir->files[i]->file;
-				scan_actions.push_back(ia);
-			}
-		} else if (ResourceCache::has(path)) { //test for potential reload
+void EditorFileSystem::_watch_import_dir() {
 
-			uint64_t mt = FileAccess::get_modified_time(path);
+	if (watcher == -1 || !watch_enabled || watch_import_dir != -1) {
+		return;
+	}
 
-			if (mt != p_dir->files[i]->modified_time) {
+	watch_import_dir = OS::get_singleton()->dir_watch_add(watcher, ProjectSettings::get_singleton()->globalize_path("res://.import"), true);
+	if (watch_import_dir == -1) {
+		watch_lost_events = true;
+	}
+}
 
-				p_dir->files[i]->modified_time = mt; //save new time, but test for reload
+void EditorFileSystem::_read_dir_changes() {
 
-				ItemAction ia;
-				ia.action = ItemAction::ACTION_FILE_RELOAD;
-				ia.dir = p_dir;
-				ia.file = p_dir->files[i]->file;
-				scan_actions.push_back(ia);
-			}
-		}
+	if (watcher == -1) {
+		return;
 	}
 
-	for (int i = 0; i < p_dir->subdirs.size(); i++) {
+	List<OS::DirWatchEvent> events;
+	OS::get_singleton()->dir_watch_poll(watcher, &events);
 
-		if (updated_dir && !p_dir->subdirs[i]->verified) {
-			//this directory was removed, add action to remove it
-			ItemAction ia;
-			ia.action = ItemAction::ACTION_DIR_REMOVE;
-			ia.dir = p_dir->subdirs[i];
-			scan_actions.push_back(ia);
+	for (List<OS::DirWatchEvent>::Element *E = events.front(); E; E = E->next()) {
+
+		const OS::DirWatchEvent &event = E->get();
+
+		if (event.overflow) {
+			watch_lost_events = true;
 			continue;
 		}
-		_scan_fs_changes(p_dir->get_subdir(i), p_progress);
+
+		if (event.watch == watch_import_dir) {
+			//imported files were removed behind the editor's back
+			watch_lost_events = true;
+			if (event.watch_removed) {
+				watch_import_dir = -1;
+			}
+			continue;
+		}
+
+		String *dir = watched_dirs.getptr(event.watch);
+		if (!dir) {
+			continue;
+		}
+
+		changed_dirs.insert(*dir);
+
+		if (event.watch_removed) {
+			watched_dirs.erase(event.watch);
+		}
 	}
 }
 
@@ -1063,6 +1257,15 @@ void EditorFileSystem::scan_changes() {
 	scanning_changes = true;
 	scanning_changes_done = false;
 
+	watch_enabled = watcher != -1 && EditorSettings::get_singleton()->get("filesystem/directories/use_change_notifications");
+
+	String import_settings_hash = ResourceFormatImporter::get_singleton()->get_import_settings_hash();
+	if (import_settings_hash != watch_import_settings_hash) {
+		//imported files may be invalid now without any file having changed
+		watch_import_settings_hash = import_settings_hash;
+		watch_lost_events = true;
+	}
+
 	abort_scan = false;
 
 	if (!use_threads) {
@@ -1534,12 +1737,12 @@ void EditorFileSystem::update_file(const String &p_file) {
 	_queue_update_script_classes();
 }
 
-void EditorFileSystem::_reimport_file(const String &p_file) {
+void EditorFileSystem::_import_file(ImportFile &r_file) {
 
-	EditorFileSystemDirectory *fs = NULL;
-	int cpos = -1;
-	bool found = _find_file(p_file, &fs, cpos);
-	ERR_FAIL_COND(!found);
+	const String &p_file = r_file.path;
+
+	r_file.imported = false;
+	r_file.added = false;
 
 	//try to obtain existing params
 
@@ -1565,7 +1768,7 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 		}
 
 	} else {
-		late_added_files.insert(p_file); //imported files do not call update_file(), but just in case..
+		r_file.added = true; //imported files do not call update_file(), but just in case..
 	}
 
 	Ref<ResourceImporter> importer;
@@ -1614,6 +1817,14 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	Variant metadata;
 	Error err = importer->import(p_file, base_path, params, &import_variants, &gen_files, &metadata);
 
+	import_errors_mutex->lock();
+	Map<String, Vector<String> >::Element *IE = import_errors.find(p_file);
+	if (IE) {
+		r_file.errors = IE->get();
+		import_errors.erase(IE);
+	}
+	import_errors_mutex->unlock();
+
 	if (err != OK) {
 		ERR_PRINTS("Error importing: " + p_file);
 	}
@@ -1714,28 +1925,57 @@ void EditorFileSystem::_reimport_file(const String &p_file) {
 	md5s->close();
 	memdelete(md5s);
 
+	r_file.type = importer->get_resource_type();
+	r_file.imported = true;
+}
+
+void EditorFileSystem::_import_file_threaded(uint32_t p_index, ImportFile *p_files) {
+
+	_import_file(p_files[p_index]);
+}
+
+void EditorFileSystem::_update_imported_file(const ImportFile &p_file) {
+
+	EditorFileSystemDirectory *fs = NULL;
+	int cpos = -1;
+	bool found = _find_file(p_file.path, &fs, cpos);
+	ERR_FAIL_COND(!found);
+
 	//update modified times, to avoid reimport
-	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file);
-	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file + ".import");
-	fs->files[cpos]->deps = _get_dependencies(p_file);
-	fs->files[cpos]->type = importer->get_resource_type();
-	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(p_file);
+	fs->files[cpos]->modified_time = FileAccess::get_modified_time(p_file.path);
+	fs->files[cpos]->import_modified_time = FileAccess::get_modified_time(p_file.path + ".import");
+	fs->files[cpos]->deps = _get_dependencies(p_file.path);
+	fs->files[cpos]->type = p_file.type;
+	fs->files[cpos]->import_valid = ResourceLoader::is_import_valid(p_file.path);
 
 	//if file is currently up, maybe the source it was loaded from changed, so import math must be updated for it
 	//to reload properly
-	if (ResourceCache::has(p_file)) {
+	if (ResourceCache::has(p_file.path)) {
 
-		Resource *r = ResourceCache::get(p_file);
+		Resource *r = ResourceCache::get(p_file.path);
 
 		if (r->get_import_path() != String()) {
 
-			String dst_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(p_file);
+			String dst_path = ResourceFormatImporter::get_singleton()->get_internal_resource_path(p_file.path);
 			r->set_import_path(dst_path);
 			r->set_import_last_modified_time(0);
 		}
 	}
 
-	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file);
+	EditorResourcePreview::get_singleton()->check_for_invalidation(p_file.path);
+}
+
+void EditorFileSystem::add_import_error(const String &p_file, const String &p_error) {
+
+	if (Thread::get_caller_id() == Thread::get_main_id()) {
+		EditorNode::add_io_error(p_error);
+		return;
+	}
+
+	//the editor UI can't be touched from the import threads, reimport_files() reports it
+	import_errors_mutex->lock();
+	import_errors[p_file].push_back(p_error);
+	import_errors_mutex->unlock();
 }
 
 void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
@@ -1758,21 +1998,70 @@ void EditorFileSystem::reimport_files(const Vector<String> &p_files) {
 
 	Vector<ImportFile> files;
 
+	bool use_threads = GLOBAL_GET("editor/import/use_multiple_threads");
+
 	for (int i = 0; i < p_files.size(); i++) {
+
+		EditorFileSystemDirectory *fs = NULL;
+		int cpos = -1;
+		ERR_CONTINUE(!_find_file(p_files[i], &fs, cpos));
+
 		ImportFile ifile;
 		ifile.path = p_files[i];
 		ifile.order = ResourceFormatImporter::get_singleton()->get_import_order(p_files[i]);
+		ifile.threaded = use_threads && ResourceFormatImporter::get_singleton()->can_import_threaded(p_files[i]);
+		ifile.imported = false;
+		ifile.added = false;
 		files.push_back(ifile);
 	}
 
 	files.sort();
 
-	for (int i = 0; i < files.size(); i++) {
-		pr.step(files[i].path.get_file(), i);
+	ThreadWorkPool import_pool;
+	if (use_threads) {
+		import_pool.init();
+	}
+
+	int from = 0;
+	while (from < files.size()) {
+
+		int count = 1;
+		if (files[from].threaded) {
+			while (from + count < files.size() && files[from + count].threaded && files[from + count].order == files[from].order) {
+				count++;
+			}
+		}
+
+		if (count > 1) {
+			//a few files per thread at a time, so progress is still shown
+			int batch = (import_pool.get_thread_count() + 1) * 2;
+			for (int i = from; i < from + count; i += batch) {
+				pr.step(files[i].path.get_file(), i);
+				import_pool.do_work(MIN(batch, from + count - i), this, &EditorFileSystem::_import_file_threaded, files.ptrw() + i);
+			}
+		} else {
+			pr.step(files[from].path.get_file(), from);
+			_import_file(files.write[from]);
+		}
+
+		//the tree and resource cache are only updated here, files of a later import order may depend on these
+		for (int i = from; i < from + count; i++) {
+			if (files[i].added) {
+				late_added_files.insert(files[i].path);
+			}
+			if (files[i].imported) {
+				_update_imported_file(files[i]);
+			}
+			for (int j = 0; j < files[i].errors.size(); j++) {
+				EditorNode::add_io_error(files[i].errors[j]);
+			}
+		}
 
-		_reimport_file(files[i].path);
+		from += count;
 	}
 
+	import_pool.finish();
+
 	_save_filesystem_cache();
 	importing = false;
 	if (!is_scanning()) {
@@ -1835,6 +2124,7 @@ EditorFileSystem::EditorFileSystem() {
 
 	ResourceLoader::import = _resource_import;
 	reimport_on_missing_imported_files = GLOBAL_DEF("editor/reimport_missing_imported_files", true);
+	GLOBAL_DEF("editor/import/use_multiple_threads", true);
 
 	singleton = this;
 	filesystem = memnew(EditorFileSystemDirectory); //like, empty
@@ -1863,7 +2153,20 @@ EditorFileSystem::EditorFileSystem() {
 	update_script_classes_queued = false;
 	first_scan = true;
 	revalidate_import_files = false;
+
+	scan_pool.init();
+
+	import_errors_mutex = Mutex::create();
+
+	watcher = OS::get_singleton()->dir_watch_create();
+	watch_import_dir = -1;
+	watch_enabled = false;
+	watch_incomplete = false;
+	watch_lost_events = false;
 }
 
 EditorFileSystem::~EditorFileSystem() {
+
+	OS::get_singleton()->dir_watch_free(watcher);
+	memdelete(import_errors_mutex);
 }
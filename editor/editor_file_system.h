@@ -32,8 +32,10 @@
 #define EDITOR_FILE_SYSTEM_H
 
 #include "core/os/dir_access.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/os/thread_safe.h"
+#include "core/os/thread_work_pool.h"
 #include "core/set.h"
 #include "scene/main/node.h"
 class FileAccess;
@@ -174,6 +176,46 @@ class EditorFileSystem : public Node {
 
 	HashMap<String, FileCache> file_cache;
 
+	/* A file found while walking the directories, the per file checks (stat, .import parsing) run on scan_pool */
+	struct ScanFile {
+
+		EditorFileSystemDirectory *dir;
+		EditorFileSystemDirectory::FileInfo *file;
+		String path;
+		bool imported;
+		const FileCache *cache; //new directories only
+		uint64_t modified_time;
+		uint64_t import_modified_time;
+		bool changed; //new directories: cache can't be used, known directories: must test for reimport or reload
+		bool test_reimport;
+	};
+
+	struct ReimportTest {
+
+		String path;
+		bool reimport;
+	};
+
+	ThreadWorkPool scan_pool;
+
+	void _check_new_file(uint32_t p_index, ScanFile *p_files);
+	void _check_file_changes(uint32_t p_index, ScanFile *p_files);
+	void _test_for_reimport_threaded(uint32_t p_index, ReimportTest *p_tests);
+
+	/* Change notifications from the OS, so scan_changes() only looks into directories that were touched */
+	int watcher;
+	int watch_import_dir;
+	bool watch_enabled;
+	bool watch_incomplete; //a directory could not be watched, check everything until the next full scan
+	bool watch_lost_events; //check everything once
+	HashMap<int, String> watched_dirs;
+	Set<String> changed_dirs;
+	String watch_import_settings_hash;
+
+	void _watch_dir(EditorFileSystemDirectory *p_dir);
+	void _watch_import_dir();
+	void _read_dir_changes();
+
 	struct ScanProgress {
 
 		float low;
@@ -189,6 +231,7 @@ class EditorFileSystem : public Node {
 	bool _find_file(const String &p_file, EditorFileSystemDirectory **r_d, int &r_file_pos) const;
 
 	void _scan_fs_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress);
+	void _scan_fs_dir_changes(EditorFileSystemDirectory *p_dir, const ScanProgress &p_progress, const Set<String> *p_changed_dirs, Vector<ScanFile> &r_files);
 
 	void _delete_internal_files(String p_file);
 
@@ -196,6 +239,7 @@ class EditorFileSystem : public Node {
 	Set<String> import_extensions;
 
 	void _scan_new_dir(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress);
+	void _scan_new_dir_files(EditorFileSystemDirectory *p_dir, DirAccess *da, const ScanProgress &p_progress, Vector<ScanFile> &r_files);
 
 	Thread *thread_sources;
 	bool scanning_changes;
@@ -210,8 +254,6 @@ class EditorFileSystem : public Node {
 
 	void _update_extensions();
 
-	void _reimport_file(const String &p_file);
-
 	bool _test_for_reimport(const String &p_path, bool p_only_imported_files);
 
 	bool reimport_on_missing_imported_files;
@@ -221,11 +263,25 @@ class EditorFileSystem : public Node {
 	struct ImportFile {
 		String path;
 		int order;
+		bool threaded;
+		//results of _import_file()
+		bool imported;
+		bool added;
+		String type;
+		Vector<String> errors; //from the import threads, reported on the main thread
 		bool operator<(const ImportFile &p_if) const {
-			return order < p_if.order;
+			//files that can be imported on threads go first within the same order, to be grouped together
+			return order == p_if.order ? threaded && !p_if.threaded : order < p_if.order;
 		}
 	};
 
+	void _import_file(ImportFile &r_file);
+	void _import_file_threaded(uint32_t p_index, ImportFile *p_files);
+	void _update_imported_file(const ImportFile &p_file);
+
+	Mutex *import_errors_mutex;
+	Map<String, Vector<String> > import_errors;
+
 	void _scan_script_classes(EditorFileSystemDirectory *p_dir);
 	volatile bool update_script_classes_queued;
 	void _queue_update_script_classes();
@@ -257,6 +313,7 @@ public:
 	EditorFileSystemDirectory *find_file(const String &p_file, int *r_index) const;
 
 	void reimport_files(const Vector<String> &p_files);
+	void add_import_error(const String &p_file, const String &p_error);
 
 	void update_script_classes();
 
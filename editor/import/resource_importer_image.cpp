@@ -58,6 +58,11 @@ String ResourceImporterImage::get_resource_type() const {
 	return "Image";
 }
 
+bool ResourceImporterImage::can_import_threaded() const {
+
+	return true;
+}
+
 bool ResourceImporterImage::get_option_visibility(const String &p_option, const Map<StringName, Variant> &p_options) const {
 
 	return true;
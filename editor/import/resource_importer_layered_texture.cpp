@@ -35,7 +35,6 @@
 #include "core/io/config_file.h"
 #include "core/io/image_loader.h"
 #include "editor/editor_file_system.h"
-#include "editor/editor_node.h"
 #include "scene/resources/texture.h"
 
 String ResourceImporterLayeredTexture::get_importer_name() const {
@@ -60,6 +59,12 @@ String ResourceImporterLayeredTexture::get_resource_type() const {
 	return is_3d ? "Texture3D" : "TextureArray";
 }
 
+bool ResourceImporterLayeredTexture::can_import_threaded() const {
+
+	//same image compression as regular textures
+	return ResourceImporterTexture::get_singleton()->can_import_threaded();
+}
+
 bool ResourceImporterLayeredTexture::get_option_visibility(const String &p_option, const Map<StringName, Variant> &p_options) const {
 
 	return true;
@@ -311,7 +316,7 @@ Error ResourceImporterLayeredTexture::import(const String &p_source_file, const
 		}
 
 		if (!ok_on_pc) {
-			EditorNode::add_io_error("Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
+			EditorFileSystem::get_singleton()->add_import_error(p_source_file, "Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
 		}
 	} else {
 		//import normally
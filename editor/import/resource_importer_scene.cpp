@@ -48,6 +48,7 @@
 #include "scene/resources/ray_shape.h"
 #include "scene/resources/resource_format_text.h"
 #include "scene/resources/sphere_shape.h"
+#include "scene/resources/surface_tool.h"
 
 uint32_t EditorSceneImporter::get_import_flags() const {
 
@@ -215,6 +216,10 @@ bool ResourceImporterScene::get_option_visibility(const String &p_option, const
 		return false;
 	}
 
+	if ((p_option == "meshes/lods/ratio" || p_option == "meshes/lods/distance_factor") && int(p_options["meshes/lods/count"]) == 0) {
+		return false;
+	}
+
 	return true;
 }
 
@@ -909,6 +914,125 @@ void ResourceImporterScene::_find_meshes(Node *p_node, Map<Ref<ArrayMesh>, Trans
 	}
 }
 
+static int _get_mesh_index_count(const Ref<ArrayMesh> &p_mesh) {
+
+	int count = 0;
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		int index_len = p_mesh->surface_get_array_index_len(i);
+		count += index_len > 0 ? index_len : p_mesh->surface_get_array_len(i);
+	}
+	return count;
+}
+
+void ResourceImporterScene::_generate_lods(Node *p_node, int p_count, float p_ratio, float p_distance_factor, bool p_compress, Map<Ref<ArrayMesh>, Vector<Ref<ArrayMesh> > > &r_lods) {
+
+	// LODs of a child are added next to it, copy the list so only the original children are visited.
+	Vector<Node *> children;
+	for (int i = 0; i < p_node->get_child_count(); i++) {
+		children.push_back(p_node->get_child(i));
+	}
+	for (int i = 0; i < children.size(); i++) {
+		_generate_lods(children[i], p_count, p_ratio, p_distance_factor, p_compress, r_lods);
+	}
+
+	MeshInstance *mi = Object::cast_to<MeshInstance>(p_node);
+	if (!mi || !mi->get_parent()) {
+		return;
+	}
+
+	Ref<ArrayMesh> mesh = mi->get_mesh();
+	if (mesh.is_null() || mesh->get_blend_shape_count() > 0) {
+		return; // Blend shapes rely on the vertex layout, which simplification changes.
+	}
+
+	if (!r_lods.has(mesh)) {
+
+		Vector<Ref<ArrayMesh> > lods;
+		int index_count = _get_mesh_index_count(mesh);
+		float ratio = 1.0;
+		for (int i = 0; i < p_count; i++) {
+
+			ratio *= p_ratio;
+
+			Ref<ArrayMesh> lod;
+			lod.instance();
+			for (int j = 0; j < mesh->get_surface_count(); j++) {
+
+				if (mesh->surface_get_primitive_type(j) != Mesh::PRIMITIVE_TRIANGLES) {
+					lod.unref();
+					break;
+				}
+
+				Ref<SurfaceTool> st;
+				st.instance();
+				st->create_from(mesh, j);
+				st->generate_lod(ratio);
+				st->commit(lod, p_compress ? Mesh::ARRAY_COMPRESS_DEFAULT : 0);
+				if (lod->get_surface_count() != j + 1) {
+					lod.unref(); // Simplified to nothing, keep surface indices aligned with the source.
+					break;
+				}
+				lod->surface_set_name(j, mesh->surface_get_name(j));
+			}
+
+			if (lod.is_null()) {
+				break;
+			}
+
+			// Simplification can get stuck on borders and seams, a level that isn't any lighter is only overhead.
+			int lod_index_count = _get_mesh_index_count(lod);
+			if (lod_index_count >= index_count) {
+				continue;
+			}
+			index_count = lod_index_count;
+
+			lod->set_name(mesh->get_name() + "_lod" + itos(lods.size() + 1));
+			lods.push_back(lod);
+		}
+
+		r_lods[mesh] = lods;
+	}
+
+	const Vector<Ref<ArrayMesh> > &lods = r_lods[mesh];
+	if (lods.empty()) {
+		return;
+	}
+
+	// Each level covers twice the distance of the previous one, starting at a multiple of the mesh size.
+	float distance = mesh->get_aabb().get_longest_axis_size() * p_distance_factor;
+	if (distance <= 0) {
+		return;
+	}
+
+	mi->set_lod_max_distance(distance);
+
+	Node *below = mi;
+	for (int i = 0; i < lods.size(); i++) {
+
+		MeshInstance *lod_mi = memnew(MeshInstance);
+		lod_mi->set_name(String(mi->get_name()) + "_lod" + itos(i + 1));
+		lod_mi->set_transform(mi->get_transform());
+		lod_mi->set_mesh(lods[i]);
+		lod_mi->set_skeleton_path(mi->get_skeleton_path());
+		lod_mi->set_material_override(mi->get_material_override());
+		lod_mi->set_cast_shadows_setting(mi->get_cast_shadows_setting());
+		for (int j = 0; j < mi->get_surface_material_count(); j++) {
+			lod_mi->set_surface_material(j, mi->get_surface_material(j));
+		}
+
+		lod_mi->set_lod_min_distance(distance);
+		distance *= 2.0;
+		if (i < lods.size() - 1) {
+			lod_mi->set_lod_max_distance(distance);
+		}
+
+		mi->get_parent()->add_child_below_node(below, lod_mi);
+		below = lod_mi;
+		lod_mi->set_owner(mi->get_owner());
+		lod_mi->set_lod_parent(lod_mi->get_path_to(mi));
+	}
+}
+
 void ResourceImporterScene::_make_external_resources(Node *p_node, const String &p_base_path, bool p_make_animations, bool p_keep_animations, bool p_make_materials, bool p_keep_materials, bool p_make_meshes, Map<Ref<Animation>, Ref<Animation> > &p_animations, Map<Ref<Material>, Ref<Material> > &p_materials, Map<Ref<ArrayMesh>, Ref<ArrayMesh> > &p_meshes) {
 
 	List<PropertyInfo> pi;
@@ -1090,6 +1214,9 @@ void ResourceImporterScene::get_import_options(List<ImportOption> *r_options, in
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/storage", PROPERTY_HINT_ENUM, "Built-In,Files"), meshes_out ? 1 : 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/light_baking", PROPERTY_HINT_ENUM, "Disabled,Enable,Gen Lightmaps", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "meshes/lightmap_texel_size", PROPERTY_HINT_RANGE, "0.001,100,0.001"), 0.1));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::INT, "meshes/lods/count", PROPERTY_HINT_RANGE, "0,4,1", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), 0));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "meshes/lods/ratio", PROPERTY_HINT_RANGE, "0.05,0.95,0.01"), 0.5));
+	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "meshes/lods/distance_factor", PROPERTY_HINT_RANGE, "1,1000,0.1"), 10.0));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "external_files/store_in_subdir"), false));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::BOOL, "animation/import", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_UPDATE_ALL_IF_MODIFIED), true));
 	r_options->push_back(ImportOption(PropertyInfo(Variant::REAL, "animation/fps", PROPERTY_HINT_RANGE, "1,120,1"), 15));
@@ -1322,7 +1449,7 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
-	if (light_bake_mode == 2 /* || generate LOD */) {
+	if (light_bake_mode == 2) {
 
 		Map<Ref<ArrayMesh>, Transform> meshes;
 		_find_meshes(scene, meshes);
@@ -1353,6 +1480,13 @@ Error ResourceImporterScene::import(const String &p_source_file, const String &p
 		}
 	}
 
+	int lod_count = p_options["meshes/lods/count"];
+	if (lod_count > 0) {
+		// Generated after lightmap unwrapping so the simplified meshes keep the UV2 layout.
+		Map<Ref<ArrayMesh>, Vector<Ref<ArrayMesh> > > lods;
+		_generate_lods(scene, lod_count, p_options["meshes/lods/ratio"], p_options["meshes/lods/distance_factor"], int(p_options["meshes/compress"]), lods);
+	}
+
 	if (external_animations || external_materials || external_meshes) {
 		Map<Ref<Animation>, Ref<Animation> > anim_map;
 		Map<Ref<Material>, Ref<Material> > mat_map;
@@ -143,6 +143,7 @@ public:
 	virtual int get_import_order() const { return 100; } //after everything
 
 	void _find_meshes(Node *p_node, Map<Ref<ArrayMesh>, Transform> &meshes);
+	void _generate_lods(Node *p_node, int p_count, float p_ratio, float p_distance_factor, bool p_compress, Map<Ref<ArrayMesh>, Vector<Ref<ArrayMesh> > > &r_lods);
 
 	void _make_external_resources(Node *p_node, const String &p_base_path, bool p_make_animations, bool p_keep_animations, bool p_make_materials, bool p_keep_materials, bool p_make_meshes, Map<Ref<Animation>, Ref<Animation> > &p_animations, Map<Ref<Material>, Ref<Material> > &p_materials, Map<Ref<ArrayMesh>, Ref<ArrayMesh> > &p_meshes);
 
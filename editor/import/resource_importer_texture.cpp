@@ -33,7 +33,7 @@
 #include "core/io/config_file.h"
 #include "core/io/image_loader.h"
 #include "editor/editor_file_system.h"
-#include "editor/editor_node.h"
+#include "editor/editor_settings.h"
 #include "scene/resources/texture.h"
 
 void ResourceImporterTexture::_texture_reimport_srgb(const Ref<StreamTexture> &p_tex) {
@@ -157,6 +157,13 @@ String ResourceImporterTexture::get_resource_type() const {
 	return "StreamTexture";
 }
 
+bool ResourceImporterTexture::can_import_threaded() const {
+
+	//the external PVRTC tool goes through fixed temporary files and an ImageTexture
+	bool pvrtc = ProjectSettings::get_singleton()->get("rendering/vram_compression/import_pvrtc");
+	return !pvrtc || String(EditorSettings::get_singleton()->get("filesystem/import/pvrtc_texture_tool")).strip_edges() == String();
+}
+
 bool ResourceImporterTexture::get_option_visibility(const String &p_option, const Map<StringName, Variant> &p_options) const {
 
 	if (p_option == "compress/lossy_quality") {
@@ -524,7 +531,7 @@ Error ResourceImporterTexture::import(const String &p_source_file, const String
 		}
 
 		if (!ok_on_pc) {
-			EditorNode::add_io_error("Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
+			EditorFileSystem::get_singleton()->add_import_error(p_source_file, "Warning, no suitable PC VRAM compression enabled in Project Settings. This texture will not display correctly on PC.");
 		}
 	} else {
 		//import normally
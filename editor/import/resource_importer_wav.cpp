@@ -60,6 +60,11 @@ String ResourceImporterWAV::get_resource_type() const {
 	return "AudioStreamSample";
 }
 
+bool ResourceImporterWAV::can_import_threaded() const {
+
+	return true;
+}
+
 bool ResourceImporterWAV::get_option_visibility(const String &p_option, const Map<StringName, Variant> &p_options) const {
 
 	return true;
@@ -1892,112 +1892,111 @@ void PhysicalBoneSpatialGizmoPlugin::redraw(EditorSpatialGizmo *p_gizmo) {
 	p_gizmo->add_lines(points, material);
 }
 
-// FIXME: Kept as reference for reimplementation in 3.1+
-#if 0
+RoomSpatialGizmoPlugin::RoomSpatialGizmoPlugin() {
 
-void RoomSpatialGizmo::redraw() {
+	Color gizmo_color = EDITOR_DEF("editors/3d_gizmos/gizmo_colors/room_edge", Color(0.5, 1.0, 0.0));
+	create_material("room_material", gizmo_color);
+}
 
-	clear();
-	Ref<RoomBounds> roomie = room->get_room();
-	if (roomie.is_null())
-		return;
-	PoolVector<Face3> faces = roomie->get_geometry_hint();
+bool RoomSpatialGizmoPlugin::has_gizmo(Spatial *p_spatial) {
+	return Object::cast_to<Room>(p_spatial) != NULL;
+}
 
-	Vector<Vector3> lines;
-	int fc = faces.size();
-	PoolVector<Face3>::Read r = faces.read();
+String RoomSpatialGizmoPlugin::get_name() const {
+	return "Room";
+}
 
-	Map<_EdgeKey, Vector3> edge_map;
+int RoomSpatialGizmoPlugin::get_priority() const {
+	return -1;
+}
 
-	for (int i = 0; i < fc; i++) {
+void RoomSpatialGizmoPlugin::redraw(EditorSpatialGizmo *p_gizmo) {
 
-			Vector3 fn = r[i].get_plane().normal;
+	Room *room = Object::cast_to<Room>(p_gizmo->get_spatial_node());
 
-			for (int j = 0; j < 3; j++) {
+	p_gizmo->clear();
 
-					_EdgeKey ek;
-					ek.from = r[i].vertex[j].snapped(Vector3(CMP_EPSILON, CMP_EPSILON, CMP_EPSILON));
-					ek.to = r[i].vertex[(j + 1) % 3].snapped(Vector3(CMP_EPSILON, CMP_EPSILON, CMP_EPSILON));
-					if (ek.from < ek.to)
-						SWAP(ek.from, ek.to);
+	PoolVector<Vector3> bounds = room->get_bounds();
+	if (bounds.size() < 4) {
+		return;
+	}
 
-					Map<_EdgeKey, Vector3>::Element *E = edge_map.find(ek);
+	Vector<Vector3> points;
+	for (int i = 0; i < bounds.size(); i++) {
+		points.push_back(bounds[i]);
+	}
 
-					if (E) {
+	Geometry::MeshData md;
+	if (QuickHull::build(points, md) != OK) {
+		return;
+	}
 
-							if (E->get().dot(fn) > 0.9) {
+	Vector<Vector3> lines;
+	for (int i = 0; i < md.edges.size(); i++) {
+		lines.push_back(md.vertices[md.edges[i].a]);
+		lines.push_back(md.vertices[md.edges[i].b]);
+	}
 
-									E->get() = Vector3();
-								}
+	Ref<Material> material = get_material("room_material", p_gizmo);
 
-						} else {
+	p_gizmo->add_lines(lines, material);
+	p_gizmo->add_collision_segments(lines);
+}
 
-							edge_map[ek] = fn;
-						}
-				}
-		}
+/////
 
-	for (Map<_EdgeKey, Vector3>::Element *E = edge_map.front(); E; E = E->next()) {
+PortalSpatialGizmoPlugin::PortalSpatialGizmoPlugin() {
 
-			if (E->get() != Vector3()) {
-					lines.push_back(E->key().from);
-					lines.push_back(E->key().to);
-				}
-		}
+	Color gizmo_color = EDITOR_DEF("editors/3d_gizmos/gizmo_colors/portal_edge", Color(0.0, 0.5, 1.0));
+	create_material("portal_material", gizmo_color);
+}
 
-	add_lines(lines, EditorSpatialGizmos::singleton->room_material);
-	add_collision_segments(lines);
+bool PortalSpatialGizmoPlugin::has_gizmo(Spatial *p_spatial) {
+	return Object::cast_to<Portal>(p_spatial) != NULL;
 }
 
-RoomSpatialGizmo::RoomSpatialGizmo(Room *p_room) {
+String PortalSpatialGizmoPlugin::get_name() const {
+	return "Portal";
+}
 
-	set_spatial_node(p_room);
-	room = p_room;
+int PortalSpatialGizmoPlugin::get_priority() const {
+	return -1;
 }
 
-/////
+void PortalSpatialGizmoPlugin::redraw(EditorSpatialGizmo *p_gizmo) {
 
-void PortalSpatialGizmo::redraw() {
+	Portal *portal = Object::cast_to<Portal>(p_gizmo->get_spatial_node());
 
-	clear();
+	p_gizmo->clear();
 
-	Vector<Point2> points = portal->get_shape();
+	PoolVector<Vector2> points = portal->get_polygon();
 	if (points.size() == 0) {
-			return;
-		}
+		return;
+	}
 
 	Vector<Vector3> lines;
 
 	Vector3 center;
 	for (int i = 0; i < points.size(); i++) {
 
-			Vector3 f;
-			f.x = points[i].x;
-			f.y = points[i].y;
-			Vector3 fn;
-			fn.x = points[(i + 1) % points.size()].x;
-			fn.y = points[(i + 1) % points.size()].y;
-			center += f;
+		Vector3 f(points[i].x, points[i].y, 0);
+		Vector3 fn(points[(i + 1) % points.size()].x, points[(i + 1) % points.size()].y, 0);
+		center += f;
 
-			lines.push_back(f);
-			lines.push_back(fn);
-		}
+		lines.push_back(f);
+		lines.push_back(fn);
+	}
 
 	center /= points.size();
 	lines.push_back(center);
 	lines.push_back(center + Vector3(0, 0, 1));
 
-	add_lines(lines, EditorSpatialGizmos::singleton->portal_material);
-	add_collision_segments(lines);
-}
-
-PortalSpatialGizmo::PortalSpatialGizmo(Portal *p_portal) {
+	Ref<Material> material = get_material("portal_material", p_gizmo);
 
-	set_spatial_node(p_portal);
-	portal = p_portal;
+	p_gizmo->add_lines(lines, material);
+	p_gizmo->add_collision_segments(lines);
 }
 
-#endif
 /////
 
 RayCastSpatialGizmoPlugin::RayCastSpatialGizmoPlugin() {
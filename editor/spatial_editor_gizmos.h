@@ -160,18 +160,31 @@ public:
 	PhysicalBoneSpatialGizmoPlugin();
 };
 
-#if 0
-class PortalSpatialGizmo : public EditorSpatialGizmo {
+class RoomSpatialGizmoPlugin : public EditorSpatialGizmoPlugin {
 
-	GDCLASS(PortalSpatialGizmo, EditorSpatialGizmo);
+	GDCLASS(RoomSpatialGizmoPlugin, EditorSpatialGizmoPlugin);
 
-	Portal *portal;
+public:
+	bool has_gizmo(Spatial *p_spatial);
+	String get_name() const;
+	int get_priority() const;
+	void redraw(EditorSpatialGizmo *p_gizmo);
+
+	RoomSpatialGizmoPlugin();
+};
+
+class PortalSpatialGizmoPlugin : public EditorSpatialGizmoPlugin {
+
+	GDCLASS(PortalSpatialGizmoPlugin, EditorSpatialGizmoPlugin);
 
 public:
-	void redraw();
-	PortalSpatialGizmo(Portal *p_portal = NULL);
+	bool has_gizmo(Spatial *p_spatial);
+	String get_name() const;
+	int get_priority() const;
+	void redraw(EditorSpatialGizmo *p_gizmo);
+
+	PortalSpatialGizmoPlugin();
 };
-#endif
 
 class RayCastSpatialGizmoPlugin : public EditorSpatialGizmoPlugin {
 
@@ -136,6 +136,7 @@ static bool force_lowdpi = false;
 // Debug
 
 static bool use_debug_profiler = false;
+static String profile_scripts_path;
 #ifdef DEBUG_ENABLED
 static bool debug_collisions = false;
 static bool debug_navigation = false;
@@ -263,6 +264,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  -b, --breakpoints                Breakpoint list as source::line comma-separated pairs, no spaces (use %%20 instead).\n");
 	OS::get_singleton()->print("  --profiling                      Enable profiling in the script debugger.\n");
 	OS::get_singleton()->print("  --remote-debug <address>         Remote debug (<host/IP>:<port> address).\n");
+	OS::get_singleton()->print("  --profile-scripts <file>         Sample script call stacks and write them to <file> in collapsed (flamegraph) format on exit.\n");
 #ifdef DEBUG_ENABLED
 	OS::get_singleton()->print("  --debug-collisions               Show collisions shapes when running the scene.\n");
 	OS::get_singleton()->print("  --debug-navigation               Show navigation polygons when running the scene.\n");
@@ -284,6 +286,7 @@ void Main::print_help(const char *p_binary) {
 	OS::get_singleton()->print("  --doctool <path>                 Dump the engine API reference to the given <path> in XML format, merging if existing files are found.\n");
 	OS::get_singleton()->print("  --no-docbase                     Disallow dumping the base types (used with --doctool).\n");
 	OS::get_singleton()->print("  --build-solutions                Build the scripting solutions (e.g. for C# projects).\n");
+	OS::get_singleton()->print("  --gdscript-transpile <in> <out>  Translate a statically typed GDScript into a C++ NativeScript class for GDNative.\n");
 #ifdef DEBUG_METHODS_ENABLED
 	OS::get_singleton()->print("  --gdnative-generate-json-api     Generate JSON dump of the Godot API for GDNative bindings.\n");
 #endif
@@ -496,6 +499,16 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else if (I->get() == "--profiling") { // enable profiling
 
 			use_debug_profiler = true;
+		} else if (I->get() == "--profile-scripts") { // enable sampling script profiler
+
+			if (I->next()) {
+
+				profile_scripts_path = I->next()->get();
+				N = I->next()->next();
+			} else {
+				OS::get_singleton()->print("Missing profile output file argument, aborting.\n");
+				goto error;
+			}
 		} else if (I->get() == "--video-driver") { // force video driver
 
 			if (I->next()) {
@@ -1238,6 +1251,9 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 
 	register_driver_types();
 
+	// Languages may preload scripts on init, which are remapped (to .gdc for GDScript) in exported projects
+	ResourceLoader::load_path_remaps();
+
 	// This loads global classes, so it must happen before custom loaders and savers are registered
 	ScriptServer::init_languages();
 
@@ -1251,13 +1267,18 @@ Error Main::setup2(Thread::ID p_main_tid_override) {
 	translation_server->load_translations();
 	ResourceLoader::load_translation_remaps(); //load remaps for resources
 
-	ResourceLoader::load_path_remaps();
-
 	audio_server->load_default_bus_layout();
 
 	if (use_debug_profiler && script_debugger) {
 		script_debugger->profiling_start();
 	}
+
+	uint64_t sampling_interval = GLOBAL_DEF("debug/settings/profiler/sampling_interval_usec", 1000);
+	if (profile_scripts_path != String()) {
+		for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+			ScriptServer::get_language(i)->profiling_sampling_start(sampling_interval);
+		}
+	}
 	_start_success = true;
 	locale = String();
 
@@ -2015,6 +2036,24 @@ void Main::cleanup() {
 	ResourceLoader::clear_translation_remaps();
 	ResourceLoader::clear_path_remaps();
 
+	if (profile_scripts_path != String()) {
+		Map<String, uint64_t> stacks;
+		for (int i = 0; i < ScriptServer::get_language_count(); i++) {
+			ScriptServer::get_language(i)->profiling_sampling_stop();
+			ScriptServer::get_language(i)->profiling_get_sampled_stacks(&stacks);
+		}
+
+		FileAccess *f = FileAccess::open(profile_scripts_path, FileAccess::WRITE);
+		if (f) {
+			for (Map<String, uint64_t>::Element *E = stacks.front(); E; E = E->next()) {
+				f->store_line(E->key() + " " + itos(E->get()));
+			}
+			memdelete(f);
+		} else {
+			ERR_PRINTS("Cannot write script profile to: " + profile_scripts_path);
+		}
+	}
+
 	ScriptServer::finish_languages();
 
 #ifdef TOOLS_ENABLED
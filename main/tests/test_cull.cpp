@@ -0,0 +1,332 @@
+/*************************************************************************/
+/*  test_cull.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_cull.h"
+
+#include "core/math/camera_matrix.h"
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "servers/visual/visual_server_globals.h"
+#include "servers/visual/visual_server_scene.h"
+#include "servers/visual_server.h"
+
+// Builds a large scenario and times camera culling without rendering anything,
+// so it also runs on the headless (server) platform. Meant to be run with the
+// single threaded rendering model, since it calls into the scene directly.
+namespace TestCull {
+
+MainLoop *test() {
+
+	const int grid = 245; // ~60k instances
+	const int frames = 100;
+	const float spacing = 4.0;
+
+	VisualServer *vs = VisualServer::get_singleton();
+
+	RID scenario = vs->scenario_create();
+	RID mesh = vs->mesh_create();
+
+	Vector<RID> instances;
+	for (int i = 0; i < grid; i++) {
+		for (int j = 0; j < grid; j++) {
+			RID instance = vs->instance_create2(mesh, scenario);
+			vs->instance_set_custom_aabb(instance, AABB(Vector3(-1, -1, -1), Vector3(2, 2, 2)));
+			vs->instance_set_transform(instance, Transform(Basis(), Vector3((i - grid / 2) * spacing, 0, (j - grid / 2) * spacing)));
+			instances.push_back(instance);
+		}
+	}
+
+	VSG::scene->update_dirty_instances();
+
+	VisualServerScene::Scenario *scenario_ptr = VSG::scene->scenario_owner.get(scenario);
+
+	CameraMatrix projection;
+	projection.set_perspective(70, 16.0 / 9.0, 0.05, 500);
+
+	Vector<VisualServerScene::Instance *> octree_result;
+	octree_result.resize(instances.size());
+
+	uint64_t octree_usec = 0;
+	uint64_t prepare_usec = 0;
+	int mismatches = 0;
+	int visible = 0;
+
+	for (int i = 0; i < frames; i++) {
+
+		// Orbit around the center, looking slightly down at the grid.
+		float angle = Math_PI * 2.0 * i / frames;
+		Transform camera;
+		camera.origin = Vector3(Math::cos(angle) * 200, 30, Math::sin(angle) * 200);
+		camera = camera.looking_at(Vector3(), Vector3(0, 1, 0));
+
+		Vector<Plane> planes = projection.get_projection_planes(camera);
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		int octree_count = scenario_ptr->octree.cull_convex(planes, octree_result.ptrw(), octree_result.size());
+		octree_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+		from = OS::get_singleton()->get_ticks_usec();
+		VSG::scene->_prepare_scene(camera, projection, false, RID(), 0xFFFFFFFF, scenario, RID(), RID());
+		prepare_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+		// Both paths see the same boxes, so they must agree on what's visible.
+		if (VSG::scene->_cull_convex(scenario_ptr, planes, VSG::scene->instance_shadow_cull_result) != octree_count) {
+			mismatches++;
+		}
+		visible += VSG::scene->instance_cull_count;
+	}
+
+	OS::get_singleton()->print("instances: %i, frames: %i, average visible: %i\n", instances.size(), frames, visible / frames);
+	OS::get_singleton()->print("octree cull: %.3f ms/frame\n", octree_usec / 1000.0 / frames);
+	OS::get_singleton()->print("_prepare_scene: %.3f ms/frame\n", prepare_usec / 1000.0 / frames);
+	OS::get_singleton()->print("cull mismatches: %i, %s\n", mismatches, mismatches == 0 ? "PASS" : "FAILED");
+
+	// Same orbit with a tall box in the middle of the grid used as occluder.
+	const AABB wall(Vector3(-60, -1, -60), Vector3(120, 200, 120));
+
+	PoolVector<Vector3> wall_faces;
+	for (int i = 0; i < 6; i++) {
+		int axis = i / 2;
+		Vector3 n;
+		n[axis] = (i & 1) ? 1 : -1;
+		Vector3 u, v;
+		u[(axis + 1) % 3] = 1;
+		v[(axis + 2) % 3] = 1;
+		Vector3 center = wall.position + wall.size * 0.5;
+		Vector3 half = wall.size * 0.5;
+		Vector3 c = center + n * half[axis];
+		Vector3 du = u * half[(axis + 1) % 3];
+		Vector3 dv = v * half[(axis + 2) % 3];
+		Vector3 quad[6] = { c - du - dv, c + du - dv, c + du + dv, c - du - dv, c + du + dv, c - du + dv };
+		for (int j = 0; j < 6; j++) {
+			wall_faces.push_back(quad[j]);
+		}
+	}
+
+	RID occluder = vs->instance_create2(mesh, scenario);
+	vs->instance_set_custom_aabb(occluder, wall);
+	vs->instance_geometry_set_occluder(occluder, wall_faces);
+	VSG::scene->update_dirty_instances();
+
+	bool occlusion_culling = VSG::scene->occlusion_culling;
+	VSG::scene->occlusion_culling = true;
+
+	uint64_t occlusion_usec = 0;
+	int occluded_visible = 0;
+	int wrongly_occluded = 0;
+
+	for (int i = 0; i < frames; i++) {
+
+		float angle = Math_PI * 2.0 * i / frames;
+		Transform camera;
+		camera.origin = Vector3(Math::cos(angle) * 200, 30, Math::sin(angle) * 200);
+		camera = camera.looking_at(Vector3(), Vector3(0, 1, 0));
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		VSG::scene->_prepare_scene(camera, projection, false, RID(), 0xFFFFFFFF, scenario, RID(), RID());
+		occlusion_usec += OS::get_singleton()->get_ticks_usec() - from;
+		occluded_visible += VSG::scene->instance_cull_count;
+
+		// Anything culled must lie further than the near side of the wall.
+		Vector<Plane> planes = projection.get_projection_planes(camera);
+		int octree_count = scenario_ptr->octree.cull_convex(planes, octree_result.ptrw(), octree_result.size());
+		real_t wall_distance = camera.origin.distance_to(Vector3(CLAMP(camera.origin.x, wall.position.x, wall.position.x + wall.size.x), CLAMP(camera.origin.y, wall.position.y, wall.position.y + wall.size.y), CLAMP(camera.origin.z, wall.position.z, wall.position.z + wall.size.z)));
+		for (int j = 0; j < octree_count; j++) {
+			VisualServerScene::Instance *ins = octree_result[j];
+			if (ins->last_render_pass == VSG::scene->render_pass) {
+				continue;
+			}
+			const AABB &aabb = ins->transformed_aabb;
+			real_t furthest = 0;
+			for (int k = 0; k < 8; k++) {
+				furthest = MAX(furthest, camera.origin.distance_to(aabb.get_endpoint(k)));
+			}
+			if (furthest < wall_distance) {
+				wrongly_occluded++;
+			}
+		}
+	}
+
+	VSG::scene->occlusion_culling = occlusion_culling;
+
+	OS::get_singleton()->print("with occluder, average visible: %i\n", occluded_visible / frames);
+	OS::get_singleton()->print("_prepare_scene with occlusion culling: %.3f ms/frame\n", occlusion_usec / 1000.0 / frames);
+	// The wall must hide part of the grid, without hiding anything in front of it.
+	bool occlusion_ok = wrongly_occluded == 0 && occluded_visible < visible;
+	OS::get_singleton()->print("wrongly occluded: %i, %s\n", wrongly_occluded, occlusion_ok ? "PASS" : "FAILED");
+
+	vs->free(occluder);
+
+	// Cube shadows for 40 omni lights over the grid, 6 passes each. The dummy rasterizer has no lights,
+	// so the light data is set up by hand and paired with what the octree finds in range.
+	const int light_count = 40;
+	const float light_range = 20.0;
+
+	static const Vector3 view_normals[6] = { Vector3(-1, 0, 0), Vector3(+1, 0, 0), Vector3(0, -1, 0), Vector3(0, +1, 0), Vector3(0, 0, -1), Vector3(0, 0, +1) };
+	static const Vector3 view_up[6] = { Vector3(0, -1, 0), Vector3(0, -1, 0), Vector3(0, 0, -1), Vector3(0, 0, +1), Vector3(0, -1, 0), Vector3(0, -1, 0) };
+
+	CameraMatrix cube;
+	cube.set_perspective(90, 1, 0.01, light_range);
+
+	Vector<VisualServerScene::InstanceLightData *> lights;
+	Vector<Vector<Plane> > light_planes;
+	for (int i = 0; i < light_count; i++) {
+
+		Vector3 origin(Math::random(-400.0, 400.0), 5, Math::random(-400.0, 400.0));
+
+		VisualServerScene::InstanceLightData *light = memnew(VisualServerScene::InstanceLightData);
+		int pair_count = scenario_ptr->octree.cull_aabb(AABB(origin - Vector3(light_range, light_range, light_range), Vector3(light_range, light_range, light_range) * 2), octree_result.ptrw(), octree_result.size());
+		for (int j = 0; j < pair_count; j++) {
+			VisualServerScene::InstanceLightData::PairInfo pinfo;
+			pinfo.L = NULL;
+			pinfo.geometry = octree_result[j];
+			light->geometries.push_back(pinfo);
+		}
+		lights.push_back(light);
+
+		for (int j = 0; j < 6; j++) {
+			light_planes.push_back(cube.get_projection_planes(Transform(Basis(), origin) * Transform().looking_at(view_normals[j], view_up[j])));
+		}
+	}
+
+	uint64_t shadow_octree_usec = 0;
+	uint64_t shadow_cull_usec = 0;
+	uint64_t shadow_cached_usec = 0;
+	uint64_t culled = VSG::scene->shadow_cull_count;
+	uint64_t skipped = VSG::scene->shadow_cull_skipped_count;
+	int cache_mismatches = 0;
+
+	for (int i = 0; i < frames; i++) {
+
+		uint64_t from = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < light_planes.size(); j++) {
+			scenario_ptr->octree.cull_convex(light_planes[j], VSG::scene->instance_shadow_cull_result, VSG::scene->instance_cull_result_size, VS::INSTANCE_GEOMETRY_MASK);
+		}
+		shadow_octree_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+		// Every caster moved.
+		for (int j = 0; j < light_count; j++) {
+			lights[j]->shadow_casters_valid = 0;
+		}
+
+		int counts[light_count * 6];
+		from = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < light_planes.size(); j++) {
+			counts[j] = VSG::scene->_light_cull_shadow_casters(lights[j / 6], j % 6, light_planes[j]);
+		}
+		shadow_cull_usec += OS::get_singleton()->get_ticks_usec() - from;
+
+		// Nothing moved.
+		from = OS::get_singleton()->get_ticks_usec();
+		for (int j = 0; j < light_planes.size(); j++) {
+			if (VSG::scene->_light_cull_shadow_casters(lights[j / 6], j % 6, light_planes[j]) != counts[j]) {
+				cache_mismatches++;
+			}
+		}
+		shadow_cached_usec += OS::get_singleton()->get_ticks_usec() - from;
+	}
+
+	OS::get_singleton()->print("shadow passes: %i, octree cull: %.3f ms/frame\n", light_planes.size(), shadow_octree_usec / 1000.0 / frames);
+	OS::get_singleton()->print("shadow cull from pairs: %.3f ms/frame, cached: %.3f ms/frame\n", shadow_cull_usec / 1000.0 / frames, shadow_cached_usec / 1000.0 / frames);
+	OS::get_singleton()->print("shadow culls: %i, skipped: %i, cache mismatches: %i, %s\n", int(VSG::scene->shadow_cull_count - culled), int(VSG::scene->shadow_cull_skipped_count - skipped), cache_mismatches, cache_mismatches == 0 ? "PASS" : "FAILED");
+
+	for (int i = 0; i < lights.size(); i++) {
+		memdelete(lights[i]);
+	}
+
+	// Two rooms side by side, seen from the first through a small opening in the wall between them.
+	RID room_scenario = vs->scenario_create();
+	RID rooms[2];
+	for (int i = 0; i < 2; i++) {
+		rooms[i] = vs->room_create();
+		vs->room_set_scenario(rooms[i], room_scenario);
+		PoolVector<Vector3> bounds;
+		for (int j = 0; j < 8; j++) {
+			bounds.push_back(AABB(Vector3(i == 0 ? -20 : 0, -10, -10), Vector3(20, 20, 20)).get_endpoint(j));
+		}
+		vs->room_set_bounds(rooms[i], bounds);
+	}
+
+	RID portal = vs->portal_create();
+	vs->portal_set_scenario(portal, room_scenario);
+	PoolVector<Vector3> opening;
+	opening.push_back(Vector3(0, -1, -1));
+	opening.push_back(Vector3(0, -1, 1));
+	opening.push_back(Vector3(0, 1, 1));
+	opening.push_back(Vector3(0, 1, -1));
+	vs->portal_set_polygon(portal, opening);
+	vs->portal_set_rooms(portal, rooms[0], rooms[1]);
+
+	// Behind the opening, beside it in the next room, and outside both rooms.
+	const Vector3 positions[3] = { Vector3(10, 0, 0), Vector3(10, 0, 8), Vector3(-30, 0, 0) };
+	RID room_instances[3];
+	for (int i = 0; i < 3; i++) {
+		room_instances[i] = vs->instance_create2(mesh, room_scenario);
+		vs->instance_set_custom_aabb(room_instances[i], AABB(Vector3(-0.5, -0.5, -0.5), Vector3(1, 1, 1)));
+		vs->instance_set_transform(room_instances[i], Transform(Basis(), positions[i]));
+	}
+	VSG::scene->update_dirty_instances();
+
+	Transform camera;
+	camera.origin = Vector3(-10, 0, 0);
+	camera = camera.looking_at(Vector3(10, 0, 0), Vector3(0, 1, 0));
+	VSG::scene->_prepare_scene(camera, projection, false, RID(), 0xFFFFFFFF, room_scenario, RID(), RID());
+	int seen = VSG::scene->instance_cull_count;
+	OS::get_singleton()->print("seen through portal: %i, %s\n", seen, seen == 1 ? "PASS" : "FAILED");
+
+	vs->portal_set_enabled(portal, false);
+	VSG::scene->_prepare_scene(camera, projection, false, RID(), 0xFFFFFFFF, room_scenario, RID(), RID());
+	seen = VSG::scene->instance_cull_count;
+	OS::get_singleton()->print("seen through closed portal: %i, %s\n", seen, seen == 0 ? "PASS" : "FAILED");
+
+	// Linking a portal to the same room on both sides drops its previous link.
+	vs->portal_set_enabled(portal, true);
+	vs->portal_set_rooms(portal, rooms[0], rooms[0]);
+	VSG::scene->_prepare_scene(camera, projection, false, RID(), 0xFFFFFFFF, room_scenario, RID(), RID());
+	seen = VSG::scene->instance_cull_count;
+	OS::get_singleton()->print("seen through unlinked portal: %i, %s\n", seen, seen == 0 ? "PASS" : "FAILED");
+
+	for (int i = 0; i < 3; i++) {
+		vs->free(room_instances[i]);
+	}
+	vs->free(portal);
+	vs->free(rooms[0]);
+	vs->free(rooms[1]);
+	vs->free(room_scenario);
+
+	for (int i = 0; i < instances.size(); i++) {
+		vs->free(instances[i]);
+	}
+	vs->free(mesh);
+	vs->free(scenario);
+
+	return NULL;
+}
+} // namespace TestCull
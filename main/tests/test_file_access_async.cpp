@@ -0,0 +1,194 @@
+/*************************************************************************/
+/*  test_file_access_async.cpp                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "test_file_access_async.h"
+
+#include "core/io/file_access_async.h"
+#include "core/math/random_pcg.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+// Reads random blocks of a large file, first with a single FileAccess and then
+// as a batch of FileAccessAsync requests, and compares throughput and contents.
+namespace TestFileAccessAsync {
+
+static uint8_t _expected_byte(int64_t p_offset) {
+
+	return uint8_t((p_offset * 31 + (p_offset >> 12)) & 0xFF);
+}
+
+static bool _check_block(const PoolVector<uint8_t> &p_data, int64_t p_offset, int p_size) {
+
+	if (p_data.size() != p_size) {
+		return false;
+	}
+
+	PoolVector<uint8_t>::Read r = p_data.read();
+	for (int i = 0; i < p_size; i++) {
+		if (r[i] != _expected_byte(p_offset + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+MainLoop *test() {
+
+	const int file_size = 16 * 1024 * 1024;
+	const int block_size = 4096;
+	const int block_count = 4096;
+
+	FileAccessAsync *async = FileAccessAsync::get_singleton();
+	if (!async) {
+		OS::get_singleton()->print("FileAccessAsync singleton not available\n");
+		return NULL;
+	}
+
+	String path = OS::get_singleton()->get_cache_path().plus_file("test_file_access_async.bin");
+
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	if (!f) {
+		OS::get_singleton()->print("can't create %s\n", path.utf8().get_data());
+		return NULL;
+	}
+
+	Vector<uint8_t> chunk;
+	chunk.resize(65536);
+	for (int64_t ofs = 0; ofs < file_size; ofs += chunk.size()) {
+		for (int i = 0; i < chunk.size(); i++) {
+			chunk.write[i] = _expected_byte(ofs + i);
+		}
+		f->store_buffer(chunk.ptr(), chunk.size());
+	}
+	memdelete(f);
+
+	RandomPCG rng(0x5eed);
+	Vector<int64_t> offsets;
+	offsets.resize(block_count);
+	for (int i = 0; i < block_count; i++) {
+		offsets.write[i] = int64_t(rng.rand() % (file_size / block_size)) * block_size;
+	}
+
+	bool valid = true;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	f = FileAccess::open(path, FileAccess::READ);
+	PoolVector<uint8_t> block;
+	block.resize(block_size);
+	for (int i = 0; i < block_count; i++) {
+		{
+			PoolVector<uint8_t>::Write w = block.write();
+			f->seek(offsets[i]);
+			f->get_buffer(w.ptr(), block_size);
+		}
+		valid = valid && _check_block(block, offsets[i], block_size);
+	}
+	memdelete(f);
+	uint64_t sync_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	Vector<FileAccessAsync::RequestID> ids;
+	ids.resize(block_count);
+	async->begin_batch();
+	for (int i = 0; i < block_count; i++) {
+		ids.write[i] = async->read(path, offsets[i], block_size);
+	}
+	async->end_batch();
+	for (int i = 0; i < block_count; i++) {
+		valid = valid && async->wait(ids[i]) == OK && _check_block(async->get_data(ids[i]), offsets[i], block_size);
+		async->release(ids[i]);
+	}
+	uint64_t async_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	// Whole file, past the end, missing file and cancellation.
+	FileAccessAsync::RequestID whole = async->read(path);
+	FileAccessAsync::RequestID tail = async->read(path, file_size - 100, block_size);
+	FileAccessAsync::RequestID missing = async->read(path + ".missing");
+	async->begin_batch();
+	FileAccessAsync::RequestID cancelled = async->read(path);
+	valid = valid && async->cancel(cancelled) && async->get_status(cancelled) == FileAccessAsync::STATUS_CANCELLED;
+	async->end_batch();
+
+	valid = valid && async->wait(whole) == OK && async->get_data(whole).size() == file_size;
+	valid = valid && async->wait(tail) == OK && _check_block(async->get_data(tail), file_size - 100, 100);
+	valid = valid && async->wait(missing) != OK && async->get_status(missing) == FileAccessAsync::STATUS_FAILED;
+
+	async->release(whole);
+	async->release(tail);
+	async->release(missing);
+	async->release(cancelled);
+
+	// Write a new file and part of it again in place, then read it back.
+	String write_path = path + ".write";
+	PoolVector<uint8_t> written;
+	written.resize(3 * block_size + 100);
+	{
+		PoolVector<uint8_t>::Write w = written.write();
+		for (int i = 0; i < written.size(); i++) {
+			w[i] = _expected_byte(i);
+		}
+	}
+	FileAccessAsync::RequestID write = async->write(write_path, written);
+	valid = valid && async->wait(write) == OK && async->get_status(write) == FileAccessAsync::STATUS_DONE;
+	FileAccessAsync::RequestID overwrite = async->write(write_path, block, block_size);
+	valid = valid && async->wait(overwrite) == OK;
+	FileAccessAsync::RequestID read_back = async->read(write_path);
+	valid = valid && async->wait(read_back) == OK;
+	PoolVector<uint8_t> read_data = async->get_data(read_back);
+	valid = valid && read_data.size() == written.size() && _check_block(read_data.subarray(0, block_size - 1), 0, block_size);
+	valid = valid && _check_block(read_data.subarray(2 * block_size, read_data.size() - 1), 2 * block_size, block_size + 100);
+	{
+		// The middle block now holds the last block read above.
+		PoolVector<uint8_t>::Read r = read_data.read();
+		PoolVector<uint8_t>::Read b = block.read();
+		valid = valid && memcmp(r.ptr() + block_size, b.ptr(), block_size) == 0;
+	}
+
+	async->release(write);
+	async->release(overwrite);
+	async->release(read_back);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(path);
+	da->remove(write_path);
+	memdelete(da);
+
+	double mb = double(block_count) * block_size / (1024.0 * 1024.0);
+	OS::get_singleton()->print("%i random reads of %i bytes from a %i MiB file\n", block_count, block_size, file_size / (1024 * 1024));
+	OS::get_singleton()->print("FileAccess: %.3f ms, %.1f MiB/s\n", sync_usec / 1000.0, mb / (sync_usec / 1000000.0));
+	OS::get_singleton()->print("FileAccessAsync: %.3f ms, %.1f MiB/s\n", async_usec / 1000.0, mb / (async_usec / 1000000.0));
+	OS::get_singleton()->print("data valid: %s\n", valid ? "yes" : "no");
+
+	return NULL;
+}
+} // namespace TestFileAccessAsync
@@ -1,5 +1,5 @@
 /*************************************************************************/
-/*  room.cpp                                                             */
+/*  test_file_access_async.h                                             */
 /*************************************************************************/
 /*                       This file is part of:                           */
 /*                           GODOT ENGINE                                */
@@ -28,43 +28,15 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 
-#include "room.h"
 
-#include "servers/visual_server.h"
+#ifndef TEST_FILE_ACCESS_ASYNC_H
+#define TEST_FILE_ACCESS_ASYNC_H
 
-// FIXME: Left for reference for reimplementation using Area
-#if 0
-RID RoomBounds::get_rid() const {
+#include "core/os/main_loop.h"
 
-	return area;
-}
-
-void RoomBounds::set_geometry_hint(const PoolVector<Face3> &p_geometry_hint) {
-
-	geometry_hint = p_geometry_hint;
-}
-
-PoolVector<Face3> RoomBounds::get_geometry_hint() const {
-
-	return geometry_hint;
-}
+namespace TestFileAccessAsync {
 
-void RoomBounds::_bind_methods() {
-
-	ClassDB::bind_method(D_METHOD("set_geometry_hint", "triangles"), &RoomBounds::set_geometry_hint);
-	ClassDB::bind_method(D_METHOD("get_geometry_hint"), &RoomBounds::get_geometry_hint);
-
-	//ADD_PROPERTY( PropertyInfo( Variant::DICTIONARY, "bounds"), "set_bounds","get_bounds") ;
-	ADD_PROPERTY(PropertyInfo(Variant::POOL_VECTOR3_ARRAY, "geometry_hint"), "set_geometry_hint", "get_geometry_hint");
+MainLoop *test();
 }
 
-RoomBounds::RoomBounds() {
-
-	area = VisualServer::get_singleton()->room_create();
-}
-
-RoomBounds::~RoomBounds() {
-
-	VisualServer::get_singleton()->free(area);
-}
-#endif
+#endif // TEST_FILE_ACCESS_ASYNC_H
@@ -0,0 +1,205 @@
+/*************************************************************************/
+/*  test_file_access_compressed.cpp                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_file_access_compressed.h"
+
+#include "core/io/file_access_compressed.h"
+#include "core/math/random_pcg.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+// Writes the same data to a plain and a compressed file, then runs the same
+// random seeks and reads on both and compares every result. Reads cross block
+// boundaries and run sequentially, so blocks come from the cache and from the
+// read ahead thread as well as from the file.
+namespace TestFileAccessCompressed {
+
+static const int block_size = 4096;
+
+static uint8_t _make_byte(RandomPCG &p_rng, int p_offset) {
+
+	// Runs of a repeated byte mixed with noise, so blocks compress to different sizes.
+	if ((p_offset / 300) % 3 == 0) {
+		return uint8_t(p_offset / 300);
+	}
+	return uint8_t(p_rng.rand());
+}
+
+static bool _compare(FileAccess *p_plain, FileAccess *p_compressed, int p_read_len, uint8_t *r_plain_buf, uint8_t *r_compressed_buf) {
+
+	int plain_read = p_plain->get_buffer(r_plain_buf, p_read_len);
+	int compressed_read = p_compressed->get_buffer(r_compressed_buf, p_read_len);
+	if (plain_read != compressed_read || memcmp(r_plain_buf, r_compressed_buf, plain_read) != 0) {
+		return false;
+	}
+
+	return p_plain->get_position() == p_compressed->get_position() && p_plain->eof_reached() == p_compressed->eof_reached();
+}
+
+static bool _test_mode(Compression::Mode p_mode, int p_size) {
+
+	String plain_path = OS::get_singleton()->get_cache_path().plus_file("test_file_access_compressed.bin");
+	String compressed_path = plain_path + ".compressed";
+
+	RandomPCG rng(p_size);
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = _make_byte(rng, i);
+	}
+
+	FileAccess *plain = FileAccess::open(plain_path, FileAccess::WRITE);
+	if (!plain) {
+		return false;
+	}
+	plain->store_buffer(data.ptr(), p_size);
+	memdelete(plain);
+
+	FileAccessCompressed *compressed = memnew(FileAccessCompressed);
+	compressed->configure("TFAC", p_mode, block_size);
+	if (compressed->_open(compressed_path, FileAccess::WRITE) != OK) {
+		memdelete(compressed);
+		return false;
+	}
+	compressed->store_buffer(data.ptr(), p_size);
+	compressed->close();
+
+	plain = FileAccess::open(plain_path, FileAccess::READ);
+	compressed->configure("TFAC");
+	if (!plain || compressed->_open(compressed_path, FileAccess::READ) != OK) {
+		if (plain) {
+			memdelete(plain);
+		}
+		memdelete(compressed);
+		return false;
+	}
+
+	bool pass = compressed->get_len() == plain->get_len();
+
+	Vector<uint8_t> plain_buf;
+	plain_buf.resize(block_size * 3);
+	Vector<uint8_t> compressed_buf;
+	compressed_buf.resize(block_size * 3);
+
+	int block_count = p_size / block_size + 1;
+	for (int i = 0; i < 2000 && pass; i++) {
+
+		switch (rng.rand() % 5) {
+			case 0: {
+				// Land just before or after a block boundary, then read across it.
+				int pos = (rng.rand() % block_count) * block_size + int(rng.rand() % 16) - 8;
+				pos = CLAMP(pos, 0, p_size);
+				plain->seek(pos);
+				compressed->seek(pos);
+			} break;
+			case 1: {
+				int pos = rng.rand() % (p_size + 1);
+				plain->seek(pos);
+				compressed->seek(pos);
+			} break;
+			case 2: {
+				int pos = -int(rng.rand() % 64);
+				plain->seek_end(pos);
+				compressed->seek_end(pos);
+			} break;
+			case 3: {
+				// Byte reads, walking over boundaries one step at a time.
+				for (int j = 0; j < 20 && pass; j++) {
+					uint8_t a = plain->get_8();
+					uint8_t b = compressed->get_8();
+					pass = a == b && plain->eof_reached() == compressed->eof_reached();
+				}
+			} break;
+			default: {
+				// Keep reading where the last read stopped, so the read ahead kicks in.
+			} break;
+		}
+
+		pass = pass && plain->get_position() == compressed->get_position();
+		int read_len = 1 + rng.rand() % (block_size * 3);
+		pass = pass && _compare(plain, compressed, read_len, plain_buf.ptrw(), compressed_buf.ptrw());
+	}
+
+	// A full sequential pass from the start.
+	plain->seek(0);
+	compressed->seek(0);
+	while (pass && !plain->eof_reached()) {
+		pass = _compare(plain, compressed, block_size - 1, plain_buf.ptrw(), compressed_buf.ptrw());
+	}
+
+	memdelete(plain);
+	memdelete(compressed);
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	da->remove(plain_path);
+	da->remove(compressed_path);
+	memdelete(da);
+
+	return pass;
+}
+
+MainLoop *test() {
+
+	struct Case {
+		Compression::Mode mode;
+		const char *name;
+		int size;
+	};
+
+	// The last size is a whole number of blocks, so the file ends at a block boundary.
+	const Case cases[] = {
+		{ Compression::MODE_ZSTD, "zstd", block_size * 10 + 1234 },
+		{ Compression::MODE_DEFLATE, "deflate", block_size * 10 + 1234 },
+		{ Compression::MODE_FASTLZ, "fastlz", block_size * 10 + 1234 },
+		{ Compression::MODE_ZSTD, "zstd", block_size * 8 },
+	};
+
+	// Read ahead needs room for at least two blocks.
+	int cache_size = FileAccessCompressed::block_cache_size;
+	FileAccessCompressed::block_cache_size = 4;
+
+	int passed = 0;
+	int count = sizeof(cases) / sizeof(cases[0]);
+	for (int i = 0; i < count; i++) {
+		bool pass = _test_mode(cases[i].mode, cases[i].size);
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s, %i bytes: %s\n", cases[i].name, cases[i].size, pass ? "PASS" : "FAILED");
+	}
+
+	FileAccessCompressed::block_cache_size = cache_size;
+
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+} // namespace TestFileAccessCompressed
@@ -758,9 +758,13 @@ static void _disassemble_class(const Ref<GDScript> &p_class, const Vector<String
 					incr = 5 + argc;
 
 				} break;
-				case GDScriptFunction::OPCODE_CALL_BUILT_IN: {
+				case GDScriptFunction::OPCODE_CALL_BUILT_IN:
+				case GDScriptFunction::OPCODE_CALL_BUILT_IN_MATH: {
 
-					txt += " call-built-in ";
+					if (code[ip] == GDScriptFunction::OPCODE_CALL_BUILT_IN_MATH)
+						txt += " call-built-in-math ";
+					else
+						txt += " call-built-in ";
 
 					int argc = code[ip + 2];
 					txt += DADDR(3 + argc) + "=";
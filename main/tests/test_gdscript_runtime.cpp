@@ -0,0 +1,429 @@
+/*************************************************************************/
+/*  test_gdscript_runtime.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_gdscript_runtime.h"
+
+#include "core/os/os.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/viewport.h"
+
+#ifdef GDSCRIPT_ENABLED
+
+#include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_functions.h"
+
+// Compiles small scripts from source and checks what they do when run.
+namespace TestGDScriptRuntime {
+
+static bool all_passed = true;
+
+static void _check(bool p_ok, const String &p_what) {
+
+	OS::get_singleton()->print("\t%s: %s\n", p_ok ? "PASS" : "FAILED", p_what.utf8().get_data());
+	if (!p_ok) {
+		all_passed = false;
+	}
+}
+
+static Ref<GDScript> _compile(const String &p_code) {
+
+	Ref<GDScript> script;
+	script.instance();
+	script->set_source_code(p_code);
+	Error err = script->reload();
+	if (err != OK) {
+		ERR_PRINT("Test script failed to compile.");
+		return Ref<GDScript>();
+	}
+
+	return script;
+}
+
+static Variant _instance(const String &p_code) {
+
+	Ref<GDScript> script = _compile(p_code);
+	if (script.is_null()) {
+		return Variant();
+	}
+
+	Variant::CallError ce;
+	return script->_new(NULL, 0, ce);
+}
+
+static const char *profiler_code =
+		"func spin(msec):\n"
+		"\tvar end = OS.get_ticks_msec() + msec\n"
+		"\twhile OS.get_ticks_msec() < end:\n"
+		"\t\tbusy()\n"
+		"\n"
+		"func busy():\n"
+		"\tvar a = 0\n"
+		"\tfor i in range(100):\n"
+		"\t\ta += i\n"
+		"\treturn a\n";
+
+static void _test_profiler() {
+
+	OS::get_singleton()->print("profiler:\n");
+
+	Variant instance = _instance(profiler_code);
+	_check(instance.get_type() == Variant::OBJECT, "script instanced");
+	if (instance.get_type() != Variant::OBJECT) {
+		return;
+	}
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	language->profiling_sampling_start(500);
+	instance.call("spin", 200);
+	language->profiling_sampling_stop();
+
+	Map<String, uint64_t> stacks;
+	language->profiling_get_sampled_stacks(&stacks);
+
+	uint64_t samples = 0;
+	bool nested = false;
+	for (Map<String, uint64_t>::Element *E = stacks.front(); E; E = E->next()) {
+		samples += E->get();
+		Vector<String> frames = E->key().split(";");
+		if (frames.size() == 2 && frames[0].ends_with("spin") && frames[1].ends_with("busy")) {
+			nested = true;
+		}
+	}
+
+	_check(samples > 0, "stacks were sampled");
+	_check(nested, "nested calls are collapsed root first");
+
+	//starting again discards the previous samples
+	language->profiling_sampling_start(500);
+	language->profiling_sampling_stop();
+	stacks.clear();
+	language->profiling_get_sampled_stacks(&stacks);
+	_check(stacks.empty(), "restarting clears previous samples");
+}
+
+static bool _same(const Variant &p_a, const Variant &p_b) {
+
+	if (p_a.get_type() != p_b.get_type()) {
+		return false;
+	}
+	if (p_a.get_type() == Variant::REAL && Math::is_nan((double)p_a)) {
+		return Math::is_nan((double)p_b);
+	}
+	return p_a == p_b;
+}
+
+// Calls inside array literals are not type checked, so the results go through locals first.
+static const char *math_code =
+		"func typed(a: float, b: int, c: float):\n"
+		"\tvar r0 = lerp(a, b, c)\n"
+		"\tvar r1 = fmod(a, b)\n"
+		"\tvar r2 = pow(b, a)\n"
+		"\tvar r3 = floor(b)\n"
+		"\tvar r4 = sqrt(b)\n"
+		"\tvar r5 = clamp(a, c, 4.0)\n"
+		"\tvar r6 = max(a, c)\n"
+		"\tvar r7 = range_lerp(b, 0, 10, a, c)\n"
+		"\tvar r8 = wrapf(b, a, c)\n"
+		"\tvar r9 = stepify(b, c)\n"
+		"\treturn [r0, r1, r2, r3, r4, r5, r6, r7, r8, r9]\n"
+		"\n"
+		"func untyped(a, b, c):\n"
+		"\tvar r0 = lerp(a, b, c)\n"
+		"\tvar r1 = fmod(a, b)\n"
+		"\tvar r2 = pow(b, a)\n"
+		"\tvar r3 = floor(b)\n"
+		"\tvar r4 = sqrt(b)\n"
+		"\tvar r5 = clamp(a, c, 4.0)\n"
+		"\tvar r6 = max(a, c)\n"
+		"\tvar r7 = range_lerp(b, 0, 10, a, c)\n"
+		"\tvar r8 = wrapf(b, a, c)\n"
+		"\tvar r9 = stepify(b, c)\n"
+		"\treturn [r0, r1, r2, r3, r4, r5, r6, r7, r8, r9]\n";
+
+static void _test_math() {
+
+	OS::get_singleton()->print("math intrinsics:\n");
+
+	// Every argument combination the compiler accepts must give the same result as the generic call.
+	Variant values[] = { 2, 0.75, -3, 1.5 };
+	const int value_count = sizeof(values) / sizeof(values[0]);
+
+	int compared = 0;
+	int mismatches = 0;
+	for (int f = 0; f < GDScriptFunctions::FUNC_MAX; f++) {
+
+		GDScriptFunctions::Function func = GDScriptFunctions::Function(f);
+
+		for (int argc = 1; argc <= 5; argc++) {
+
+			int combinations = 1;
+			for (int i = 0; i < argc; i++) {
+				combinations *= value_count;
+			}
+
+			for (int c = 0; c < combinations; c++) {
+
+				const Variant *args[5];
+				bool all_real = true;
+				int index = c;
+				for (int i = 0; i < argc; i++) {
+					args[i] = &values[index % value_count];
+					index /= value_count;
+					if (args[i]->get_type() != Variant::REAL) {
+						all_real = false;
+					}
+				}
+
+				if (!GDScriptFunctions::is_math_intrinsic(func, argc, all_real)) {
+					continue;
+				}
+
+				Variant generic;
+				Variant::CallError ce;
+				GDScriptFunctions::call(func, args, argc, generic, ce);
+
+				Variant intrinsic;
+				GDScriptFunctions::call_math_intrinsic(func, args, intrinsic);
+
+				compared++;
+				if (ce.error != Variant::CallError::CALL_OK || !_same(generic, intrinsic)) {
+					mismatches++;
+					OS::get_singleton()->print("\t\t%s: %s vs %s\n", GDScriptFunctions::get_func_name(func), String(generic).utf8().get_data(), String(intrinsic).utf8().get_data());
+				}
+			}
+		}
+	}
+	_check(compared > 0 && mismatches == 0, itos(compared) + " intrinsic calls match the generic call");
+
+	Variant instance = _instance(math_code);
+	_check(instance.get_type() == Variant::OBJECT, "script instanced");
+	if (instance.get_type() != Variant::OBJECT) {
+		return;
+	}
+
+	// Typed arguments go through the intrinsic opcode, untyped ones through the generic call.
+	Array typed = instance.call("typed", 0.75, 2, 1.5);
+	Array untyped = instance.call("untyped", 0.75, 2, 1.5);
+	bool same = typed.size() == untyped.size() && typed.size() > 0;
+	for (int i = 0; same && i < typed.size(); i++) {
+		same = _same(typed[i], untyped[i]);
+	}
+	_check(same, "typed and untyped script calls agree on mixed int and float arguments");
+}
+
+static void _test_array_lerp() {
+
+	OS::get_singleton()->print("array lerp:\n");
+
+	Variant::CallError ce;
+	Variant weight = 0.25;
+
+	PoolRealArray reals_from;
+	PoolRealArray reals_to;
+	reals_from.push_back(0);
+	reals_from.push_back(-4);
+	reals_to.push_back(8);
+	reals_to.push_back(4);
+	Variant from = reals_from;
+	Variant to = reals_to;
+	const Variant *args[3] = { &from, &to, &weight };
+
+	Variant ret;
+	GDScriptFunctions::call(GDScriptFunctions::MATH_LERP, args, 3, ret, ce);
+	PoolRealArray reals = ret;
+	_check(ce.error == Variant::CallError::CALL_OK && ret.get_type() == Variant::POOL_REAL_ARRAY && reals.size() == 2 && reals[0] == 2 && reals[1] == -2, "PoolRealArray");
+
+	PoolVector3Array vectors_from;
+	PoolVector3Array vectors_to;
+	vectors_from.push_back(Vector3(0, 4, -4));
+	vectors_to.push_back(Vector3(4, 8, 4));
+	from = vectors_from;
+	to = vectors_to;
+	GDScriptFunctions::call(GDScriptFunctions::MATH_LERP, args, 3, ret, ce);
+	PoolVector3Array vectors = ret;
+	_check(ce.error == Variant::CallError::CALL_OK && ret.get_type() == Variant::POOL_VECTOR3_ARRAY && vectors.size() == 1 && vectors[0] == Vector3(1, 5, -2), "PoolVector3Array");
+
+	PoolColorArray colors_from;
+	PoolColorArray colors_to;
+	colors_from.push_back(Color(0, 0, 0, 1));
+	colors_to.push_back(Color(1, 0.5, 0, 1));
+	from = colors_from;
+	to = colors_to;
+	GDScriptFunctions::call(GDScriptFunctions::MATH_LERP, args, 3, ret, ce);
+	PoolColorArray colors = ret;
+	_check(ce.error == Variant::CallError::CALL_OK && ret.get_type() == Variant::POOL_COLOR_ARRAY && colors.size() == 1 && colors[0] == Color(0.25, 0.125, 0, 1), "PoolColorArray");
+
+	reals_to.push_back(1);
+	from = reals_from;
+	to = reals_to;
+	GDScriptFunctions::call(GDScriptFunctions::MATH_LERP, args, 3, ret, ce);
+	_check(ce.error == Variant::CallError::CALL_ERROR_INVALID_ARGUMENT, "arrays of different sizes are rejected");
+
+	from = reals_from;
+	to = vectors_to;
+	GDScriptFunctions::call(GDScriptFunctions::MATH_LERP, args, 3, ret, ce);
+	_check(ce.error != Variant::CallError::CALL_OK, "arrays of different types are rejected");
+}
+
+static const char *pool_object_code =
+		"extends Object\n"
+		"var value = 3\n"
+		"var items = []\n"
+		"var position = Vector3()\n"
+		"func _init(p_value = 3):\n"
+		"\tvalue = p_value\n";
+
+static const char *pool_node_code =
+		"extends Node\n"
+		"onready var ready_name = get_name()\n"
+		"var ready_calls = 0\n"
+		"func _ready():\n"
+		"\tready_calls += 1\n";
+
+static void _test_pool_objects() {
+
+	OS::get_singleton()->print("pooled objects:\n");
+
+	Ref<GDScript> script = _compile(pool_object_code);
+	_check(script.is_valid(), "script compiled");
+	if (script.is_null()) {
+		return;
+	}
+
+	Variant::CallError ce;
+	Variant arg = 5;
+	const Variant *args[1] = { &arg };
+
+	Object *first = script->_new_pooled(args, 1, ce);
+	ObjectID id = first->get_instance_id();
+	first->set("value", 9);
+	first->set("position", Vector3(1, 2, 3));
+	script->release_to_pool(first);
+	_check(script->get_pool_count() == 1, "released instance is pooled");
+
+	arg = 7;
+	Object *second = script->_new_pooled(args, 1, ce);
+	_check(second->get_instance_id() == id && script->get_pool_count() == 0, "new_pooled() reuses the released instance");
+	_check(int(second->get("value")) == 7 && Vector3(second->get("position")) == Vector3(), "members are initialized again");
+	memdelete(second);
+
+	// Allocation and registration cost of new() and free() against reusing pooled instances.
+	const int count = 100000;
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Object *obj = script->_new(args, 1, ce);
+		memdelete(obj);
+	}
+	uint64_t new_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		Object *obj = script->_new_pooled(args, 1, ce);
+		script->release_to_pool(obj);
+	}
+	uint64_t pooled_usec = OS::get_singleton()->get_ticks_usec() - from;
+	_check(script->get_pool_count() == 1, "a single instance is reused when released every time");
+	script->clear_pool();
+
+	OS::get_singleton()->print("\tnew()/free(): %.3f usec per instance\n", double(new_usec) / count);
+	OS::get_singleton()->print("\tnew_pooled()/release_to_pool(): %.3f usec per instance\n", double(pooled_usec) / count);
+}
+
+static void _test_pool_nodes() {
+
+	OS::get_singleton()->print("pooled nodes:\n");
+
+	Ref<GDScript> script = _compile(pool_node_code);
+	_check(script.is_valid(), "script compiled");
+	if (script.is_null()) {
+		return;
+	}
+
+	SceneTree *tree = memnew(SceneTree);
+	tree->init();
+	Variant::CallError ce;
+
+	Node *node = Object::cast_to<Node>(script->_new_pooled(NULL, 0, ce));
+	node->set_name("First");
+	tree->get_root()->add_child(node);
+	_check(int(node->get("ready_calls")) == 1 && String(node->get("ready_name")) == "First", "onready members are set on the first use");
+
+	tree->get_root()->remove_child(node);
+	script->release_to_pool(node);
+
+	Node *again = Object::cast_to<Node>(script->_new_pooled(NULL, 0, ce));
+	_check(again == node, "new_pooled() reuses the released node");
+	_check(again->get("ready_name").get_type() == Variant::NIL, "onready members are cleared until the node is ready again");
+
+	again->set_name("Second");
+	tree->get_root()->add_child(again);
+	_check(int(again->get("ready_calls")) == 1 && String(again->get("ready_name")) == "Second", "onready members and _ready() run again on reuse");
+
+	tree->get_root()->remove_child(again);
+	memdelete(again);
+	tree->finish();
+	memdelete(tree);
+}
+
+MainLoop *test(TestType p_type) {
+
+	all_passed = true;
+
+	switch (p_type) {
+		case TEST_PROFILER: {
+			_test_profiler();
+		} break;
+		case TEST_MATH: {
+			_test_math();
+			_test_array_lerp();
+		} break;
+		case TEST_POOL: {
+			_test_pool_objects();
+			_test_pool_nodes();
+		} break;
+	}
+
+	OS::get_singleton()->print("%s\n", all_passed ? "All tests passed." : "Some tests failed.");
+	return NULL;
+}
+} // namespace TestGDScriptRuntime
+
+#else
+
+namespace TestGDScriptRuntime {
+
+MainLoop *test(TestType p_type) {
+
+	return NULL;
+}
+} // namespace TestGDScriptRuntime
+
+#endif
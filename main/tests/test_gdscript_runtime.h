@@ -1,5 +1,5 @@
 /*************************************************************************/
-/*  room.h                                                               */
+/*  test_gdscript_runtime.h                                              */
 /*************************************************************************/
 /*                       This file is part of:                           */
 /*                           GODOT ENGINE                                */
@@ -28,38 +28,20 @@
 /* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
 /*************************************************************************/
 
-#ifndef ROOM_BOUNDS_H
-#define ROOM_BOUNDS_H
+#ifndef TEST_GDSCRIPT_RUNTIME_H
+#define TEST_GDSCRIPT_RUNTIME_H
 
-#include "core/math/bsp_tree.h"
-#include "core/resource.h"
-/**
-	@author Juan Linietsky <reduzio@gmail.com>
-*/
+#include "core/os/main_loop.h"
 
-// FIXME: left for reference but will be removed when portals are reimplemented using Area
-#if 0
+namespace TestGDScriptRuntime {
 
-class RoomBounds : public Resource {
-
-	GDCLASS(RoomBounds, Resource);
-	RES_BASE_EXTENSION("room");
-
-	RID area;
-	PoolVector<Face3> geometry_hint;
-
-protected:
-	static void _bind_methods();
-
-public:
-	virtual RID get_rid() const;
-
-	void set_geometry_hint(const PoolVector<Face3> &p_geometry_hint);
-	PoolVector<Face3> get_geometry_hint() const;
-
-	RoomBounds();
-	~RoomBounds();
+enum TestType {
+	TEST_PROFILER,
+	TEST_MATH,
+	TEST_POOL,
 };
 
-#endif
-#endif // ROOM_H
+MainLoop *test(TestType p_type);
+} // namespace TestGDScriptRuntime
+
+#endif // TEST_GDSCRIPT_RUNTIME_H
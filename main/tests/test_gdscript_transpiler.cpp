@@ -0,0 +1,386 @@
+/*************************************************************************/
+/*  test_gdscript_transpiler.cpp                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_gdscript_transpiler.h"
+
+#include "core/os/os.h"
+
+#if defined(GDSCRIPT_ENABLED) && defined(TOOLS_ENABLED)
+
+#include "modules/gdscript/editor/gdscript_transpiler.h"
+
+// Transpiles a script and compares the generated class with a known good
+// output, which builds against modules/gdnative/include into a library.
+namespace TestGDScriptTranspiler {
+
+static const char *golden_script =
+		"extends Reference\n"
+		"\n"
+		"signal arrived(steps)\n"
+		"\n"
+		"export var speed: float = 4.0\n"
+		"export(int) var max_steps = 10\n"
+		"var position := Vector2()\n"
+		"var target := Vector2(100, 50)\n"
+		"var steps: int = 0 setget set_steps\n"
+		"\n"
+		"func set_steps(value: int) -> void:\n"
+		"\tsteps = int(clamp(value, 0, max_steps))\n"
+		"\n"
+		"func advance(delta: float) -> bool:\n"
+		"\tvar to_target: Vector2 = target - position\n"
+		"\tvar distance: float = to_target.length()\n"
+		"\tif distance <= speed * delta:\n"
+		"\t\tposition = target\n"
+		"\t\temit_signal(\"arrived\", steps)\n"
+		"\t\treturn true\n"
+		"\tposition += to_target / distance * speed * delta\n"
+		"\tself.steps += 1\n"
+		"\treturn false\n"
+		"\n"
+		"func sum_squares(count: int) -> int:\n"
+		"\tvar total := 0\n"
+		"\tfor i in range(count):\n"
+		"\t\tif i % 2 == 0:\n"
+		"\t\t\tcontinue\n"
+		"\t\ttotal += i * i\n"
+		"\treturn total\n"
+		"\n"
+		"func describe(value) -> String:\n"
+		"\tvar text = str(value)\n"
+		"\twhile text.length() < 4:\n"
+		"\t\ttext = \"0\" + text\n"
+		"\treturn text\n";
+
+// Everything after the shared runtime helpers.
+static const char *golden_class =
+		"struct Mover {\n"
+		"\tgodot_object *owner;\n"
+		"\tdouble m_speed;\n"
+		"\tVar m_max_steps;\n"
+		"\tVar m_position;\n"
+		"\tVar m_target;\n"
+		"\tint64_t m_steps;\n"
+		"\n"
+		"\tMover(godot_object *p_owner);\n"
+		"\tVar f_set_steps(int64_t l_value);\n"
+		"\tbool f_advance(double l_delta);\n"
+		"\tint64_t f_sum_squares(int64_t l_count);\n"
+		"\tVar f_describe(Var l_value);\n"
+		"};\n"
+		"\n"
+		"Mover::Mover(godot_object *p_owner) {\n"
+		"\towner = p_owner;\n"
+		"\tm_speed = 0.0;\n"
+		"\tm_steps = 0;\n"
+		"\tm_speed = 4.0;\n"
+		"\tm_max_steps = Var((int64_t)(int64_t(10LL)));\n"
+		"\tm_position = Var::vector2(0.0, 0.0);\n"
+		"\tm_target = Var::vector2(100.0, 50.0);\n"
+		"\tm_steps = int64_t(0LL);\n"
+		"}\n"
+		"\n"
+		"Var Mover::f_set_steps(int64_t l_value) {\n"
+		"\tm_steps = _gd_clamp(Var((int64_t)(l_value)), Var((int64_t)(int64_t(0LL))), m_max_steps).as_int();\n"
+		"\treturn Var();\n"
+		"}\n"
+		"\n"
+		"bool Mover::f_advance(double l_delta) {\n"
+		"\tVar l_to_target = _gd_op(GODOT_VARIANT_OP_SUBTRACT, m_target, m_position);\n"
+		"\tdouble l_distance = _gd_call(l_to_target, \"length\").as_real();\n"
+		"\tif (l_distance <= (m_speed * l_delta)) {\n"
+		"\t\tm_position = m_target;\n"
+		"\t\t_gd_call(Var::object(owner), \"emit_signal\", Var::string(\"arrived\"), Var((int64_t)(m_steps)));\n"
+		"\t\treturn true;\n"
+		"\t}\n"
+		"\tm_position = _gd_op(GODOT_VARIANT_OP_ADD, m_position, _gd_op(GODOT_VARIANT_OP_MULTIPLY, _gd_op(GODOT_VARIANT_OP_MULTIPLY, _gd_op(GODOT_VARIANT_OP_DIVIDE, l_to_target, Var((double)(l_distance))), Var((double)(m_speed))), Var((double)(l_delta))));\n"
+		"\tf_set_steps(m_steps + int64_t(1LL));\n"
+		"\treturn false;\n"
+		"}\n"
+		"\n"
+		"int64_t Mover::f_sum_squares(int64_t l_count) {\n"
+		"\tint64_t l_total = int64_t(0LL);\n"
+		"\t{\n"
+		"\t\tconst int64_t _from0 = 0;\n"
+		"\t\tconst int64_t _to0 = l_count;\n"
+		"\t\tfor (int64_t _i0 = _from0; _i0 < _to0; _i0++) {\n"
+		"\t\t\tint64_t l_i = _i0;\n"
+		"\t\t\tif (_gd_imod(l_i, int64_t(2LL)) == int64_t(0LL)) {\n"
+		"\t\t\t\tcontinue;\n"
+		"\t\t\t}\n"
+		"\t\t\tl_total = l_total + (l_i * l_i);\n"
+		"\t\t}\n"
+		"\t}\n"
+		"\treturn l_total;\n"
+		"}\n"
+		"\n"
+		"Var Mover::f_describe(Var l_value) {\n"
+		"\tVar l_text = _gd_str(l_value);\n"
+		"\twhile (_gd_op(GODOT_VARIANT_OP_LESS, _gd_call(l_text, \"length\"), Var((int64_t)(int64_t(4LL)))).booleanize()) {\n"
+		"\t\tl_text = _gd_op(GODOT_VARIANT_OP_ADD, Var::string(\"0\"), l_text);\n"
+		"\t}\n"
+		"\treturn l_text;\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void *Mover_create(godot_object *p_instance, void *p_method_data) {\n"
+		"\tMover *instance = new Mover(p_instance);\n"
+		"\treturn instance;\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_destroy(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tdelete (Mover *)p_user_data;\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_method_set_steps(godot_object *p_instance, void *p_method_data, void *p_user_data, int p_num_args, godot_variant **p_args) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tif (p_num_args < 1 || p_num_args > 1) {\n"
+		"\t\t_gd_error(\"Invalid number of arguments when calling \\'set_steps\\'.\");\n"
+		"\t\treturn _gd_return(Var());\n"
+		"\t}\n"
+		"\treturn _gd_return(instance->f_set_steps(Var(p_args[0]).as_int()));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_method_advance(godot_object *p_instance, void *p_method_data, void *p_user_data, int p_num_args, godot_variant **p_args) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tif (p_num_args < 1 || p_num_args > 1) {\n"
+		"\t\t_gd_error(\"Invalid number of arguments when calling \\'advance\\'.\");\n"
+		"\t\treturn _gd_return(Var());\n"
+		"\t}\n"
+		"\treturn _gd_return(Var((bool)(instance->f_advance(Var(p_args[0]).as_real()))));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_method_sum_squares(godot_object *p_instance, void *p_method_data, void *p_user_data, int p_num_args, godot_variant **p_args) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tif (p_num_args < 1 || p_num_args > 1) {\n"
+		"\t\t_gd_error(\"Invalid number of arguments when calling \\'sum_squares\\'.\");\n"
+		"\t\treturn _gd_return(Var());\n"
+		"\t}\n"
+		"\treturn _gd_return(Var((int64_t)(instance->f_sum_squares(Var(p_args[0]).as_int()))));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_method_describe(godot_object *p_instance, void *p_method_data, void *p_user_data, int p_num_args, godot_variant **p_args) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tif (p_num_args < 1 || p_num_args > 1) {\n"
+		"\t\t_gd_error(\"Invalid number of arguments when calling \\'describe\\'.\");\n"
+		"\t\treturn _gd_return(Var());\n"
+		"\t}\n"
+		"\treturn _gd_return(instance->f_describe(Var(p_args[0])));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_get_speed(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\treturn _gd_return(Var((double)(instance->m_speed)));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_set_speed(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tinstance->m_speed = Var(p_value).as_real();\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_get_max_steps(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\treturn _gd_return(instance->m_max_steps);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_set_max_steps(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tinstance->m_max_steps = Var(p_value);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_get_position(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\treturn _gd_return(instance->m_position);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_set_position(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tinstance->m_position = Var(p_value);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_get_target(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\treturn _gd_return(instance->m_target);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_set_target(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tinstance->m_target = Var(p_value);\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV godot_variant Mover_get_steps(godot_object *p_instance, void *p_method_data, void *p_user_data) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\treturn _gd_return(Var((int64_t)(instance->m_steps)));\n"
+		"}\n"
+		"\n"
+		"GDCALLINGCONV void Mover_set_steps(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {\n"
+		"\tMover *instance = (Mover *)p_user_data;\n"
+		"\tinstance->f_set_steps(Var(p_value).as_int());\n"
+		"}\n"
+		"\n"
+		"} // namespace\n"
+		"\n"
+		"void godot_transpiled_register_Mover(void *p_handle, const godot_gdnative_core_api_struct *p_api, const godot_gdnative_ext_nativescript_api_struct *p_nativescript_api) {\n"
+		"\tapi = p_api;\n"
+		"\tapi_1_1 = (const godot_gdnative_core_1_1_api_struct *)p_api->next;\n"
+		"\tnativescript_api = p_nativescript_api;\n"
+		"\n"
+		"\tgodot_instance_create_func create = { NULL, NULL, NULL };\n"
+		"\tcreate.create_func = &Mover_create;\n"
+		"\tgodot_instance_destroy_func destroy = { NULL, NULL, NULL };\n"
+		"\tdestroy.destroy_func = &Mover_destroy;\n"
+		"\tnativescript_api->godot_nativescript_register_class(p_handle, \"Mover\", \"Reference\", create, destroy);\n"
+		"\n"
+		"\t_gd_register_method(p_handle, \"Mover\", \"set_steps\", 0, &Mover_method_set_steps);\n"
+		"\t_gd_register_method(p_handle, \"Mover\", \"advance\", 0, &Mover_method_advance);\n"
+		"\t_gd_register_method(p_handle, \"Mover\", \"sum_squares\", 0, &Mover_method_sum_squares);\n"
+		"\t_gd_register_method(p_handle, \"Mover\", \"describe\", 0, &Mover_method_describe);\n"
+		"\t_gd_register_property(p_handle, \"Mover\", \"speed\", 3, 0, \"\", 7, Var((double)(4.0)), &Mover_set_speed, &Mover_get_speed);\n"
+		"\t_gd_register_property(p_handle, \"Mover\", \"max_steps\", 2, 0, \"\", 8199, Var((int64_t)(int64_t(10LL))), &Mover_set_max_steps, &Mover_get_max_steps);\n"
+		"\t_gd_register_property(p_handle, \"Mover\", \"position\", 5, 0, \"\", 8192, Var(), &Mover_set_position, &Mover_get_position);\n"
+		"\t_gd_register_property(p_handle, \"Mover\", \"target\", 5, 0, \"\", 8192, Var(), &Mover_set_target, &Mover_get_target);\n"
+		"\t_gd_register_property(p_handle, \"Mover\", \"steps\", 2, 0, \"\", 8192, Var((int64_t)(int64_t(0LL))), &Mover_set_steps, &Mover_get_steps);\n"
+		"\t{\n"
+		"\t\tconst char *args[] = { \"steps\" };\n"
+		"\t\t_gd_register_signal(p_handle, \"Mover\", \"arrived\", 1, args);\n"
+		"\t}\n"
+		"}\n"
+		"\n"
+		"#ifndef GODOT_TRANSPILED_NO_ENTRY_POINTS\n"
+		"\n"
+		"extern \"C\" void GDN_EXPORT godot_gdnative_init(godot_gdnative_init_options *p_options) {\n"
+		"\tapi = p_options->api_struct;\n"
+		"\tfor (unsigned int i = 0; i < api->num_extensions; i++) {\n"
+		"\t\tif (api->extensions[i]->type == GDNATIVE_EXT_NATIVESCRIPT) {\n"
+		"\t\t\tnativescript_api = (const godot_gdnative_ext_nativescript_api_struct *)api->extensions[i];\n"
+		"\t\t}\n"
+		"\t}\n"
+		"}\n"
+		"\n"
+		"extern \"C\" void GDN_EXPORT godot_gdnative_terminate(godot_gdnative_terminate_options *p_options) {\n"
+		"}\n"
+		"\n"
+		"extern \"C\" void GDN_EXPORT godot_nativescript_init(void *p_handle) {\n"
+		"\tgodot_transpiled_register_Mover(p_handle, api, nativescript_api);\n"
+		"}\n"
+		"\n"
+		"#endif // GODOT_TRANSPILED_NO_ENTRY_POINTS\n";
+
+static const char *unsupported_script =
+		"extends Reference\n"
+		"\n"
+		"func wait():\n"
+		"\tyield()\n";
+
+static bool _test_golden() {
+
+	GDScriptTranspiler transpiler;
+	String code;
+	Error err = transpiler.transpile_source(golden_script, "res://mover.gd", code);
+	if (err != OK) {
+		OS::get_singleton()->print("\tTranspile error at line %i: %s\n", transpiler.get_error_line(), transpiler.get_error().utf8().get_data());
+		return false;
+	}
+
+	int from = code.find("struct Mover {");
+	if (from == -1) {
+		OS::get_singleton()->print("\tNo class found in the output.\n");
+		return false;
+	}
+
+	Vector<String> got = code.substr(from, code.length() - from).split("\n");
+	Vector<String> expected = String(golden_class).split("\n");
+	for (int i = 0; i < MAX(got.size(), expected.size()); i++) {
+		String got_line = i < got.size() ? got[i] : String();
+		String expected_line = i < expected.size() ? expected[i] : String();
+		if (got_line != expected_line) {
+			OS::get_singleton()->print("\tFirst difference at line %i:\n\t\tgot:      %s\n\t\texpected: %s\n", i + 1, got_line.utf8().get_data(), expected_line.utf8().get_data());
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool _test_unsupported() {
+
+	GDScriptTranspiler transpiler;
+	String code;
+	Error err = transpiler.transpile_source(unsupported_script, "res://unsupported.gd", code);
+	return err != OK && transpiler.get_error_line() == 3;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	_test_golden,
+	_test_unsupported,
+	0
+
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+
+	OS::get_singleton()->print("\n\n\n");
+	OS::get_singleton()->print("*************\n");
+	OS::get_singleton()->print("***TOTALS!***\n");
+	OS::get_singleton()->print("*************\n");
+
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+} // namespace TestGDScriptTranspiler
+
+#else
+
+namespace TestGDScriptTranspiler {
+
+MainLoop *test() {
+
+	return NULL;
+}
+} // namespace TestGDScriptTranspiler
+
+#endif
@@ -34,15 +34,27 @@
 #ifdef DEBUG_ENABLED
 
 #include "test_astar.h"
+#include "test_cull.h"
+#include "test_file_access_async.h"
+#include "test_file_access_compressed.h"
 #include "test_gdscript.h"
+#include "test_gdscript_runtime.h"
+#include "test_gdscript_transpiler.h"
 #include "test_gui.h"
 #include "test_math.h"
 #include "test_oa_hash_map.h"
 #include "test_ordered_hash_map.h"
+#include "test_packed_scene.h"
+#include "test_particles.h"
 #include "test_physics.h"
 #include "test_physics_2d.h"
 #include "test_render.h"
+#include "test_resource_format_binary.h"
+#include "test_resource_loader.h"
 #include "test_shader_lang.h"
+#include "test_skeleton.h"
+#include "test_skinning.h"
+#include "test_sort.h"
 #include "test_string.h"
 
 const char **tests_get_names() {
@@ -60,8 +72,22 @@ const char **tests_get_names() {
 		"gd_parser",
 		"gd_compiler",
 		"gd_bytecode",
+		"gd_profiler",
+		"gd_math",
+		"gd_pool",
+		"gd_transpiler",
 		"ordered_hash_map",
 		"astar",
+		"cull",
+		"skeleton",
+		"skinning",
+		"particles",
+		"sort",
+		"packed_scene",
+		"file_access_async",
+		"file_access_compressed",
+		"resource_loader",
+		"resource_format_binary",
 		NULL
 	};
 
@@ -132,6 +158,26 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestGDScript::test(TestGDScript::TEST_BYTECODE);
 	}
 
+	if (p_test == "gd_profiler") {
+
+		return TestGDScriptRuntime::test(TestGDScriptRuntime::TEST_PROFILER);
+	}
+
+	if (p_test == "gd_math") {
+
+		return TestGDScriptRuntime::test(TestGDScriptRuntime::TEST_MATH);
+	}
+
+	if (p_test == "gd_pool") {
+
+		return TestGDScriptRuntime::test(TestGDScriptRuntime::TEST_POOL);
+	}
+
+	if (p_test == "gd_transpiler") {
+
+		return TestGDScriptTranspiler::test();
+	}
+
 	if (p_test == "ordered_hash_map") {
 
 		return TestOrderedHashMap::test();
@@ -142,6 +188,56 @@ MainLoop *test_main(String p_test, const List<String> &p_args) {
 		return TestAStar::test();
 	}
 
+	if (p_test == "cull") {
+
+		return TestCull::test();
+	}
+
+	if (p_test == "skeleton") {
+
+		return TestSkeleton::test();
+	}
+
+	if (p_test == "skinning") {
+
+		return TestSkinning::test();
+	}
+
+	if (p_test == "particles") {
+
+		return TestParticles::test();
+	}
+
+	if (p_test == "sort") {
+
+		return TestSort::test();
+	}
+
+	if (p_test == "packed_scene") {
+
+		return TestPackedScene::test();
+	}
+
+	if (p_test == "file_access_async") {
+
+		return TestFileAccessAsync::test();
+	}
+
+	if (p_test == "file_access_compressed") {
+
+		return TestFileAccessCompressed::test();
+	}
+
+	if (p_test == "resource_loader") {
+
+		return TestResourceLoader::test();
+	}
+
+	if (p_test == "resource_format_binary") {
+
+		return TestResourceFormatBinary::test();
+	}
+
 	print_line("Unknown test: " + p_test);
 	return NULL;
 }
@@ -0,0 +1,149 @@
+/*************************************************************************/
+/*  test_packed_scene.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "test_packed_scene.h"
+
+#include "core/os/os.h"
+#include "scene/main/timer.h"
+#include "scene/resources/packed_scene.h"
+
+// Spawns many copies of a small packed scene, one at a time and in bulk, and
+// checks that properties, groups and connections survive instancing.
+namespace TestPackedScene {
+
+static bool _check_instance(Node *p_node, int p_timers) {
+
+	if (!p_node->is_in_group("enemies") || p_node->get_child_count() != p_timers * 2) {
+		return false;
+	}
+
+	for (int i = 0; i < p_timers; i++) {
+
+		Timer *timer = Object::cast_to<Timer>(p_node->get_child(i * 2));
+		if (!timer || timer->get_wait_time() != 0.5 + i || timer->is_one_shot() != (i % 2 == 0) || timer->get_timer_process_mode() != Timer::TIMER_PROCESS_PHYSICS) {
+			return false;
+		}
+		if (!timer->is_connected("timeout", p_node, "set_process")) {
+			return false;
+		}
+
+		Node *state = p_node->get_child(i * 2 + 1);
+		if (state->get_name() != "State" + itos(i) || state->get_pause_mode() != Node::PAUSE_MODE_PROCESS) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+MainLoop *test() {
+
+	const int timers = 16;
+	const int count = 2000;
+
+	Node *root = memnew(Node);
+	root->set_name("Enemy");
+	root->add_to_group("enemies", true);
+
+	for (int i = 0; i < timers; i++) {
+
+		Timer *timer = memnew(Timer);
+		timer->set_name("Timer" + itos(i));
+		timer->set_wait_time(0.5 + i);
+		timer->set_one_shot(i % 2 == 0);
+		timer->set_autostart(true);
+		timer->set_timer_process_mode(Timer::TIMER_PROCESS_PHYSICS);
+		root->add_child(timer);
+		timer->set_owner(root);
+
+		Vector<Variant> binds;
+		binds.push_back(false);
+		timer->connect("timeout", root, "set_process", binds, Object::CONNECT_PERSIST);
+
+		Node *state = memnew(Node);
+		state->set_name("State" + itos(i));
+		state->set_pause_mode(Node::PAUSE_MODE_PROCESS);
+		root->add_child(state);
+		state->set_owner(root);
+	}
+
+	Ref<PackedScene> scene;
+	scene.instance();
+	Error err = scene->pack(root);
+	memdelete(root);
+
+	if (err != OK) {
+		OS::get_singleton()->print("failed to pack the scene\n");
+		return NULL;
+	}
+
+	// The first instance also resolves the instancing plan.
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	Node *first = scene->instance();
+	uint64_t first_usec = OS::get_singleton()->get_ticks_usec() - from;
+	bool valid = _check_instance(first, timers);
+	memdelete(first);
+
+	Vector<Node *> single;
+	single.resize(count);
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		single.write[i] = scene->instance();
+	}
+	uint64_t single_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	for (int i = 0; i < count; i++) {
+		valid = valid && _check_instance(single[i], timers);
+		memdelete(single[i]);
+	}
+
+	from = OS::get_singleton()->get_ticks_usec();
+	Array many = scene->instance_many(count);
+	uint64_t many_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	valid = valid && many.size() == count;
+	for (int i = 0; i < many.size(); i++) {
+		Node *node = Object::cast_to<Node>(many[i]);
+		valid = valid && node && _check_instance(node, timers);
+		if (node) {
+			memdelete(node);
+		}
+	}
+
+	OS::get_singleton()->print("nodes per instance: %i, instances: %i\n", timers * 2 + 1, count);
+	OS::get_singleton()->print("first instance: %.3f ms\n", first_usec / 1000.0);
+	OS::get_singleton()->print("instance(): %.3f ms, %.2f us per instance\n", single_usec / 1000.0, single_usec / double(count));
+	OS::get_singleton()->print("instance_many(): %.3f ms, %.2f us per instance\n", many_usec / 1000.0, many_usec / double(count));
+	OS::get_singleton()->print("instances valid: %s\n", valid ? "yes" : "no");
+
+	return NULL;
+}
+} // namespace TestPackedScene
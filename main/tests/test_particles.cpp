@@ -0,0 +1,120 @@
+/*************************************************************************/
+/*  test_particles.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_particles.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/project_settings.h"
+#include "scene/3d/cpu_particles.h"
+
+// Steps a large CPUParticles emitter with the simulation running serially and
+// split across worker threads, and checks that both give the same particles.
+namespace TestParticles {
+
+// Runs the steps as pre-process time, which a single process notification
+// goes through, as the node isn't inside a tree to give it a frame delta.
+static uint64_t _simulate(CPUParticles *p_particles, int p_steps) {
+
+	p_particles->set_pre_process_time((p_steps - 1) / 60.0);
+	p_particles->restart();
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	p_particles->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+	return OS::get_singleton()->get_ticks_usec() - from;
+}
+
+// The threading setting is read when the node is created, and the emitter
+// seed comes from Math::rand(), so seed it to get the same particles twice.
+static CPUParticles *_make_particles(int p_amount, bool p_parallel) {
+
+	ProjectSettings::get_singleton()->set("rendering/threads/parallel_cpu_particles", p_parallel);
+	Math::seed(0x5EED);
+
+	CPUParticles *particles = memnew(CPUParticles);
+	particles->set_amount(p_amount);
+	particles->set_fixed_fps(60);
+	particles->set_lifetime(1.5);
+	particles->set_explosiveness_ratio(0.1);
+	particles->set_randomness_ratio(0.5);
+	particles->set_emission_shape(CPUParticles::EMISSION_SHAPE_SPHERE);
+	particles->set_emission_sphere_radius(2.0);
+	particles->set_param(CPUParticles::PARAM_INITIAL_LINEAR_VELOCITY, 4.0);
+	particles->set_param_randomness(CPUParticles::PARAM_INITIAL_LINEAR_VELOCITY, 0.5);
+	particles->set_param(CPUParticles::PARAM_DAMPING, 1.0);
+	particles->set_param(CPUParticles::PARAM_ANGULAR_VELOCITY, 90.0);
+
+	Ref<Curve> scale_curve;
+	scale_curve.instance();
+	scale_curve->add_point(Vector2(0, 0.2));
+	scale_curve->add_point(Vector2(0.3, 1.0));
+	scale_curve->add_point(Vector2(1, 0));
+	particles->set_param_curve(CPUParticles::PARAM_SCALE, scale_curve);
+
+	Ref<Gradient> color_ramp;
+	color_ramp.instance();
+	color_ramp->add_point(0.5, Color(1, 0.5, 0));
+	particles->set_color_ramp(color_ramp);
+
+	return particles;
+}
+
+MainLoop *test() {
+
+	const int amount = 100000;
+	const int steps = 120;
+
+	CPUParticles *serial = _make_particles(amount, false);
+	uint64_t serial_usec = _simulate(serial, steps);
+	PoolVector<float> serial_data = serial->get_particle_data();
+	memdelete(serial);
+
+	CPUParticles *threaded = _make_particles(amount, true);
+	_simulate(threaded, 1); // Starts the worker threads.
+	uint64_t threaded_usec = _simulate(threaded, steps);
+	PoolVector<float> threaded_data = threaded->get_particle_data();
+	memdelete(threaded);
+
+	OS::get_singleton()->print("particles: %i, steps: %i, threads: %i\n", amount, steps, OS::get_singleton()->get_processor_count());
+	OS::get_singleton()->print("serial: %.3f ms per step, %.1f M particles/s\n", serial_usec / 1000.0 / steps, double(amount) * steps / serial_usec);
+	OS::get_singleton()->print("threaded: %.3f ms per step, %.1f M particles/s\n", threaded_usec / 1000.0 / steps, double(amount) * steps / threaded_usec);
+
+	// Colors are packed into the floats as bytes, so compare the bits.
+	bool same = serial_data.size() == threaded_data.size();
+	if (same) {
+		PoolVector<float>::Read s = serial_data.read();
+		PoolVector<float>::Read t = threaded_data.read();
+		same = memcmp(s.ptr(), t.ptr(), serial_data.size() * sizeof(float)) == 0;
+	}
+	OS::get_singleton()->print("serial and threaded particles match: %s\n", same ? "PASS" : "FAILED");
+
+	return NULL;
+}
+} // namespace TestParticles
@@ -0,0 +1,293 @@
+/*************************************************************************/
+/*  test_resource_format_binary.cpp                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_format_binary.h"
+
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/dir_access.h"
+#include "core/os/file_access.h"
+#include "core/os/os.h"
+
+// Saves, loads and renames the dependencies of binary resources, and loads a
+// file written in the previous format version.
+namespace TestResourceFormatBinary {
+
+// Written by the version 3 saver from a resource like the one _make_resource() builds,
+// minus the strings array, the vectors and the external resource.
+static const uint8_t version_3_res[] = {
+	0x52, 0x53, 0x52, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x02, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x52, 0x65, 0x73, 0x6f,
+	0x75, 0x72, 0x63, 0x65, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x72, 0x65, 0x73,
+	0x6f, 0x75, 0x72, 0x63, 0x65, 0x5f, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x5f, 0x74, 0x6f, 0x5f, 0x73,
+	0x63, 0x65, 0x6e, 0x65, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x72, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63,
+	0x65, 0x5f, 0x6e, 0x61, 0x6d, 0x65, 0x00, 0x07, 0x00, 0x00, 0x00, 0x73, 0x63, 0x72, 0x69, 0x70,
+	0x74, 0x00, 0x09, 0x00, 0x00, 0x00, 0x5f, 0x5f, 0x6d, 0x65, 0x74, 0x61, 0x5f, 0x5f, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x6c, 0x6f, 0x63, 0x61, 0x6c,
+	0x3a, 0x2f, 0x2f, 0x31, 0x00, 0xe3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00,
+	0x00, 0x6c, 0x6f, 0x63, 0x61, 0x6c, 0x3a, 0x2f, 0x2f, 0x32, 0x00, 0x1a, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x52, 0x65, 0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x6c, 0x61, 0x62, 0x65, 0x6c, 0x00, 0x05, 0x00,
+	0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x73, 0x75, 0x62, 0x00, 0x09, 0x00, 0x00, 0x00, 0x52, 0x65,
+	0x73, 0x6f, 0x75, 0x72, 0x63, 0x65, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x1a,
+	0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x6c,
+	0x61, 0x62, 0x65, 0x6c, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x6d, 0x61, 0x69,
+	0x6e, 0x00, 0x05, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x73, 0x75, 0x62, 0x00, 0x18, 0x00,
+	0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x05, 0x00,
+	0x00, 0x00, 0x69, 0x6e, 0x74, 0x73, 0x00, 0x20, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x10,
+	0x00, 0x00, 0x00, 0x52, 0x53, 0x52, 0x43,
+};
+
+static String _get_path(const String &p_file) {
+
+	return OS::get_singleton()->get_cache_path().plus_file(p_file);
+}
+
+static Ref<Resource> _make_resource() {
+
+	Ref<Resource> sub;
+	sub.instance();
+	sub->set_meta("label", "sub");
+
+	Ref<Resource> res;
+	res.instance();
+	res->set_meta("label", "main");
+	res->set_meta("sub", sub);
+	res->set_meta("sub_again", sub);
+
+	PoolVector<int> ints;
+	for (int i = 0; i < 5; i++) {
+		ints.push_back(i * i);
+	}
+	res->set_meta("ints", ints);
+
+	// Repeated strings go through the string table.
+	PoolVector<String> strings;
+	strings.push_back("main");
+	strings.push_back(String::utf8("\xc3\xa9t\xc3\xa9"));
+	strings.push_back("");
+	strings.push_back("main");
+	res->set_meta("strings", strings);
+
+	// An odd number of elements, so the next array starts unaligned.
+	PoolVector<Vector3> vectors;
+	for (int i = 0; i < 7; i++) {
+		vectors.push_back(Vector3(i, i * 2, i * 3));
+	}
+	res->set_meta("vectors", vectors);
+
+	PoolVector<uint8_t> bytes;
+	for (int i = 0; i < 13; i++) {
+		bytes.push_back(i * 7);
+	}
+	res->set_meta("bytes", bytes);
+
+	return res;
+}
+
+static bool _check_common(const RES &p_res) {
+
+	if (p_res.is_null() || String(p_res->get_meta("label")) != "main") {
+		return false;
+	}
+
+	RES sub = p_res->get_meta("sub");
+	if (sub.is_null() || String(sub->get_meta("label")) != "sub") {
+		return false;
+	}
+
+	PoolVector<int> ints = p_res->get_meta("ints");
+	if (ints.size() != 5) {
+		return false;
+	}
+	for (int i = 0; i < 5; i++) {
+		if (ints[i] != i * i) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool _check_resource(const RES &p_res) {
+
+	if (!_check_common(p_res)) {
+		return false;
+	}
+
+	if (RES(p_res->get_meta("sub_again")) != RES(p_res->get_meta("sub"))) {
+		return false;
+	}
+
+	PoolVector<String> strings = p_res->get_meta("strings");
+	if (strings.size() != 4 || strings[0] != "main" || strings[1] != String::utf8("\xc3\xa9t\xc3\xa9") || strings[2] != "" || strings[3] != "main") {
+		return false;
+	}
+
+	PoolVector<Vector3> vectors = p_res->get_meta("vectors");
+	if (vectors.size() != 7) {
+		return false;
+	}
+	for (int i = 0; i < 7; i++) {
+		if (vectors[i] != Vector3(i, i * 2, i * 3)) {
+			return false;
+		}
+	}
+
+	PoolVector<uint8_t> bytes = p_res->get_meta("bytes");
+	if (bytes.size() != 13) {
+		return false;
+	}
+	for (int i = 0; i < 13; i++) {
+		if (bytes[i] != i * 7) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool _test_round_trip() {
+
+	String path = _get_path("test_binary.res");
+	if (ResourceSaver::save(path, _make_resource()) != OK) {
+		return false;
+	}
+
+	return _check_resource(ResourceLoader::load(path, "", true));
+}
+
+static bool _test_round_trip_compressed() {
+
+	String path = _get_path("test_binary_compressed.res");
+	if (ResourceSaver::save(path, _make_resource(), ResourceSaver::FLAG_COMPRESS) != OK) {
+		return false;
+	}
+
+	return _check_resource(ResourceLoader::load(path, "", true));
+}
+
+static bool _test_version_3() {
+
+	String path = _get_path("test_binary_version_3.res");
+	FileAccess *f = FileAccess::open(path, FileAccess::WRITE);
+	if (!f) {
+		return false;
+	}
+	f->store_buffer(version_3_res, sizeof(version_3_res));
+	memdelete(f);
+
+	return _check_common(ResourceLoader::load(path, "", true));
+}
+
+// The new path is 15 characters longer, so everything after it has to be moved
+// by an amount that isn't a multiple of the data alignment.
+static bool _test_rename_dependencies() {
+
+	String ext_path = _get_path("test_binary_ext.res");
+	String renamed_path = _get_path("test_binary_ext_renamed_longer.res");
+	String path = _get_path("test_binary_deps.res");
+
+	{
+		Ref<Resource> ext;
+		ext.instance();
+		ext->set_meta("label", "external");
+		if (ResourceSaver::save(ext_path, ext) != OK) {
+			return false;
+		}
+
+		ext = ResourceLoader::load(ext_path);
+		Ref<Resource> res = _make_resource();
+		res->set_meta("ext", ext);
+		if (ResourceSaver::save(path, res) != OK) {
+			return false;
+		}
+	}
+
+	DirAccess *da = DirAccess::create(DirAccess::ACCESS_FILESYSTEM);
+	Error err = da->copy(ext_path, renamed_path);
+	memdelete(da);
+	if (err != OK) {
+		return false;
+	}
+
+	Map<String, String> map;
+	map[ext_path] = renamed_path;
+	if (ResourceLoader::rename_dependencies(path, map) != OK) {
+		return false;
+	}
+
+	RES res = ResourceLoader::load(path, "", true);
+	if (!_check_resource(res)) {
+		return false;
+	}
+
+	RES ext = res->get_meta("ext");
+	return ext.is_valid() && ext->get_path() == renamed_path && String(ext->get_meta("label")) == "external";
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	_test_round_trip,
+	_test_round_trip_compressed,
+	_test_version_3,
+	_test_rename_dependencies,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	return NULL;
+}
+} // namespace TestResourceFormatBinary
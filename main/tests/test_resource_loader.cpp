@@ -0,0 +1,209 @@
+/*************************************************************************/
+/*  test_resource_loader.cpp                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_resource_loader.h"
+
+#include "core/io/resource_loader.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+
+// Threaded loading against a loader that builds resources from a
+// dependency table instead of files, and counts how often each is loaded.
+namespace TestResourceLoader {
+
+class TableLoader : public ResourceFormatLoader {
+
+	Mutex *mutex;
+	HashMap<String, int> load_counts;
+
+public:
+	HashMap<String, Vector<String> > dependencies;
+
+	virtual RES load(const String &p_path, const String &p_original_path = "", Error *r_error = NULL) {
+
+		mutex->lock();
+		load_counts[p_path] = get_load_count(p_path) + 1;
+		mutex->unlock();
+
+		// Slow enough for other requests to find the load in progress.
+		OS::get_singleton()->delay_usec(20000);
+
+		// Keep the dependencies referenced, as sub-resources would be.
+		Array loaded;
+		Vector<String> deps = dependencies.has(p_path) ? dependencies[p_path] : Vector<String>();
+		for (int i = 0; i < deps.size(); i++) {
+			RES dependency = ResourceLoader::load(deps[i]);
+			if (dependency.is_null()) {
+				if (r_error) {
+					*r_error = ERR_FILE_MISSING_DEPENDENCIES;
+				}
+				return RES();
+			}
+			loaded.push_back(dependency);
+		}
+
+		if (r_error) {
+			*r_error = OK;
+		}
+		Ref<Resource> res;
+		res.instance();
+		res->set_meta("dependencies", loaded);
+		return res;
+	}
+
+	virtual void get_recognized_extensions(List<String> *p_extensions) const {
+
+		p_extensions->push_back("table");
+	}
+
+	virtual bool handles_type(const String &p_type) const {
+
+		return p_type == "Resource";
+	}
+
+	virtual String get_resource_type(const String &p_path) const {
+
+		return p_path.get_extension() == "table" ? "Resource" : "";
+	}
+
+	virtual void get_dependencies(const String &p_path, List<String> *p_dependencies, bool p_add_types = false) {
+
+		if (dependencies.has(p_path)) {
+			for (int i = 0; i < dependencies[p_path].size(); i++) {
+				p_dependencies->push_back(dependencies[p_path][i]);
+			}
+		}
+	}
+
+	int get_load_count(const String &p_path) const {
+
+		return load_counts.has(p_path) ? load_counts[p_path] : 0;
+	}
+
+	TableLoader() {
+
+		mutex = Mutex::create();
+	}
+
+	~TableLoader() {
+
+		memdelete(mutex);
+	}
+};
+
+static Ref<TableLoader> loader;
+
+// Two requests and a plain load() of the same path get one resource, loaded once.
+static bool _test_shared_request() {
+
+	String path = "res://shared.table";
+	ResourceLoader::load_threaded_request(path);
+	ResourceLoader::load_threaded_request(path);
+
+	RES loaded = ResourceLoader::load(path);
+	RES first = ResourceLoader::load_threaded_get(path);
+	RES second = ResourceLoader::load_threaded_get(path);
+
+	bool pass = loaded.is_valid() && first == loaded && second == loaded;
+	pass = pass && loader->get_load_count(path) == 1;
+	pass = pass && ResourceLoader::load_threaded_get_status(path) == ResourceLoader::THREAD_LOAD_INVALID_RESOURCE;
+	return pass;
+}
+
+// Dependencies shared by two branches load once, before the resource that needs them.
+static bool _test_sub_threads() {
+
+	loader->dependencies["res://level.table"].push_back("res://left.table");
+	loader->dependencies["res://level.table"].push_back("res://right.table");
+	loader->dependencies["res://left.table"].push_back("res://common.table");
+	loader->dependencies["res://right.table"].push_back("res://common.table");
+
+	ResourceLoader::load_threaded_request("res://level.table", "", true);
+	Error err;
+	RES level = ResourceLoader::load_threaded_get("res://level.table", &err);
+
+	bool pass = level.is_valid() && err == OK;
+	pass = pass && loader->get_load_count("res://level.table") == 1;
+	pass = pass && loader->get_load_count("res://left.table") == 1;
+	pass = pass && loader->get_load_count("res://right.table") == 1;
+	pass = pass && loader->get_load_count("res://common.table") == 1;
+	return pass;
+}
+
+// A cycle fails the load instead of waiting forever.
+static bool _test_cycle() {
+
+	loader->dependencies["res://cycle_a.table"].push_back("res://cycle_b.table");
+	loader->dependencies["res://cycle_b.table"].push_back("res://cycle_a.table");
+
+	ResourceLoader::load_threaded_request("res://cycle_a.table", "", true);
+	Error err;
+	RES res = ResourceLoader::load_threaded_get("res://cycle_a.table", &err);
+
+	return res.is_null() && err != OK;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	_test_shared_request,
+	_test_sub_threads,
+	_test_cycle,
+	NULL
+};
+
+MainLoop *test() {
+
+	loader.instance();
+	ResourceLoader::add_resource_format_loader(loader, true);
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+
+	ResourceLoader::remove_resource_format_loader(loader);
+	loader.unref();
+
+	return NULL;
+}
+} // namespace TestResourceLoader
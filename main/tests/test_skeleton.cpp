@@ -0,0 +1,126 @@
+/*************************************************************************/
+/*  test_skeleton.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_skeleton.h"
+
+#include "core/message_queue.h"
+#include "core/os/os.h"
+#include "scene/3d/skeleton.h"
+
+namespace TestSkeleton {
+
+static bool _is_equal_approx(const Transform &p_a, const Transform &p_b) {
+
+	for (int i = 0; i < 3; i++) {
+		for (int j = 0; j < 3; j++) {
+			if (!Math::is_equal_approx(p_a.basis[i][j], p_b.basis[i][j]))
+				return false;
+		}
+		if (!Math::is_equal_approx(p_a.origin[i], p_b.origin[i]))
+			return false;
+	}
+	return true;
+}
+
+static Skeleton *_make_skeleton() {
+
+	Skeleton *skeleton = memnew(Skeleton);
+	skeleton->add_bone("root");
+	skeleton->add_bone("arm");
+	skeleton->set_bone_parent(1, 0);
+	skeleton->set_bone_rest(0, Transform(Basis(), Vector3(0, 1, 0)));
+	skeleton->set_bone_rest(1, Transform(Basis(Vector3(0, 0, 1), Math_PI * 0.5), Vector3(0, 2, 0)));
+	skeleton->set_bone_custom_pose(0, Transform(Basis(), Vector3(3, 0, 0)));
+	MessageQueue::get_singleton()->flush();
+	return skeleton;
+}
+
+// A node bound to a bone that doesn't move afterwards must still get the bone transform.
+static bool _test_bind_static_bone() {
+
+	Skeleton *skeleton = _make_skeleton();
+	Spatial *attached = memnew(Spatial);
+	skeleton->add_child(attached);
+
+	skeleton->bind_child_node_to_bone(1, attached);
+	MessageQueue::get_singleton()->flush();
+
+	bool pass = _is_equal_approx(attached->get_transform(), skeleton->get_bone_global_pose(1));
+	memdelete(skeleton);
+	return pass;
+}
+
+// Only the moved branch is updated, but bound nodes below it follow along.
+static bool _test_bound_child_follows_parent() {
+
+	Skeleton *skeleton = _make_skeleton();
+	Spatial *attached = memnew(Spatial);
+	skeleton->add_child(attached);
+	skeleton->bind_child_node_to_bone(1, attached);
+	MessageQueue::get_singleton()->flush();
+
+	skeleton->set_bone_custom_pose(0, Transform(Basis(), Vector3(-5, 0, 0)));
+	MessageQueue::get_singleton()->flush();
+
+	bool pass = _is_equal_approx(attached->get_transform(), skeleton->get_bone_global_pose(1));
+	pass = pass && _is_equal_approx(attached->get_transform(), Transform(Basis(Vector3(0, 0, 1), Math_PI * 0.5), Vector3(-5, 3, 0)));
+	memdelete(skeleton);
+	return pass;
+}
+
+typedef bool (*TestFunc)(void);
+
+TestFunc test_funcs[] = {
+
+	_test_bind_static_bone,
+	_test_bound_child_follows_parent,
+	NULL
+};
+
+MainLoop *test() {
+
+	int count = 0;
+	int passed = 0;
+
+	while (true) {
+		if (!test_funcs[count])
+			break;
+		bool pass = test_funcs[count]();
+		if (pass)
+			passed++;
+		OS::get_singleton()->print("\t%s\n", pass ? "PASS" : "FAILED");
+
+		count++;
+	}
+	OS::get_singleton()->print("\n");
+	OS::get_singleton()->print("Passed %i of %i tests\n", passed, count);
+	return NULL;
+}
+} // namespace TestSkeleton
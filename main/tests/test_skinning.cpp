@@ -0,0 +1,186 @@
+/*************************************************************************/
+/*  test_skinning.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_skinning.h"
+
+#include "core/math/transform.h"
+#include "core/os/os.h"
+#include "servers/visual/software_skinning.h"
+
+// Runs the CPU skinning kernels over a crowd sized vertex buffer, serially and
+// on the worker threads, without needing a rendering context.
+namespace TestSkinning {
+
+struct Vertex {
+	uint16_t bones[4];
+	float weights[4];
+};
+
+static void _store_bone(const Transform &p_transform, float *r_bone) {
+
+	for (int i = 0; i < 3; i++) {
+		r_bone[i * 4 + 0] = p_transform.basis[i][0];
+		r_bone[i * 4 + 1] = p_transform.basis[i][1];
+		r_bone[i * 4 + 2] = p_transform.basis[i][2];
+		r_bone[i * 4 + 3] = p_transform.origin[i];
+	}
+}
+
+static float _max_difference(const Vector<float> &p_a, const Vector<float> &p_b) {
+
+	float diff = 0;
+	for (int i = 0; i < p_a.size(); i++) {
+		diff = MAX(diff, Math::abs(p_a[i] - p_b[i]));
+	}
+	return diff;
+}
+
+MainLoop *test() {
+
+	const int characters = 300;
+	const int vertices_per_character = 4000;
+	const int bone_count = 64;
+	const int vertex_count = characters * vertices_per_character;
+
+	Vector<float> bones;
+	bones.resize(bone_count * 12);
+	for (int i = 0; i < bone_count; i++) {
+		Basis basis(Vector3(Math::random(-1.0, 1.0), Math::random(-1.0, 1.0), Math::random(-1.0, 1.0)).normalized(), Math::random(-Math_PI, Math_PI));
+		_store_bone(Transform(basis, Vector3(Math::random(-2.0, 2.0), Math::random(-2.0, 2.0), Math::random(-2.0, 2.0))), &bones.write[i * 12]);
+	}
+
+	// Every 8th vertex follows a single bone, the rest up to four.
+	Vector<Vertex> vertices;
+	vertices.resize(vertex_count);
+	for (int i = 0; i < vertex_count; i++) {
+		Vertex &v = vertices.write[i];
+		float total = 0;
+		for (int j = 0; j < 4; j++) {
+			v.bones[j] = Math::rand() % bone_count;
+			v.weights[j] = (i % 8 == 0 && j > 0) ? 0 : Math::random(0.1, 1.0);
+			total += v.weights[j];
+		}
+		for (int j = 0; j < 4; j++) {
+			v.weights[j] /= total;
+		}
+	}
+
+	Vector<float> serial;
+	Vector<float> threaded;
+	Vector<float> dual_quaternion;
+	serial.resize(vertex_count * 12);
+	threaded.resize(vertex_count * 12);
+	dual_quaternion.resize(vertex_count * 12);
+
+	SoftwareSkinning::SkinJob job;
+	job.bones = bones.ptr();
+	job.bone_count = bone_count;
+	job.vertex_data = (const uint8_t *)vertices.ptr();
+	job.vertex_count = vertex_count;
+	job.bones_offset = offsetof(Vertex, bones);
+	job.bones_stride = sizeof(Vertex);
+	job.bones_16_bits = true;
+	job.weights_offset = offsetof(Vertex, weights);
+	job.weights_stride = sizeof(Vertex);
+	job.weights_float = true;
+
+	SoftwareSkinning single(0);
+	SoftwareSkinning pool(CLAMP(OS::get_singleton()->get_processor_count() - 1, 0, 7));
+
+	job.result = serial.ptrw();
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	single.skin(job, SoftwareSkinning::MODE_LINEAR);
+	uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	job.result = threaded.ptrw();
+	from = OS::get_singleton()->get_ticks_usec();
+	pool.skin(job, SoftwareSkinning::MODE_LINEAR);
+	uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	job.result = dual_quaternion.ptrw();
+	from = OS::get_singleton()->get_ticks_usec();
+	pool.skin(job, SoftwareSkinning::MODE_DUAL_QUATERNION);
+	uint64_t dual_quaternion_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	// With a single influence both methods must give back the bone itself.
+	float single_bone_diff = 0;
+	for (int i = 0; i < vertex_count; i += 8) {
+		for (int j = 0; j < 12; j++) {
+			single_bone_diff = MAX(single_bone_diff, Math::abs(dual_quaternion[i * 12 + j] - serial[i * 12 + j]));
+		}
+	}
+
+	OS::get_singleton()->print("vertices: %i, bones: %i, threads: %i\n", vertex_count, bone_count, pool.get_thread_count());
+	OS::get_singleton()->print("linear skinning: %.3f ms serial, %.3f ms threaded\n", serial_usec / 1000.0, threaded_usec / 1000.0);
+	OS::get_singleton()->print("dual quaternion skinning: %.3f ms threaded\n", dual_quaternion_usec / 1000.0);
+	OS::get_singleton()->print("threaded difference: %f, single bone difference: %f\n", _max_difference(serial, threaded), single_bone_diff);
+
+	// Two relative blend shapes over the positions and normals of the same crowd.
+	const int float_count = vertex_count * 6;
+	Vector<float> base;
+	Vector<float> shapes[2];
+	base.resize(float_count);
+	shapes[0].resize(float_count);
+	shapes[1].resize(float_count);
+	for (int i = 0; i < float_count; i++) {
+		base.write[i] = Math::random(-1.0, 1.0);
+		shapes[0].write[i] = Math::random(-0.1, 0.1);
+		shapes[1].write[i] = Math::random(-0.1, 0.1);
+	}
+
+	const float *shape_ptrs[2] = { shapes[0].ptr(), shapes[1].ptr() };
+	const float weights[2] = { 0.25, 0.5 };
+
+	Vector<float> blended;
+	blended.resize(float_count);
+
+	SoftwareSkinning::BlendShapeJob blend;
+	blend.base = base.ptr();
+	blend.shapes = shape_ptrs;
+	blend.weights = weights;
+	blend.shape_count = 2;
+	blend.float_count = float_count;
+	blend.relative = true;
+	blend.result = blended.ptrw();
+
+	from = OS::get_singleton()->get_ticks_usec();
+	pool.blend(blend);
+	uint64_t blend_usec = OS::get_singleton()->get_ticks_usec() - from;
+
+	float blend_diff = 0;
+	for (int i = 0; i < float_count; i++) {
+		blend_diff = MAX(blend_diff, Math::abs(blended[i] - (base[i] + shapes[0][i] * weights[0] + shapes[1][i] * weights[1])));
+	}
+
+	OS::get_singleton()->print("blend shapes: %.3f ms threaded, difference: %f\n", blend_usec / 1000.0, blend_diff);
+
+	return NULL;
+}
+} // namespace TestSkinning
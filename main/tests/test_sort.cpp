@@ -0,0 +1,159 @@
+/*************************************************************************/
+/*  test_sort.cpp                                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "test_sort.h"
+
+#include "core/math/math_funcs.h"
+#include "core/os/os.h"
+#include "core/radix_sort.h"
+#include "core/sort_array.h"
+#include "core/vector.h"
+
+// Sorts a render list sized array of elements by a 64 bits key, the way the
+// GLES3 renderer does every frame, with SortArray and with RadixSort.
+namespace TestSort {
+
+struct Element {
+	uint64_t sort_key;
+	float depth;
+};
+
+struct SortByKey {
+	_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
+		return A->sort_key < B->sort_key;
+	}
+};
+
+struct KeyBySortKey {
+	_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+		return A->sort_key;
+	}
+};
+
+struct SortByDepth {
+	_FORCE_INLINE_ bool operator()(const Element *A, const Element *B) const {
+		return A->depth < B->depth;
+	}
+};
+
+struct KeyByDepth {
+	_FORCE_INLINE_ uint64_t operator()(const Element *A) const {
+		return RadixSort<const Element *, KeyByDepth>::float_key(A->depth);
+	}
+};
+
+static void _reset(Vector<const Element *> &r_list, const Vector<Element> &p_elements) {
+
+	for (int i = 0; i < p_elements.size(); i++) {
+		r_list.write[i] = &p_elements[i];
+	}
+}
+
+template <class C>
+static bool _is_sorted(const Vector<const Element *> &p_list) {
+
+	C compare;
+	for (int i = 1; i < p_list.size(); i++) {
+		if (compare(p_list[i], p_list[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+MainLoop *test() {
+
+	const int element_count = 20000;
+	const int frames = 50;
+
+	// Keys laid out like the GLES3 ones: priority, shading flags, material
+	// and geometry indices.
+	Vector<Element> elements;
+	elements.resize(element_count);
+	for (int i = 0; i < element_count; i++) {
+		uint64_t material = Math::rand() % 200;
+		uint64_t geometry = Math::rand() % 3000;
+		uint64_t flags = Math::rand() % 4;
+		elements.write[i].sort_key = (uint64_t(128) << 56) | (flags << 44) | (material << 28) | (geometry << 8) | (Math::rand() % 4);
+		elements.write[i].depth = Math::random(-100.0, 100.0);
+	}
+
+	Vector<const Element *> list;
+	list.resize(element_count);
+
+	uint64_t from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		_reset(list, elements);
+		SortArray<const Element *, SortByKey> sorter;
+		sorter.sort(list.ptrw(), element_count);
+	}
+	uint64_t sort_array_usec = OS::get_singleton()->get_ticks_usec() - from;
+	bool sort_array_ok = _is_sorted<SortByKey>(list);
+
+	// Every frame uses a fresh sorter, so the previous order is never reused.
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		_reset(list, elements);
+		RadixSort<const Element *, KeyBySortKey> sorter;
+		sorter.sort(list.ptrw(), element_count);
+	}
+	uint64_t radix_usec = OS::get_singleton()->get_ticks_usec() - from;
+	bool radix_ok = _is_sorted<SortByKey>(list);
+
+	// A persistent sorter over an unchanged list, as for a static scene.
+	RadixSort<const Element *, KeyBySortKey> persistent;
+	from = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < frames; i++) {
+		_reset(list, elements);
+		persistent.sort(list.ptrw(), element_count);
+	}
+	uint64_t persistent_usec = OS::get_singleton()->get_ticks_usec() - from;
+	bool persistent_ok = _is_sorted<SortByKey>(list);
+
+	// Moving one element to the back of the list forces a full sort again.
+	elements.write[element_count / 2].sort_key = ~uint64_t(0);
+	_reset(list, elements);
+	persistent.sort(list.ptrw(), element_count);
+	persistent_ok = persistent_ok && _is_sorted<SortByKey>(list) && list[element_count - 1] == &elements[element_count / 2];
+
+	_reset(list, elements);
+	RadixSort<const Element *, KeyByDepth> depth_sorter;
+	depth_sorter.sort(list.ptrw(), element_count);
+	bool depth_ok = _is_sorted<SortByDepth>(list);
+
+	OS::get_singleton()->print("elements: %i, frames: %i\n", element_count, frames);
+	OS::get_singleton()->print("SortArray: %.3f ms per frame (%s)\n", sort_array_usec / 1000.0 / frames, sort_array_ok ? "sorted" : "NOT SORTED");
+	OS::get_singleton()->print("RadixSort: %.3f ms per frame (%s)\n", radix_usec / 1000.0 / frames, radix_ok ? "sorted" : "NOT SORTED");
+	OS::get_singleton()->print("RadixSort, previous order reused: %.3f ms per frame (%s)\n", persistent_usec / 1000.0 / frames, persistent_ok ? "sorted" : "NOT SORTED");
+	OS::get_singleton()->print("RadixSort by depth: %s\n", depth_ok ? "sorted" : "NOT SORTED");
+
+	return NULL;
+}
+} // namespace TestSort
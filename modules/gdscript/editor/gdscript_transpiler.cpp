@@ -0,0 +1,2266 @@
+/*************************************************************************/
+/*  gdscript_transpiler.cpp                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_transpiler.h"
+
+#include "../gdscript.h"
+#include "core/class_db.h"
+#include "core/engine.h"
+#include "core/os/file_access.h"
+#include "core/project_settings.h"
+
+// Support code emitted into every generated file, inside its anonymous
+// namespace. It wraps godot_variant in a small RAII class and provides the
+// Variant fallbacks (operators, calls, indexing, iteration) used for values
+// whose type isn't known at translation time.
+static const char *_runtime[] = {
+	"inline void _gd_error(const char *p_error) {",
+	"\tapi->godot_print_error(p_error, \"\", script_path, 0);",
+	"}",
+	"",
+	"class Var {",
+	"public:",
+	"\tgodot_variant v;",
+	"",
+	"\tVar() { api->godot_variant_new_nil(&v); }",
+	"\tVar(const Var &p_other) { api->godot_variant_new_copy(&v, &p_other.v); }",
+	"\tVar(const godot_variant *p_variant) { api->godot_variant_new_copy(&v, p_variant); }",
+	"\tVar(bool p_value) { api->godot_variant_new_bool(&v, p_value); }",
+	"\tVar(int64_t p_value) { api->godot_variant_new_int(&v, p_value); }",
+	"\tVar(double p_value) { api->godot_variant_new_real(&v, p_value); }",
+	"\t~Var() { api->godot_variant_destroy(&v); }",
+	"",
+	"\tVar &operator=(const Var &p_other) {",
+	"\t\tif (this != &p_other) {",
+	"\t\t\tapi->godot_variant_destroy(&v);",
+	"\t\t\tapi->godot_variant_new_copy(&v, &p_other.v);",
+	"\t\t}",
+	"\t\treturn *this;",
+	"\t}",
+	"",
+	"\tstatic Var adopt(godot_variant p_variant) {",
+	"\t\tVar r;",
+	"\t\tapi->godot_variant_destroy(&r.v);",
+	"\t\tr.v = p_variant;",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var object(godot_object *p_object) {",
+	"\t\tVar r;",
+	"\t\tif (p_object) {",
+	"\t\t\tapi->godot_variant_new_object(&r.v, p_object);",
+	"\t\t}",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var string(const char *p_utf8) {",
+	"\t\tVar r;",
+	"\t\tgodot_string s = api->godot_string_chars_to_utf8(p_utf8);",
+	"\t\tapi->godot_variant_new_string(&r.v, &s);",
+	"\t\tapi->godot_string_destroy(&s);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var node_path(const char *p_utf8) {",
+	"\t\tVar r;",
+	"\t\tgodot_string s = api->godot_string_chars_to_utf8(p_utf8);",
+	"\t\tgodot_node_path np;",
+	"\t\tapi->godot_node_path_new(&np, &s);",
+	"\t\tapi->godot_variant_new_node_path(&r.v, &np);",
+	"\t\tapi->godot_node_path_destroy(&np);",
+	"\t\tapi->godot_string_destroy(&s);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var vector2(double p_x, double p_y) {",
+	"\t\tVar r;",
+	"\t\tgodot_vector2 vec;",
+	"\t\tapi->godot_vector2_new(&vec, p_x, p_y);",
+	"\t\tapi->godot_variant_new_vector2(&r.v, &vec);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var vector3(double p_x, double p_y, double p_z) {",
+	"\t\tVar r;",
+	"\t\tgodot_vector3 vec;",
+	"\t\tapi->godot_vector3_new(&vec, p_x, p_y, p_z);",
+	"\t\tapi->godot_variant_new_vector3(&r.v, &vec);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var color(double p_r, double p_g, double p_b, double p_a) {",
+	"\t\tVar r;",
+	"\t\tgodot_color col;",
+	"\t\tapi->godot_color_new_rgba(&col, p_r, p_g, p_b, p_a);",
+	"\t\tapi->godot_variant_new_color(&r.v, &col);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var array() {",
+	"\t\tVar r;",
+	"\t\tgodot_array arr;",
+	"\t\tapi->godot_array_new(&arr);",
+	"\t\tapi->godot_variant_new_array(&r.v, &arr);",
+	"\t\tapi->godot_array_destroy(&arr);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tstatic Var dictionary() {",
+	"\t\tVar r;",
+	"\t\tgodot_dictionary dict;",
+	"\t\tapi->godot_dictionary_new(&dict);",
+	"\t\tapi->godot_variant_new_dictionary(&r.v, &dict);",
+	"\t\tapi->godot_dictionary_destroy(&dict);",
+	"\t\treturn r;",
+	"\t}",
+	"",
+	"\tgodot_variant_type get_type() const { return api->godot_variant_get_type(&v); }",
+	"\tint64_t as_int() const { return api->godot_variant_as_int(&v); }",
+	"\tdouble as_real() const { return api->godot_variant_as_real(&v); }",
+	"\tbool booleanize() const { return api->godot_variant_booleanize(&v); }",
+	"};",
+	"",
+	"inline godot_variant _gd_return(const Var &p_value) {",
+	"\tgodot_variant r;",
+	"\tapi->godot_variant_new_copy(&r, &p_value.v);",
+	"\treturn r;",
+	"}",
+	"",
+	"inline Var _gd_op(godot_variant_operator p_op, const Var &p_a, const Var &p_b) {",
+	"\tVar r;",
+	"\tgodot_bool valid = true;",
+	"\tapi_1_1->godot_variant_evaluate(p_op, &p_a.v, &p_b.v, &r.v, &valid);",
+	"\tif (!valid) {",
+	"\t\tgodot_string name = api_1_1->godot_variant_get_operator_name(p_op);",
+	"\t\tgodot_char_string utf8 = api->godot_string_utf8(&name);",
+	"\t\tchar msg[256];",
+	"\t\tsnprintf(msg, sizeof(msg), \"Invalid operands for operator '%s'.\", api->godot_char_string_get_data(&utf8));",
+	"\t\tapi->godot_char_string_destroy(&utf8);",
+	"\t\tapi->godot_string_destroy(&name);",
+	"\t\t_gd_error(msg);",
+	"\t}",
+	"\treturn r;",
+	"}",
+	"",
+	"inline Var _gd_callv(const Var &p_base, const char *p_method, const godot_variant **p_args, int p_argc) {",
+	"\tgodot_string method = api->godot_string_chars_to_utf8(p_method);",
+	"\tgodot_variant_call_error error;",
+	"\tVar r = Var::adopt(api->godot_variant_call(const_cast<godot_variant *>(&p_base.v), &method, p_args, p_argc, &error));",
+	"\tapi->godot_string_destroy(&method);",
+	"\tif (error.error != GODOT_CALL_ERROR_CALL_OK) {",
+	"\t\tchar msg[256];",
+	"\t\tsnprintf(msg, sizeof(msg), \"Invalid call to method '%s'.\", p_method);",
+	"\t\t_gd_error(msg);",
+	"\t}",
+	"\treturn r;",
+	"}",
+	"",
+	"inline Var _gd_call(const Var &p_base, const char *p_method) {",
+	"\treturn _gd_callv(p_base, p_method, NULL, 0);",
+	"}",
+	"",
+	"template <class... Args>",
+	"inline Var _gd_call(const Var &p_base, const char *p_method, const Args &... p_args) {",
+	"\tconst godot_variant *args[] = { &p_args.v... };",
+	"\treturn _gd_callv(p_base, p_method, args, sizeof...(Args));",
+	"}",
+	"",
+	"inline Var _gd_singleton(const char *p_name) {",
+	"\treturn Var::object(api->godot_global_get_singleton(const_cast<char *>(p_name)));",
+	"}",
+	"",
+	"inline Var _gd_new(const char *p_class) {",
+	"\tgodot_class_constructor constructor = api->godot_get_class_constructor(p_class);",
+	"\tif (!constructor) {",
+	"\t\t_gd_error(\"Class can't be instanced.\");",
+	"\t\treturn Var();",
+	"\t}",
+	"\treturn Var::object(constructor());",
+	"}",
+	"",
+	"inline bool _gd_is_class(const Var &p_value, const char *p_class) {",
+	"\tif (p_value.get_type() != GODOT_VARIANT_TYPE_OBJECT || !api->godot_variant_as_object(&p_value.v)) {",
+	"\t\treturn false;",
+	"\t}",
+	"\treturn _gd_call(p_value, \"is_class\", Var::string(p_class)).booleanize();",
+	"}",
+	"",
+	"inline Var _gd_get_named(const Var &p_base, const char *p_name) {",
+	"\tswitch (p_base.get_type()) {",
+	"\t\tcase GODOT_VARIANT_TYPE_OBJECT: return _gd_call(p_base, \"get\", Var::string(p_name));",
+	"\t\tcase GODOT_VARIANT_TYPE_DICTIONARY: return _gd_call(p_base, \"get\", Var::string(p_name));",
+	"\t\tcase GODOT_VARIANT_TYPE_VECTOR2: {",
+	"\t\t\tgodot_vector2 vec = api->godot_variant_as_vector2(&p_base.v);",
+	"\t\t\tif (p_name[0] == 'x' && !p_name[1]) return Var((double)api->godot_vector2_get_x(&vec));",
+	"\t\t\tif (p_name[0] == 'y' && !p_name[1]) return Var((double)api->godot_vector2_get_y(&vec));",
+	"\t\t} break;",
+	"\t\tcase GODOT_VARIANT_TYPE_VECTOR3: {",
+	"\t\t\tgodot_vector3 vec = api->godot_variant_as_vector3(&p_base.v);",
+	"\t\t\tif (p_name[0] >= 'x' && p_name[0] <= 'z' && !p_name[1]) return Var((double)api->godot_vector3_get_axis(&vec, (godot_vector3_axis)(p_name[0] - 'x')));",
+	"\t\t} break;",
+	"\t\tcase GODOT_VARIANT_TYPE_COLOR: {",
+	"\t\t\tgodot_color col = api->godot_variant_as_color(&p_base.v);",
+	"\t\t\tif (p_name[0] == 'r' && !p_name[1]) return Var((double)api->godot_color_get_r(&col));",
+	"\t\t\tif (p_name[0] == 'g' && !p_name[1]) return Var((double)api->godot_color_get_g(&col));",
+	"\t\t\tif (p_name[0] == 'b' && !p_name[1]) return Var((double)api->godot_color_get_b(&col));",
+	"\t\t\tif (p_name[0] == 'a' && !p_name[1]) return Var((double)api->godot_color_get_a(&col));",
+	"\t\t} break;",
+	"\t\tdefault: break;",
+	"\t}",
+	"\tchar msg[256];",
+	"\tsnprintf(msg, sizeof(msg), \"Invalid get index '%s'.\", p_name);",
+	"\t_gd_error(msg);",
+	"\treturn Var();",
+	"}",
+	"",
+	"inline void _gd_set_named(Var &r_base, const char *p_name, const Var &p_value) {",
+	"\tswitch (r_base.get_type()) {",
+	"\t\tcase GODOT_VARIANT_TYPE_OBJECT: {",
+	"\t\t\t_gd_call(r_base, \"set\", Var::string(p_name), p_value);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_DICTIONARY: {",
+	"\t\t\tgodot_dictionary dict = api->godot_variant_as_dictionary(&r_base.v);",
+	"\t\t\tVar key = Var::string(p_name);",
+	"\t\t\tapi->godot_dictionary_set(&dict, &key.v, &p_value.v);",
+	"\t\t\tapi->godot_dictionary_destroy(&dict);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_VECTOR2: {",
+	"\t\t\tgodot_vector2 vec = api->godot_variant_as_vector2(&r_base.v);",
+	"\t\t\tif (p_name[0] == 'x' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_vector2_set_x(&vec, p_value.as_real());",
+	"\t\t\t} else if (p_name[0] == 'y' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_vector2_set_y(&vec, p_value.as_real());",
+	"\t\t\t} else {",
+	"\t\t\t\tbreak;",
+	"\t\t\t}",
+	"\t\t\tapi->godot_variant_destroy(&r_base.v);",
+	"\t\t\tapi->godot_variant_new_vector2(&r_base.v, &vec);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_VECTOR3: {",
+	"\t\t\tgodot_vector3 vec = api->godot_variant_as_vector3(&r_base.v);",
+	"\t\t\tif (p_name[0] < 'x' || p_name[0] > 'z' || p_name[1]) {",
+	"\t\t\t\tbreak;",
+	"\t\t\t}",
+	"\t\t\tapi->godot_vector3_set_axis(&vec, (godot_vector3_axis)(p_name[0] - 'x'), p_value.as_real());",
+	"\t\t\tapi->godot_variant_destroy(&r_base.v);",
+	"\t\t\tapi->godot_variant_new_vector3(&r_base.v, &vec);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_COLOR: {",
+	"\t\t\tgodot_color col = api->godot_variant_as_color(&r_base.v);",
+	"\t\t\tif (p_name[0] == 'r' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_color_set_r(&col, p_value.as_real());",
+	"\t\t\t} else if (p_name[0] == 'g' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_color_set_g(&col, p_value.as_real());",
+	"\t\t\t} else if (p_name[0] == 'b' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_color_set_b(&col, p_value.as_real());",
+	"\t\t\t} else if (p_name[0] == 'a' && !p_name[1]) {",
+	"\t\t\t\tapi->godot_color_set_a(&col, p_value.as_real());",
+	"\t\t\t} else {",
+	"\t\t\t\tbreak;",
+	"\t\t\t}",
+	"\t\t\tapi->godot_variant_destroy(&r_base.v);",
+	"\t\t\tapi->godot_variant_new_color(&r_base.v, &col);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tdefault: break;",
+	"\t}",
+	"\tchar msg[256];",
+	"\tsnprintf(msg, sizeof(msg), \"Invalid set index '%s'.\", p_name);",
+	"\t_gd_error(msg);",
+	"}",
+	"",
+	"inline int64_t _gd_size(const Var &p_value) {",
+	"\tif (p_value.get_type() == GODOT_VARIANT_TYPE_STRING) {",
+	"\t\treturn _gd_call(p_value, \"length\").as_int();",
+	"\t}",
+	"\treturn _gd_call(p_value, \"size\").as_int();",
+	"}",
+	"",
+	"inline Var _gd_get_indexed(const Var &p_base, const Var &p_index) {",
+	"\tswitch (p_base.get_type()) {",
+	"\t\tcase GODOT_VARIANT_TYPE_ARRAY: {",
+	"\t\t\tgodot_array arr = api->godot_variant_as_array(&p_base.v);",
+	"\t\t\tint64_t size = api->godot_array_size(&arr);",
+	"\t\t\tint64_t index = p_index.as_int();",
+	"\t\t\tif (index < 0) {",
+	"\t\t\t\tindex += size;",
+	"\t\t\t}",
+	"\t\t\tVar r;",
+	"\t\t\tif (index >= 0 && index < size) {",
+	"\t\t\t\tr = Var::adopt(api->godot_array_get(&arr, index));",
+	"\t\t\t} else {",
+	"\t\t\t\t_gd_error(\"Array index out of bounds.\");",
+	"\t\t\t}",
+	"\t\t\tapi->godot_array_destroy(&arr);",
+	"\t\t\treturn r;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_DICTIONARY: {",
+	"\t\t\tif (!_gd_call(p_base, \"has\", p_index).booleanize()) {",
+	"\t\t\t\t_gd_error(\"Invalid dictionary key.\");",
+	"\t\t\t\treturn Var();",
+	"\t\t\t}",
+	"\t\t\treturn _gd_call(p_base, \"get\", p_index);",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_OBJECT: return _gd_call(p_base, \"get\", p_index);",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_BYTE_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_INT_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_REAL_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_STRING_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR2_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR3_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_COLOR_ARRAY: {",
+	"\t\t\tVar arr;",
+	"\t\t\tgodot_array a = api->godot_variant_as_array(&p_base.v);",
+	"\t\t\tapi->godot_variant_destroy(&arr.v);",
+	"\t\t\tapi->godot_variant_new_array(&arr.v, &a);",
+	"\t\t\tapi->godot_array_destroy(&a);",
+	"\t\t\treturn _gd_get_indexed(arr, p_index);",
+	"\t\t}",
+	"\t\tdefault: break;",
+	"\t}",
+	"\t_gd_error(\"Invalid get index.\");",
+	"\treturn Var();",
+	"}",
+	"",
+	"inline void _gd_set_indexed(Var &r_base, const Var &p_index, const Var &p_value) {",
+	"\tswitch (r_base.get_type()) {",
+	"\t\tcase GODOT_VARIANT_TYPE_ARRAY: {",
+	"\t\t\tgodot_array arr = api->godot_variant_as_array(&r_base.v);",
+	"\t\t\tint64_t size = api->godot_array_size(&arr);",
+	"\t\t\tint64_t index = p_index.as_int();",
+	"\t\t\tif (index < 0) {",
+	"\t\t\t\tindex += size;",
+	"\t\t\t}",
+	"\t\t\tif (index >= 0 && index < size) {",
+	"\t\t\t\tapi->godot_array_set(&arr, index, &p_value.v);",
+	"\t\t\t} else {",
+	"\t\t\t\t_gd_error(\"Array index out of bounds.\");",
+	"\t\t\t}",
+	"\t\t\tapi->godot_array_destroy(&arr);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_DICTIONARY: {",
+	"\t\t\tgodot_dictionary dict = api->godot_variant_as_dictionary(&r_base.v);",
+	"\t\t\tapi->godot_dictionary_set(&dict, &p_index.v, &p_value.v);",
+	"\t\t\tapi->godot_dictionary_destroy(&dict);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_OBJECT:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_BYTE_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_INT_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_REAL_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_STRING_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR2_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR3_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_COLOR_ARRAY: {",
+	"\t\t\t_gd_call(r_base, \"set\", p_index, p_value);",
+	"\t\t\treturn;",
+	"\t\t}",
+	"\t\tdefault: break;",
+	"\t}",
+	"\t_gd_error(\"Invalid set index.\");",
+	"}",
+	"",
+	"inline Var _gd_iterable(const Var &p_container) {",
+	"\tswitch (p_container.get_type()) {",
+	"\t\tcase GODOT_VARIANT_TYPE_ARRAY: return p_container;",
+	"\t\tcase GODOT_VARIANT_TYPE_DICTIONARY: return _gd_call(p_container, \"keys\");",
+	"\t\tcase GODOT_VARIANT_TYPE_INT:",
+	"\t\tcase GODOT_VARIANT_TYPE_REAL: {",
+	"\t\t\tVar r = Var::array();",
+	"\t\t\tfor (int64_t i = 0; i < p_container.as_int(); i++) {",
+	"\t\t\t\t_gd_call(r, \"push_back\", Var(i));",
+	"\t\t\t}",
+	"\t\t\treturn r;",
+	"\t\t}",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_BYTE_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_INT_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_REAL_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_STRING_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR2_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_VECTOR3_ARRAY:",
+	"\t\tcase GODOT_VARIANT_TYPE_POOL_COLOR_ARRAY: {",
+	"\t\t\tVar r;",
+	"\t\t\tgodot_array a = api->godot_variant_as_array(&p_container.v);",
+	"\t\t\tapi->godot_variant_destroy(&r.v);",
+	"\t\t\tapi->godot_variant_new_array(&r.v, &a);",
+	"\t\t\tapi->godot_array_destroy(&a);",
+	"\t\t\treturn r;",
+	"\t\t}",
+	"\t\tdefault: break;",
+	"\t}",
+	"\t_gd_error(\"Value is not iterable.\");",
+	"\treturn Var::array();",
+	"}",
+	"",
+	"inline Var _gd_str(const Var &p_value) {",
+	"\tVar r;",
+	"\tgodot_string s = api->godot_variant_as_string(&p_value.v);",
+	"\tapi->godot_variant_destroy(&r.v);",
+	"\tapi->godot_variant_new_string(&r.v, &s);",
+	"\tapi->godot_string_destroy(&s);",
+	"\treturn r;",
+	"}",
+	"",
+	"template <class... Args>",
+	"inline Var _gd_str(const Var &p_value, const Args &... p_args) {",
+	"\treturn _gd_op(GODOT_VARIANT_OP_ADD, _gd_str(p_value), _gd_str(p_args...));",
+	"}",
+	"",
+	"template <class... Args>",
+	"inline void _gd_print(const Args &... p_args) {",
+	"\tVar text = _gd_str(p_args...);",
+	"\tgodot_string s = api->godot_variant_as_string(&text.v);",
+	"\tapi->godot_print(&s);",
+	"\tapi->godot_string_destroy(&s);",
+	"}",
+	"",
+	"inline void _gd_print() {",
+	"\tgodot_string s = api->godot_string_chars_to_utf8(\"\");",
+	"\tapi->godot_print(&s);",
+	"\tapi->godot_string_destroy(&s);",
+	"}",
+	"",
+	"inline bool _gd_is_int(const Var &p_value) {",
+	"\treturn p_value.get_type() == GODOT_VARIANT_TYPE_INT;",
+	"}",
+	"",
+	"inline Var _gd_abs(const Var &p_value) {",
+	"\treturn _gd_is_int(p_value) ? Var((int64_t)llabs(p_value.as_int())) : Var(fabs(p_value.as_real()));",
+	"}",
+	"",
+	"inline Var _gd_sign(const Var &p_value) {",
+	"\tif (_gd_is_int(p_value)) {",
+	"\t\tint64_t i = p_value.as_int();",
+	"\t\treturn Var((int64_t)(i > 0 ? 1 : (i < 0 ? -1 : 0)));",
+	"\t}",
+	"\tdouble d = p_value.as_real();",
+	"\treturn Var(d > 0 ? 1.0 : (d < 0 ? -1.0 : 0.0));",
+	"}",
+	"",
+	"inline Var _gd_min(const Var &p_a, const Var &p_b) {",
+	"\tif (_gd_is_int(p_a) && _gd_is_int(p_b)) {",
+	"\t\treturn Var(p_a.as_int() < p_b.as_int() ? p_a.as_int() : p_b.as_int());",
+	"\t}",
+	"\treturn Var(p_a.as_real() < p_b.as_real() ? p_a.as_real() : p_b.as_real());",
+	"}",
+	"",
+	"inline Var _gd_max(const Var &p_a, const Var &p_b) {",
+	"\tif (_gd_is_int(p_a) && _gd_is_int(p_b)) {",
+	"\t\treturn Var(p_a.as_int() > p_b.as_int() ? p_a.as_int() : p_b.as_int());",
+	"\t}",
+	"\treturn Var(p_a.as_real() > p_b.as_real() ? p_a.as_real() : p_b.as_real());",
+	"}",
+	"",
+	"inline Var _gd_clamp(const Var &p_value, const Var &p_min, const Var &p_max) {",
+	"\treturn _gd_min(_gd_max(p_value, p_min), p_max);",
+	"}",
+	"",
+	"inline int64_t _gd_idiv(int64_t p_a, int64_t p_b) {",
+	"\tif (p_b == 0) {",
+	"\t\t_gd_error(\"Division by zero error in operator '/'.\");",
+	"\t\treturn 0;",
+	"\t}",
+	"\treturn p_a / p_b;",
+	"}",
+	"",
+	"inline int64_t _gd_imod(int64_t p_a, int64_t p_b) {",
+	"\tif (p_b == 0) {",
+	"\t\t_gd_error(\"Division by zero error in operator '%'.\");",
+	"\t\treturn 0;",
+	"\t}",
+	"\treturn p_a % p_b;",
+	"}",
+	"",
+	"inline double _gd_lerp(double p_from, double p_to, double p_weight) {",
+	"\treturn p_from + (p_to - p_from) * p_weight;",
+	"}",
+	"",
+	"inline double _gd_clampf(double p_value, double p_min, double p_max) {",
+	"\treturn p_value < p_min ? p_min : (p_value > p_max ? p_max : p_value);",
+	"}",
+	"",
+	"inline int64_t _gd_clampi(int64_t p_value, int64_t p_min, int64_t p_max) {",
+	"\treturn p_value < p_min ? p_min : (p_value > p_max ? p_max : p_value);",
+	"}",
+	"",
+	"inline double _gd_signf(double p_value) {",
+	"\treturn p_value > 0 ? 1.0 : (p_value < 0 ? -1.0 : 0.0);",
+	"}",
+	"",
+	"inline int64_t _gd_signi(int64_t p_value) {",
+	"\treturn p_value > 0 ? 1 : (p_value < 0 ? -1 : 0);",
+	"}",
+	"",
+	"inline Var _gd_cast_object(const Var &p_value, const char *p_class) {",
+	"\treturn _gd_is_class(p_value, p_class) ? p_value : Var();",
+	"}",
+	"",
+	"inline void _gd_set_property(godot_object *p_owner, const char *p_name, const Var &p_value) {",
+	"\tVar self = Var::object(p_owner);",
+	"\t_gd_set_named(self, p_name, p_value);",
+	"}",
+	"",
+	"inline void _gd_register_property(void *p_handle, const char *p_class, const char *p_name, int p_type, int p_hint, const char *p_hint_string, int p_usage, const Var &p_default, GDCALLINGCONV void (*p_set)(godot_object *, void *, void *, godot_variant *), GDCALLINGCONV godot_variant (*p_get)(godot_object *, void *, void *)) {",
+	"\tgodot_property_attributes attributes;",
+	"\tattributes.rset_type = GODOT_METHOD_RPC_MODE_DISABLED;",
+	"\tattributes.type = p_type;",
+	"\tattributes.hint = (godot_property_hint)p_hint;",
+	"\tattributes.hint_string = api->godot_string_chars_to_utf8(p_hint_string);",
+	"\tattributes.usage = (godot_property_usage_flags)p_usage;",
+	"\tapi->godot_variant_new_copy(&attributes.default_value, &p_default.v);",
+	"\tgodot_property_set_func set_func = { NULL, NULL, NULL };",
+	"\tset_func.set_func = p_set;",
+	"\tgodot_property_get_func get_func = { NULL, NULL, NULL };",
+	"\tget_func.get_func = p_get;",
+	"\tnativescript_api->godot_nativescript_register_property(p_handle, p_class, p_name, &attributes, set_func, get_func);",
+	"\tapi->godot_variant_destroy(&attributes.default_value);",
+	"\tapi->godot_string_destroy(&attributes.hint_string);",
+	"}",
+	"",
+	"inline void _gd_register_method(void *p_handle, const char *p_class, const char *p_name, int p_rpc_mode, GDCALLINGCONV godot_variant (*p_method)(godot_object *, void *, void *, int, godot_variant **)) {",
+	"\tgodot_method_attributes attributes;",
+	"\tattributes.rpc_type = (godot_method_rpc_mode)p_rpc_mode;",
+	"\tgodot_instance_method method = { NULL, NULL, NULL };",
+	"\tmethod.method = p_method;",
+	"\tnativescript_api->godot_nativescript_register_method(p_handle, p_class, p_name, attributes, method);",
+	"}",
+	"",
+	"inline void _gd_register_signal(void *p_handle, const char *p_class, const char *p_name, int p_argc, const char **p_args) {",
+	"\tgodot_signal signal;",
+	"\tsignal.name = api->godot_string_chars_to_utf8(p_name);",
+	"\tsignal.num_args = p_argc;",
+	"\tsignal.args = p_argc ? (godot_signal_argument *)api->godot_alloc(sizeof(godot_signal_argument) * p_argc) : NULL;",
+	"\tfor (int i = 0; i < p_argc; i++) {",
+	"\t\tsignal.args[i].name = api->godot_string_chars_to_utf8(p_args[i]);",
+	"\t\tsignal.args[i].type = GODOT_VARIANT_TYPE_NIL;",
+	"\t\tsignal.args[i].hint = GODOT_PROPERTY_HINT_NONE;",
+	"\t\tsignal.args[i].hint_string = api->godot_string_chars_to_utf8(\"\");",
+	"\t\tsignal.args[i].usage = GODOT_PROPERTY_USAGE_DEFAULT;",
+	"\t\tapi->godot_variant_new_nil(&signal.args[i].default_value);",
+	"\t}",
+	"\tsignal.num_default_args = 0;",
+	"\tsignal.default_args = NULL;",
+	"\tnativescript_api->godot_nativescript_register_signal(p_handle, p_class, &signal);",
+	"\tfor (int i = 0; i < p_argc; i++) {",
+	"\t\tapi->godot_string_destroy(&signal.args[i].name);",
+	"\t\tapi->godot_string_destroy(&signal.args[i].hint_string);",
+	"\t\tapi->godot_variant_destroy(&signal.args[i].default_value);",
+	"\t}",
+	"\tif (signal.args) {",
+	"\t\tapi->godot_free(signal.args);",
+	"\t}",
+	"\tapi->godot_string_destroy(&signal.name);",
+	"}",
+	"",
+	"inline Var _gd_autoload(const char *p_name) {",
+	"\tVar tree = _gd_call(_gd_singleton(\"Engine\"), \"get_main_loop\");",
+	"\treturn _gd_call(_gd_call(tree, \"get_root\"), \"get_node\", Var::node_path(p_name));",
+	"}",
+	"",
+	"inline int64_t _gd_mini(int64_t p_a, int64_t p_b) {",
+	"\treturn p_a < p_b ? p_a : p_b;",
+	"}",
+	"",
+	"inline int64_t _gd_maxi(int64_t p_a, int64_t p_b) {",
+	"\treturn p_a > p_b ? p_a : p_b;",
+	"}",
+	"",
+	"inline double _gd_minf(double p_a, double p_b) {",
+	"\treturn p_a < p_b ? p_a : p_b;",
+	"}",
+	"",
+	"inline double _gd_maxf(double p_a, double p_b) {",
+	"\treturn p_a > p_b ? p_a : p_b;",
+	"}",
+	NULL
+};
+
+static const char *_variant_operator(GDScriptParser::OperatorNode::Operator p_op) {
+
+	switch (p_op) {
+		case GDScriptParser::OperatorNode::OP_IN: return "GODOT_VARIANT_OP_IN";
+		case GDScriptParser::OperatorNode::OP_EQUAL: return "GODOT_VARIANT_OP_EQUAL";
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL: return "GODOT_VARIANT_OP_NOT_EQUAL";
+		case GDScriptParser::OperatorNode::OP_LESS: return "GODOT_VARIANT_OP_LESS";
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL: return "GODOT_VARIANT_OP_LESS_EQUAL";
+		case GDScriptParser::OperatorNode::OP_GREATER: return "GODOT_VARIANT_OP_GREATER";
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: return "GODOT_VARIANT_OP_GREATER_EQUAL";
+		case GDScriptParser::OperatorNode::OP_ADD: return "GODOT_VARIANT_OP_ADD";
+		case GDScriptParser::OperatorNode::OP_SUB: return "GODOT_VARIANT_OP_SUBTRACT";
+		case GDScriptParser::OperatorNode::OP_MUL: return "GODOT_VARIANT_OP_MULTIPLY";
+		case GDScriptParser::OperatorNode::OP_DIV: return "GODOT_VARIANT_OP_DIVIDE";
+		case GDScriptParser::OperatorNode::OP_MOD: return "GODOT_VARIANT_OP_MODULE";
+		case GDScriptParser::OperatorNode::OP_SHIFT_LEFT: return "GODOT_VARIANT_OP_SHIFT_LEFT";
+		case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT: return "GODOT_VARIANT_OP_SHIFT_RIGHT";
+		case GDScriptParser::OperatorNode::OP_BIT_AND: return "GODOT_VARIANT_OP_BIT_AND";
+		case GDScriptParser::OperatorNode::OP_BIT_OR: return "GODOT_VARIANT_OP_BIT_OR";
+		case GDScriptParser::OperatorNode::OP_BIT_XOR: return "GODOT_VARIANT_OP_BIT_XOR";
+		default: return NULL;
+	}
+}
+
+static const char *_native_operator(GDScriptParser::OperatorNode::Operator p_op) {
+
+	switch (p_op) {
+		case GDScriptParser::OperatorNode::OP_EQUAL: return " == ";
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL: return " != ";
+		case GDScriptParser::OperatorNode::OP_LESS: return " < ";
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL: return " <= ";
+		case GDScriptParser::OperatorNode::OP_GREATER: return " > ";
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: return " >= ";
+		case GDScriptParser::OperatorNode::OP_ADD: return " + ";
+		case GDScriptParser::OperatorNode::OP_SUB: return " - ";
+		case GDScriptParser::OperatorNode::OP_MUL: return " * ";
+		case GDScriptParser::OperatorNode::OP_DIV: return " / ";
+		case GDScriptParser::OperatorNode::OP_SHIFT_LEFT: return " << ";
+		case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT: return " >> ";
+		case GDScriptParser::OperatorNode::OP_BIT_AND: return " & ";
+		case GDScriptParser::OperatorNode::OP_BIT_OR: return " | ";
+		case GDScriptParser::OperatorNode::OP_BIT_XOR: return " ^ ";
+		default: return NULL;
+	}
+}
+
+// Strips one pair of parentheses enclosing the whole expression, for conditions.
+static String _unwrap(const String &p_code) {
+
+	if (p_code.length() < 2 || p_code[0] != '(' || p_code[p_code.length() - 1] != ')') {
+		return p_code;
+	}
+
+	int depth = 0;
+	for (int i = 0; i < p_code.length() - 1; i++) {
+		if (p_code[i] == '(') {
+			depth++;
+		} else if (p_code[i] == ')') {
+			depth--;
+			if (depth == 0) {
+				return p_code; // Closed before the end, e.g. "(a) && (b)".
+			}
+		}
+	}
+	return p_code.substr(1, p_code.length() - 2);
+}
+
+void GDScriptTranspiler::_set_error(const String &p_error, const GDScriptParser::Node *p_node) {
+
+	if (error_set) {
+		return;
+	}
+
+	error = p_error;
+	error_line = p_node ? p_node->line : -1;
+	error_set = true;
+}
+
+void GDScriptTranspiler::_line(const String &p_line) {
+
+	if (p_line.empty()) {
+		source.push_back("\n");
+		return;
+	}
+
+	String line;
+	for (int i = 0; i < indent; i++) {
+		line += "\t";
+	}
+	source.push_back(line + p_line + "\n");
+}
+
+String GDScriptTranspiler::_temp() {
+
+	return "_t" + itos(temp_count++);
+}
+
+GDScriptTranspiler::Kind GDScriptTranspiler::_kind_from_type(const GDScriptParser::DataType &p_type) {
+
+	if (!p_type.has_type || p_type.kind != GDScriptParser::DataType::BUILTIN) {
+		return KIND_VARIANT;
+	}
+
+	switch (p_type.builtin_type) {
+		case Variant::INT: return KIND_INT;
+		case Variant::REAL: return KIND_REAL;
+		case Variant::BOOL: return KIND_BOOL;
+		default: return KIND_VARIANT;
+	}
+}
+
+String GDScriptTranspiler::_ctype(Kind p_kind) {
+
+	switch (p_kind) {
+		case KIND_INT: return "int64_t";
+		case KIND_REAL: return "double";
+		case KIND_BOOL: return "bool";
+		default: return "Var";
+	}
+}
+
+String GDScriptTranspiler::_zero(Kind p_kind) {
+
+	switch (p_kind) {
+		case KIND_INT: return "0";
+		case KIND_REAL: return "0.0";
+		case KIND_BOOL: return "false";
+		default: return "Var()";
+	}
+}
+
+String GDScriptTranspiler::_string(const String &p_string) {
+
+	return "\"" + p_string.c_escape() + "\"";
+}
+
+String GDScriptTranspiler::_real(double p_value) {
+
+	if (Math::is_nan(p_value)) {
+		return "NAN";
+	}
+	if (Math::is_inf(p_value)) {
+		return p_value > 0 ? "INFINITY" : "(-INFINITY)";
+	}
+
+	char buf[64];
+	snprintf(buf, sizeof(buf), "%.17g", p_value);
+	String literal = buf;
+	if (literal.find(".") == -1 && literal.find("e") == -1) {
+		literal += ".0";
+	}
+	return p_value < 0 ? "(" + literal + ")" : literal;
+}
+
+String GDScriptTranspiler::_ident(const String &p_name) {
+
+	String ident;
+	for (int i = 0; i < p_name.length(); i++) {
+		CharType c = p_name[i];
+		bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+		ident += valid ? String::chr(c) : String("_");
+	}
+	if (ident.empty() || (ident[0] >= '0' && ident[0] <= '9')) {
+		ident = "_" + ident;
+	}
+	return ident;
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_convert(const Expression &p_expr, Kind p_kind) {
+
+	if (p_expr.kind == p_kind) {
+		return p_expr;
+	}
+
+	String code;
+	switch (p_kind) {
+		case KIND_VARIANT: {
+			code = "Var((" + _ctype(p_expr.kind) + ")(" + p_expr.code + "))";
+		} break;
+		case KIND_INT: {
+			code = p_expr.kind == KIND_VARIANT ? p_expr.code + ".as_int()" : "((int64_t)(" + p_expr.code + "))";
+		} break;
+		case KIND_REAL: {
+			code = p_expr.kind == KIND_VARIANT ? p_expr.code + ".as_real()" : "((double)(" + p_expr.code + "))";
+		} break;
+		case KIND_BOOL: {
+			code = p_expr.kind == KIND_VARIANT ? p_expr.code + ".booleanize()" : "((" + p_expr.code + ") != 0)";
+		} break;
+	}
+	return Expression(code, p_kind);
+}
+
+void GDScriptTranspiler::_push_scope() {
+
+	scopes.push_back(Map<StringName, Kind>());
+}
+
+void GDScriptTranspiler::_pop_scope() {
+
+	scopes.pop_back();
+}
+
+void GDScriptTranspiler::_declare_local(const StringName &p_name, Kind p_kind) {
+
+	scopes.back()->get()[p_name] = p_kind;
+}
+
+bool GDScriptTranspiler::_find_local(const StringName &p_name, Kind *r_kind) const {
+
+	for (const List<Map<StringName, Kind> >::Element *E = scopes.back(); E; E = E->prev()) {
+		const Map<StringName, Kind>::Element *F = E->get().find(p_name);
+		if (F) {
+			if (r_kind) {
+				*r_kind = F->get();
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+bool GDScriptTranspiler::_get_global(const StringName &p_name, Variant *r_value) const {
+
+	const Map<StringName, int> &globals = GDScriptLanguage::get_singleton()->get_global_map();
+	const Map<StringName, int>::Element *E = globals.find(p_name);
+	if (!E) {
+		return false;
+	}
+	*r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->get()];
+	return true;
+}
+
+bool GDScriptTranspiler::_get_native_class(const GDScriptParser::Node *p_node, StringName *r_class) const {
+
+	Variant value;
+	if (p_node->type == GDScriptParser::Node::TYPE_IDENTIFIER) {
+		StringName name = static_cast<const GDScriptParser::IdentifierNode *>(p_node)->name;
+		if (_find_local(name, NULL) || members.has(name) || !_get_global(name, &value)) {
+			return false;
+		}
+	} else if (p_node->type == GDScriptParser::Node::TYPE_CONSTANT) {
+		value = static_cast<const GDScriptParser::ConstantNode *>(p_node)->value;
+	} else {
+		return false;
+	}
+
+	GDScriptNativeClass *native = Object::cast_to<GDScriptNativeClass>(value.operator Object *());
+	if (!native) {
+		return false;
+	}
+	*r_class = native->get_name();
+	return true;
+}
+
+bool GDScriptTranspiler::_is_constant_supported(const Variant &p_value) const {
+
+	switch (p_value.get_type()) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::REAL:
+		case Variant::STRING:
+		case Variant::VECTOR2:
+		case Variant::VECTOR3:
+		case Variant::COLOR:
+		case Variant::NODE_PATH: {
+			return true;
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_constant_supported(array[i])) {
+					return false;
+				}
+			}
+			return true;
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				if (!_is_constant_supported(E->get()) || !_is_constant_supported(dict[E->get()])) {
+					return false;
+				}
+			}
+			return true;
+		} break;
+		case Variant::OBJECT: {
+			// Preloaded resources are loaded again by path at runtime.
+			Ref<Resource> res = p_value;
+			return res.is_valid() && res->get_path().is_resource_file();
+		} break;
+		default: {
+			return false;
+		}
+	}
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_constant(const Variant &p_value, const GDScriptParser::Node *p_node) {
+
+	if (!_is_constant_supported(p_value)) {
+		_set_error("Constants of type '" + Variant::get_type_name(p_value.get_type()) + "' can't be transpiled.", p_node);
+		return Expression();
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::BOOL: {
+			return Expression(p_value.operator bool() ? "true" : "false", KIND_BOOL);
+		} break;
+		case Variant::INT: {
+			int64_t value = p_value;
+			if (value == INT64_MIN) {
+				return Expression("INT64_MIN", KIND_INT);
+			}
+			return Expression("int64_t(" + itos(value) + "LL)", KIND_INT);
+		} break;
+		case Variant::REAL: {
+			return Expression(_real(p_value), KIND_REAL);
+		} break;
+		case Variant::STRING: {
+			return Expression("Var::string(" + _string(p_value) + ")", KIND_VARIANT);
+		} break;
+		case Variant::VECTOR2: {
+			Vector2 v = p_value;
+			return Expression("Var::vector2(" + _real(v.x) + ", " + _real(v.y) + ")", KIND_VARIANT);
+		} break;
+		case Variant::VECTOR3: {
+			Vector3 v = p_value;
+			return Expression("Var::vector3(" + _real(v.x) + ", " + _real(v.y) + ", " + _real(v.z) + ")", KIND_VARIANT);
+		} break;
+		case Variant::COLOR: {
+			Color c = p_value;
+			return Expression("Var::color(" + _real(c.r) + ", " + _real(c.g) + ", " + _real(c.b) + ", " + _real(c.a) + ")", KIND_VARIANT);
+		} break;
+		case Variant::NODE_PATH: {
+			return Expression("Var::node_path(" + _string(String(p_value.operator NodePath())) + ")", KIND_VARIANT);
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			String code = "([&]() { Var _a = Var::array();";
+			for (int i = 0; i < array.size(); i++) {
+				code += " _gd_call(_a, \"push_back\", " + _as(_constant(array[i], p_node), KIND_VARIANT) + ");";
+			}
+			return Expression(code + " return _a; }())", KIND_VARIANT);
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			List<Variant> keys;
+			dict.get_key_list(&keys);
+			String code = "([&]() { Var _d = Var::dictionary();";
+			for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
+				code += " _gd_set_indexed(_d, " + _as(_constant(E->get(), p_node), KIND_VARIANT) + ", " + _as(_constant(dict[E->get()], p_node), KIND_VARIANT) + ");";
+			}
+			return Expression(code + " return _d; }())", KIND_VARIANT);
+		} break;
+		case Variant::OBJECT: {
+			Ref<Resource> res = p_value;
+			return Expression("_gd_call(_gd_singleton(\"ResourceLoader\"), \"load\", Var::string(" + _string(res->get_path()) + "))", KIND_VARIANT);
+		} break;
+		default: {
+			return Expression("Var()", KIND_VARIANT);
+		}
+	}
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_identifier(const GDScriptParser::IdentifierNode *p_identifier) {
+
+	const StringName &name = p_identifier->name;
+
+	Kind kind;
+	if (_find_local(name, &kind)) {
+		return Expression("l_" + String(name), kind);
+	}
+
+	if (members.has(name)) {
+		return Expression("m_" + String(name), members[name].kind);
+	}
+
+	if (class_node->constant_expressions.has(name)) {
+		const GDScriptParser::Node *expr = class_node->constant_expressions[name].expression;
+		if (expr->type == GDScriptParser::Node::TYPE_CONSTANT) {
+			return _constant(static_cast<const GDScriptParser::ConstantNode *>(expr)->value, p_identifier);
+		}
+		_set_error("Constant '" + String(name) + "' couldn't be reduced to a value.", p_identifier);
+		return Expression();
+	}
+
+	bool valid = false;
+	int constant = ClassDB::get_integer_constant(base_class, name, &valid);
+	if (valid) {
+		return Expression("int64_t(" + itos(constant) + ")", KIND_INT);
+	}
+
+	if (ClassDB::has_property(base_class, name)) {
+		return Expression("_gd_get_named(Var::object(owner), " + _string(name) + ")", KIND_VARIANT);
+	}
+
+	if (ProjectSettings::get_singleton()->has_setting("autoload/" + String(name))) {
+		return Expression("_gd_autoload(" + _string(name) + ")", KIND_VARIANT);
+	}
+
+	Variant value;
+	if (_get_global(name, &value)) {
+		if (value.get_type() == Variant::OBJECT) {
+			if (Engine::get_singleton()->has_singleton(name)) {
+				return Expression("_gd_singleton(" + _string(name) + ")", KIND_VARIANT);
+			}
+		} else if (_is_constant_supported(value)) {
+			return _constant(value, p_identifier);
+		}
+	}
+
+	_set_error("Identifier '" + String(name) + "' can't be transpiled.", p_identifier);
+	return Expression();
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_get_named(const GDScriptParser::OperatorNode *p_op) {
+
+	const GDScriptParser::Node *base = p_op->arguments[0];
+	StringName name = static_cast<const GDScriptParser::IdentifierNode *>(p_op->arguments[1])->name;
+
+	if (base->type == GDScriptParser::Node::TYPE_SELF) {
+		// Access through self goes through setget, like in GDScript.
+		if (members.has(name)) {
+			const Member &member = members[name];
+			if (member.getter != StringName() && functions.has(member.getter)) {
+				return Expression("f_" + String(member.getter) + "()", _kind_from_type(functions[member.getter]->return_type));
+			}
+			return Expression("m_" + String(name), member.kind);
+		}
+		return Expression("_gd_get_named(Var::object(owner), " + _string(name) + ")", KIND_VARIANT);
+	}
+
+	StringName native;
+	if (_get_native_class(base, &native)) {
+		bool valid = false;
+		int constant = ClassDB::get_integer_constant(native, name, &valid);
+		if (valid) {
+			return Expression("int64_t(" + itos(constant) + ")", KIND_INT);
+		}
+		_set_error("Only integer constants of native classes can be accessed in transpiled scripts.", p_op);
+		return Expression();
+	}
+
+	return Expression("_gd_get_named(" + _as(_expression(base), KIND_VARIANT) + ", " + _string(name) + ")", KIND_VARIANT);
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_binary(GDScriptParser::OperatorNode::Operator p_op, const Expression &p_a, const Expression &p_b) {
+
+	bool numeric = (p_a.kind == KIND_INT || p_a.kind == KIND_REAL) && (p_b.kind == KIND_INT || p_b.kind == KIND_REAL);
+	bool integers = p_a.kind == KIND_INT && p_b.kind == KIND_INT;
+	bool comparison = false;
+
+	switch (p_op) {
+		case GDScriptParser::OperatorNode::OP_AND: {
+			return Expression("(" + _as(p_a, KIND_BOOL) + " && " + _as(p_b, KIND_BOOL) + ")", KIND_BOOL);
+		} break;
+		case GDScriptParser::OperatorNode::OP_OR: {
+			return Expression("(" + _as(p_a, KIND_BOOL) + " || " + _as(p_b, KIND_BOOL) + ")", KIND_BOOL);
+		} break;
+		case GDScriptParser::OperatorNode::OP_EQUAL:
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL: {
+			if (numeric || (p_a.kind == KIND_BOOL && p_b.kind == KIND_BOOL)) {
+				return Expression("(" + p_a.code + _native_operator(p_op) + p_b.code + ")", KIND_BOOL);
+			}
+			comparison = true;
+		} break;
+		case GDScriptParser::OperatorNode::OP_LESS:
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL:
+		case GDScriptParser::OperatorNode::OP_GREATER:
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL: {
+			if (numeric) {
+				return Expression("(" + p_a.code + _native_operator(p_op) + p_b.code + ")", KIND_BOOL);
+			}
+			comparison = true;
+		} break;
+		case GDScriptParser::OperatorNode::OP_IN: {
+			comparison = true;
+		} break;
+		case GDScriptParser::OperatorNode::OP_ADD:
+		case GDScriptParser::OperatorNode::OP_SUB:
+		case GDScriptParser::OperatorNode::OP_MUL: {
+			if (integers) {
+				return Expression("(" + p_a.code + _native_operator(p_op) + p_b.code + ")", KIND_INT);
+			}
+			if (numeric) {
+				return Expression("(" + _as(p_a, KIND_REAL) + _native_operator(p_op) + _as(p_b, KIND_REAL) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptParser::OperatorNode::OP_DIV: {
+			if (integers) {
+				return Expression("_gd_idiv(" + p_a.code + ", " + p_b.code + ")", KIND_INT);
+			}
+			if (numeric) {
+				return Expression("(" + _as(p_a, KIND_REAL) + " / " + _as(p_b, KIND_REAL) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptParser::OperatorNode::OP_MOD: {
+			// Modulo of floats is an error in GDScript, let the Variant path report it.
+			if (integers) {
+				return Expression("_gd_imod(" + p_a.code + ", " + p_b.code + ")", KIND_INT);
+			}
+		} break;
+		case GDScriptParser::OperatorNode::OP_SHIFT_LEFT:
+		case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT:
+		case GDScriptParser::OperatorNode::OP_BIT_AND:
+		case GDScriptParser::OperatorNode::OP_BIT_OR:
+		case GDScriptParser::OperatorNode::OP_BIT_XOR: {
+			if (integers) {
+				return Expression("(" + p_a.code + _native_operator(p_op) + p_b.code + ")", KIND_INT);
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(Expression());
+		}
+	}
+
+	String code = String("_gd_op(") + _variant_operator(p_op) + ", " + _as(p_a, KIND_VARIANT) + ", " + _as(p_b, KIND_VARIANT) + ")";
+	if (comparison) {
+		return Expression(code + ".booleanize()", KIND_BOOL);
+	}
+	return Expression(code, KIND_VARIANT);
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_operator(const GDScriptParser::OperatorNode *p_op) {
+
+	switch (p_op->op) {
+		case GDScriptParser::OperatorNode::OP_CALL: {
+			return _call(p_op);
+		} break;
+		case GDScriptParser::OperatorNode::OP_PARENT_CALL: {
+			_set_error("Calls to the parent implementation of a function can't be transpiled.", p_op);
+		} break;
+		case GDScriptParser::OperatorNode::OP_YIELD: {
+			_set_error("Functions using 'yield' can't be transpiled.", p_op);
+		} break;
+		case GDScriptParser::OperatorNode::OP_IS: {
+			StringName native;
+			if (_get_native_class(p_op->arguments[1], &native)) {
+				return Expression("_gd_is_class(" + _as(_expression(p_op->arguments[0]), KIND_VARIANT) + ", " + _string(native) + ")", KIND_BOOL);
+			}
+			_set_error("Only native classes can be used with 'is' in transpiled scripts.", p_op);
+		} break;
+		case GDScriptParser::OperatorNode::OP_IS_BUILTIN: {
+			Variant::Type type = static_cast<const GDScriptParser::TypeNode *>(p_op->arguments[1])->vtype;
+			return Expression("(" + _as(_expression(p_op->arguments[0]), KIND_VARIANT) + ".get_type() == (godot_variant_type)" + itos(type) + ")", KIND_BOOL);
+		} break;
+		case GDScriptParser::OperatorNode::OP_INDEX: {
+			Expression base = _expression(p_op->arguments[0]);
+			Expression index = _expression(p_op->arguments[1]);
+			return Expression("_gd_get_indexed(" + _as(base, KIND_VARIANT) + ", " + _as(index, KIND_VARIANT) + ")", KIND_VARIANT);
+		} break;
+		case GDScriptParser::OperatorNode::OP_INDEX_NAMED: {
+			return _get_named(p_op);
+		} break;
+		case GDScriptParser::OperatorNode::OP_NEG: {
+			Expression a = _expression(p_op->arguments[0]);
+			if (a.kind == KIND_INT || a.kind == KIND_REAL) {
+				return Expression("(-(" + a.code + "))", a.kind);
+			}
+			return Expression("_gd_op(GODOT_VARIANT_OP_NEGATE, " + _as(a, KIND_VARIANT) + ", Var())", KIND_VARIANT);
+		} break;
+		case GDScriptParser::OperatorNode::OP_POS: {
+			Expression a = _expression(p_op->arguments[0]);
+			if (a.kind == KIND_INT || a.kind == KIND_REAL) {
+				return a;
+			}
+			return Expression("_gd_op(GODOT_VARIANT_OP_POSITIVE, " + _as(a, KIND_VARIANT) + ", Var())", KIND_VARIANT);
+		} break;
+		case GDScriptParser::OperatorNode::OP_NOT: {
+			return Expression("(!" + _as(_expression(p_op->arguments[0]), KIND_BOOL) + ")", KIND_BOOL);
+		} break;
+		case GDScriptParser::OperatorNode::OP_BIT_INVERT: {
+			Expression a = _expression(p_op->arguments[0]);
+			if (a.kind == KIND_INT) {
+				return Expression("(~(" + a.code + "))", KIND_INT);
+			}
+			return Expression("_gd_op(GODOT_VARIANT_OP_BIT_NEGATE, " + _as(a, KIND_VARIANT) + ", Var())", KIND_VARIANT);
+		} break;
+		case GDScriptParser::OperatorNode::OP_TERNARY_IF: {
+			Expression condition = _expression(p_op->arguments[0]);
+			Expression a = _expression(p_op->arguments[1]);
+			Expression b = _expression(p_op->arguments[2]);
+			Kind kind = a.kind == b.kind ? a.kind : KIND_VARIANT;
+			return Expression("(" + _as(condition, KIND_BOOL) + " ? " + _as(a, kind) + " : " + _as(b, kind) + ")", kind);
+		} break;
+		case GDScriptParser::OperatorNode::OP_IN:
+		case GDScriptParser::OperatorNode::OP_EQUAL:
+		case GDScriptParser::OperatorNode::OP_NOT_EQUAL:
+		case GDScriptParser::OperatorNode::OP_LESS:
+		case GDScriptParser::OperatorNode::OP_LESS_EQUAL:
+		case GDScriptParser::OperatorNode::OP_GREATER:
+		case GDScriptParser::OperatorNode::OP_GREATER_EQUAL:
+		case GDScriptParser::OperatorNode::OP_AND:
+		case GDScriptParser::OperatorNode::OP_OR:
+		case GDScriptParser::OperatorNode::OP_ADD:
+		case GDScriptParser::OperatorNode::OP_SUB:
+		case GDScriptParser::OperatorNode::OP_MUL:
+		case GDScriptParser::OperatorNode::OP_DIV:
+		case GDScriptParser::OperatorNode::OP_MOD:
+		case GDScriptParser::OperatorNode::OP_SHIFT_LEFT:
+		case GDScriptParser::OperatorNode::OP_SHIFT_RIGHT:
+		case GDScriptParser::OperatorNode::OP_BIT_AND:
+		case GDScriptParser::OperatorNode::OP_BIT_OR:
+		case GDScriptParser::OperatorNode::OP_BIT_XOR: {
+			Expression a = _expression(p_op->arguments[0]);
+			Expression b = _expression(p_op->arguments[1]);
+			return _binary(p_op->op, a, b);
+		} break;
+		default: {
+			_set_error("Assignments can only be used as statements.", p_op);
+		}
+	}
+
+	return Expression();
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_call(const GDScriptParser::OperatorNode *p_op) {
+
+	const GDScriptParser::Node *callee = p_op->arguments[0];
+
+	if (callee->type == GDScriptParser::Node::TYPE_BUILT_IN_FUNCTION) {
+		return _call_built_in(static_cast<const GDScriptParser::BuiltInFunctionNode *>(callee)->function, p_op);
+	}
+
+	if (callee->type == GDScriptParser::Node::TYPE_TYPE) {
+		return _construct(static_cast<const GDScriptParser::TypeNode *>(callee)->vtype, p_op);
+	}
+
+	if (p_op->arguments.size() < 2 || p_op->arguments[1]->type != GDScriptParser::Node::TYPE_IDENTIFIER) {
+		_set_error("Unsupported call.", p_op);
+		return Expression();
+	}
+
+	StringName method = static_cast<const GDScriptParser::IdentifierNode *>(p_op->arguments[1])->name;
+
+	// Functions of this script are plain C++ calls with native arguments.
+	if (callee->type == GDScriptParser::Node::TYPE_SELF && functions.has(method)) {
+		return _call_function(functions[method], p_op, 2);
+	}
+
+	StringName native;
+	if (method == "new" && _get_native_class(callee, &native)) {
+		if (p_op->arguments.size() > 2) {
+			_set_error("Native classes are constructed without arguments.", p_op);
+			return Expression();
+		}
+		return Expression("_gd_new(" + _string(native) + ")", KIND_VARIANT);
+	}
+
+	String code = "_gd_call(";
+	if (callee->type == GDScriptParser::Node::TYPE_SELF) {
+		code += "Var::object(owner)";
+	} else {
+		code += _as(_expression(callee), KIND_VARIANT);
+	}
+	code += ", " + _string(method);
+	for (int i = 2; i < p_op->arguments.size(); i++) {
+		code += ", " + _as(_expression(p_op->arguments[i]), KIND_VARIANT);
+	}
+	return Expression(code + ")", KIND_VARIANT);
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_call_function(const GDScriptParser::FunctionNode *p_function, const GDScriptParser::OperatorNode *p_op, int p_first_arg) {
+
+	int argc = p_op->arguments.size() - p_first_arg;
+	int total = p_function->arguments.size();
+	int required = total - p_function->default_values.size();
+
+	if (argc < required || argc > total) {
+		_set_error("Invalid number of arguments in call to '" + String(p_function->name) + "'.", p_op);
+		return Expression();
+	}
+
+	String code = "f_" + String(p_function->name) + "(";
+	for (int i = 0; i < total; i++) {
+		Expression arg;
+		if (i < argc) {
+			arg = _expression(p_op->arguments[p_first_arg + i]);
+		} else {
+			arg = _expression(static_cast<const GDScriptParser::OperatorNode *>(p_function->default_values[i - required])->arguments[1]);
+		}
+		if (i > 0) {
+			code += ", ";
+		}
+		code += _as(arg, _kind_from_type(p_function->argument_types[i]));
+	}
+	return Expression(code + ")", _kind_from_type(p_function->return_type));
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_call_built_in(GDScriptFunctions::Function p_function, const GDScriptParser::OperatorNode *p_op) {
+
+	Vector<Expression> args;
+	bool integers = true;
+	bool numeric = true;
+	for (int i = 1; i < p_op->arguments.size(); i++) {
+		Expression arg = _expression(p_op->arguments[i]);
+		integers = integers && arg.kind == KIND_INT;
+		numeric = numeric && (arg.kind == KIND_INT || arg.kind == KIND_REAL);
+		args.push_back(arg);
+	}
+
+	switch (p_function) {
+		case GDScriptFunctions::TYPE_CONVERT: {
+			// Inserted by the parser for implicit conversions on typed assignments.
+			if (args.size() != 2 || p_op->arguments[2]->type != GDScriptParser::Node::TYPE_CONSTANT) {
+				break;
+			}
+			Variant::Type type = Variant::Type(int(static_cast<const GDScriptParser::ConstantNode *>(p_op->arguments[2])->value));
+			switch (type) {
+				case Variant::INT: return _convert(args[0], KIND_INT);
+				case Variant::REAL: return _convert(args[0], KIND_REAL);
+				case Variant::BOOL: return _convert(args[0], KIND_BOOL);
+				case Variant::STRING: return Expression("_gd_str(" + _as(args[0], KIND_VARIANT) + ")", KIND_VARIANT);
+				default: return _convert(args[0], KIND_VARIANT);
+			}
+		} break;
+		case GDScriptFunctions::TYPE_OF: {
+			if (args.size() == 1) {
+				return Expression("((int64_t)" + _as(args[0], KIND_VARIANT) + ".get_type())", KIND_INT);
+			}
+		} break;
+		case GDScriptFunctions::TEXT_PRINT:
+		case GDScriptFunctions::TEXT_STR: {
+			String code = p_function == GDScriptFunctions::TEXT_PRINT ? "_gd_print(" : "_gd_str(";
+			for (int i = 0; i < args.size(); i++) {
+				code += (i > 0 ? ", " : "") + _as(args[i], KIND_VARIANT);
+			}
+			if (p_function == GDScriptFunctions::TEXT_PRINT) {
+				return Expression("(" + code + "), Var())", KIND_VARIANT);
+			}
+			if (args.size() > 0) {
+				return Expression(code + ")", KIND_VARIANT);
+			}
+		} break;
+		case GDScriptFunctions::LEN: {
+			if (args.size() == 1) {
+				return Expression("_gd_size(" + _as(args[0], KIND_VARIANT) + ")", KIND_INT);
+			}
+		} break;
+		case GDScriptFunctions::MATH_SIN:
+		case GDScriptFunctions::MATH_COS:
+		case GDScriptFunctions::MATH_TAN:
+		case GDScriptFunctions::MATH_SINH:
+		case GDScriptFunctions::MATH_COSH:
+		case GDScriptFunctions::MATH_TANH:
+		case GDScriptFunctions::MATH_ASIN:
+		case GDScriptFunctions::MATH_ACOS:
+		case GDScriptFunctions::MATH_ATAN:
+		case GDScriptFunctions::MATH_SQRT:
+		case GDScriptFunctions::MATH_FLOOR:
+		case GDScriptFunctions::MATH_CEIL:
+		case GDScriptFunctions::MATH_ROUND:
+		case GDScriptFunctions::MATH_LOG:
+		case GDScriptFunctions::MATH_EXP: {
+			if (args.size() == 1) {
+				// The C functions have the same names as the GDScript ones.
+				return Expression(String(GDScriptFunctions::get_func_name(p_function)) + "(" + _as(args[0], KIND_REAL) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptFunctions::MATH_ATAN2:
+		case GDScriptFunctions::MATH_POW:
+		case GDScriptFunctions::MATH_FMOD: {
+			if (args.size() == 2) {
+				return Expression(String(GDScriptFunctions::get_func_name(p_function)) + "(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptFunctions::MATH_ISNAN:
+		case GDScriptFunctions::MATH_ISINF: {
+			if (args.size() == 1) {
+				return Expression(String("(") + (p_function == GDScriptFunctions::MATH_ISNAN ? "isnan" : "isinf") + "(" + _as(args[0], KIND_REAL) + ") != 0)", KIND_BOOL);
+			}
+		} break;
+		case GDScriptFunctions::MATH_DEG2RAD: {
+			if (args.size() == 1) {
+				return Expression("(" + _as(args[0], KIND_REAL) + " * " + _real(Math_PI / 180.0) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptFunctions::MATH_RAD2DEG: {
+			if (args.size() == 1) {
+				return Expression("(" + _as(args[0], KIND_REAL) + " * " + _real(180.0 / Math_PI) + ")", KIND_REAL);
+			}
+		} break;
+		case GDScriptFunctions::MATH_LERP: {
+			if (args.size() != 3) {
+				break;
+			}
+			if (numeric) {
+				return Expression("_gd_lerp(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ", " + _as(args[2], KIND_REAL) + ")", KIND_REAL);
+			}
+			// Vectors and colors interpolate through the Variant operators.
+			String from = _as(args[0], KIND_VARIANT);
+			return Expression("_gd_op(GODOT_VARIANT_OP_ADD, " + from + ", _gd_op(GODOT_VARIANT_OP_MULTIPLY, _gd_op(GODOT_VARIANT_OP_SUBTRACT, " + _as(args[1], KIND_VARIANT) + ", " + from + "), " + _as(args[2], KIND_VARIANT) + "))", KIND_VARIANT);
+		} break;
+		case GDScriptFunctions::MATH_ABS:
+		case GDScriptFunctions::MATH_SIGN: {
+			if (args.size() != 1) {
+				break;
+			}
+			bool abs = p_function == GDScriptFunctions::MATH_ABS;
+			if (args[0].kind == KIND_INT) {
+				return Expression(String(abs ? "((int64_t)llabs(" : "(_gd_signi(") + args[0].code + "))", KIND_INT);
+			}
+			if (args[0].kind == KIND_REAL) {
+				return Expression(String(abs ? "fabs(" : "_gd_signf(") + args[0].code + ")", KIND_REAL);
+			}
+			return Expression(String(abs ? "_gd_abs(" : "_gd_sign(") + _as(args[0], KIND_VARIANT) + ")", KIND_VARIANT);
+		} break;
+		case GDScriptFunctions::LOGIC_MIN:
+		case GDScriptFunctions::LOGIC_MAX: {
+			if (args.size() != 2) {
+				break;
+			}
+			String name = p_function == GDScriptFunctions::LOGIC_MIN ? "_gd_min" : "_gd_max";
+			if (integers) {
+				return Expression(name + "i(" + args[0].code + ", " + args[1].code + ")", KIND_INT);
+			}
+			if (numeric) {
+				return Expression(name + "f(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ")", KIND_REAL);
+			}
+			return Expression(name + "(" + _as(args[0], KIND_VARIANT) + ", " + _as(args[1], KIND_VARIANT) + ")", KIND_VARIANT);
+		} break;
+		case GDScriptFunctions::LOGIC_CLAMP: {
+			if (args.size() != 3) {
+				break;
+			}
+			if (integers) {
+				return Expression("_gd_clampi(" + args[0].code + ", " + args[1].code + ", " + args[2].code + ")", KIND_INT);
+			}
+			if (numeric) {
+				return Expression("_gd_clampf(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ", " + _as(args[2], KIND_REAL) + ")", KIND_REAL);
+			}
+			return Expression("_gd_clamp(" + _as(args[0], KIND_VARIANT) + ", " + _as(args[1], KIND_VARIANT) + ", " + _as(args[2], KIND_VARIANT) + ")", KIND_VARIANT);
+		} break;
+		default: {
+		}
+	}
+
+	_set_error("Built-in function '" + String(GDScriptFunctions::get_func_name(p_function)) + "' can't be transpiled.", p_op);
+	return Expression();
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_construct(Variant::Type p_type, const GDScriptParser::OperatorNode *p_op) {
+
+	Vector<Expression> args;
+	for (int i = 1; i < p_op->arguments.size(); i++) {
+		args.push_back(_expression(p_op->arguments[i]));
+	}
+
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::REAL: {
+			Kind kind = p_type == Variant::BOOL ? KIND_BOOL : (p_type == Variant::INT ? KIND_INT : KIND_REAL);
+			if (args.size() == 0) {
+				return Expression(_zero(kind), kind);
+			}
+			if (args.size() == 1) {
+				return _convert(args[0], kind);
+			}
+		} break;
+		case Variant::STRING: {
+			if (args.size() == 0) {
+				return Expression("Var::string(\"\")", KIND_VARIANT);
+			}
+			if (args.size() == 1) {
+				return Expression("_gd_str(" + _as(args[0], KIND_VARIANT) + ")", KIND_VARIANT);
+			}
+		} break;
+		case Variant::VECTOR2: {
+			if (args.size() == 0) {
+				return Expression("Var::vector2(0.0, 0.0)", KIND_VARIANT);
+			}
+			if (args.size() == 2) {
+				return Expression("Var::vector2(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ")", KIND_VARIANT);
+			}
+		} break;
+		case Variant::VECTOR3: {
+			if (args.size() == 0) {
+				return Expression("Var::vector3(0.0, 0.0, 0.0)", KIND_VARIANT);
+			}
+			if (args.size() == 3) {
+				return Expression("Var::vector3(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ", " + _as(args[2], KIND_REAL) + ")", KIND_VARIANT);
+			}
+		} break;
+		case Variant::COLOR: {
+			if (args.size() == 3 || args.size() == 4) {
+				String alpha = args.size() == 4 ? _as(args[3], KIND_REAL) : String("1.0");
+				return Expression("Var::color(" + _as(args[0], KIND_REAL) + ", " + _as(args[1], KIND_REAL) + ", " + _as(args[2], KIND_REAL) + ", " + alpha + ")", KIND_VARIANT);
+			}
+		} break;
+		case Variant::ARRAY: {
+			if (args.size() == 0) {
+				return Expression("Var::array()", KIND_VARIANT);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			if (args.size() == 0) {
+				return Expression("Var::dictionary()", KIND_VARIANT);
+			}
+		} break;
+		default: {
+		}
+	}
+
+	_set_error("Constructing '" + Variant::get_type_name(p_type) + "' with " + itos(args.size()) + " arguments can't be transpiled.", p_op);
+	return Expression();
+}
+
+GDScriptTranspiler::Expression GDScriptTranspiler::_expression(const GDScriptParser::Node *p_node) {
+
+	if (error_set) {
+		return Expression();
+	}
+
+	switch (p_node->type) {
+		case GDScriptParser::Node::TYPE_CONSTANT: {
+			return _constant(static_cast<const GDScriptParser::ConstantNode *>(p_node)->value, p_node);
+		} break;
+		case GDScriptParser::Node::TYPE_SELF: {
+			return Expression("Var::object(owner)", KIND_VARIANT);
+		} break;
+		case GDScriptParser::Node::TYPE_IDENTIFIER: {
+			return _identifier(static_cast<const GDScriptParser::IdentifierNode *>(p_node));
+		} break;
+		case GDScriptParser::Node::TYPE_OPERATOR: {
+			return _operator(static_cast<const GDScriptParser::OperatorNode *>(p_node));
+		} break;
+		case GDScriptParser::Node::TYPE_ARRAY: {
+			const GDScriptParser::ArrayNode *an = static_cast<const GDScriptParser::ArrayNode *>(p_node);
+			String code = "([&]() { Var _a = Var::array();";
+			for (int i = 0; i < an->elements.size(); i++) {
+				code += " _gd_call(_a, \"push_back\", " + _as(_expression(an->elements[i]), KIND_VARIANT) + ");";
+			}
+			return Expression(code + " return _a; }())", KIND_VARIANT);
+		} break;
+		case GDScriptParser::Node::TYPE_DICTIONARY: {
+			const GDScriptParser::DictionaryNode *dn = static_cast<const GDScriptParser::DictionaryNode *>(p_node);
+			String code = "([&]() { Var _d = Var::dictionary();";
+			for (int i = 0; i < dn->elements.size(); i++) {
+				code += " _gd_set_indexed(_d, " + _as(_expression(dn->elements[i].key), KIND_VARIANT) + ", " + _as(_expression(dn->elements[i].value), KIND_VARIANT) + ");";
+			}
+			return Expression(code + " return _d; }())", KIND_VARIANT);
+		} break;
+		case GDScriptParser::Node::TYPE_CAST: {
+			const GDScriptParser::CastNode *cn = static_cast<const GDScriptParser::CastNode *>(p_node);
+			Expression source_expr = _expression(cn->source_node);
+			if (cn->cast_type.kind == GDScriptParser::DataType::BUILTIN) {
+				if (cn->cast_type.builtin_type == Variant::STRING) {
+					return Expression("_gd_str(" + _as(source_expr, KIND_VARIANT) + ")", KIND_VARIANT);
+				}
+				return _convert(source_expr, _kind_from_type(cn->cast_type));
+			}
+			if (cn->cast_type.kind == GDScriptParser::DataType::NATIVE) {
+				return Expression("_gd_cast_object(" + _as(source_expr, KIND_VARIANT) + ", " + _string(cn->cast_type.native_type) + ")", KIND_VARIANT);
+			}
+			_set_error("Only casts to built-in types and native classes can be transpiled.", p_node);
+		} break;
+		default: {
+			_set_error("Expression can't be transpiled.", p_node);
+		}
+	}
+
+	return Expression();
+}
+
+void GDScriptTranspiler::_store(const GDScriptParser::Node *p_target, const Expression &p_value) {
+
+	if (p_target->type == GDScriptParser::Node::TYPE_IDENTIFIER) {
+		StringName name = static_cast<const GDScriptParser::IdentifierNode *>(p_target)->name;
+		Kind kind;
+		if (_find_local(name, &kind)) {
+			_line("l_" + String(name) + " = " + _unwrap(_as(p_value, kind)) + ";");
+			return;
+		}
+		if (members.has(name)) {
+			_line("m_" + String(name) + " = " + _unwrap(_as(p_value, members[name].kind)) + ";");
+			return;
+		}
+		if (ClassDB::has_property(base_class, name)) {
+			_line("_gd_set_property(owner, " + _string(name) + ", " + _as(p_value, KIND_VARIANT) + ");");
+			return;
+		}
+
+	} else if (p_target->type == GDScriptParser::Node::TYPE_OPERATOR) {
+		const GDScriptParser::OperatorNode *op = static_cast<const GDScriptParser::OperatorNode *>(p_target);
+
+		if (op->op == GDScriptParser::OperatorNode::OP_INDEX_NAMED && op->arguments[0]->type == GDScriptParser::Node::TYPE_SELF) {
+			StringName name = static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name;
+			if (members.has(name)) {
+				const Member &member = members[name];
+				if (member.setter != StringName() && functions.has(member.setter)) {
+					const GDScriptParser::FunctionNode *setter = functions[member.setter];
+					Kind kind = setter->argument_types.size() ? _kind_from_type(setter->argument_types[0]) : KIND_VARIANT;
+					_line("f_" + String(member.setter) + "(" + _unwrap(_as(p_value, kind)) + ");");
+				} else {
+					_line("m_" + String(name) + " = " + _unwrap(_as(p_value, member.kind)) + ";");
+				}
+			} else {
+				_line("_gd_set_property(owner, " + _string(name) + ", " + _as(p_value, KIND_VARIANT) + ");");
+			}
+			return;
+		}
+
+		if (op->op == GDScriptParser::OperatorNode::OP_INDEX_NAMED || op->op == GDScriptParser::OperatorNode::OP_INDEX) {
+			String base = _temp();
+			_line("{");
+			indent++;
+			_line("Var " + base + " = " + _unwrap(_as(_expression(op->arguments[0]), KIND_VARIANT)) + ";");
+			if (op->op == GDScriptParser::OperatorNode::OP_INDEX_NAMED) {
+				StringName name = static_cast<const GDScriptParser::IdentifierNode *>(op->arguments[1])->name;
+				_line("_gd_set_named(" + base + ", " + _string(name) + ", " + _as(p_value, KIND_VARIANT) + ");");
+			} else {
+				_line("_gd_set_indexed(" + base + ", " + _as(_expression(op->arguments[1]), KIND_VARIANT) + ", " + _as(p_value, KIND_VARIANT) + ");");
+			}
+
+			// Built-in types are values, so a modified vector has to be written back to where it came from.
+			const GDScriptParser::Node *parent = op->arguments[0];
+			bool writable = parent->type == GDScriptParser::Node::TYPE_IDENTIFIER;
+			if (parent->type == GDScriptParser::Node::TYPE_OPERATOR) {
+				GDScriptParser::OperatorNode::Operator parent_op = static_cast<const GDScriptParser::OperatorNode *>(parent)->op;
+				writable = parent_op == GDScriptParser::OperatorNode::OP_INDEX || parent_op == GDScriptParser::OperatorNode::OP_INDEX_NAMED;
+			}
+			if (writable) {
+				_store(parent, Expression(base, KIND_VARIANT));
+			}
+
+			indent--;
+			_line("}");
+			return;
+		}
+	}
+
+	_set_error("Invalid assignment target.", p_target);
+}
+
+void GDScriptTranspiler::_assign(const GDScriptParser::OperatorNode *p_op) {
+
+	const GDScriptParser::Node *target = p_op->arguments[0];
+	Expression value = _expression(p_op->arguments[1]);
+
+	GDScriptParser::OperatorNode::Operator op;
+	switch (p_op->op) {
+		case GDScriptParser::OperatorNode::OP_INIT_ASSIGN:
+		case GDScriptParser::OperatorNode::OP_ASSIGN: {
+			_store(target, value);
+			return;
+		} break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_ADD: op = GDScriptParser::OperatorNode::OP_ADD; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SUB: op = GDScriptParser::OperatorNode::OP_SUB; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_MUL: op = GDScriptParser::OperatorNode::OP_MUL; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_DIV: op = GDScriptParser::OperatorNode::OP_DIV; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_MOD: op = GDScriptParser::OperatorNode::OP_MOD; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_LEFT: op = GDScriptParser::OperatorNode::OP_SHIFT_LEFT; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_SHIFT_RIGHT: op = GDScriptParser::OperatorNode::OP_SHIFT_RIGHT; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_AND: op = GDScriptParser::OperatorNode::OP_BIT_AND; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_OR: op = GDScriptParser::OperatorNode::OP_BIT_OR; break;
+		case GDScriptParser::OperatorNode::OP_ASSIGN_BIT_XOR: op = GDScriptParser::OperatorNode::OP_BIT_XOR; break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+
+	_store(target, _binary(op, _expression(target), value));
+}
+
+void GDScriptTranspiler::_for(const GDScriptParser::ControlFlowNode *p_cf) {
+
+	const GDScriptParser::IdentifierNode *id = static_cast<const GDScriptParser::IdentifierNode *>(p_cf->arguments[0]);
+	const GDScriptParser::Node *container = p_cf->arguments[1];
+	Kind kind = _kind_from_type(id->get_datatype());
+	String n = itos(temp_count++);
+
+	// The parser turns range() into an int or vector constructor, both iterate
+	// as an integer range. Those and plain numbers become native loops.
+	String from, to, step;
+	if (container->type == GDScriptParser::Node::TYPE_OPERATOR) {
+		const GDScriptParser::OperatorNode *op = static_cast<const GDScriptParser::OperatorNode *>(container);
+		if (op->op == GDScriptParser::OperatorNode::OP_CALL && op->arguments[0]->type == GDScriptParser::Node::TYPE_TYPE) {
+			Variant::Type type = static_cast<const GDScriptParser::TypeNode *>(op->arguments[0])->vtype;
+			int argc = op->arguments.size() - 1;
+			if (type == Variant::INT && argc == 1) {
+				from = "0";
+				to = _as(_expression(op->arguments[1]), KIND_INT);
+			} else if ((type == Variant::VECTOR2 && argc == 2) || (type == Variant::VECTOR3 && argc == 3)) {
+				from = _as(_expression(op->arguments[1]), KIND_INT);
+				to = _as(_expression(op->arguments[2]), KIND_INT);
+				if (argc == 3) {
+					step = _as(_expression(op->arguments[3]), KIND_INT);
+				}
+			}
+		}
+	}
+
+	Expression iterable;
+	if (to.empty()) {
+		iterable = _expression(container);
+		if (iterable.kind == KIND_INT || iterable.kind == KIND_REAL) {
+			from = "0";
+			to = _as(iterable, KIND_INT);
+		}
+	}
+
+	_line("{");
+	indent++;
+
+	String index = "_i" + n;
+	if (!to.empty()) {
+		_line("const int64_t _from" + n + " = " + _unwrap(from) + ";");
+		_line("const int64_t _to" + n + " = " + _unwrap(to) + ";");
+		if (step.empty()) {
+			_line("for (int64_t " + index + " = _from" + n + "; " + index + " < _to" + n + "; " + index + "++) {");
+		} else {
+			_line("const int64_t _step" + n + " = " + _unwrap(step) + ";");
+			_line("for (int64_t " + index + " = _from" + n + "; _step" + n + " > 0 ? " + index + " < _to" + n + " : (_step" + n + " < 0 && " + index + " > _to" + n + "); " + index + " += _step" + n + ") {");
+		}
+		indent++;
+		_line(_ctype(kind) + " l_" + String(id->name) + " = " + _unwrap(_as(Expression(index, KIND_INT), kind)) + ";");
+	} else {
+		// Anything else is walked as an array, dictionaries by their keys.
+		_line("const Var _iter" + n + " = _gd_iterable(" + _unwrap(_as(iterable, KIND_VARIANT)) + ");");
+		_line("const int64_t _size" + n + " = _gd_size(_iter" + n + ");");
+		_line("for (int64_t " + index + " = 0; " + index + " < _size" + n + "; " + index + "++) {");
+		indent++;
+		_line(_ctype(kind) + " l_" + String(id->name) + " = " + _as(Expression("_gd_get_indexed(_iter" + n + ", Var(" + index + "))", KIND_VARIANT), kind) + ";");
+	}
+
+	_push_scope();
+	_declare_local(id->name, kind);
+	_block(p_cf->body);
+	_pop_scope();
+
+	indent--;
+	_line("}");
+	indent--;
+	_line("}");
+}
+
+void GDScriptTranspiler::_statement(const GDScriptParser::Node *p_node) {
+
+	if (error_set || skip_statements.has(p_node)) {
+		return;
+	}
+
+	switch (p_node->type) {
+		case GDScriptParser::Node::TYPE_NEWLINE:
+		case GDScriptParser::Node::TYPE_BREAKPOINT: {
+		} break;
+		case GDScriptParser::Node::TYPE_LOCAL_VAR: {
+			const GDScriptParser::LocalVarNode *lv = static_cast<const GDScriptParser::LocalVarNode *>(p_node);
+			Kind kind = _kind_from_type(lv->datatype);
+			// The initializer is emitted before the name is visible, "var a = a" reads the outer one.
+			String init = lv->assign ? _as(_expression(lv->assign), kind) : _zero(kind);
+			_line(_ctype(kind) + " l_" + String(lv->name) + " = " + _unwrap(init) + ";");
+			_declare_local(lv->name, kind);
+			if (lv->assign_op) {
+				skip_statements.insert(lv->assign_op);
+			}
+		} break;
+		case GDScriptParser::Node::TYPE_OPERATOR: {
+			const GDScriptParser::OperatorNode *op = static_cast<const GDScriptParser::OperatorNode *>(p_node);
+			if (op->op >= GDScriptParser::OperatorNode::OP_INIT_ASSIGN && op->op <= GDScriptParser::OperatorNode::OP_ASSIGN_BIT_XOR) {
+				_assign(op);
+				break;
+			}
+			Expression expr = _expression(op);
+			_line((op->op == GDScriptParser::OperatorNode::OP_CALL ? "" : "(void)") + expr.code + ";");
+		} break;
+		case GDScriptParser::Node::TYPE_CONTROL_FLOW: {
+			const GDScriptParser::ControlFlowNode *cf = static_cast<const GDScriptParser::ControlFlowNode *>(p_node);
+			switch (cf->cf_type) {
+				case GDScriptParser::ControlFlowNode::CF_IF: {
+					_line("if (" + _unwrap(_as(_expression(cf->arguments[0]), KIND_BOOL)) + ") {");
+					indent++;
+					_block(cf->body);
+					indent--;
+					if (cf->body_else) {
+						_line("} else {");
+						indent++;
+						_block(cf->body_else);
+						indent--;
+					}
+					_line("}");
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_WHILE: {
+					_line("while (" + _unwrap(_as(_expression(cf->arguments[0]), KIND_BOOL)) + ") {");
+					indent++;
+					_block(cf->body);
+					indent--;
+					_line("}");
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_FOR: {
+					_for(cf);
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_BREAK: {
+					_line("break;");
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_CONTINUE: {
+					_line("continue;");
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_RETURN: {
+					if (cf->arguments.size()) {
+						_line("return " + _unwrap(_as(_expression(cf->arguments[0]), return_kind)) + ";");
+					} else {
+						_line("return " + _zero(return_kind) + ";");
+					}
+				} break;
+				case GDScriptParser::ControlFlowNode::CF_MATCH: {
+					_set_error("'match' statements can't be transpiled.", p_node);
+				} break;
+			}
+		} break;
+		case GDScriptParser::Node::TYPE_ASSERT: {
+			const GDScriptParser::AssertNode *an = static_cast<const GDScriptParser::AssertNode *>(p_node);
+			_line("if (!" + _as(_expression(an->condition), KIND_BOOL) + ") {");
+			indent++;
+			_line("_gd_error(\"Assertion failed.\");");
+			indent--;
+			_line("}");
+		} break;
+		default: {
+			Expression expr = _expression(p_node);
+			_line("(void)" + expr.code + ";");
+		}
+	}
+}
+
+void GDScriptTranspiler::_block(const GDScriptParser::BlockNode *p_block) {
+
+	_push_scope();
+	for (const List<GDScriptParser::Node *>::Element *E = p_block->statements.front(); E; E = E->next()) {
+		_statement(E->get());
+	}
+	_pop_scope();
+}
+
+String GDScriptTranspiler::_signature(const GDScriptParser::FunctionNode *p_function, bool p_qualified) const {
+
+	String signature = _ctype(_kind_from_type(p_function->return_type)) + " ";
+	if (p_qualified) {
+		signature += class_name + "::";
+	}
+	signature += "f_" + String(p_function->name) + "(";
+	for (int i = 0; i < p_function->arguments.size(); i++) {
+		if (i > 0) {
+			signature += ", ";
+		}
+		signature += _ctype(_kind_from_type(p_function->argument_types[i])) + " l_" + String(p_function->arguments[i]);
+	}
+	return signature + ")";
+}
+
+void GDScriptTranspiler::_function(const GDScriptParser::FunctionNode *p_function) {
+
+	return_kind = _kind_from_type(p_function->return_type);
+
+	_line(_signature(p_function, true) + " {");
+	indent++;
+
+	_push_scope();
+	for (int i = 0; i < p_function->arguments.size(); i++) {
+		_declare_local(p_function->arguments[i], _kind_from_type(p_function->argument_types[i]));
+	}
+
+	// onready members are initialized right before _ready() runs.
+	if (p_function->name == "_ready" && class_node->ready) {
+		_block(class_node->ready);
+	}
+	if (p_function->body) {
+		_block(p_function->body);
+	}
+	_pop_scope();
+
+	if (!p_function->body || !p_function->body->has_return) {
+		_line("return " + _zero(return_kind) + ";");
+	}
+
+	indent--;
+	_line("}");
+	_line("");
+}
+
+void GDScriptTranspiler::_method_wrapper(const GDScriptParser::FunctionNode *p_function) {
+
+	String name = p_function->name;
+	int total = p_function->arguments.size();
+	int required = total - p_function->default_values.size();
+
+	_line("GDCALLINGCONV godot_variant " + class_name + "_method_" + name + "(godot_object *p_instance, void *p_method_data, void *p_user_data, int p_num_args, godot_variant **p_args) {");
+	indent++;
+	_line(class_name + " *instance = (" + class_name + " *)p_user_data;");
+	_line("if (p_num_args < " + itos(required) + " || p_num_args > " + itos(total) + ") {");
+	_line("\t_gd_error(" + _string("Invalid number of arguments when calling '" + name + "'.") + ");");
+	_line("\treturn _gd_return(Var());");
+	_line("}");
+
+	String call = "instance->f_" + name + "(";
+	for (int i = 0; i < total; i++) {
+		Kind kind = _kind_from_type(p_function->argument_types[i]);
+		String arg = _as(Expression("Var(p_args[" + itos(i) + "])", KIND_VARIANT), kind);
+		if (i >= required) {
+			const GDScriptParser::Node *default_value = static_cast<const GDScriptParser::OperatorNode *>(p_function->default_values[i - required])->arguments[1];
+			if (default_value->type != GDScriptParser::Node::TYPE_CONSTANT) {
+				_set_error("Default argument values must be constant to be transpiled.", default_value);
+				return;
+			}
+			arg = "(p_num_args > " + itos(i) + " ? " + arg + " : " + _as(_expression(default_value), kind) + ")";
+		}
+		call += (i > 0 ? ", " : "") + arg;
+	}
+	call += ")";
+
+	_line("return _gd_return(" + _as(Expression(call, _kind_from_type(p_function->return_type)), KIND_VARIANT) + ");");
+	indent--;
+	_line("}");
+	_line("");
+}
+
+void GDScriptTranspiler::_property_accessors(const GDScriptParser::ClassNode::Member &p_member) {
+
+	String name = p_member.identifier;
+	const Member &member = members[p_member.identifier];
+
+	_line("GDCALLINGCONV godot_variant " + class_name + "_get_" + name + "(godot_object *p_instance, void *p_method_data, void *p_user_data) {");
+	indent++;
+	_line(class_name + " *instance = (" + class_name + " *)p_user_data;");
+	if (member.getter != StringName() && functions.has(member.getter)) {
+		_line("return _gd_return(" + _as(Expression("instance->f_" + String(member.getter) + "()", _kind_from_type(functions[member.getter]->return_type)), KIND_VARIANT) + ");");
+	} else {
+		_line("return _gd_return(" + _as(Expression("instance->m_" + name, member.kind), KIND_VARIANT) + ");");
+	}
+	indent--;
+	_line("}");
+	_line("");
+
+	_line("GDCALLINGCONV void " + class_name + "_set_" + name + "(godot_object *p_instance, void *p_method_data, void *p_user_data, godot_variant *p_value) {");
+	indent++;
+	_line(class_name + " *instance = (" + class_name + " *)p_user_data;");
+	if (member.setter != StringName() && functions.has(member.setter)) {
+		const GDScriptParser::FunctionNode *setter = functions[member.setter];
+		Kind kind = setter->argument_types.size() ? _kind_from_type(setter->argument_types[0]) : KIND_VARIANT;
+		_line("instance->f_" + String(member.setter) + "(" + _as(Expression("Var(p_value)", KIND_VARIANT), kind) + ");");
+	} else {
+		_line("instance->m_" + name + " = " + _as(Expression("Var(p_value)", KIND_VARIANT), member.kind) + ";");
+	}
+	indent--;
+	_line("}");
+	_line("");
+}
+
+void GDScriptTranspiler::_register() {
+
+	_line("void godot_transpiled_register_" + class_name + "(void *p_handle, const godot_gdnative_core_api_struct *p_api, const godot_gdnative_ext_nativescript_api_struct *p_nativescript_api) {");
+	indent++;
+	_line("api = p_api;");
+	_line("api_1_1 = (const godot_gdnative_core_1_1_api_struct *)p_api->next;");
+	_line("nativescript_api = p_nativescript_api;");
+	_line("");
+	_line("godot_instance_create_func create = { NULL, NULL, NULL };");
+	_line("create.create_func = &" + class_name + "_create;");
+	_line("godot_instance_destroy_func destroy = { NULL, NULL, NULL };");
+	_line("destroy.destroy_func = &" + class_name + "_destroy;");
+	String register_class = class_node->tool ? "godot_nativescript_register_tool_class" : "godot_nativescript_register_class";
+	_line("nativescript_api->" + register_class + "(p_handle, " + _string(class_name) + ", " + _string(base_class) + ", create, destroy);");
+	_line("");
+
+	for (Map<StringName, const GDScriptParser::FunctionNode *>::Element *E = functions.front(); E; E = E->next()) {
+		_line("_gd_register_method(p_handle, " + _string(class_name) + ", " + _string(E->key()) + ", " + itos(E->get()->rpc_mode) + ", &" + class_name + "_method_" + String(E->key()) + ");");
+	}
+
+	for (int i = 0; i < class_node->variables.size(); i++) {
+		const GDScriptParser::ClassNode::Member &m = class_node->variables[i];
+		String name = m.identifier;
+
+		int type = m.data_type.has_type && m.data_type.kind == GDScriptParser::DataType::BUILTIN ? int(m.data_type.builtin_type) : int(Variant::NIL);
+		int hint = PROPERTY_HINT_NONE;
+		String hint_string;
+		int usage = PROPERTY_USAGE_SCRIPT_VARIABLE;
+		if (m._export.type != Variant::NIL) {
+			type = m._export.type;
+			hint = m._export.hint;
+			hint_string = m._export.hint_string;
+			usage = m._export.usage;
+		}
+		String default_value = _is_constant_supported(m.default_value) ? _as(_constant(m.default_value, NULL), KIND_VARIANT) : String("Var()");
+
+		_line("_gd_register_property(p_handle, " + _string(class_name) + ", " + _string(name) + ", " + itos(type) + ", " + itos(hint) + ", " + _string(hint_string) + ", " + itos(usage) + ", " + default_value + ", &" + class_name + "_set_" + name + ", &" + class_name + "_get_" + name + ");");
+	}
+
+	for (int i = 0; i < class_node->_signals.size(); i++) {
+		const GDScriptParser::ClassNode::Signal &s = class_node->_signals[i];
+		if (s.arguments.empty()) {
+			_line("_gd_register_signal(p_handle, " + _string(class_name) + ", " + _string(s.name) + ", 0, NULL);");
+			continue;
+		}
+		String args;
+		for (int j = 0; j < s.arguments.size(); j++) {
+			args += (j > 0 ? ", " : "") + _string(s.arguments[j]);
+		}
+		_line("{");
+		_line("\tconst char *args[] = { " + args + " };");
+		_line("\t_gd_register_signal(p_handle, " + _string(class_name) + ", " + _string(s.name) + ", " + itos(s.arguments.size()) + ", args);");
+		_line("}");
+	}
+
+	indent--;
+	_line("}");
+}
+
+void GDScriptTranspiler::_class(const GDScriptParser::ClassNode *p_class) {
+
+	class_node = p_class;
+
+	if (p_class->subclasses.size()) {
+		_set_error("Scripts with inner classes can't be transpiled.", p_class->subclasses[0]);
+		return;
+	}
+	if (p_class->base_type.kind != GDScriptParser::DataType::NATIVE) {
+		_set_error("Only scripts extending a native class can be transpiled.", p_class);
+		return;
+	}
+
+	base_class = p_class->base_type.native_type;
+	if (base_class.begins_with("_")) {
+		base_class = base_class.substr(1, base_class.length());
+	}
+	class_name = _ident(p_class->name != StringName() ? String(p_class->name) : script_path.get_file().get_basename().capitalize().replace(" ", ""));
+
+	for (int i = 0; i < p_class->variables.size(); i++) {
+		const GDScriptParser::ClassNode::Member &m = p_class->variables[i];
+		Member member;
+		member.kind = _kind_from_type(m.data_type);
+		member.setter = m.setter;
+		member.getter = m.getter;
+		members[m.identifier] = member;
+	}
+
+	for (int i = 0; i < p_class->functions.size(); i++) {
+		functions[p_class->functions[i]->name] = p_class->functions[i];
+	}
+	for (int i = 0; i < p_class->static_functions.size(); i++) {
+		functions[p_class->static_functions[i]->name] = p_class->static_functions[i];
+	}
+	for (Map<StringName, const GDScriptParser::FunctionNode *>::Element *E = functions.front(); E; E = E->next()) {
+		if (E->get()->has_yield) {
+			_set_error("Functions using 'yield' can't be transpiled.", E->get());
+			return;
+		}
+	}
+
+	// onready members need a _ready() to be initialized in.
+	GDScriptParser::FunctionNode *ready = NULL;
+	if (p_class->ready && p_class->ready->statements.size() && !functions.has("_ready")) {
+		ready = memnew(GDScriptParser::FunctionNode);
+		ready->name = "_ready";
+		ready->line = p_class->line;
+		ready->body = NULL;
+		functions["_ready"] = ready;
+	}
+
+	const GDScriptParser::FunctionNode *init = functions.has("_init") ? functions["_init"] : NULL;
+	if (init && init->arguments.size() > init->default_values.size()) {
+		_set_error("'_init' can't take required arguments in transpiled scripts.", init);
+	}
+
+	// Class declaration.
+	_line("struct " + class_name + " {");
+	indent++;
+	_line("godot_object *owner;");
+	for (int i = 0; i < p_class->variables.size(); i++) {
+		const GDScriptParser::ClassNode::Member &m = p_class->variables[i];
+		_line(_ctype(members[m.identifier].kind) + " m_" + String(m.identifier) + ";");
+	}
+	_line("");
+	_line(class_name + "(godot_object *p_owner);");
+	for (Map<StringName, const GDScriptParser::FunctionNode *>::Element *E = functions.front(); E; E = E->next()) {
+		_line(_signature(E->get(), false) + ";");
+	}
+	indent--;
+	_line("};");
+	_line("");
+
+	// Constructor, runs the member initializers.
+	return_kind = KIND_VARIANT;
+	_line(class_name + "::" + class_name + "(godot_object *p_owner) {");
+	indent++;
+	_line("owner = p_owner;");
+	for (int i = 0; i < p_class->variables.size(); i++) {
+		const GDScriptParser::ClassNode::Member &m = p_class->variables[i];
+		Kind kind = members[m.identifier].kind;
+		if (kind != KIND_VARIANT) {
+			_line("m_" + String(m.identifier) + " = " + _zero(kind) + ";");
+		}
+	}
+	if (p_class->initializer) {
+		_block(p_class->initializer);
+	}
+	indent--;
+	_line("}");
+	_line("");
+
+	for (Map<StringName, const GDScriptParser::FunctionNode *>::Element *E = functions.front(); E; E = E->next()) {
+		_function(E->get());
+	}
+
+	// GDNative glue.
+	_line("GDCALLINGCONV void *" + class_name + "_create(godot_object *p_instance, void *p_method_data) {");
+	indent++;
+	_line(class_name + " *instance = new " + class_name + "(p_instance);");
+	if (init && !error_set) {
+		String call = "instance->f__init(";
+		for (int i = 0; i < init->arguments.size(); i++) {
+			const GDScriptParser::Node *default_value = static_cast<const GDScriptParser::OperatorNode *>(init->default_values[i])->arguments[1];
+			call += (i > 0 ? ", " : "") + _as(_expression(default_value), _kind_from_type(init->argument_types[i]));
+		}
+		_line(call + ");");
+	}
+	_line("return instance;");
+	indent--;
+	_line("}");
+	_line("");
+	_line("GDCALLINGCONV void " + class_name + "_destroy(godot_object *p_instance, void *p_method_data, void *p_user_data) {");
+	_line("\tdelete (" + class_name + " *)p_user_data;");
+	_line("}");
+	_line("");
+
+	for (Map<StringName, const GDScriptParser::FunctionNode *>::Element *E = functions.front(); E; E = E->next()) {
+		_method_wrapper(E->get());
+	}
+	for (int i = 0; i < p_class->variables.size(); i++) {
+		_property_accessors(p_class->variables[i]);
+	}
+
+	_line("} // namespace");
+	_line("");
+	_register();
+
+	if (ready) {
+		memdelete(ready);
+	}
+}
+
+Error GDScriptTranspiler::transpile(const String &p_path, String &r_code) {
+
+	Error err;
+	String code = FileAccess::get_file_as_string(p_path, &err);
+	if (err != OK) {
+		error = "Can't open script file: " + p_path;
+		return err;
+	}
+
+	return transpile_source(code, p_path, r_code);
+}
+
+Error GDScriptTranspiler::transpile_source(const String &p_source, const String &p_path, String &r_code) {
+
+	GDScriptParser parser;
+	Error err = parser.parse(p_source, p_path.get_base_dir(), false, p_path);
+	if (err != OK) {
+		error = parser.get_error();
+		error_line = parser.get_error_line();
+		return err;
+	}
+
+	script_path = p_path;
+
+	_line("/* Generated from " + p_path + " by \"godot --gdscript-transpile\". Do not edit. */");
+	_line("");
+	_line("#include <gdnative_api_struct.gen.h>");
+	_line("");
+	_line("#include <math.h>");
+	_line("#include <stdint.h>");
+	_line("#include <stdio.h>");
+	_line("#include <stdlib.h>");
+	_line("");
+	_line("namespace {");
+	_line("");
+	_line("const char *script_path = " + _string(p_path) + ";");
+	_line("");
+	_line("const godot_gdnative_core_api_struct *api = NULL;");
+	_line("const godot_gdnative_core_1_1_api_struct *api_1_1 = NULL;");
+	_line("const godot_gdnative_ext_nativescript_api_struct *nativescript_api = NULL;");
+	_line("");
+	for (int i = 0; _runtime[i]; i++) {
+		_line(_runtime[i]);
+	}
+	_line("");
+
+	_class(static_cast<const GDScriptParser::ClassNode *>(parser.get_parse_tree()));
+
+	if (error_set) {
+		return ERR_COMPILATION_FAILED;
+	}
+
+	// Entry points, leave them out when linking several scripts into one library.
+	_line("");
+	_line("#ifndef GODOT_TRANSPILED_NO_ENTRY_POINTS");
+	_line("");
+	_line("extern \"C\" void GDN_EXPORT godot_gdnative_init(godot_gdnative_init_options *p_options) {");
+	_line("\tapi = p_options->api_struct;");
+	_line("\tfor (unsigned int i = 0; i < api->num_extensions; i++) {");
+	_line("\t\tif (api->extensions[i]->type == GDNATIVE_EXT_NATIVESCRIPT) {");
+	_line("\t\t\tnativescript_api = (const godot_gdnative_ext_nativescript_api_struct *)api->extensions[i];");
+	_line("\t\t}");
+	_line("\t}");
+	_line("}");
+	_line("");
+	_line("extern \"C\" void GDN_EXPORT godot_gdnative_terminate(godot_gdnative_terminate_options *p_options) {");
+	_line("}");
+	_line("");
+	_line("extern \"C\" void GDN_EXPORT godot_nativescript_init(void *p_handle) {");
+	_line("\tgodot_transpiled_register_" + class_name + "(p_handle, api, nativescript_api);");
+	_line("}");
+	_line("");
+	_line("#endif // GODOT_TRANSPILED_NO_ENTRY_POINTS");
+
+	r_code = String();
+	for (List<String>::Element *E = source.front(); E; E = E->next()) {
+		r_code += E->get();
+	}
+	return OK;
+}
+
+Error GDScriptTranspiler::transpile_file(const String &p_path, const String &p_output_path) {
+
+	String path = ProjectSettings::get_singleton()->localize_path(p_path);
+
+	GDScriptTranspiler transpiler;
+	String code;
+	Error err = transpiler.transpile(path, code);
+	if (err != OK) {
+		ERR_PRINTS(path + ":" + itos(transpiler.get_error_line()) + " - " + transpiler.get_error());
+		return err;
+	}
+
+	FileAccessRef file = FileAccess::open(p_output_path, FileAccess::WRITE, &err);
+	if (!file) {
+		ERR_PRINTS("Can't write transpiled script to: " + p_output_path);
+		return err;
+	}
+	file->store_string(code);
+	file->close();
+
+	print_line("Transpiled " + path + " to " + p_output_path + ".");
+	return OK;
+}
+
+GDScriptTranspiler::GDScriptTranspiler() {
+
+	class_node = NULL;
+	return_kind = KIND_VARIANT;
+	indent = 0;
+	temp_count = 0;
+	error_set = false;
+	error_line = -1;
+}
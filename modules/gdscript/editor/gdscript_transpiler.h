@@ -0,0 +1,148 @@
+/*************************************************************************/
+/*  gdscript_transpiler.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_TRANSPILER_H
+#define GDSCRIPT_TRANSPILER_H
+
+#include "../gdscript_parser.h"
+
+// Translates a statically typed script into a C++ NativeScript class written
+// against the GDNative C API, so hot code can be built into a native library
+// instead of being ported by hand. Locals, members, arguments and expressions
+// whose type is known to be int, float or bool become plain C++ values; the
+// rest is kept in godot_variant and goes through the Variant operators and
+// calls, so untyped code still behaves the same. Constructs that have no
+// GDNative equivalent (yield, match, inner classes, ...) make the translation
+// fail with an error pointing at the offending line.
+class GDScriptTranspiler {
+
+	enum Kind {
+		KIND_VARIANT,
+		KIND_INT,
+		KIND_REAL,
+		KIND_BOOL,
+	};
+
+	struct Expression {
+		String code;
+		Kind kind;
+
+		Expression() { kind = KIND_VARIANT; }
+		Expression(const String &p_code, Kind p_kind) {
+			code = p_code;
+			kind = p_kind;
+		}
+	};
+
+	struct Member {
+		Kind kind;
+		StringName setter;
+		StringName getter;
+	};
+
+	const GDScriptParser::ClassNode *class_node;
+	String script_path;
+	String class_name;
+	String base_class;
+
+	Map<StringName, Member> members;
+	Map<StringName, const GDScriptParser::FunctionNode *> functions;
+	List<Map<StringName, Kind> > scopes;
+	Set<const GDScriptParser::Node *> skip_statements;
+	Kind return_kind;
+
+	List<String> source;
+	int indent;
+	int temp_count;
+
+	bool error_set;
+	String error;
+	int error_line;
+
+	void _set_error(const String &p_error, const GDScriptParser::Node *p_node);
+	void _line(const String &p_line);
+	String _temp();
+
+	static Kind _kind_from_type(const GDScriptParser::DataType &p_type);
+	static String _ctype(Kind p_kind);
+	static String _zero(Kind p_kind);
+	static String _string(const String &p_string);
+	static String _real(double p_value);
+	static String _ident(const String &p_name);
+	static Expression _convert(const Expression &p_expr, Kind p_kind);
+	static String _as(const Expression &p_expr, Kind p_kind) { return _convert(p_expr, p_kind).code; }
+
+	void _push_scope();
+	void _pop_scope();
+	void _declare_local(const StringName &p_name, Kind p_kind);
+	bool _find_local(const StringName &p_name, Kind *r_kind) const;
+
+	bool _get_global(const StringName &p_name, Variant *r_value) const;
+	bool _get_native_class(const GDScriptParser::Node *p_node, StringName *r_class) const;
+	bool _is_constant_supported(const Variant &p_value) const;
+
+	Expression _constant(const Variant &p_value, const GDScriptParser::Node *p_node);
+	Expression _identifier(const GDScriptParser::IdentifierNode *p_identifier);
+	Expression _get_named(const GDScriptParser::OperatorNode *p_op);
+	Expression _binary(GDScriptParser::OperatorNode::Operator p_op, const Expression &p_a, const Expression &p_b);
+	Expression _operator(const GDScriptParser::OperatorNode *p_op);
+	Expression _call(const GDScriptParser::OperatorNode *p_op);
+	Expression _call_function(const GDScriptParser::FunctionNode *p_function, const GDScriptParser::OperatorNode *p_op, int p_first_arg);
+	Expression _call_built_in(GDScriptFunctions::Function p_function, const GDScriptParser::OperatorNode *p_op);
+	Expression _construct(Variant::Type p_type, const GDScriptParser::OperatorNode *p_op);
+	Expression _expression(const GDScriptParser::Node *p_node);
+
+	void _store(const GDScriptParser::Node *p_target, const Expression &p_value);
+	void _assign(const GDScriptParser::OperatorNode *p_op);
+	void _for(const GDScriptParser::ControlFlowNode *p_cf);
+	void _statement(const GDScriptParser::Node *p_node);
+	void _block(const GDScriptParser::BlockNode *p_block);
+
+	String _signature(const GDScriptParser::FunctionNode *p_function, bool p_qualified) const;
+	void _function(const GDScriptParser::FunctionNode *p_function);
+	void _method_wrapper(const GDScriptParser::FunctionNode *p_function);
+	void _property_accessors(const GDScriptParser::ClassNode::Member &p_member);
+	void _register();
+
+	void _class(const GDScriptParser::ClassNode *p_class);
+
+public:
+	Error transpile(const String &p_path, String &r_code);
+	Error transpile_source(const String &p_source, const String &p_path, String &r_code);
+
+	String get_error() const { return error; }
+	int get_error_line() const { return error_line; }
+
+	static Error transpile_file(const String &p_path, const String &p_output_path);
+
+	GDScriptTranspiler();
+};
+
+#endif // GDSCRIPT_TRANSPILER_H
@@ -37,6 +37,12 @@
 #include "core/os/os.h"
 #include "core/project_settings.h"
 #include "gdscript_compiler.h"
+#include "gdscript_preloader.h"
+#include "scene/main/node.h"
+
+#ifdef TOOLS_ENABLED
+#include "editor/gdscript_transpiler.h"
+#endif
 
 ///////////////////////////
 
@@ -180,6 +186,117 @@ Variant GDScript::_new(const Variant **p_args, int p_argcount, Variant::CallErro
 	}
 }
 
+Variant GDScript::_new_pooled(const Variant **p_args, int p_argcount, Variant::CallError &r_error) {
+
+	if (!valid) {
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_METHOD;
+		return Variant();
+	}
+
+	while (instance_pool.size()) {
+
+		ObjectID id = instance_pool[instance_pool.size() - 1];
+		instance_pool.resize(instance_pool.size() - 1);
+
+		Object *owner = ObjectDB::get_instance(id);
+		if (!owner || !owner->get_script_instance() || owner->get_script_instance()->get_script().ptr() != this) {
+			continue; //freed or script changed while pooled
+		}
+
+		if (instance_pool.empty()) {
+			_pool_list_remove();
+		}
+
+		// Already registered in ObjectDB and in instances, only run the initializer again.
+		GDScriptInstance *instance = static_cast<GDScriptInstance *>(owner->get_script_instance());
+		r_error.error = Variant::CallError::CALL_OK;
+		initializer->call(instance, p_args, p_argcount, r_error);
+
+		if (r_error.error != Variant::CallError::CALL_OK) {
+			memdelete(owner);
+			return Variant();
+		}
+
+		return owner;
+	}
+
+	return _new(p_args, p_argcount, r_error);
+}
+
+void GDScript::release_to_pool(Object *p_instance) {
+
+	ERR_FAIL_NULL(p_instance);
+	ERR_EXPLAIN("Only instances of this exact script can be released to its pool.");
+	ERR_FAIL_COND(!p_instance->get_script_instance() || p_instance->get_script_instance()->get_script().ptr() != this);
+	ERR_EXPLAIN("References are freed automatically and can't be pooled.");
+	ERR_FAIL_COND(Object::cast_to<Reference>(p_instance));
+	Node *node = Object::cast_to<Node>(p_instance);
+	ERR_EXPLAIN("Remove the node from the scene tree before releasing it to the pool.");
+	ERR_FAIL_COND(node && node->is_inside_tree());
+
+	// Drop member values now so pooled instances don't keep other objects alive.
+	GDScriptInstance *instance = static_cast<GDScriptInstance *>(p_instance->get_script_instance());
+	for (int i = 0; i < instance->members.size(); i++) {
+		instance->members.write[i] = Variant();
+	}
+
+	if (node) {
+		// onready members were cleared too, run _ready() again next time it enters the tree, like a new node would.
+		node->request_ready();
+	}
+
+	if (instance_pool.empty()) {
+		_pool_list_add();
+	}
+	instance_pool.push_back(p_instance->get_instance_id());
+}
+
+void GDScript::clear_pool() {
+
+	if (instance_pool.empty()) {
+		return;
+	}
+
+	Ref<GDScript> keep_alive(this); // freeing the last pooled instance may release the last reference
+	Vector<ObjectID> pool = instance_pool;
+	instance_pool.clear();
+	_pool_list_remove();
+
+	for (int i = 0; i < pool.size(); i++) {
+		Object *owner = ObjectDB::get_instance(pool[i]);
+		if (owner) {
+			memdelete(owner);
+		}
+	}
+}
+
+int GDScript::get_pool_count() const {
+
+	return instance_pool.size();
+}
+
+void GDScript::_pool_list_add() {
+
+#ifndef NO_THREADS
+	GDScriptLanguage::singleton->lock->lock();
+#endif
+	GDScriptLanguage::singleton->pooling_scripts.insert(this);
+#ifndef NO_THREADS
+	GDScriptLanguage::singleton->lock->unlock();
+#endif
+}
+
+void GDScript::_pool_list_remove() {
+
+#ifndef NO_THREADS
+	GDScriptLanguage::singleton->lock->lock();
+#endif
+	GDScriptLanguage::singleton->pooling_scripts.erase(this);
+#ifndef NO_THREADS
+	GDScriptLanguage::singleton->lock->unlock();
+#endif
+}
+
 bool GDScript::can_instance() const {
 
 #ifdef TOOLS_ENABLED
@@ -718,6 +835,10 @@ void GDScript::_get_property_list(List<PropertyInfo> *p_properties) const {
 void GDScript::_bind_methods() {
 
 	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "new", &GDScript::_new, MethodInfo(Variant::OBJECT, "new"));
+	ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "new_pooled", &GDScript::_new_pooled, MethodInfo(Variant::OBJECT, "new_pooled"));
+	ClassDB::bind_method(D_METHOD("release_to_pool", "instance"), &GDScript::release_to_pool);
+	ClassDB::bind_method(D_METHOD("clear_pool"), &GDScript::clear_pool);
+	ClassDB::bind_method(D_METHOD("get_pool_count"), &GDScript::get_pool_count);
 
 	ClassDB::bind_method(D_METHOD("get_as_byte_code"), &GDScript::get_as_byte_code);
 }
@@ -924,6 +1045,10 @@ GDScript::GDScript() :
 }
 
 GDScript::~GDScript() {
+	if (!instance_pool.empty()) {
+		_pool_list_remove();
+	}
+
 	for (Map<StringName, GDScriptFunction *>::Element *E = member_functions.front(); E; E = E->next()) {
 		memdelete(E->get());
 	}
@@ -1405,6 +1530,49 @@ void GDScriptLanguage::init() {
 
 		_add_global(E->get().name, E->get().ptr);
 	}
+
+#ifdef TOOLS_ENABLED
+	List<String> cmdline_args = OS::get_singleton()->get_cmdline_args();
+	List<String>::Element *transpile_arg = cmdline_args.find("--gdscript-transpile");
+	if (transpile_arg && transpile_arg->next() && transpile_arg->next()->next()) {
+		Error err = GDScriptTranspiler::transpile_file(transpile_arg->next()->get(), transpile_arg->next()->next()->get());
+		exit(err == OK ? 0 : 1);
+	}
+#endif
+
+	// Parse and compile global classes and autoload scripts on worker threads ahead of their first use.
+	bool parallel_preload = GLOBAL_DEF("application/run/parallel_script_preload", false);
+	if (parallel_preload && !Engine::get_singleton()->is_editor_hint()) {
+
+		Vector<String> paths;
+
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		for (List<StringName>::Element *E = global_classes.front(); E; E = E->next()) {
+			if (ScriptServer::get_global_class_language(E->get()) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(E->get()));
+			}
+		}
+
+		List<PropertyInfo> props;
+		ProjectSettings::get_singleton()->get_property_list(&props);
+		for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
+			if (!E->get().name.begins_with("autoload/")) {
+				continue;
+			}
+			String path = ProjectSettings::get_singleton()->get(E->get().name);
+			if (path.begins_with("*")) {
+				path = path.right(1);
+			}
+			if (!path.begins_with("res://")) {
+				path = "res://" + path;
+			}
+			paths.push_back(path);
+		}
+
+		GDScriptPreloader preloader;
+		preloader.preload(paths, &preloaded_scripts);
+	}
 }
 
 String GDScriptLanguage::get_type() const {
@@ -1421,6 +1589,12 @@ Error GDScriptLanguage::execute_file(const String &p_path) {
 	return OK;
 }
 void GDScriptLanguage::finish() {
+
+	while (pooling_scripts.size()) {
+		pooling_scripts.front()->get()->clear_pool();
+	}
+
+	preloaded_scripts.clear();
 }
 
 void GDScriptLanguage::profiling_start() {
@@ -1528,6 +1702,122 @@ int GDScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_
 	return current;
 }
 
+void GDScriptLanguage::_sampling_thread_func(void *p_ud) {
+
+	GDScriptLanguage *self = (GDScriptLanguage *)p_ud;
+
+	while (!self->sampling_quit) {
+		OS::get_singleton()->delay_usec(self->sampling_interval_usec);
+		self->_take_sample();
+	}
+}
+
+void GDScriptLanguage::_take_sample() {
+
+#ifdef DEBUG_ENABLED
+	// Functions remove themselves from function_list under this same lock when freed,
+	// so holding it keeps every function still on the call stack alive while we read it.
+	if (lock) {
+		lock->lock();
+	}
+
+	//snapshot the call stack, the main thread only holds sampling_lock while pushing or popping a level
+	Vector<GDScriptFunction *> functions;
+	sampling_lock->lock();
+	functions.resize(_debug_call_stack_pos);
+	for (int i = 0; i < functions.size(); i++) {
+		functions.write[i] = _call_stack[i].function;
+	}
+	sampling_lock->unlock();
+
+	if (functions.size()) {
+		String stack;
+		for (int i = 0; i < functions.size(); i++) {
+			GDScriptFunction *func = functions[i];
+			if (!func)
+				continue;
+			if (stack != String()) {
+				stack += ";";
+			}
+			stack += func->profile.signature != StringName() ? String(func->profile.signature) : String(func->get_name());
+		}
+
+		Map<String, uint64_t>::Element *E = sampled_stacks.find(stack);
+		if (E) {
+			E->get()++;
+		} else {
+			sampled_stacks.insert(stack, 1);
+		}
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+#endif
+}
+
+void GDScriptLanguage::profiling_sampling_start(uint64_t p_interval_usec) {
+
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND(sampling_thread);
+	ERR_FAIL_COND(p_interval_usec == 0);
+
+	if (!_call_stack) {
+		// Not debugging, so the call stack was never allocated.
+		_debug_max_call_stack = GLOBAL_GET("debug/settings/gdscript/max_call_stack");
+		_call_stack = memnew_arr(CallLevel, _debug_max_call_stack + 1);
+	}
+
+	if (lock) {
+		lock->lock();
+	}
+	sampled_stacks.clear();
+	if (lock) {
+		lock->unlock();
+	}
+
+	sampling_interval_usec = p_interval_usec;
+	sampling_quit = false;
+	sampling_lock = Mutex::create();
+	_debug_track_call_stack = true;
+	sampling_thread = Thread::create(_sampling_thread_func, this);
+#endif
+}
+
+void GDScriptLanguage::profiling_sampling_stop() {
+
+#ifdef DEBUG_ENABLED
+	if (!sampling_thread) {
+		return;
+	}
+
+	sampling_quit = true;
+	Thread::wait_to_finish(sampling_thread);
+	memdelete(sampling_thread);
+	sampling_thread = NULL;
+	memdelete(sampling_lock);
+	sampling_lock = NULL;
+	_debug_track_call_stack = ScriptDebugger::get_singleton() != NULL;
+#endif
+}
+
+void GDScriptLanguage::profiling_get_sampled_stacks(Map<String, uint64_t> *r_stacks) const {
+
+#ifdef DEBUG_ENABLED
+	if (lock) {
+		lock->lock();
+	}
+
+	for (const Map<String, uint64_t>::Element *E = sampled_stacks.front(); E; E = E->next()) {
+		(*r_stacks)[E->key()] += E->get();
+	}
+
+	if (lock) {
+		lock->unlock();
+	}
+#endif
+}
+
 struct GDScriptDepSort {
 
 	//must support sorting so inheritance works properly (parent must be reloaded first)
@@ -2111,6 +2401,11 @@ GDScriptLanguage::GDScriptLanguage() {
 	profiling = false;
 	script_frame_time = 0;
 
+	sampling_thread = NULL;
+	sampling_lock = NULL;
+	sampling_quit = false;
+	sampling_interval_usec = 0;
+
 	_debug_call_stack_pos = 0;
 	int dmcs = GLOBAL_DEF("debug/settings/gdscript/max_call_stack", 1024);
 	ProjectSettings::get_singleton()->set_custom_property_info("debug/settings/gdscript/max_call_stack", PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater")); //minimum is 1024
@@ -2119,10 +2414,12 @@ GDScriptLanguage::GDScriptLanguage() {
 		//debugging enabled!
 
 		_debug_max_call_stack = dmcs;
+		_debug_track_call_stack = true;
 		_call_stack = memnew_arr(CallLevel, _debug_max_call_stack + 1);
 
 	} else {
 		_debug_max_call_stack = 0;
+		_debug_track_call_stack = false;
 		_call_stack = NULL;
 	}
 
@@ -2139,6 +2436,8 @@ GDScriptLanguage::GDScriptLanguage() {
 
 GDScriptLanguage::~GDScriptLanguage() {
 
+	profiling_sampling_stop();
+
 	if (lock) {
 		memdelete(lock);
 		lock = NULL;
@@ -107,6 +107,7 @@ class GDScript : public Script {
 
 	int subclass_count;
 	Set<Object *> instances;
+	Vector<ObjectID> instance_pool; // released instances kept alive for reuse, see new_pooled()
 	//exported members
 	String source;
 	String path;
@@ -116,6 +117,8 @@ class GDScript : public Script {
 	GDScriptInstance *_create_instance(const Variant **p_args, int p_argcount, Object *p_owner, bool p_isref, Variant::CallError &r_error);
 
 	void _set_subclass_path(Ref<GDScript> &p_sc, const String &p_path);
+	void _pool_list_add();
+	void _pool_list_remove();
 
 #ifdef TOOLS_ENABLED
 	Set<PlaceHolderScriptInstance *> placeholders;
@@ -166,6 +169,10 @@ public:
 	StringName debug_get_member_by_index(int p_idx) const;
 
 	Variant _new(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	Variant _new_pooled(const Variant **p_args, int p_argcount, Variant::CallError &r_error);
+	void release_to_pool(Object *p_instance);
+	void clear_pool();
+	int get_pool_count() const;
 	virtual bool can_instance() const;
 
 	virtual Ref<Script> get_base_script() const;
@@ -334,6 +341,7 @@ class GDScriptLanguage : public ScriptLanguage {
 	String _debug_error;
 	int _debug_call_stack_pos;
 	int _debug_max_call_stack;
+	bool _debug_track_call_stack;
 	CallLevel *_call_stack;
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
@@ -348,9 +356,20 @@ class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunction;
 
 	SelfList<GDScriptFunction>::List function_list;
+	List<Ref<GDScript> > preloaded_scripts;
+	Set<GDScript *> pooling_scripts;
 	bool profiling;
 	uint64_t script_frame_time;
 
+	Thread *sampling_thread;
+	Mutex *sampling_lock; //guards the call stack against the sampling thread, only exists while sampling
+	volatile bool sampling_quit;
+	uint64_t sampling_interval_usec;
+	Map<String, uint64_t> sampled_stacks;
+
+	static void _sampling_thread_func(void *p_ud);
+	void _take_sample();
+
 public:
 	int calls;
 
@@ -362,22 +381,31 @@ public:
 		if (Thread::get_main_id() != Thread::get_caller_id())
 			return; //no support for other threads than main for now
 
-		if (ScriptDebugger::get_singleton()->get_lines_left() > 0 && ScriptDebugger::get_singleton()->get_depth() >= 0)
-			ScriptDebugger::get_singleton()->set_depth(ScriptDebugger::get_singleton()->get_depth() + 1);
+		ScriptDebugger *debugger = ScriptDebugger::get_singleton();
+
+		if (debugger && debugger->get_lines_left() > 0 && debugger->get_depth() >= 0)
+			debugger->set_depth(debugger->get_depth() + 1);
 
 		if (_debug_call_stack_pos >= _debug_max_call_stack) {
 			//stack overflow
 			_debug_error = "Stack Overflow (Stack Size: " + itos(_debug_max_call_stack) + ")";
-			ScriptDebugger::get_singleton()->debug(this);
+			if (debugger)
+				debugger->debug(this);
 			return;
 		}
 
+		if (sampling_lock)
+			sampling_lock->lock();
+
 		_call_stack[_debug_call_stack_pos].stack = p_stack;
 		_call_stack[_debug_call_stack_pos].instance = p_instance;
 		_call_stack[_debug_call_stack_pos].function = p_function;
 		_call_stack[_debug_call_stack_pos].ip = p_ip;
 		_call_stack[_debug_call_stack_pos].line = p_line;
 		_debug_call_stack_pos++;
+
+		if (sampling_lock)
+			sampling_lock->unlock();
 	}
 
 	_FORCE_INLINE_ void exit_function() {
@@ -385,17 +413,26 @@ public:
 		if (Thread::get_main_id() != Thread::get_caller_id())
 			return; //no support for other threads than main for now
 
-		if (ScriptDebugger::get_singleton()->get_lines_left() > 0 && ScriptDebugger::get_singleton()->get_depth() >= 0)
-			ScriptDebugger::get_singleton()->set_depth(ScriptDebugger::get_singleton()->get_depth() - 1);
+		ScriptDebugger *debugger = ScriptDebugger::get_singleton();
+
+		if (debugger && debugger->get_lines_left() > 0 && debugger->get_depth() >= 0)
+			debugger->set_depth(debugger->get_depth() - 1);
 
 		if (_debug_call_stack_pos == 0) {
 
 			_debug_error = "Stack Underflow (Engine Bug)";
-			ScriptDebugger::get_singleton()->debug(this);
+			if (debugger)
+				debugger->debug(this);
 			return;
 		}
 
+		if (sampling_lock)
+			sampling_lock->lock();
+
 		_debug_call_stack_pos--;
+
+		if (sampling_lock)
+			sampling_lock->unlock();
 	}
 
 	virtual Vector<StackInfo> debug_get_current_stack_info() {
@@ -492,6 +529,10 @@ public:
 	virtual int profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max);
 	virtual int profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max);
 
+	virtual void profiling_sampling_start(uint64_t p_interval_usec);
+	virtual void profiling_sampling_stop();
+	virtual void profiling_get_sampled_stacks(Map<String, uint64_t> *r_stacks) const;
+
 	/* LOADER FUNCTIONS */
 
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
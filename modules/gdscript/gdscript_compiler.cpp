@@ -607,8 +607,28 @@ int GDScriptCompiler::_parse_expression(CodeGen &codegen, const GDScriptParser::
 							arguments.push_back(ret);
 						}
 
-						codegen.opcodes.push_back(GDScriptFunction::OPCODE_CALL_BUILT_IN);
-						codegen.opcodes.push_back(static_cast<const GDScriptParser::BuiltInFunctionNode *>(on->arguments[0])->function);
+						GDScriptFunctions::Function func = static_cast<const GDScriptParser::BuiltInFunctionNode *>(on->arguments[0])->function;
+
+						// Math functions on arguments statically typed as numbers skip the generic call and its validation.
+						bool numeric_args = true;
+						bool all_real = true;
+						for (int i = 1; i < on->arguments.size(); i++) {
+							GDScriptParser::DataType arg_type = on->arguments[i]->get_datatype();
+							if (!arg_type.has_type || arg_type.kind != GDScriptParser::DataType::BUILTIN || (arg_type.builtin_type != Variant::REAL && arg_type.builtin_type != Variant::INT)) {
+								numeric_args = false;
+								break;
+							}
+							if (arg_type.builtin_type != Variant::REAL) {
+								all_real = false;
+							}
+						}
+
+						if (numeric_args && GDScriptFunctions::is_math_intrinsic(func, on->arguments.size() - 1, all_real)) {
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_CALL_BUILT_IN_MATH);
+						} else {
+							codegen.opcodes.push_back(GDScriptFunction::OPCODE_CALL_BUILT_IN);
+						}
+						codegen.opcodes.push_back(func);
 						codegen.opcodes.push_back(on->arguments.size() - 1);
 						codegen.alloc_call(on->arguments.size() - 1);
 						for (int i = 0; i < arguments.size(); i++)
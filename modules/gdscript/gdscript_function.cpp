@@ -210,6 +210,7 @@ static String _get_var_type(const Variant *p_type) {
 		&&OPCODE_CALL,                        \
 		&&OPCODE_CALL_RETURN,                 \
 		&&OPCODE_CALL_BUILT_IN,               \
+		&&OPCODE_CALL_BUILT_IN_MATH,          \
 		&&OPCODE_CALL_SELF,                   \
 		&&OPCODE_CALL_SELF_BASE,              \
 		&&OPCODE_YIELD,                       \
@@ -383,7 +384,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 #ifdef DEBUG_ENABLED
 
-	if (ScriptDebugger::get_singleton())
+	// Tracked when debugging or when the sampling profiler runs; remember the choice so exit matches enter.
+	bool track_call_stack = GDScriptLanguage::get_singleton()->_debug_track_call_stack;
+	if (track_call_stack)
 		GDScriptLanguage::get_singleton()->enter_function(p_instance, this, stack, &ip, &line);
 
 #define GD_ERR_BREAK(m_cond)                                                                                           \
@@ -1155,6 +1158,32 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_CALL_BUILT_IN_MATH) {
+
+				CHECK_SPACE(4);
+
+				GDScriptFunctions::Function func = GDScriptFunctions::Function(_code_ptr[ip + 1]);
+				int argc = _code_ptr[ip + 2];
+				GD_ERR_BREAK(argc < 0);
+
+				ip += 3;
+				CHECK_SPACE(argc + 1);
+				Variant **argptrs = call_args;
+
+				for (int i = 0; i < argc; i++) {
+					GET_VARIANT_PTR(v, i);
+					argptrs[i] = v;
+				}
+
+				GET_VARIANT_PTR(dst, argc);
+
+				// Argument types were checked at compile time, no call error possible.
+				GDScriptFunctions::call_math_intrinsic(func, (const Variant **)argptrs, *dst);
+
+				ip += argc + 1;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_CALL_SELF) {
 
 				OPCODE_BREAK;
@@ -1583,7 +1612,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		GDScriptLanguage::get_singleton()->script_frame_time += time_taken - function_call_time;
 	}
 
-	if (ScriptDebugger::get_singleton())
+	if (track_call_stack)
 		GDScriptLanguage::get_singleton()->exit_function();
 #endif
 
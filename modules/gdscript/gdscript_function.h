@@ -171,6 +171,7 @@ public:
 		OPCODE_CALL,
 		OPCODE_CALL_RETURN,
 		OPCODE_CALL_BUILT_IN,
+		OPCODE_CALL_BUILT_IN_MATH,
 		OPCODE_CALL_SELF,
 		OPCODE_CALL_SELF_BASE,
 		OPCODE_YIELD,
@@ -40,6 +40,39 @@
 #include "core/variant_parser.h"
 #include "gdscript.h"
 
+template <class T>
+static void _lerp_pool_array(const Variant &p_from, const Variant &p_to, real_t p_weight, Variant &r_ret, Variant::CallError &r_error) {
+
+	PoolVector<T> from = p_from;
+	PoolVector<T> to = p_to;
+
+	if (from.size() != to.size()) {
+		r_ret = RTR("Arrays passed to lerp() must have the same size.");
+		r_error.error = Variant::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 1;
+		r_error.expected = p_from.get_type();
+		return;
+	}
+
+	int size = from.size();
+	PoolVector<T> result;
+	result.resize(size);
+
+	// One pass over raw arrays instead of one script call per element.
+	typename PoolVector<T>::Read rf = from.read();
+	typename PoolVector<T>::Read rt = to.read();
+	typename PoolVector<T>::Write w = result.write();
+	const T *f = rf.ptr();
+	const T *t = rt.ptr();
+	T *dst = w.ptr();
+	for (int i = 0; i < size; i++) {
+		dst[i] = f[i] + (t[i] - f[i]) * p_weight;
+	}
+
+	w = typename PoolVector<T>::Write();
+	r_ret = result;
+}
+
 const char *GDScriptFunctions::get_func_name(Function p_func) {
 
 	ERR_FAIL_INDEX_V(p_func, FUNC_MAX, "");
@@ -347,6 +380,18 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 				case Variant::COLOR: {
 					r_ret = ((Color)*p_args[0]).linear_interpolate((Color)*p_args[1], t);
 				} break;
+				case Variant::POOL_REAL_ARRAY: {
+					_lerp_pool_array<real_t>(*p_args[0], *p_args[1], t, r_ret, r_error);
+				} break;
+				case Variant::POOL_VECTOR2_ARRAY: {
+					_lerp_pool_array<Vector2>(*p_args[0], *p_args[1], t, r_ret, r_error);
+				} break;
+				case Variant::POOL_VECTOR3_ARRAY: {
+					_lerp_pool_array<Vector3>(*p_args[0], *p_args[1], t, r_ret, r_error);
+				} break;
+				case Variant::POOL_COLOR_ARRAY: {
+					_lerp_pool_array<Color>(*p_args[0], *p_args[1], t, r_ret, r_error);
+				} break;
 				default: {
 					VALIDATE_ARG_NUM(0);
 					VALIDATE_ARG_NUM(1);
@@ -1407,6 +1452,127 @@ void GDScriptFunctions::call(Function p_func, const Variant **p_args, int p_arg_
 	}
 }
 
+bool GDScriptFunctions::is_math_intrinsic(Function p_func, int p_arg_count, bool p_all_real) {
+
+	// Functions that can run through call_math_intrinsic() when all arguments are known
+	// to be numbers at compile time. Those returning int for int arguments need all reals.
+
+	switch (p_func) {
+
+		case MATH_SIN:
+		case MATH_COS:
+		case MATH_TAN:
+		case MATH_SINH:
+		case MATH_COSH:
+		case MATH_TANH:
+		case MATH_ASIN:
+		case MATH_ACOS:
+		case MATH_ATAN:
+		case MATH_SQRT:
+		case MATH_FLOOR:
+		case MATH_CEIL:
+		case MATH_ROUND:
+		case MATH_LOG:
+		case MATH_EXP:
+		case MATH_ISNAN:
+		case MATH_ISINF:
+		case MATH_DEG2RAD:
+		case MATH_RAD2DEG:
+		case MATH_LINEAR2DB:
+		case MATH_DB2LINEAR:
+			return p_arg_count == 1;
+		case MATH_ABS:
+		case MATH_SIGN:
+			return p_arg_count == 1 && p_all_real;
+		case MATH_ATAN2:
+		case MATH_FMOD:
+		case MATH_FPOSMOD:
+		case MATH_POW:
+		case MATH_EASE:
+		case MATH_STEPIFY:
+			return p_arg_count == 2;
+		case LOGIC_MAX:
+		case LOGIC_MIN:
+			return p_arg_count == 2 && p_all_real;
+		case MATH_LERP:
+		case MATH_INVERSE_LERP:
+		case MATH_SMOOTHSTEP:
+		case MATH_WRAPF:
+			return p_arg_count == 3;
+		case LOGIC_CLAMP:
+			return p_arg_count == 3 && p_all_real;
+		case MATH_RANGE_LERP:
+			return p_arg_count == 5;
+		default:
+			return false;
+	}
+}
+
+void GDScriptFunctions::call_math_intrinsic(Function p_func, const Variant **p_args, Variant &r_ret) {
+
+	// No validation here, the compiler only emits this for arguments typed as numbers.
+
+	switch (p_func) {
+
+		case MATH_SIN: r_ret = Math::sin((double)*p_args[0]); break;
+		case MATH_COS: r_ret = Math::cos((double)*p_args[0]); break;
+		case MATH_TAN: r_ret = Math::tan((double)*p_args[0]); break;
+		case MATH_SINH: r_ret = Math::sinh((double)*p_args[0]); break;
+		case MATH_COSH: r_ret = Math::cosh((double)*p_args[0]); break;
+		case MATH_TANH: r_ret = Math::tanh((double)*p_args[0]); break;
+		case MATH_ASIN: r_ret = Math::asin((double)*p_args[0]); break;
+		case MATH_ACOS: r_ret = Math::acos((double)*p_args[0]); break;
+		case MATH_ATAN: r_ret = Math::atan((double)*p_args[0]); break;
+		case MATH_SQRT: r_ret = Math::sqrt((double)*p_args[0]); break;
+		case MATH_FLOOR: r_ret = Math::floor((double)*p_args[0]); break;
+		case MATH_CEIL: r_ret = Math::ceil((double)*p_args[0]); break;
+		case MATH_ROUND: r_ret = Math::round((double)*p_args[0]); break;
+		case MATH_LOG: r_ret = Math::log((double)*p_args[0]); break;
+		case MATH_EXP: r_ret = Math::exp((double)*p_args[0]); break;
+		case MATH_ISNAN: r_ret = Math::is_nan((double)*p_args[0]); break;
+		case MATH_ISINF: r_ret = Math::is_inf((double)*p_args[0]); break;
+		case MATH_DEG2RAD: r_ret = Math::deg2rad((double)*p_args[0]); break;
+		case MATH_RAD2DEG: r_ret = Math::rad2deg((double)*p_args[0]); break;
+		case MATH_LINEAR2DB: r_ret = Math::linear2db((double)*p_args[0]); break;
+		case MATH_DB2LINEAR: r_ret = Math::db2linear((double)*p_args[0]); break;
+		case MATH_ABS: r_ret = Math::abs((double)*p_args[0]); break;
+		case MATH_SIGN: {
+			real_t r = *p_args[0];
+			r_ret = r < 0.0 ? -1.0 : (r > 0.0 ? +1.0 : 0.0);
+		} break;
+		case MATH_ATAN2: r_ret = Math::atan2((double)*p_args[0], (double)*p_args[1]); break;
+		case MATH_FMOD: r_ret = Math::fmod((double)*p_args[0], (double)*p_args[1]); break;
+		case MATH_FPOSMOD: r_ret = Math::fposmod((double)*p_args[0], (double)*p_args[1]); break;
+		case MATH_POW: r_ret = Math::pow((double)*p_args[0], (double)*p_args[1]); break;
+		case MATH_EASE: r_ret = Math::ease((double)*p_args[0], (double)*p_args[1]); break;
+		case MATH_STEPIFY: r_ret = Math::stepify((double)*p_args[0], (double)*p_args[1]); break;
+		case LOGIC_MAX: {
+			real_t a = *p_args[0];
+			real_t b = *p_args[1];
+			r_ret = MAX(a, b);
+		} break;
+		case LOGIC_MIN: {
+			real_t a = *p_args[0];
+			real_t b = *p_args[1];
+			r_ret = MIN(a, b);
+		} break;
+		case MATH_LERP: r_ret = Math::lerp((double)*p_args[0], (double)*p_args[1], (double)*p_args[2]); break;
+		case MATH_INVERSE_LERP: r_ret = Math::inverse_lerp((double)*p_args[0], (double)*p_args[1], (double)*p_args[2]); break;
+		case MATH_SMOOTHSTEP: r_ret = Math::smoothstep((double)*p_args[0], (double)*p_args[1], (double)*p_args[2]); break;
+		case MATH_WRAPF: r_ret = Math::wrapf((double)*p_args[0], (double)*p_args[1], (double)*p_args[2]); break;
+		case LOGIC_CLAMP: {
+			real_t a = *p_args[0];
+			real_t b = *p_args[1];
+			real_t c = *p_args[2];
+			r_ret = CLAMP(a, b, c);
+		} break;
+		case MATH_RANGE_LERP: r_ret = Math::range_lerp((double)*p_args[0], (double)*p_args[1], (double)*p_args[2], (double)*p_args[3], (double)*p_args[4]); break;
+		default: {
+			ERR_FAIL();
+		}
+	}
+}
+
 bool GDScriptFunctions::is_deterministic(Function p_func) {
 
 	//man i couldn't have chosen a worse function name,
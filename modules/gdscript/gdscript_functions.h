@@ -125,6 +125,8 @@ public:
 	static const char *get_func_name(Function p_func);
 	static void call(Function p_func, const Variant **p_args, int p_arg_count, Variant &r_ret, Variant::CallError &r_error);
 	static bool is_deterministic(Function p_func);
+	static bool is_math_intrinsic(Function p_func, int p_arg_count, bool p_all_real);
+	static void call_math_intrinsic(Function p_func, const Variant **p_args, Variant &r_ret);
 	static MethodInfo get_info(Function p_func);
 };
 
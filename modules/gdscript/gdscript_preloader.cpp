@@ -0,0 +1,250 @@
+/*************************************************************************/
+/*  gdscript_preloader.cpp                                               */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "gdscript_preloader.h"
+
+#include "core/os/threaded_array_processor.h"
+#include "core/project_settings.h"
+
+void GDScriptPreloader::_add_entry(const String &p_path) {
+
+	if (entry_map.has(p_path) || ResourceCache::has(p_path)) {
+		return;
+	}
+
+	Entry e;
+	e.path = p_path;
+	e.source_path = ResourceLoader::path_remap(p_path);
+	entry_map[p_path] = entries.size();
+	entries.push_back(e);
+}
+
+void GDScriptPreloader::_scan_tokens(GDScriptTokenizer &p_tokenizer, Entry &r_entry) {
+
+	String base_dir = r_entry.path.get_base_dir();
+
+	// Only a token scan, mirroring how the parser resolves the paths it will load.
+	while (p_tokenizer.get_token() != GDScriptTokenizer::TK_EOF && p_tokenizer.get_token() != GDScriptTokenizer::TK_ERROR) {
+
+		switch (p_tokenizer.get_token()) {
+
+			case GDScriptTokenizer::TK_PR_PRELOAD: {
+
+				if (p_tokenizer.get_token(1) != GDScriptTokenizer::TK_PARENTHESIS_OPEN || p_tokenizer.get_token(2) != GDScriptTokenizer::TK_CONSTANT || p_tokenizer.get_token(3) != GDScriptTokenizer::TK_PARENTHESIS_CLOSE || p_tokenizer.get_token_constant(2).get_type() != Variant::STRING) {
+					// Path comes from an expression, we can't know what it loads.
+					r_entry.safe = false;
+					break;
+				}
+
+				String path = p_tokenizer.get_token_constant(2);
+				if (!path.is_abs_path() && base_dir != "")
+					path = base_dir + "/" + path;
+				path = path.replace("///", "//").simplify_path();
+				if (path != r_entry.path && r_entry.dependencies.find(path) == -1) {
+					r_entry.dependencies.push_back(path);
+				}
+			} break;
+			case GDScriptTokenizer::TK_PR_EXTENDS: {
+
+				if (p_tokenizer.get_token(1) != GDScriptTokenizer::TK_CONSTANT || p_tokenizer.get_token_constant(1).get_type() != Variant::STRING) {
+					break;
+				}
+
+				String path = p_tokenizer.get_token_constant(1);
+				if (path.is_rel_path()) {
+					path = base_dir.plus_file(path).simplify_path();
+				}
+				if (r_entry.dependencies.find(path) == -1) {
+					r_entry.dependencies.push_back(path);
+				}
+			} break;
+			case GDScriptTokenizer::TK_IDENTIFIER: {
+
+				StringName identifier = p_tokenizer.get_token_identifier();
+				if (unregistered_autoloads.has(identifier)) {
+					r_entry.safe = false;
+				} else if (ScriptServer::is_global_class(identifier)) {
+					String path = ScriptServer::get_global_class_path(identifier);
+					if (path != r_entry.path && r_entry.dependencies.find(path) == -1) {
+						r_entry.dependencies.push_back(path);
+					}
+				}
+			} break;
+			default: {
+			}
+		}
+
+		if (!r_entry.safe) {
+			return;
+		}
+
+		p_tokenizer.advance();
+	}
+}
+
+void GDScriptPreloader::_scan_entry(uint32_t p_index, Entry *p_entries) {
+
+	Entry &e = p_entries[p_index];
+
+	e.script.instance();
+	e.script->set_script_path(e.path);
+
+	String extension = e.source_path.get_extension();
+	if (extension == "gd") {
+
+		if (e.script->load_source_code(e.source_path) != OK) {
+			e.safe = false;
+			return;
+		}
+
+		GDScriptTokenizerText tokenizer;
+		tokenizer.set_code(e.script->get_source_code());
+		_scan_tokens(tokenizer, e);
+
+	} else if (extension == "gdc") {
+
+		Vector<uint8_t> bytecode = FileAccess::get_file_as_array(e.source_path);
+
+		GDScriptTokenizerBuffer tokenizer;
+		if (bytecode.size() == 0 || tokenizer.set_code_buffer(bytecode) != OK) {
+			e.safe = false;
+			return;
+		}
+		_scan_tokens(tokenizer, e);
+
+	} else {
+		// Encrypted (.gde) scripts are left to the regular loader.
+		e.safe = false;
+	}
+}
+
+void GDScriptPreloader::_compile_entry(uint32_t p_index, Entry **p_level) {
+
+	Entry *e = p_level[p_index];
+
+	// Same order as ResourceFormatLoaderGDScript::load(). Failed scripts stay cached too, like regular loads.
+	e->script->set_path(e->path);
+	if (e->source_path.get_extension() == "gdc") {
+		e->script->load_byte_code(e->source_path);
+	} else {
+		e->script->reload();
+	}
+}
+
+void GDScriptPreloader::preload(const Vector<String> &p_paths, List<Ref<GDScript> > *r_scripts) {
+
+	List<PropertyInfo> props;
+	ProjectSettings::get_singleton()->get_property_list(&props);
+	for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
+		String s = E->get().name;
+		if (!s.begins_with("autoload/")) {
+			continue;
+		}
+		StringName name = s.get_slice("/", 1);
+		String path = ProjectSettings::get_singleton()->get(s);
+		if (path.begins_with("*") && !GDScriptLanguage::get_singleton()->get_named_globals_map().has(name)) {
+			unregistered_autoloads.insert(name);
+		}
+	}
+
+	for (int i = 0; i < p_paths.size(); i++) {
+		if (p_paths[i].get_extension() == "gd") {
+			_add_entry(p_paths[i]);
+		}
+	}
+
+	// Scan in rounds until the dependency closure is known. Dependencies that aren't
+	// text scripts are loaded here, on this thread, so workers only ever hit the cache.
+	List<RES> other_dependencies;
+	int scanned = 0;
+	while (scanned < entries.size()) {
+
+		int from = scanned;
+		scanned = entries.size();
+		thread_process_array(scanned - from, this, &GDScriptPreloader::_scan_entry, entries.ptrw() + from);
+
+		for (int i = from; i < scanned; i++) {
+			if (!entries[i].safe) {
+				continue;
+			}
+			for (int j = 0; j < entries[i].dependencies.size(); j++) {
+				const String &dep = entries[i].dependencies[j];
+				if (dep.get_extension() == "gd" && FileAccess::exists(ResourceLoader::path_remap(dep))) {
+					_add_entry(dep);
+				} else if (!ResourceCache::has(dep)) {
+					RES res = ResourceLoader::load(dep);
+					if (res.is_valid()) {
+						other_dependencies.push_back(res);
+					}
+				}
+			}
+		}
+	}
+
+	Vector<Entry *> level;
+	for (int i = 0; i < entries.size(); i++) {
+		Entry &e = entries.write[i];
+		for (int j = 0; j < e.dependencies.size(); j++) {
+			const int *dep = entry_map.getptr(e.dependencies[j]);
+			if (dep) {
+				e.pending++;
+				entries.write[*dep].dependents.push_back(i);
+			}
+		}
+	}
+	for (int i = 0; i < entries.size(); i++) {
+		if (entries[i].safe && entries[i].pending == 0) {
+			level.push_back(&entries.write[i]);
+		}
+	}
+
+	// Entries in cycles or depending on unsafe ones never reach zero pending and are skipped.
+	int compiled = 0;
+	while (level.size()) {
+
+		thread_process_array(level.size(), this, &GDScriptPreloader::_compile_entry, level.ptrw());
+
+		Vector<Entry *> next;
+		compiled += level.size();
+		for (int i = 0; i < level.size(); i++) {
+			r_scripts->push_back(level[i]->script);
+			for (int j = 0; j < level[i]->dependents.size(); j++) {
+				Entry &d = entries.write[level[i]->dependents[j]];
+				d.pending--;
+				if (d.pending == 0 && d.safe) {
+					next.push_back(&d);
+				}
+			}
+		}
+		level = next;
+	}
+
+	print_verbose("GDScript: Preloaded " + itos(compiled) + " of " + itos(entries.size()) + " scripts.");
+}
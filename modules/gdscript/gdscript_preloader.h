@@ -0,0 +1,75 @@
+/*************************************************************************/
+/*  gdscript_preloader.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef GDSCRIPT_PRELOADER_H
+#define GDSCRIPT_PRELOADER_H
+
+#include "core/hash_map.h"
+#include "core/set.h"
+#include "gdscript.h"
+#include "gdscript_tokenizer.h"
+
+// Loads a set of scripts plus the scripts they depend on, parsing and compiling
+// independent ones on worker threads. Compilation goes level by level in
+// dependency order, so preload() and extends always find their targets in the
+// resource cache. Anything that can't be handled safely this way (cycles,
+// references to autoloads not registered yet, non-constant preload paths) is
+// left to the regular loader.
+
+class GDScriptPreloader {
+
+	struct Entry {
+		String path;
+		String source_path; //remapped file, .gdc in exported projects
+		Ref<GDScript> script;
+		Vector<String> dependencies;
+		Vector<int> dependents;
+		int pending;
+		bool safe;
+
+		Entry() :
+				pending(0),
+				safe(true) {}
+	};
+
+	Vector<Entry> entries;
+	HashMap<String, int> entry_map;
+	Set<StringName> unregistered_autoloads;
+
+	void _add_entry(const String &p_path);
+	void _scan_tokens(GDScriptTokenizer &p_tokenizer, Entry &r_entry);
+	void _scan_entry(uint32_t p_index, Entry *p_entries);
+	void _compile_entry(uint32_t p_index, Entry **p_level);
+
+public:
+	void preload(const Vector<String> &p_paths, List<Ref<GDScript> > *r_scripts);
+};
+
+#endif // GDSCRIPT_PRELOADER_H
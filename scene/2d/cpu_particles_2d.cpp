@@ -29,6 +29,8 @@
 /*************************************************************************/
 
 #include "cpu_particles_2d.h"
+#include "core/os/thread_work_pool.h"
+#include "core/project_settings.h"
 #include "particles_2d.h"
 #include "scene/2d/canvas_item.h"
 #include "scene/resources/particles_material.h"
@@ -497,6 +499,8 @@ void CPUParticles2D::_validate_property(PropertyInfo &property) const {
 	*/
 }
 
+ThreadWorkPool *CPUParticles2D::work_pool = NULL;
+
 static uint32_t idhash(uint32_t x) {
 
 	x = ((x >> uint32_t(16)) ^ x) * uint32_t(0x45d9f3b);
@@ -518,34 +522,19 @@ static float rand_from_seed(uint32_t &seed) {
 	return float(seed % uint32_t(65536)) / 65535.0;
 }
 
-void CPUParticles2D::_particles_process(float p_delta) {
-
-	p_delta *= speed_scale;
+void CPUParticles2D::_process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame) {
 
-	int pcount = particles.size();
-	PoolVector<Particle>::Write w = particles.write();
+	Particle *parray = p_frame->particles;
+	int pcount = p_frame->particle_count;
+	float delta = p_frame->delta;
+	float prev_time = p_frame->prev_time;
+	const Transform2D &emission_xform = p_frame->emission_xform;
+	const Transform2D &velocity_xform = p_frame->velocity_xform;
 
-	Particle *parray = w.ptr();
+	int from = p_chunk * PROCESS_CHUNK_SIZE;
+	int to = MIN(from + PROCESS_CHUNK_SIZE, pcount);
 
-	float prev_time = time;
-	time += p_delta;
-	if (time > lifetime) {
-		time = Math::fmod(time, lifetime);
-		cycle++;
-		if (one_shot && cycle > 0) {
-			emitting = false;
-		}
-	}
-
-	Transform2D emission_xform;
-	Transform2D velocity_xform;
-	if (!local_coords) {
-		emission_xform = get_global_transform();
-		velocity_xform = emission_xform;
-		velocity_xform[2] = Vector2();
-	}
-
-	for (int i = 0; i < pcount; i++) {
+	for (int i = from; i < to; i++) {
 
 		Particle &p = parray[i];
 
@@ -553,15 +542,16 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			continue;
 
 		float restart_time = (float(i) / float(pcount)) * lifetime;
-		float local_delta = p_delta;
+		float local_delta = delta;
+
+		uint32_t seed = cycle;
+		if (restart_time >= time) {
+			seed -= uint32_t(1);
+		}
+		seed *= uint32_t(pcount);
+		seed += uint32_t(i);
 
 		if (randomness_ratio > 0.0) {
-			uint32_t seed = cycle;
-			if (restart_time >= time) {
-				seed -= uint32_t(1);
-			}
-			seed *= uint32_t(pcount);
-			seed += uint32_t(i);
 			float random = float(idhash(seed) % uint32_t(65536)) / 65536.0;
 			restart_time += randomness_ratio * random * 1.0 / float(pcount);
 		}
@@ -604,29 +594,32 @@ void CPUParticles2D::_particles_process(float p_delta) {
 
 			/*float tex_linear_velocity = 0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(0);
+				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate_baked(0);
 			}*/
 
 			float tex_angle = 0.0;
 			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(0);
+				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate_baked(0);
 			}
 
 			float tex_anim_offset = 0.0;
 			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate(0);
+				tex_anim_offset = curve_parameters[PARAM_ANGLE]->interpolate_baked(0);
 			}
 
-			p.seed = Math::rand();
+			// Seeded from the emission cycle and index instead of the global random
+			// generator, so the result does not depend on the processing thread.
+			uint32_t emit_seed = idhash(seed ^ random_seed);
+			p.seed = idhash(emit_seed);
 
-			p.angle_rand = Math::randf();
-			p.scale_rand = Math::randf();
-			p.hue_rot_rand = Math::randf();
-			p.anim_offset_rand = Math::randf();
+			p.angle_rand = rand_from_seed(emit_seed);
+			p.scale_rand = rand_from_seed(emit_seed);
+			p.hue_rot_rand = rand_from_seed(emit_seed);
+			p.anim_offset_rand = rand_from_seed(emit_seed);
 
-			float angle1_rad = (Math::randf() * 2.0 - 1.0) * Math_PI * spread / 180.0;
+			float angle1_rad = (rand_from_seed(emit_seed) * 2.0 - 1.0) * Math_PI * spread / 180.0;
 			Vector2 rot = Vector2(Math::cos(angle1_rad), Math::sin(angle1_rad));
-			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, float(Math::randf()), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
+			p.velocity = rot * parameters[PARAM_INITIAL_LINEAR_VELOCITY] * Math::lerp(1.0f, rand_from_seed(emit_seed), randomness[PARAM_INITIAL_LINEAR_VELOCITY]);
 
 			float base_angle = (parameters[PARAM_ANGLE] + tex_angle) * Math::lerp(1.0f, p.angle_rand, randomness[PARAM_ANGLE]);
 			p.rotation = Math::deg2rad(base_angle);
@@ -644,28 +637,28 @@ void CPUParticles2D::_particles_process(float p_delta) {
 					//do none
 				} break;
 				case EMISSION_SHAPE_CIRCLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0).normalized() * emission_sphere_radius;
+					p.transform[2] = Vector2(rand_from_seed(emit_seed) * 2.0 - 1.0, rand_from_seed(emit_seed) * 2.0 - 1.0).normalized() * emission_sphere_radius;
 				} break;
 				case EMISSION_SHAPE_RECTANGLE: {
-					p.transform[2] = Vector2(Math::randf() * 2.0 - 1.0, Math::randf() * 2.0 - 1.0) * emission_rect_extents;
+					p.transform[2] = Vector2(rand_from_seed(emit_seed) * 2.0 - 1.0, rand_from_seed(emit_seed) * 2.0 - 1.0) * emission_rect_extents;
 				} break;
 				case EMISSION_SHAPE_POINTS:
 				case EMISSION_SHAPE_DIRECTED_POINTS: {
 
-					int pc = emission_points.size();
+					int pc = p_frame->emission_point_count;
 					if (pc == 0)
 						break;
 
-					int random_idx = Math::rand() % pc;
+					int random_idx = int(idhash(emit_seed) % uint32_t(pc));
 
-					p.transform[2] = emission_points.get(random_idx);
+					p.transform[2] = p_frame->emission_points[random_idx];
 
-					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && emission_normals.size() == pc) {
-						p.velocity = emission_normals.get(random_idx);
+					if (emission_shape == EMISSION_SHAPE_DIRECTED_POINTS && p_frame->emission_normal_count == pc) {
+						p.velocity = p_frame->emission_normals[random_idx];
 					}
 
-					if (emission_colors.size() == pc) {
-						p.base_color = emission_colors.get(random_idx);
+					if (p_frame->emission_color_count == pc) {
+						p.base_color = p_frame->emission_colors[random_idx];
 					}
 				} break;
 			}
@@ -686,7 +679,7 @@ void CPUParticles2D::_particles_process(float p_delta) {
 
 			float tex_linear_velocity = 0.0;
 			if (curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY].is_valid()) {
-				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate(p.custom[1]);
+				tex_linear_velocity = curve_parameters[PARAM_INITIAL_LINEAR_VELOCITY]->interpolate_baked(p.custom[1]);
 			}
 			/*
 			float tex_orbit_velocity = 0.0;
@@ -694,47 +687,47 @@ void CPUParticles2D::_particles_process(float p_delta) {
 			if (flags[FLAG_DISABLE_Z]) {
 
 				if (curve_parameters[PARAM_INITIAL_ORBIT_VELOCITY].is_valid()) {
-					tex_orbit_velocity = curve_parameters[PARAM_INITIAL_ORBIT_VELOCITY]->interpolate(p.custom[1]);
+					tex_orbit_velocity = curve_parameters[PARAM_INITIAL_ORBIT_VELOCITY]->interpolate_baked(p.custom[1]);
 				}
 			}
 */
 			float tex_angular_velocity = 0.0;
 			if (curve_parameters[PARAM_ANGULAR_VELOCITY].is_valid()) {
-				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate(p.custom[1]);
+				tex_angular_velocity = curve_parameters[PARAM_ANGULAR_VELOCITY]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_linear_accel = 0.0;
 			if (curve_parameters[PARAM_LINEAR_ACCEL].is_valid()) {
-				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate(p.custom[1]);
+				tex_linear_accel = curve_parameters[PARAM_LINEAR_ACCEL]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_tangential_accel = 0.0;
 			if (curve_parameters[PARAM_TANGENTIAL_ACCEL].is_valid()) {
-				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate(p.custom[1]);
+				tex_tangential_accel = curve_parameters[PARAM_TANGENTIAL_ACCEL]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_radial_accel = 0.0;
 			if (curve_parameters[PARAM_RADIAL_ACCEL].is_valid()) {
-				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate(p.custom[1]);
+				tex_radial_accel = curve_parameters[PARAM_RADIAL_ACCEL]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_damping = 0.0;
 			if (curve_parameters[PARAM_DAMPING].is_valid()) {
-				tex_damping = curve_parameters[PARAM_DAMPING]->interpolate(p.custom[1]);
+				tex_damping = curve_parameters[PARAM_DAMPING]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_angle = 0.0;
 			if (curve_parameters[PARAM_ANGLE].is_valid()) {
-				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate(p.custom[1]);
+				tex_angle = curve_parameters[PARAM_ANGLE]->interpolate_baked(p.custom[1]);
 			}
 			float tex_anim_speed = 0.0;
 			if (curve_parameters[PARAM_ANIM_SPEED].is_valid()) {
-				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate(p.custom[1]);
+				tex_anim_speed = curve_parameters[PARAM_ANIM_SPEED]->interpolate_baked(p.custom[1]);
 			}
 
 			float tex_anim_offset = 0.0;
 			if (curve_parameters[PARAM_ANIM_OFFSET].is_valid()) {
-				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate(p.custom[1]);
+				tex_anim_offset = curve_parameters[PARAM_ANIM_OFFSET]->interpolate_baked(p.custom[1]);
 			}
 
 			Vector2 force = gravity;
@@ -790,12 +783,12 @@ void CPUParticles2D::_particles_process(float p_delta) {
 
 		float tex_scale = 1.0;
 		if (curve_parameters[PARAM_SCALE].is_valid()) {
-			tex_scale = curve_parameters[PARAM_SCALE]->interpolate(p.custom[1]);
+			tex_scale = curve_parameters[PARAM_SCALE]->interpolate_baked(p.custom[1]);
 		}
 
 		float tex_hue_variation = 0.0;
 		if (curve_parameters[PARAM_HUE_VARIATION].is_valid()) {
-			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate(p.custom[1]);
+			tex_hue_variation = curve_parameters[PARAM_HUE_VARIATION]->interpolate_baked(p.custom[1]);
 		}
 
 		float hue_rot_angle = (parameters[PARAM_HUE_VARIATION] + tex_hue_variation) * Math_PI * 2.0 * Math::lerp(1.0f, p.hue_rot_rand * 2.0f - 1.0f, randomness[PARAM_HUE_VARIATION]);
@@ -849,6 +842,79 @@ void CPUParticles2D::_particles_process(float p_delta) {
 	}
 }
 
+void CPUParticles2D::_particles_process(float p_delta) {
+
+	p_delta *= speed_scale;
+
+	int pcount = particles.size();
+	PoolVector<Particle>::Write w = particles.write();
+
+	float prev_time = time;
+	time += p_delta;
+	if (time > lifetime) {
+		time = Math::fmod(time, lifetime);
+		cycle++;
+		if (one_shot && cycle > 0) {
+			emitting = false;
+		}
+	}
+
+	ProcessFrame frame;
+	frame.particles = w.ptr();
+	frame.particle_count = pcount;
+	frame.delta = p_delta;
+	frame.prev_time = prev_time;
+	if (!local_coords) {
+		frame.emission_xform = get_global_transform();
+		frame.velocity_xform = frame.emission_xform;
+		frame.velocity_xform[2] = Vector2();
+	}
+
+	PoolVector<Vector2>::Read emission_points_r = emission_points.read();
+	PoolVector<Vector2>::Read emission_normals_r = emission_normals.read();
+	PoolVector<Color>::Read emission_colors_r = emission_colors.read();
+	frame.emission_points = emission_points_r.ptr();
+	frame.emission_normals = emission_normals_r.ptr();
+	frame.emission_colors = emission_colors_r.ptr();
+	frame.emission_point_count = emission_points.size();
+	frame.emission_normal_count = emission_normals.size();
+	frame.emission_color_count = emission_colors.size();
+
+	// Curves and gradients build their lookup data lazily, make sure it is
+	// done here so the chunks below only read it.
+	for (int i = 0; i < PARAM_MAX; i++) {
+		if (curve_parameters[i].is_valid()) {
+			curve_parameters[i]->interpolate_baked(0);
+		}
+	}
+	if (color_ramp.is_valid()) {
+		color_ramp->get_color_at_offset(0);
+	}
+
+	uint32_t chunk_count = (pcount + PROCESS_CHUNK_SIZE - 1) / PROCESS_CHUNK_SIZE;
+
+	if (chunk_count > 1 && parallel_process) {
+		if (!work_pool) {
+			work_pool = memnew(ThreadWorkPool);
+			work_pool->init();
+		}
+		work_pool->do_work(chunk_count, this, &CPUParticles2D::_process_chunk, (const ProcessFrame *)&frame);
+	} else {
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			_process_chunk(i, &frame);
+		}
+	}
+}
+
+void CPUParticles2D::finish_work_pool() {
+
+	if (work_pool) {
+		work_pool->finish();
+		memdelete(work_pool);
+		work_pool = NULL;
+	}
+}
+
 void CPUParticles2D::_update_particle_data_buffer() {
 #ifndef NO_THREADS
 	update_mutex->lock();
@@ -1340,6 +1406,8 @@ CPUParticles2D::CPUParticles2D() {
 	frame_remainder = 0;
 	cycle = 0;
 	redraw = false;
+	random_seed = Math::rand();
+	parallel_process = GLOBAL_GET("rendering/threads/parallel_cpu_particles");
 
 	mesh = VisualServer::get_singleton()->mesh_create();
 	multimesh = VisualServer::get_singleton()->multimesh_create();
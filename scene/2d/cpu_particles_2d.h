@@ -35,6 +35,8 @@
 #include "scene/2d/node_2d.h"
 #include "scene/resources/texture.h"
 
+class ThreadWorkPool;
+
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
 */
@@ -104,6 +106,7 @@ private:
 	float frame_remainder;
 	int cycle;
 	bool redraw;
+	uint32_t random_seed;
 
 	RID mesh;
 	RID multimesh;
@@ -171,7 +174,31 @@ private:
 
 	Vector2 gravity;
 
+	enum {
+		PROCESS_CHUNK_SIZE = 1024
+	};
+
+	// Per step values shared by all chunks, so chunks can run on worker threads.
+	struct ProcessFrame {
+		Particle *particles;
+		int particle_count;
+		float delta;
+		float prev_time;
+		Transform2D emission_xform;
+		Transform2D velocity_xform;
+		const Vector2 *emission_points;
+		const Vector2 *emission_normals;
+		const Color *emission_colors;
+		int emission_point_count;
+		int emission_normal_count;
+		int emission_color_count;
+	};
+
+	static ThreadWorkPool *work_pool;
+	bool parallel_process;
+
 	void _particles_process(float p_delta);
+	void _process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame);
 	void _update_particle_data_buffer();
 
 	Mutex *update_mutex;
@@ -279,6 +306,8 @@ public:
 
 	void convert_from_particles(Node *p_particles);
 
+	static void finish_work_pool();
+
 	CPUParticles2D();
 	~CPUParticles2D();
 };
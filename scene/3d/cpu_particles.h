@@ -34,6 +34,8 @@
 #include "core/rid.h"
 #include "scene/3d/visual_instance.h"
 
+class ThreadWorkPool;
+
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
 */
@@ -105,6 +107,7 @@ private:
 	float frame_remainder;
 	int cycle;
 	bool redraw;
+	uint32_t random_seed;
 
 	RID multimesh;
 
@@ -172,7 +175,31 @@ private:
 
 	Vector3 gravity;
 
+	enum {
+		PROCESS_CHUNK_SIZE = 1024
+	};
+
+	// Per step values shared by all chunks, so chunks can run on worker threads.
+	struct ProcessFrame {
+		Particle *particles;
+		int particle_count;
+		float delta;
+		float prev_time;
+		Transform emission_xform;
+		Basis velocity_xform;
+		const Vector3 *emission_points;
+		const Vector3 *emission_normals;
+		const Color *emission_colors;
+		int emission_point_count;
+		int emission_normal_count;
+		int emission_color_count;
+	};
+
+	static ThreadWorkPool *work_pool;
+	bool parallel_process;
+
 	void _particles_process(float p_delta);
+	void _process_chunk(uint32_t p_chunk, const ProcessFrame *p_frame);
 	void _update_particle_data_buffer();
 
 	Mutex *update_mutex;
@@ -278,6 +305,10 @@ public:
 
 	void convert_from_particles(Node *p_particles);
 
+	PoolVector<float> get_particle_data() const; // what the last processed frame sends to the multimesh
+
+	static void finish_work_pool();
+
 	CPUParticles();
 	~CPUParticles();
 };
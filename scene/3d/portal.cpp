@@ -29,139 +29,102 @@
 /*************************************************************************/
 
 #include "portal.h"
-#include "core/project_settings.h"
-#include "scene/resources/surface_tool.h"
-#include "servers/visual_server.h"
-
-// FIXME: This will be removed, kept as reference for new implementation
-#if 0
-bool Portal::_set(const StringName &p_name, const Variant &p_value) {
-
-	if (p_name == "shape") {
-		PoolVector<float> src_coords = p_value;
-		Vector<Point2> points;
-		int src_coords_size = src_coords.size();
-		ERR_FAIL_COND_V(src_coords_size % 2, false);
-		points.resize(src_coords_size / 2);
-		for (int i = 0; i < points.size(); i++) {
-
-			points[i].x = src_coords[i * 2 + 0];
-			points[i].y = src_coords[i * 2 + 1];
-			set_shape(points);
-		}
-	} else if (p_name == "enabled") {
-		set_enabled(p_value);
-	} else if (p_name == "disable_distance") {
-		set_disable_distance(p_value);
-	} else if (p_name == "disabled_color") {
-		set_disabled_color(p_value);
-	} else if (p_name == "connect_range") {
-		set_connect_range(p_value);
-	} else
-		return false;
-
-	return true;
-}
-
-bool Portal::_get(const StringName &p_name, Variant &r_ret) const {
 
-	if (p_name == "shape") {
-		Vector<Point2> points = get_shape();
-		PoolVector<float> dst_coords;
-		dst_coords.resize(points.size() * 2);
+#include "scene/3d/room_instance.h"
+#include "servers/visual_server.h"
 
-		for (int i = 0; i < points.size(); i++) {
+RID Portal::_get_parent_room() const {
 
-			dst_coords.set(i * 2 + 0, points[i].x);
-			dst_coords.set(i * 2 + 1, points[i].y);
+	for (Node *parent = get_parent(); parent; parent = parent->get_parent()) {
+		Room *room = Object::cast_to<Room>(parent);
+		if (room) {
+			return room->get_rid();
 		}
+	}
 
-		r_ret = dst_coords;
-	} else if (p_name == "enabled") {
-		r_ret = is_enabled();
-	} else if (p_name == "disable_distance") {
-		r_ret = get_disable_distance();
-	} else if (p_name == "disabled_color") {
-		r_ret = get_disabled_color();
-	} else if (p_name == "connect_range") {
-		r_ret = get_connect_range();
-	} else
-		return false;
-	return true;
+	return RID();
 }
 
-void Portal::_get_property_list(List<PropertyInfo> *p_list) const {
-
-	p_list->push_back(PropertyInfo(Variant::POOL_REAL_ARRAY, "shape"));
-	p_list->push_back(PropertyInfo(Variant::BOOL, "enabled"));
-	p_list->push_back(PropertyInfo(Variant::REAL, "disable_distance", PROPERTY_HINT_RANGE, "0,4096,0.01"));
-	p_list->push_back(PropertyInfo(Variant::COLOR, "disabled_color"));
-	p_list->push_back(PropertyInfo(Variant::REAL, "connect_range", PROPERTY_HINT_RANGE, "0.1,4096,0.01"));
-}
+RID Portal::_get_linked_room() const {
 
-AABB Portal::get_aabb() const {
+	if (linked_room.is_empty() || !is_inside_tree()) {
+		return RID();
+	}
 
-	return aabb;
+	Room *room = Object::cast_to<Room>(get_node_or_null(linked_room));
+	return room ? room->get_rid() : RID();
 }
-PoolVector<Face3> Portal::get_faces(uint32_t p_usage_flags) const {
 
-	if (!(p_usage_flags & FACES_ENCLOSING))
-		return PoolVector<Face3>();
+void Portal::_update_polygon() {
 
-	Vector<Point2> shape = get_shape();
-	if (shape.size() == 0)
-		return PoolVector<Face3>();
+	if (!is_inside_tree()) {
+		return;
+	}
 
-	Vector2 center;
-	for (int i = 0; i < shape.size(); i++) {
+	Transform xform = get_global_transform();
 
-		center += shape[i];
+	PoolVector<Vector3> points;
+	points.resize(polygon.size());
+	PoolVector<Vector2>::Read r = polygon.read();
+	PoolVector<Vector3>::Write w = points.write();
+	for (int i = 0; i < polygon.size(); i++) {
+		w[i] = xform.xform(Vector3(r[i].x, r[i].y, 0));
 	}
+	w = PoolVector<Vector3>::Write();
 
-	PoolVector<Face3> ret;
-	center /= shape.size();
+	VS::get_singleton()->portal_set_polygon(portal, points);
+}
 
-	for (int i = 0; i < shape.size(); i++) {
+void Portal::_update_rooms() {
 
-		int n = (i + 1) % shape.size();
+	RID room_a = _get_parent_room();
+	RID room_b = _get_linked_room();
 
-		Face3 f;
-		f.vertex[0] = Vector3(center.x, center.y, 0);
-		f.vertex[1] = Vector3(shape[i].x, shape[i].y, 0);
-		f.vertex[2] = Vector3(shape[n].x, shape[n].y, 0);
-		ret.push_back(f);
+	if (room_a == room_b) {
+		// nothing to connect, see the configuration warning, but drop any previous link
+		VS::get_singleton()->portal_set_rooms(portal, RID(), RID());
+		return;
 	}
 
-	return ret;
+	VS::get_singleton()->portal_set_rooms(portal, room_a, room_b);
 }
 
-void Portal::set_shape(const Vector<Point2> &p_shape) {
+void Portal::_notification(int p_what) {
 
-	VisualServer::get_singleton()->portal_set_shape(portal, p_shape);
-	shape = p_shape;
-	update_gizmo();
-}
+	switch (p_what) {
+		case NOTIFICATION_ENTER_WORLD: {
+
+			VS::get_singleton()->portal_set_scenario(portal, get_world()->get_scenario());
+			_update_polygon();
+			_update_rooms();
+		} break;
+		case NOTIFICATION_TRANSFORM_CHANGED: {
 
-Vector<Point2> Portal::get_shape() const {
+			_update_polygon();
+		} break;
+		case NOTIFICATION_EXIT_WORLD: {
 
-	return shape;
+			VS::get_singleton()->portal_set_scenario(portal, RID());
+		} break;
+	}
 }
 
-void Portal::set_connect_range(float p_range) {
+void Portal::set_polygon(const PoolVector<Vector2> &p_polygon) {
 
-	connect_range = p_range;
-	//VisualServer::get_singleton()->portal_set_connect_range(portal,p_range);
+	polygon = p_polygon;
+	_update_polygon();
+	update_gizmo();
 }
 
-float Portal::get_connect_range() const {
+PoolVector<Vector2> Portal::get_polygon() const {
 
-	return connect_range;
+	return polygon;
 }
 
 void Portal::set_enabled(bool p_enabled) {
 
 	enabled = p_enabled;
-	VisualServer::get_singleton()->portal_set_enabled(portal, enabled);
+	VS::get_singleton()->portal_set_enabled(portal, enabled);
 }
 
 bool Portal::is_enabled() const {
@@ -169,64 +132,63 @@ bool Portal::is_enabled() const {
 	return enabled;
 }
 
-void Portal::set_disable_distance(float p_distance) {
+void Portal::set_linked_room(const NodePath &p_room) {
 
-	disable_distance = p_distance;
-	VisualServer::get_singleton()->portal_set_disable_distance(portal, disable_distance);
+	linked_room = p_room;
+	if (is_inside_tree()) {
+		_update_rooms();
+	}
+	update_configuration_warning();
 }
-float Portal::get_disable_distance() const {
 
-	return disable_distance;
+NodePath Portal::get_linked_room() const {
+
+	return linked_room;
 }
 
-void Portal::set_disabled_color(const Color &p_disabled_color) {
+String Portal::get_configuration_warning() const {
 
-	disabled_color = p_disabled_color;
-	VisualServer::get_singleton()->portal_set_disabled_color(portal, disabled_color);
-}
+	if (!is_inside_tree()) {
+		return String();
+	}
 
-Color Portal::get_disabled_color() const {
+	if (_get_parent_room() == _get_linked_room()) {
+		return TTR("A Portal must be inside a Room, or have a linked_room, and both can't be the same Room.");
+	}
 
-	return disabled_color;
+	return String();
 }
 
 void Portal::_bind_methods() {
 
-	ClassDB::bind_method(D_METHOD("set_shape", "points"), &Portal::set_shape);
-	ClassDB::bind_method(D_METHOD("get_shape"), &Portal::get_shape);
+	ClassDB::bind_method(D_METHOD("set_polygon", "polygon"), &Portal::set_polygon);
+	ClassDB::bind_method(D_METHOD("get_polygon"), &Portal::get_polygon);
 
-	ClassDB::bind_method(D_METHOD("set_enabled", "enable"), &Portal::set_enabled);
+	ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &Portal::set_enabled);
 	ClassDB::bind_method(D_METHOD("is_enabled"), &Portal::is_enabled);
 
-	ClassDB::bind_method(D_METHOD("set_disable_distance", "distance"), &Portal::set_disable_distance);
-	ClassDB::bind_method(D_METHOD("get_disable_distance"), &Portal::get_disable_distance);
-
-	ClassDB::bind_method(D_METHOD("set_disabled_color", "color"), &Portal::set_disabled_color);
-	ClassDB::bind_method(D_METHOD("get_disabled_color"), &Portal::get_disabled_color);
+	ClassDB::bind_method(D_METHOD("set_linked_room", "room"), &Portal::set_linked_room);
+	ClassDB::bind_method(D_METHOD("get_linked_room"), &Portal::get_linked_room);
 
-	ClassDB::bind_method(D_METHOD("set_connect_range", "range"), &Portal::set_connect_range);
-	ClassDB::bind_method(D_METHOD("get_connect_range"), &Portal::get_connect_range);
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_VECTOR2_ARRAY, "polygon"), "set_polygon", "get_polygon");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "linked_room", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "Room"), "set_linked_room", "get_linked_room");
 }
 
 Portal::Portal() {
 
-	portal = VisualServer::get_singleton()->portal_create();
-	Vector<Point2> points;
-	points.push_back(Point2(-1, 1));
-	points.push_back(Point2(1, 1));
-	points.push_back(Point2(1, -1));
-	points.push_back(Point2(-1, -1));
-	set_shape(points); // default shape
+	portal = VS::get_singleton()->portal_create();
+	enabled = true;
 
-	set_connect_range(0.8);
-	set_disable_distance(50);
-	set_enabled(true);
+	polygon.push_back(Vector2(-1, -1));
+	polygon.push_back(Vector2(1, -1));
+	polygon.push_back(Vector2(1, 1));
+	polygon.push_back(Vector2(-1, 1));
 
-	set_base(portal);
+	set_notify_transform(true);
 }
 
 Portal::~Portal() {
 
-	VisualServer::get_singleton()->free(portal);
+	VS::get_singleton()->free(portal);
 }
-#endif
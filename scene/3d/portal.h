@@ -31,61 +31,46 @@
 #ifndef PORTAL_H
 #define PORTAL_H
 
-#include "scene/3d/visual_instance.h"
-/**
-	@author Juan Linietsky <reduzio@gmail.com>
-*/
+#include "scene/3d/spatial.h"
 
 /* Portal Logic:
-   If a portal is placed next (very close to) a similar, opposing portal, they automatically connect,
-   otherwise, a portal connects to the parent room
+   A portal is a convex polygon on its local XY plane connecting the Room it is inside of with
+   linked_room, or with the exterior when that is empty. Rooms behind it are only drawn through
+   the part of the polygon the camera sees.
 */
-// FIXME: This will be redone and replaced by area portals, left for reference
-// since a new class with this name will have to exist and want to reuse the gizmos
-#if 0
-class Portal : public VisualInstance {
 
-	GDCLASS(Portal, VisualInstance);
+class Portal : public Spatial {
 
-	RID portal;
-	Vector<Point2> shape;
+	GDCLASS(Portal, Spatial);
 
+	RID portal;
+	PoolVector<Vector2> polygon;
 	bool enabled;
-	float disable_distance;
-	Color disabled_color;
-	float connect_range;
+	NodePath linked_room;
 
-	AABB aabb;
+	RID _get_parent_room() const;
+	RID _get_linked_room() const;
+	void _update_polygon();
+	void _update_rooms();
 
 protected:
-	bool _set(const StringName &p_name, const Variant &p_value);
-	bool _get(const StringName &p_name, Variant &r_ret) const;
-	void _get_property_list(List<PropertyInfo> *p_list) const;
-
+	void _notification(int p_what);
 	static void _bind_methods();
 
 public:
-	virtual AABB get_aabb() const;
-	virtual PoolVector<Face3> get_faces(uint32_t p_usage_flags) const;
+	void set_polygon(const PoolVector<Vector2> &p_polygon);
+	PoolVector<Vector2> get_polygon() const;
 
 	void set_enabled(bool p_enabled);
 	bool is_enabled() const;
 
-	void set_disable_distance(float p_distance);
-	float get_disable_distance() const;
-
-	void set_disabled_color(const Color &p_disabled_color);
-	Color get_disabled_color() const;
-
-	void set_shape(const Vector<Point2> &p_shape);
-	Vector<Point2> get_shape() const;
+	void set_linked_room(const NodePath &p_room);
+	NodePath get_linked_room() const;
 
-	void set_connect_range(float p_range);
-	float get_connect_range() const;
+	String get_configuration_warning() const;
 
 	Portal();
 	~Portal();
 };
 
-#endif
-#endif
+#endif // PORTAL_H
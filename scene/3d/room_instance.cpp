@@ -30,135 +30,106 @@
 
 #include "room_instance.h"
 
+#include "scene/3d/visual_instance.h"
 #include "servers/visual_server.h"
 
-// FIXME: Will be removed, kept as reference for new implementation
-#if 0
-#include "core/math/geometry.h"
-#include "core/project_settings.h"
-#include "scene/resources/surface_tool.h"
+void Room::_find_child_bounds(Node *p_node, PoolVector<Vector3> &r_points) const {
 
-void Room::_notification(int p_what) {
-
-	switch (p_what) {
-		case NOTIFICATION_ENTER_WORLD: {
-			// go find parent level
-			Node *parent_room = get_parent();
-			level = 0;
-
-			while (parent_room) {
-
-				Room *r = Object::cast_to<Room>(parent_room);
-				if (r) {
+	for (int i = 0; i < p_node->get_child_count(); i++) {
 
-					level = r->level + 1;
-					break;
-				}
+		Node *child = p_node->get_child(i);
+		if (Object::cast_to<Room>(child)) {
+			continue; // nested rooms have their own bounds
+		}
 
-				parent_room = parent_room->get_parent();
+		VisualInstance *vi = Object::cast_to<VisualInstance>(child);
+		if (vi) {
+			AABB aabb = vi->get_transformed_aabb();
+			for (int j = 0; j < 8; j++) {
+				r_points.push_back(aabb.get_endpoint(j));
 			}
+		}
 
-		} break;
-		case NOTIFICATION_TRANSFORM_CHANGED: {
-		} break;
-		case NOTIFICATION_EXIT_WORLD: {
-
-		} break;
+		_find_child_bounds(child, r_points);
 	}
 }
 
-AABB Room::get_aabb() const {
-
-	if (room.is_null())
-		return AABB();
-
-	return AABB();
-}
-
-PoolVector<Face3> Room::get_faces(uint32_t p_usage_flags) const {
-
-	return PoolVector<Face3>();
-}
-
-void Room::set_room(const Ref<RoomBounds> &p_room) {
+void Room::update_bounds() {
 
-	room = p_room;
-	update_gizmo();
+	if (!is_inside_tree()) {
+		return;
+	}
 
-	if (room.is_valid()) {
+	PoolVector<Vector3> points;
 
-		set_base(room->get_rid());
+	if (bounds.size()) {
+		Transform xform = get_global_transform();
+		points.resize(bounds.size());
+		PoolVector<Vector3>::Read r = bounds.read();
+		PoolVector<Vector3>::Write w = points.write();
+		for (int i = 0; i < bounds.size(); i++) {
+			w[i] = xform.xform(r[i]);
+		}
 	} else {
-		set_base(RID());
+		_find_child_bounds(this, points);
 	}
 
-	if (!is_inside_tree())
-		return;
-
-	propagate_notification(NOTIFICATION_AREA_CHANGED);
-	update_gizmo();
+	VS::get_singleton()->room_set_bounds(room, points);
 }
 
-Ref<RoomBounds> Room::get_room() const {
-
-	return room;
-}
-
-void Room::_parse_node_faces(PoolVector<Face3> &all_faces, const Node *p_node) const {
-
-	const VisualInstance *vi = Object::cast_to<VisualInstance>(p_node);
+void Room::_notification(int p_what) {
 
-	if (vi) {
-		PoolVector<Face3> faces = vi->get_faces(FACES_ENCLOSING);
+	switch (p_what) {
+		case NOTIFICATION_ENTER_WORLD: {
 
-		if (faces.size()) {
-			int old_len = all_faces.size();
-			all_faces.resize(all_faces.size() + faces.size());
-			int new_len = all_faces.size();
-			PoolVector<Face3>::Write all_facesw = all_faces.write();
-			Face3 *all_facesptr = all_facesw.ptr();
+			VS::get_singleton()->room_set_scenario(room, get_world()->get_scenario());
+			// Children are not in the tree yet, wait until they are in case the bounds come from them.
+			call_deferred("update_bounds");
+		} break;
+		case NOTIFICATION_TRANSFORM_CHANGED: {
 
-			PoolVector<Face3>::Read facesr = faces.read();
-			const Face3 *facesptr = facesr.ptr();
+			update_bounds();
+		} break;
+		case NOTIFICATION_EXIT_WORLD: {
 
-			Transform tr = vi->get_relative_transform(this);
+			VS::get_singleton()->room_set_scenario(room, RID());
+		} break;
+	}
+}
 
-			for (int i = old_len; i < new_len; i++) {
+void Room::set_bounds(const PoolVector<Vector3> &p_bounds) {
 
-				Face3 f = facesptr[i - old_len];
-				for (int j = 0; j < 3; j++)
-					f.vertex[j] = tr.xform(f.vertex[j]);
-				all_facesptr[i] = f;
-			}
-		}
-	}
+	bounds = p_bounds;
+	update_bounds();
+	update_gizmo();
+}
 
-	for (int i = 0; i < p_node->get_child_count(); i++) {
+PoolVector<Vector3> Room::get_bounds() const {
 
-		_parse_node_faces(all_faces, p_node->get_child(i));
-	}
+	return bounds;
 }
 
-void Room::_bounds_changed() {
+RID Room::get_rid() const {
 
-	update_gizmo();
+	return room;
 }
 
 void Room::_bind_methods() {
 
-	ClassDB::bind_method(D_METHOD("set_room", "room"), &Room::set_room);
-	ClassDB::bind_method(D_METHOD("get_room"), &Room::get_room);
+	ClassDB::bind_method(D_METHOD("set_bounds", "bounds"), &Room::set_bounds);
+	ClassDB::bind_method(D_METHOD("get_bounds"), &Room::get_bounds);
+	ClassDB::bind_method(D_METHOD("update_bounds"), &Room::update_bounds);
 
-	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "room/room", PROPERTY_HINT_RESOURCE_TYPE, "Area"), "set_room", "get_room");
+	ADD_PROPERTY(PropertyInfo(Variant::POOL_VECTOR3_ARRAY, "bounds"), "set_bounds", "get_bounds");
 }
 
 Room::Room() {
 
-	//	sound_enabled=false;
-
-	level = 0;
+	room = VS::get_singleton()->room_create();
+	set_notify_transform(true);
 }
 
 Room::~Room() {
+
+	VS::get_singleton()->free(room);
 }
-#endif
@@ -31,55 +31,37 @@
 #ifndef ROOM_INSTANCE_H
 #define ROOM_INSTANCE_H
 
-#include "scene/3d/visual_instance.h"
-#include "scene/resources/room.h"
+#include "scene/3d/spatial.h"
 
-/**
-	@author Juan Linietsky <reduzio@gmail.com>
+/* Room Logic:
+   a) A room is a convex volume. Instances whose bounds touch it belong to it, the ones not fully
+      inside any room also belong to the exterior.
+   b) Rooms are only drawn when the camera is inside them, or sees them through a chain of Portals.
+   c) Without rooms in the scenario, nothing changes.
 */
 
-/* RoomInstance Logic:
-   a) Instances that belong to the room are drawn only if the room is visible (seen through portal, or player inside)
-   b) Instances that don't belong to any room are considered to belong to the root room (RID empty)
-   c) "dynamic" Instances are assigned to the rooms their AABB touch
+class Room : public Spatial {
 
-*/
-
-// FIXME: this will be removed, left for reference
-#if 0
-
-class Room : public VisualInstance {
+	GDCLASS(Room, Spatial);
 
-	GDCLASS(Room, VisualInstance);
-
-public:
-private:
-	Ref<RoomBounds> room;
+	RID room;
+	PoolVector<Vector3> bounds;
 
-	int level;
-	void _parse_node_faces(PoolVector<Face3> &all_faces, const Node *p_node) const;
-
-	void _bounds_changed();
+	void _find_child_bounds(Node *p_node, PoolVector<Vector3> &r_points) const;
 
 protected:
 	void _notification(int p_what);
-
 	static void _bind_methods();
 
 public:
-	enum {
-		// used to notify portals that the room in which they are has changed.
-		NOTIFICATION_AREA_CHANGED = 60
-	};
+	void set_bounds(const PoolVector<Vector3> &p_bounds);
+	PoolVector<Vector3> get_bounds() const;
+	void update_bounds();
 
-	virtual AABB get_aabb() const;
-	virtual PoolVector<Face3> get_faces(uint32_t p_usage_flags) const;
-
-	void set_room(const Ref<RoomBounds> &p_room);
-	Ref<RoomBounds> get_room() const;
+	RID get_rid() const;
 
 	Room();
 	~Room();
 };
-#endif
+
 #endif // ROOM_INSTANCE_H
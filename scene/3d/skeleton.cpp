@@ -210,117 +210,114 @@ void Skeleton::_notification(int p_what) {
 		} break;
 		case NOTIFICATION_UPDATE_SKELETON: {
 
-			VisualServer *vs = VisualServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-			int len = bones.size();
-
-			vs->skeleton_allocate(skeleton, len); // if same size, nothing really happens
-
-			_update_process_order();
-
-			const int *order = process_order.ptr();
-
-			// pose changed, rebuild cache of inverses
-			if (rest_global_inverse_dirty) {
-
-				// calculate global rests and invert them
-				for (int i = 0; i < len; i++) {
-					Bone &b = bonesptr[order[i]];
-					if (b.parent >= 0)
-						b.rest_global_inverse = bonesptr[b.parent].rest_global_inverse * b.rest;
-					else
-						b.rest_global_inverse = b.rest;
-				}
-				for (int i = 0; i < len; i++) {
-					Bone &b = bonesptr[order[i]];
-					b.rest_global_inverse.affine_invert();
-				}
-
-				rest_global_inverse_dirty = false;
-			}
+			_update_bone_poses();
+		} break;
+	}
+}
 
-			for (int i = 0; i < len; i++) {
+void Skeleton::_update_bone_poses() {
 
-				Bone &b = bonesptr[order[i]];
+	VisualServer *vs = VisualServer::get_singleton();
+	int len = bones.size();
 
-				if (b.disable_rest) {
-					if (b.enabled) {
+	if (allocated_bone_count != len) {
+		vs->skeleton_allocate(skeleton, len);
+		allocated_bone_count = len;
+		all_bones_dirty = true;
+	}
 
-						Transform pose = b.pose;
-						if (b.custom_pose_enable) {
+	_update_process_order();
 
-							pose = b.custom_pose * pose;
-						}
+	const Bone *bonesptr = bones.ptr();
+	const int *order = process_order.ptr();
+	const Transform *rest = bone_rest.ptr();
+	Transform *rest_global_inverse = bone_rest_global_inverse.ptrw();
+	const Transform *pose = bone_pose.ptr();
+	Transform *pose_global = bone_pose_global.ptrw();
+	uint8_t *changed = bone_dirty.ptrw();
 
-						if (b.parent >= 0) {
+	// pose changed, rebuild cache of inverses
+	if (rest_global_inverse_dirty) {
 
-							b.pose_global = bonesptr[b.parent].pose_global * pose;
-						} else {
+		// calculate global rests and invert them
+		for (int i = 0; i < len; i++) {
+			int idx = order[i];
+			int parent = bonesptr[idx].parent;
+			if (parent >= 0)
+				rest_global_inverse[idx] = rest_global_inverse[parent] * rest[idx];
+			else
+				rest_global_inverse[idx] = rest[idx];
+		}
+		for (int i = 0; i < len; i++) {
+			rest_global_inverse[order[i]].affine_invert();
+		}
 
-							b.pose_global = pose;
-						}
-					} else {
+		rest_global_inverse_dirty = false;
+		all_bones_dirty = true;
+	}
 
-						if (b.parent >= 0) {
+	for (int i = 0; i < len; i++) {
 
-							b.pose_global = bonesptr[b.parent].pose_global;
-						} else {
+		int idx = order[i];
+		const Bone &b = bonesptr[idx];
 
-							b.pose_global = Transform();
-						}
-					}
+		// Parents come first in process order, so a moved parent has already flagged itself here.
+		if (!all_bones_dirty && !changed[idx] && (b.parent < 0 || !changed[b.parent])) {
+			continue;
+		}
+		changed[idx] = 1;
 
-				} else {
-					if (b.enabled) {
+		Transform local;
+		if (b.enabled) {
 
-						Transform pose = b.pose;
-						if (b.custom_pose_enable) {
+			local = pose[idx];
+			if (b.custom_pose_enable) {
 
-							pose = b.custom_pose * pose;
-						}
+				local = b.custom_pose * local;
+			}
 
-						if (b.parent >= 0) {
+			if (!b.disable_rest) {
 
-							b.pose_global = bonesptr[b.parent].pose_global * (b.rest * pose);
-						} else {
+				local = rest[idx] * local;
+			}
+		} else if (!b.disable_rest) {
 
-							b.pose_global = b.rest * pose;
-						}
-					} else {
+			local = rest[idx];
+		}
 
-						if (b.parent >= 0) {
+		if (b.parent >= 0) {
 
-							b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-						} else {
+			pose_global[idx] = pose_global[b.parent] * local;
+		} else {
 
-							b.pose_global = b.rest;
-						}
-					}
-				}
+			pose_global[idx] = local;
+		}
 
-				b.transform_final = b.pose_global * b.rest_global_inverse;
-				vs->skeleton_bone_set_transform(skeleton, order[i], b.transform_final);
+		vs->skeleton_bone_set_transform(skeleton, idx, pose_global[idx] * rest_global_inverse[idx]);
 
-				for (List<uint32_t>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
+		for (const List<uint32_t>::Element *E = b.nodes_bound.front(); E; E = E->next()) {
 
-					Object *obj = ObjectDB::get_instance(E->get());
-					ERR_CONTINUE(!obj);
-					Spatial *sp = Object::cast_to<Spatial>(obj);
-					ERR_CONTINUE(!sp);
-					sp->set_transform(b.pose_global);
-				}
-			}
+			Object *obj = ObjectDB::get_instance(E->get());
+			ERR_CONTINUE(!obj);
+			Spatial *sp = Object::cast_to<Spatial>(obj);
+			ERR_CONTINUE(!sp);
+			sp->set_transform(pose_global[idx]);
+		}
+	}
 
-			dirty = false;
-		} break;
+	for (int i = 0; i < len; i++) {
+		changed[i] = 0;
 	}
+
+	all_bones_dirty = false;
+	dirty = false;
 }
 
 Transform Skeleton::get_bone_transform(int p_bone) const {
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 	if (dirty)
 		const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
-	return bones[p_bone].pose_global * bones[p_bone].rest_global_inverse;
+	return bone_pose_global[p_bone] * bone_rest_global_inverse[p_bone];
 }
 
 void Skeleton::set_bone_global_pose(int p_bone, const Transform &p_pose) {
@@ -328,10 +325,10 @@ void Skeleton::set_bone_global_pose(int p_bone, const Transform &p_pose) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 	if (bones[p_bone].parent == -1) {
 
-		set_bone_pose(p_bone, bones[p_bone].rest_global_inverse * p_pose); //fast
+		set_bone_pose(p_bone, bone_rest_global_inverse[p_bone] * p_pose); //fast
 	} else {
 
-		set_bone_pose(p_bone, bones[p_bone].rest.affine_inverse() * (get_bone_global_pose(bones[p_bone].parent).affine_inverse() * p_pose)); //slow
+		set_bone_pose(p_bone, bone_rest[p_bone].affine_inverse() * (get_bone_global_pose(bones[p_bone].parent).affine_inverse() * p_pose)); //slow
 	}
 }
 
@@ -340,7 +337,7 @@ Transform Skeleton::get_bone_global_pose(int p_bone) const {
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 	if (dirty)
 		const_cast<Skeleton *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
-	return bones[p_bone].pose_global;
+	return bone_pose_global[p_bone];
 }
 
 RID Skeleton::get_skeleton() const {
@@ -361,6 +358,11 @@ void Skeleton::add_bone(const String &p_name) {
 	Bone b;
 	b.name = p_name;
 	bones.push_back(b);
+	bone_rest.push_back(Transform());
+	bone_rest_global_inverse.push_back(Transform());
+	bone_pose.push_back(Transform());
+	bone_pose_global.push_back(Transform());
+	bone_dirty.push_back(1);
 	process_order_dirty = true;
 
 	rest_global_inverse_dirty = true;
@@ -421,12 +423,13 @@ void Skeleton::unparent_bone_and_rest(int p_bone) {
 
 	int parent = bones[p_bone].parent;
 	while (parent >= 0) {
-		bones.write[p_bone].rest = bones[parent].rest * bones[p_bone].rest;
+		bone_rest.write[p_bone] = bone_rest[parent] * bone_rest[p_bone];
 		parent = bones[parent].parent;
 	}
 
 	bones.write[p_bone].parent = -1;
-	bones.write[p_bone].rest_global_inverse = bones[p_bone].rest.affine_inverse(); //same thing
+	bone_rest_global_inverse.write[p_bone] = bone_rest[p_bone].affine_inverse(); //same thing
+	bone_dirty.write[p_bone] = 1;
 	process_order_dirty = true;
 
 	_make_dirty();
@@ -447,6 +450,8 @@ void Skeleton::set_bone_disable_rest(int p_bone, bool p_disable) {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 	bones.write[p_bone].disable_rest = p_disable;
+	bone_dirty.write[p_bone] = 1;
+	_make_dirty();
 }
 
 bool Skeleton::is_bone_rest_disabled(int p_bone) const {
@@ -466,7 +471,7 @@ void Skeleton::set_bone_rest(int p_bone, const Transform &p_rest) {
 
 	ERR_FAIL_INDEX(p_bone, bones.size());
 
-	bones.write[p_bone].rest = p_rest;
+	bone_rest.write[p_bone] = p_rest;
 	rest_global_inverse_dirty = true;
 	_make_dirty();
 }
@@ -474,7 +479,7 @@ Transform Skeleton::get_bone_rest(int p_bone) const {
 
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
 
-	return bones[p_bone].rest;
+	return bone_rest[p_bone];
 }
 
 void Skeleton::set_bone_enabled(int p_bone, bool p_enabled) {
@@ -505,6 +510,8 @@ void Skeleton::bind_child_node_to_bone(int p_bone, Node *p_node) {
 	}
 
 	bones.write[p_bone].nodes_bound.push_back(id);
+	bone_dirty.write[p_bone] = 1;
+	_make_dirty();
 }
 void Skeleton::unbind_child_node_from_bone(int p_bone, Node *p_node) {
 
@@ -529,6 +536,11 @@ void Skeleton::get_bound_child_nodes_to_bone(int p_bone, List<Node *> *p_bound)
 void Skeleton::clear_bones() {
 
 	bones.clear();
+	bone_rest.clear();
+	bone_rest_global_inverse.clear();
+	bone_pose.clear();
+	bone_pose_global.clear();
+	bone_dirty.clear();
 	rest_global_inverse_dirty = true;
 	process_order_dirty = true;
 
@@ -542,13 +554,60 @@ void Skeleton::set_bone_pose(int p_bone, const Transform &p_pose) {
 	ERR_FAIL_INDEX(p_bone, bones.size());
 	ERR_FAIL_COND(!is_inside_tree());
 
-	bones.write[p_bone].pose = p_pose;
+	if (bone_pose[p_bone] == p_pose) {
+		return; // animations write every track each frame, even when nothing moves
+	}
+
+	bone_pose.write[p_bone] = p_pose;
+	bone_dirty.write[p_bone] = 1;
 	_make_dirty();
 }
+
+void Skeleton::set_bone_poses(const int *p_bones, const Transform *p_poses, int p_count) {
+
+	ERR_FAIL_COND(!is_inside_tree());
+
+	int len = bones.size();
+	Transform *pose = bone_pose.ptrw();
+	uint8_t *changed = bone_dirty.ptrw();
+	bool any_changed = false;
+
+	for (int i = 0; i < p_count; i++) {
+
+		int idx = p_bones[i];
+		ERR_CONTINUE(idx < 0 || idx >= len);
+
+		if (pose[idx] == p_poses[i]) {
+			continue;
+		}
+		pose[idx] = p_poses[i];
+		changed[idx] = 1;
+		any_changed = true;
+	}
+
+	if (any_changed) {
+		_make_dirty();
+	}
+}
+
+void Skeleton::_set_bone_poses(const PoolIntArray &p_bones, const Array &p_poses) {
+
+	ERR_FAIL_COND(p_bones.size() != p_poses.size());
+
+	Vector<Transform> poses;
+	poses.resize(p_poses.size());
+	for (int i = 0; i < p_poses.size(); i++) {
+		poses.write[i] = p_poses[i];
+	}
+
+	PoolIntArray::Read r = p_bones.read();
+	set_bone_poses(r.ptr(), poses.ptr(), poses.size());
+}
+
 Transform Skeleton::get_bone_pose(int p_bone) const {
 
 	ERR_FAIL_INDEX_V(p_bone, bones.size(), Transform());
-	return bones[p_bone].pose;
+	return bone_pose[p_bone];
 }
 
 void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose) {
@@ -558,6 +617,7 @@ void Skeleton::set_bone_custom_pose(int p_bone, const Transform &p_custom_pose)
 
 	bones.write[p_bone].custom_pose_enable = (p_custom_pose != Transform());
 	bones.write[p_bone].custom_pose = p_custom_pose;
+	bone_dirty.write[p_bone] = 1;
 
 	_make_dirty();
 }
@@ -590,7 +650,7 @@ void Skeleton::localize_rests() {
 	for (int i = bones.size() - 1; i >= 0; i--) {
 		int idx = process_order[i];
 		if (bones[idx].parent >= 0) {
-			set_bone_rest(idx, bones[bones[idx].parent].rest.affine_inverse() * bones[idx].rest);
+			set_bone_rest(idx, bone_rest[bones[idx].parent].affine_inverse() * bone_rest[idx]);
 		}
 	}
 }
@@ -783,6 +843,7 @@ void Skeleton::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("get_bone_pose", "bone_idx"), &Skeleton::get_bone_pose);
 	ClassDB::bind_method(D_METHOD("set_bone_pose", "bone_idx", "pose"), &Skeleton::set_bone_pose);
+	ClassDB::bind_method(D_METHOD("set_bone_poses", "bone_indices", "poses"), &Skeleton::_set_bone_poses);
 
 	ClassDB::bind_method(D_METHOD("set_bone_global_pose", "bone_idx", "pose"), &Skeleton::set_bone_global_pose);
 	ClassDB::bind_method(D_METHOD("get_bone_global_pose", "bone_idx"), &Skeleton::get_bone_global_pose);
@@ -815,6 +876,8 @@ Skeleton::Skeleton() {
 	rest_global_inverse_dirty = true;
 	dirty = false;
 	process_order_dirty = true;
+	all_bones_dirty = true;
+	allocated_bone_count = -1;
 	skeleton = VisualServer::get_singleton()->skeleton_create();
 	set_notify_transform(true);
 	use_bones_in_world_transform = false;
@@ -823,3 +886,35 @@ Skeleton::Skeleton() {
 Skeleton::~Skeleton() {
 	VisualServer::get_singleton()->free(skeleton);
 }
+
+void SkeletonPoseBatch::set_bone_pose(Skeleton *p_skeleton, int p_bone, const Transform &p_pose) {
+
+	if (p_skeleton != skeleton) {
+		flush();
+		skeleton = p_skeleton;
+	}
+
+	if (count == bones.size()) {
+		bones.resize(MAX(count * 2, 32));
+		poses.resize(bones.size());
+	}
+
+	bones.write[count] = p_bone;
+	poses.write[count] = p_pose;
+	count++;
+}
+
+void SkeletonPoseBatch::flush() {
+
+	if (skeleton && count) {
+		skeleton->set_bone_poses(bones.ptr(), poses.ptr(), count);
+	}
+	skeleton = NULL;
+	count = 0; // keep the arrays around for the next frame
+}
+
+SkeletonPoseBatch::SkeletonPoseBatch() {
+
+	skeleton = NULL;
+	count = 0;
+}
@@ -48,6 +48,9 @@ class Skeleton : public Spatial {
 
 	GDCLASS(Skeleton, Spatial);
 
+	// Names, hierarchy and flags. The transforms used every update live in the
+	// bone_* arrays below, indexed the same way, so the update loop walks
+	// tightly packed data.
 	struct Bone {
 
 		String name;
@@ -59,17 +62,10 @@ class Skeleton : public Spatial {
 		bool ignore_animation;
 
 		bool disable_rest;
-		Transform rest;
-		Transform rest_global_inverse;
-
-		Transform pose;
-		Transform pose_global;
 
 		bool custom_pose_enable;
 		Transform custom_pose;
 
-		Transform transform_final;
-
 #ifndef _3D_DISABLED
 		PhysicalBone *physical_bone;
 		PhysicalBone *cache_parent_physical_bone;
@@ -93,8 +89,15 @@ class Skeleton : public Spatial {
 	bool rest_global_inverse_dirty;
 
 	Vector<Bone> bones;
+	Vector<Transform> bone_rest;
+	Vector<Transform> bone_rest_global_inverse;
+	Vector<Transform> bone_pose;
+	Vector<Transform> bone_pose_global;
+	Vector<uint8_t> bone_dirty; // pose changed since the last update, children follow along
 	Vector<int> process_order;
 	bool process_order_dirty;
+	bool all_bones_dirty;
+	int allocated_bone_count;
 
 	RID skeleton;
 
@@ -117,6 +120,8 @@ class Skeleton : public Spatial {
 	}
 
 	void _update_process_order();
+	void _update_bone_poses();
+	void _set_bone_poses(const PoolIntArray &p_bones, const Array &p_poses);
 
 protected:
 	bool _get(const StringName &p_path, Variant &r_ret) const;
@@ -172,6 +177,7 @@ public:
 	// posing api
 
 	void set_bone_pose(int p_bone, const Transform &p_pose);
+	void set_bone_poses(const int *p_bones, const Transform *p_poses, int p_count);
 	Transform get_bone_pose(int p_bone) const;
 
 	void set_bone_custom_pose(int p_bone, const Transform &p_custom_pose);
@@ -209,4 +215,21 @@ public:
 	~Skeleton();
 };
 
+// Collects the bone poses written while applying animation tracks and hands
+// them to their skeleton with one set_bone_poses() call. Switching to another
+// skeleton flushes the previous one; call flush() once all tracks are done.
+class SkeletonPoseBatch {
+
+	Skeleton *skeleton;
+	Vector<int> bones;
+	Vector<Transform> poses;
+	int count;
+
+public:
+	void set_bone_pose(Skeleton *p_skeleton, int p_bone, const Transform &p_pose);
+	void flush();
+
+	SkeletonPoseBatch();
+};
+
 #endif
@@ -206,6 +206,33 @@ float GeometryInstance::get_lod_max_hysteresis() const {
 	return lod_max_hysteresis;
 }
 
+void GeometryInstance::set_lod_parent(const NodePath &p_path) {
+
+	lod_parent = p_path;
+	if (is_inside_world()) {
+		_update_lod_parent();
+	}
+}
+
+NodePath GeometryInstance::get_lod_parent() const {
+
+	return lod_parent;
+}
+
+void GeometryInstance::_update_lod_parent() {
+
+	RID parent_instance;
+
+	if (!lod_parent.is_empty() && is_inside_world()) {
+		GeometryInstance *parent = Object::cast_to<GeometryInstance>(get_node_or_null(lod_parent));
+		if (parent && parent != this) {
+			parent_instance = parent->get_instance();
+		}
+	}
+
+	VS::get_singleton()->instance_geometry_set_as_instance_lod(get_instance(), parent_instance);
+}
+
 void GeometryInstance::_notification(int p_what) {
 
 	if (p_what == NOTIFICATION_ENTER_WORLD) {
@@ -213,10 +240,18 @@ void GeometryInstance::_notification(int p_what) {
 		if (flags[FLAG_USE_BAKED_LIGHT]) {
 		}
 
+		if (!lod_parent.is_empty()) {
+			_update_lod_parent();
+		}
+
 	} else if (p_what == NOTIFICATION_EXIT_WORLD) {
 
 		if (flags[FLAG_USE_BAKED_LIGHT]) {
 		}
+
+		if (!lod_parent.is_empty()) {
+			VS::get_singleton()->instance_geometry_set_as_instance_lod(get_instance(), RID());
+		}
 	}
 }
 
@@ -251,6 +286,31 @@ GeometryInstance::ShadowCastingSetting GeometryInstance::get_cast_shadows_settin
 	return shadow_casting_setting;
 }
 
+void GeometryInstance::set_occluder_mesh(const Ref<Mesh> &p_mesh) {
+
+	occluder_mesh = p_mesh;
+
+	PoolVector<Vector3> faces;
+	if (occluder_mesh.is_valid()) {
+		PoolVector<Face3> mesh_faces = occluder_mesh->get_faces();
+		faces.resize(mesh_faces.size() * 3);
+		PoolVector<Face3>::Read r = mesh_faces.read();
+		PoolVector<Vector3>::Write w = faces.write();
+		for (int i = 0; i < mesh_faces.size(); i++) {
+			for (int j = 0; j < 3; j++) {
+				w[i * 3 + j] = r[i].vertex[j];
+			}
+		}
+	}
+
+	VS::get_singleton()->instance_geometry_set_occluder(get_instance(), faces);
+}
+
+Ref<Mesh> GeometryInstance::get_occluder_mesh() const {
+
+	return occluder_mesh;
+}
+
 void GeometryInstance::set_extra_cull_margin(float p_margin) {
 
 	ERR_FAIL_COND(p_margin < 0);
@@ -286,6 +346,12 @@ void GeometryInstance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_lod_min_distance", "mode"), &GeometryInstance::set_lod_min_distance);
 	ClassDB::bind_method(D_METHOD("get_lod_min_distance"), &GeometryInstance::get_lod_min_distance);
 
+	ClassDB::bind_method(D_METHOD("set_lod_parent", "path"), &GeometryInstance::set_lod_parent);
+	ClassDB::bind_method(D_METHOD("get_lod_parent"), &GeometryInstance::get_lod_parent);
+
+	ClassDB::bind_method(D_METHOD("set_occluder_mesh", "mesh"), &GeometryInstance::set_occluder_mesh);
+	ClassDB::bind_method(D_METHOD("get_occluder_mesh"), &GeometryInstance::get_occluder_mesh);
+
 	ClassDB::bind_method(D_METHOD("set_extra_cull_margin", "margin"), &GeometryInstance::set_extra_cull_margin);
 	ClassDB::bind_method(D_METHOD("get_extra_cull_margin"), &GeometryInstance::get_extra_cull_margin);
 
@@ -296,12 +362,14 @@ void GeometryInstance::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "cast_shadow", PROPERTY_HINT_ENUM, "Off,On,Double-Sided,Shadows Only"), "set_cast_shadows_setting", "get_cast_shadows_setting");
 	ADD_PROPERTY(PropertyInfo(Variant::REAL, "extra_cull_margin", PROPERTY_HINT_RANGE, "0,16384,0.01"), "set_extra_cull_margin", "get_extra_cull_margin");
 	ADD_PROPERTYI(PropertyInfo(Variant::BOOL, "use_in_baked_light"), "set_flag", "get_flag", FLAG_USE_BAKED_LIGHT);
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "occluder_mesh", PROPERTY_HINT_RESOURCE_TYPE, "Mesh"), "set_occluder_mesh", "get_occluder_mesh");
 
 	ADD_GROUP("LOD", "lod_");
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_min_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_distance", "get_lod_min_distance");
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_min_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_hysteresis", "get_lod_min_hysteresis");
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_distance", "get_lod_max_distance");
-	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_hysteresis", "get_lod_max_hysteresis");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "lod_min_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_distance", "get_lod_min_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "lod_min_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_min_hysteresis", "get_lod_min_hysteresis");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "lod_max_distance", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_distance", "get_lod_max_distance");
+	ADD_PROPERTY(PropertyInfo(Variant::REAL, "lod_max_hysteresis", PROPERTY_HINT_RANGE, "0,32768,0.01"), "set_lod_max_hysteresis", "get_lod_max_hysteresis");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_parent", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "GeometryInstance"), "set_lod_parent", "get_lod_parent");
 
 	//ADD_SIGNAL( MethodInfo("visibility_changed"));
 
@@ -35,6 +35,7 @@
 #include "core/rid.h"
 #include "scene/3d/spatial.h"
 #include "scene/resources/material.h"
+#include "scene/resources/mesh.h"
 /**
 	@author Juan Linietsky <reduzio@gmail.com>
 */
@@ -105,9 +106,13 @@ private:
 	float lod_max_distance;
 	float lod_min_hysteresis;
 	float lod_max_hysteresis;
+	NodePath lod_parent;
+	Ref<Mesh> occluder_mesh;
 
 	float extra_cull_margin;
 
+	void _update_lod_parent();
+
 protected:
 	void _notification(int p_what);
 	static void _bind_methods();
@@ -131,9 +136,15 @@ public:
 	void set_lod_max_hysteresis(float p_dist);
 	float get_lod_max_hysteresis() const;
 
+	void set_lod_parent(const NodePath &p_path);
+	NodePath get_lod_parent() const;
+
 	void set_material_override(const Ref<Material> &p_material);
 	Ref<Material> get_material_override() const;
 
+	void set_occluder_mesh(const Ref<Mesh> &p_mesh);
+	Ref<Mesh> get_occluder_mesh() const;
+
 	void set_extra_cull_margin(float p_margin);
 	float get_extra_cull_margin() const;
 
@@ -842,13 +842,14 @@ void AnimationPlayer::_animation_update_transforms() {
 			t.basis.set_quat_scale(nc->rot_accum, nc->scale_accum);
 			if (nc->skeleton && nc->bone_idx >= 0) {
 
-				nc->skeleton->set_bone_pose(nc->bone_idx, t);
+				bone_pose_batch.set_bone_pose(nc->skeleton, nc->bone_idx, t);
 
 			} else if (nc->spatial) {
 
 				nc->spatial->set_transform(t);
 			}
 		}
+		bone_pose_batch.flush();
 	}
 
 	cache_update_size = 0;
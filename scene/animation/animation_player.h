@@ -257,6 +257,7 @@ private:
 	void _animation_process_data(PlaybackData &cd, float p_delta, float p_blend, bool p_seeked, bool p_started);
 	void _animation_process2(float p_delta, bool p_started);
 	void _animation_update_transforms();
+	SkeletonPoseBatch bone_pose_batch;
 	void _animation_process(float p_delta);
 
 	void _node_removed(Node *p_node);
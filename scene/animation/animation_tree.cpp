@@ -1254,7 +1254,7 @@ void AnimationTree::_process_graph(float p_delta) {
 						}
 					} else if (t->skeleton && t->bone_idx >= 0) {
 
-						t->skeleton->set_bone_pose(t->bone_idx, xform);
+						bone_pose_batch.set_bone_pose(t->skeleton, t->bone_idx, xform);
 
 					} else {
 
@@ -1280,6 +1280,7 @@ void AnimationTree::_process_graph(float p_delta) {
 				} //the rest don't matter
 			}
 		}
+		bone_pose_batch.flush();
 	}
 }
 
@@ -269,6 +269,7 @@ private:
 	void _clear_caches();
 	bool _update_caches(AnimationPlayer *player);
 	void _process_graph(float p_delta);
+	SkeletonPoseBatch bone_pose_batch;
 
 	uint64_t setup_pass;
 	uint64_t process_pass;
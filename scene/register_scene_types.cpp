@@ -246,6 +246,7 @@ void register_scene_types() {
 
 	resource_loader_text.instance();
 	ResourceLoader::add_resource_format_loader(resource_loader_text, true);
+	ResourceFormatLoaderText::set_parallel_parsing(GLOBAL_DEF("application/run/parallel_text_resource_parsing", false));
 
 	resource_saver_shader.instance();
 	ResourceSaver::add_resource_format_saver(resource_saver_shader, true);
@@ -455,6 +456,8 @@ void register_scene_types() {
 	ClassDB::register_class<PathFollow>();
 	ClassDB::register_class<VisibilityNotifier>();
 	ClassDB::register_class<VisibilityEnabler>();
+	ClassDB::register_class<Room>();
+	ClassDB::register_class<Portal>();
 	ClassDB::register_class<WorldEnvironment>();
 	ClassDB::register_class<RemoteTransform>();
 
@@ -781,6 +784,10 @@ void unregister_scene_types() {
 
 	SpatialMaterial::finish_shaders();
 	ParticlesMaterial::finish_shaders();
+#ifndef _3D_DISABLED
+	CPUParticles::finish_work_pool();
+#endif
+	CPUParticles2D::finish_work_pool();
 	CanvasItemMaterial::finish_shaders();
 	SceneStringNames::free();
 }
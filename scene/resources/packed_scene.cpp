@@ -80,6 +80,8 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 	Node **ret_nodes = (Node **)alloca(sizeof(Node *) * nc);
 
+	const InstancePlan &plan = _get_instance_plan();
+
 	bool gen_node_path_cache = p_edit_state != GEN_EDIT_STATE_DISABLED && node_path_cache.empty();
 
 	Map<Ref<Resource>, Ref<Resource> > resources_local_to_scene;
@@ -92,8 +94,11 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 		if (i > 0) {
 
-			ERR_EXPLAIN(vformat("Invalid scene: node %s does not specify its parent node.", snames[n.name]))
-			ERR_FAIL_COND_V(n.parent == -1, NULL)
+			if (n.parent == -1) {
+				//only format the message when it's needed, this runs for every node
+				ERR_EXPLAIN(vformat("Invalid scene: node %s does not specify its parent node.", snames[n.name]));
+				ERR_FAIL_V(NULL);
+			}
 			NODE_FROM_ID(nparent, n.parent);
 #ifdef DEBUG_ENABLED
 			if (!nparent && (n.parent & FLAG_ID_IS_PATH)) {
@@ -191,6 +196,11 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 
 				const NodeData::Property *nprops = &n.properties[0];
 
+				const InstancePlan::Setter *setters = NULL;
+				if (plan.setter_offsets[i] >= 0 && node->get_class_name() == snames[n.type]) {
+					setters = plan.setters.ptr() + plan.setter_offsets[i];
+				}
+
 				for (int j = 0; j < nprop_count; j++) {
 
 					bool valid;
@@ -251,7 +261,24 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 						} else if (p_edit_state == GEN_EDIT_STATE_INSTANCE) {
 							value = value.duplicate(true); // Duplicate arrays and dictionaries for the editor
 						}
-						node->set(snames[nprops[j].name], value, &valid);
+
+						if (setters && setters[j].method && !node->get_script_instance()) {
+							//same call ClassDB::set_property() would make, without looking it up again
+							Variant::CallError ce;
+							if (setters[j].index >= 0) {
+								Variant index = setters[j].index;
+								const Variant *args[2] = { &index, &value };
+								setters[j].method->call(node, args, 2, ce);
+							} else {
+								const Variant *args[1] = { &value };
+								setters[j].method->call(node, args, 1, ce);
+							}
+#ifdef TOOLS_ENABLED
+							node->set_edited(true);
+#endif
+						} else {
+							node->set(snames[nprops[j].name], value, &valid);
+						}
 					}
 				}
 			}
@@ -325,14 +352,7 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 		if (!cfrom || !cto)
 			continue;
 
-		Vector<Variant> binds;
-		if (c.binds.size()) {
-			binds.resize(c.binds.size());
-			for (int j = 0; j < c.binds.size(); j++)
-				binds.write[j] = props[c.binds[j]];
-		}
-
-		cfrom->connect(snames[c.signal], cto, snames[c.method], binds, CONNECT_PERSIST | c.flags);
+		cfrom->connect(snames[c.signal], cto, snames[c.method], plan.connection_binds[i], CONNECT_PERSIST | c.flags);
 	}
 
 	//Node *s = ret_nodes[0];
@@ -353,6 +373,81 @@ Node *SceneState::instance(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+const SceneState::InstancePlan &SceneState::_get_instance_plan() const {
+
+	_THREAD_SAFE_METHOD_
+
+	if (instance_plan_valid) {
+		return instance_plan;
+	}
+
+	int nc = nodes.size();
+	const NodeData *nd = nodes.ptr();
+
+	instance_plan.setter_offsets.resize(nc);
+	instance_plan.setters.clear();
+
+	for (int i = 0; i < nc; i++) {
+
+		const NodeData &n = nd[i];
+
+		if ((i == 0 && base_scene_idx >= 0) || n.instance >= 0 || n.type < 0 || n.type >= names.size()) {
+			//inherited, instanced or invalid, the class of the node is not known here
+			instance_plan.setter_offsets.write[i] = -1;
+			continue;
+		}
+
+		instance_plan.setter_offsets.write[i] = instance_plan.setters.size();
+
+		const StringName &type = names[n.type];
+
+		for (int j = 0; j < n.properties.size(); j++) {
+
+			InstancePlan::Setter setter;
+			setter.method = NULL;
+			setter.index = -1;
+
+			int name = n.properties[j].name;
+			if (name >= 0 && name < names.size()) {
+				StringName setter_name = ClassDB::get_property_setter(type, names[name]);
+				if (setter_name != StringName()) {
+					setter.method = ClassDB::get_method(type, setter_name);
+					setter.index = ClassDB::get_property_index(type, names[name]);
+				}
+			}
+
+			instance_plan.setters.push_back(setter);
+		}
+	}
+
+	int cc = connections.size();
+	instance_plan.connection_binds.resize(cc);
+
+	for (int i = 0; i < cc; i++) {
+
+		const ConnectionData &c = connections[i];
+
+		Vector<Variant> binds;
+		binds.resize(c.binds.size());
+		for (int j = 0; j < c.binds.size(); j++) {
+			ERR_CONTINUE(c.binds[j] < 0 || c.binds[j] >= variants.size());
+			binds.write[j] = variants[c.binds[j]];
+		}
+		instance_plan.connection_binds.write[i] = binds;
+	}
+
+	instance_plan_valid = true;
+
+	return instance_plan;
+}
+
+void SceneState::_invalidate_instance_plan() {
+
+	_THREAD_SAFE_METHOD_
+
+	instance_plan_valid = false;
+}
+
 static int _nm_get_string(const String &p_string, Map<StringName, int> &name_map) {
 
 	if (name_map.has(p_string))
@@ -930,6 +1025,7 @@ void SceneState::clear() {
 	node_paths.clear();
 	editable_instances.clear();
 	base_scene_idx = -1;
+	_invalidate_instance_plan();
 }
 
 Ref<SceneState> SceneState::_get_base_scene_state() const {
@@ -1098,6 +1194,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 		ERR_FAIL();
 	}
 
+	_invalidate_instance_plan();
+
 	PoolVector<String> snames = p_dictionary["names"];
 	if (snames.size()) {
 
@@ -1566,6 +1664,7 @@ int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int
 	nd.index = p_index;
 
 	nodes.push_back(nd);
+	_invalidate_instance_plan();
 
 	return nodes.size() - 1;
 }
@@ -1579,6 +1678,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value) {
 	prop.name = p_name;
 	prop.value = p_value;
 	nodes.write[p_node].properties.push_back(prop);
+	_invalidate_instance_plan();
 }
 void SceneState::add_node_group(int p_node, int p_group) {
 
@@ -1590,6 +1690,7 @@ void SceneState::set_base_scene(int p_idx) {
 
 	ERR_FAIL_INDEX(p_idx, variants.size());
 	base_scene_idx = p_idx;
+	_invalidate_instance_plan();
 }
 void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method, int p_flags, const Vector<int> &p_binds) {
 
@@ -1607,6 +1708,7 @@ void SceneState::add_connection(int p_from, int p_to, int p_signal, int p_method
 	c.flags = p_flags;
 	c.binds = p_binds;
 	connections.push_back(c);
+	_invalidate_instance_plan();
 }
 void SceneState::add_editable_instance(const NodePath &p_path) {
 
@@ -1658,6 +1760,7 @@ SceneState::SceneState() {
 
 	base_scene_idx = -1;
 	last_modified_time = 0;
+	instance_plan_valid = false;
 }
 
 ////////////////
@@ -1712,6 +1815,23 @@ Node *PackedScene::instance(GenEditState p_edit_state) const {
 	return s;
 }
 
+Array PackedScene::instance_many(int p_count, GenEditState p_edit_state) const {
+
+	ERR_FAIL_COND_V(p_count < 0, Array());
+
+	Array instances;
+	instances.resize(p_count);
+
+	for (int i = 0; i < p_count; i++) {
+
+		Node *s = instance(p_edit_state);
+		ERR_FAIL_COND_V(!s, instances);
+		instances[i] = s;
+	}
+
+	return instances;
+}
+
 void PackedScene::replace_state(Ref<SceneState> p_by) {
 
 	state = p_by;
@@ -1745,6 +1865,7 @@ void PackedScene::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("pack", "path"), &PackedScene::pack);
 	ClassDB::bind_method(D_METHOD("instance", "edit_state"), &PackedScene::instance, DEFVAL(GEN_EDIT_STATE_DISABLED));
+	ClassDB::bind_method(D_METHOD("instance_many", "count", "edit_state"), &PackedScene::instance_many, DEFVAL(GEN_EDIT_STATE_DISABLED));
 	ClassDB::bind_method(D_METHOD("can_instance"), &PackedScene::can_instance);
 	ClassDB::bind_method(D_METHOD("_set_bundled_scene"), &PackedScene::_set_bundled_scene);
 	ClassDB::bind_method(D_METHOD("_get_bundled_scene"), &PackedScene::_get_bundled_scene);
@@ -31,6 +31,7 @@
 #ifndef PACKED_SCENE_H
 #define PACKED_SCENE_H
 
+#include "core/os/thread_safe.h"
 #include "core/resource.h"
 #include "scene/main/node.h"
 
@@ -92,6 +93,28 @@ class SceneState : public Reference {
 
 	Vector<ConnectionData> connections;
 
+	// What instance() would otherwise look up again for every instance: property setters
+	// resolved against the class of each node and the bound arguments of each connection.
+	struct InstancePlan {
+
+		struct Setter {
+			MethodBind *method; // NULL if the property must go through Object::set()
+			int index;
+		};
+
+		Vector<int> setter_offsets; // per node, first entry in setters or -1 if the node is not created from its class
+		Vector<Setter> setters;
+		Vector<Vector<Variant> > connection_binds;
+	};
+
+	_THREAD_SAFE_CLASS_
+
+	mutable InstancePlan instance_plan;
+	mutable bool instance_plan_valid;
+
+	const InstancePlan &_get_instance_plan() const;
+	void _invalidate_instance_plan();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, Map<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, Map<Node *, int> &node_map, Map<Node *, int> &nodepath_map);
 
@@ -221,6 +244,7 @@ public:
 
 	bool can_instance() const;
 	Node *instance(GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
+	Array instance_many(int p_count, GenEditState p_edit_state = GEN_EDIT_STATE_DISABLED) const;
 
 	void recreate_state();
 	void replace_state(Ref<SceneState> p_by);
@@ -32,12 +32,16 @@
 
 #include "core/io/resource_format_binary.h"
 #include "core/os/dir_access.h"
+#include "core/os/threaded_array_processor.h"
 #include "core/project_settings.h"
 #include "core/version.h"
 
 //version 2: changed names for basis, aabb, poolvectors, etc.
 #define FORMAT_VERSION 2
 
+//files smaller than this are always parsed sequentially
+#define PARALLEL_PARSE_MIN_SIZE (64 * 1024)
+
 #include "core/os/dir_access.h"
 #include "core/version.h"
 
@@ -389,6 +393,267 @@ Ref<PackedScene> ResourceInteractiveLoaderText::_parse_node_tag(VariantParser::R
 	return packed_scene;
 }
 
+Error ResourceInteractiveLoaderText::_instance_sub_resource(const VariantParser::Tag &p_tag, RES &r_res) {
+
+	if (!p_tag.fields.has("type")) {
+		error_text = "Missing 'type' in external resource tag";
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (!p_tag.fields.has("id")) {
+		error_text = "Missing 'index' in external resource tag";
+		return ERR_FILE_CORRUPT;
+	}
+
+	String type = p_tag.fields["type"];
+	int id = p_tag.fields["id"];
+
+	String path = local_path + "::" + itos(id);
+
+	if (!ResourceCache::has(path)) { //only if it doesn't exist
+
+		Object *obj = ClassDB::instance(type);
+		if (!obj) {
+
+			error_text += "Can't create sub resource of type: " + type;
+			return ERR_FILE_CORRUPT;
+		}
+
+		Resource *r = Object::cast_to<Resource>(obj);
+		if (!r) {
+
+			error_text += "Can't create sub resource of type, because not a resource: " + type;
+			return ERR_FILE_CORRUPT;
+		}
+
+		r_res = Ref<Resource>(r);
+		resource_cache.push_back(r_res);
+		r_res->set_path(path);
+	}
+
+	resource_current++;
+
+	return OK;
+}
+
+void ResourceInteractiveLoaderText::_parse_sub_resource_section(uint32_t p_index, SubResourceBatch *p_batch) {
+
+	SubResourceSection &section = p_batch->sections[p_index];
+
+	VariantParser::StreamString ss;
+	ss.s.parse_utf8((const char *)p_batch->data + section.begin, section.end - section.begin);
+
+	int line = section.line;
+	VariantParser::Tag tag;
+
+	section.error = OK;
+	if (p_index > 0) {
+		//the header of the first section was already parsed from the file
+		section.error = VariantParser::parse_tag(&ss, line, section.error_text, tag, &rp);
+	}
+
+	while (section.error == OK) {
+
+		String assign;
+		Variant value;
+
+		section.error = VariantParser::parse_tag_assign_eof(&ss, line, section.error_text, tag, assign, value, &rp);
+
+		if (section.error == ERR_FILE_EOF) {
+			section.error = OK;
+			break;
+		} else if (section.error == OK) {
+			if (assign != String()) {
+				section.names.push_back(assign);
+				section.values.push_back(value);
+			} else {
+				section.error = ERR_FILE_CORRUPT;
+				section.error_text = "Unexpected tag in [sub_resource]: " + tag.name;
+			}
+		}
+	}
+
+	section.error_line = line;
+}
+
+Error ResourceInteractiveLoaderText::_parse_sub_resources_parallel() {
+
+	//properties of consecutive sub-resources don't depend on each other, so once the
+	//section boundaries are known their values can be parsed on worker threads
+
+	size_t start = stream.get_position();
+	size_t len = f->get_len();
+	if (len < start + PARALLEL_PARSE_MIN_SIZE) {
+		return ERR_SKIP;
+	}
+
+	Vector<uint8_t> data;
+	data.resize(len - start);
+	f->seek(start);
+	int size = f->get_buffer(data.ptrw(), data.size());
+	const uint8_t *ptr = data.ptr();
+
+	Vector<SubResourceSection> sections;
+	SubResourceSection section;
+	section.begin = 0;
+	section.line = lines;
+
+	int end = size;
+	int end_line = lines;
+
+	int line = lines;
+	bool in_string = false;
+	bool line_start = true;
+
+	for (int i = 0; i < size; i++) {
+
+		uint8_t c = ptr[i];
+
+		if (in_string) {
+			if (c == '\\' && i + 1 < size) {
+				i++;
+				c = ptr[i];
+			} else if (c == '"') {
+				in_string = false;
+			}
+			if (c == '\n') {
+				line++;
+			}
+			continue;
+		}
+
+		if (c == '\n') {
+			line++;
+			line_start = true;
+			continue;
+		}
+
+		if (c == ' ' || c == '\t' || c == '\r') {
+			continue;
+		}
+
+		if (line_start && c == '[') {
+
+			int from = i + 1;
+			int to = from;
+			while (to < size && ((ptr[to] >= 'a' && ptr[to] <= 'z') || ptr[to] == '_')) {
+				to++;
+			}
+
+			if (to < size && (ptr[to] == ' ' || ptr[to] == ']')) {
+
+				String name;
+				name.parse_utf8((const char *)ptr + from, to - from);
+
+				if (name == "sub_resource") {
+					section.end = i;
+					sections.push_back(section);
+					section.begin = i;
+					section.line = line;
+				} else if (name == "ext_resource" || name == "resource" || name == "node" || name == "connection" || name == "editable") {
+					end = i;
+					end_line = line;
+					break;
+				}
+			}
+		}
+
+		line_start = false;
+
+		if (c == '"') {
+			in_string = true;
+		} else if (c == ';') {
+			while (i + 1 < size && ptr[i + 1] != '\n') {
+				i++;
+			}
+		}
+	}
+
+	if (end == size) {
+		end_line = line;
+	}
+	section.end = end;
+	sections.push_back(section);
+
+	if (sections.size() < 2) {
+		stream.seek(start);
+		return ERR_SKIP;
+	}
+
+	//resources are created on this thread in file order, exactly as when parsing sequentially
+
+	SubResourceSection *w = sections.ptrw();
+
+	error = _instance_sub_resource(next_tag, w[0].res);
+
+	for (int i = 1; i < sections.size() && error == OK; i++) {
+
+		const char *header = (const char *)ptr + w[i].begin;
+		int header_len = 0;
+		while (w[i].begin + header_len < w[i].end && header[header_len] != '\n') {
+			header_len++;
+		}
+
+		VariantParser::StreamString ss;
+		ss.s.parse_utf8(header, header_len);
+
+		lines = w[i].line;
+		VariantParser::Tag tag;
+		error = VariantParser::parse_tag(&ss, lines, error_text, tag, &rp);
+		if (error == OK) {
+			error = _instance_sub_resource(tag, w[i].res);
+		}
+	}
+
+	if (error) {
+		_printerr();
+		return error;
+	}
+
+	SubResourceBatch batch;
+	batch.data = ptr;
+	batch.sections = w;
+
+	thread_process_array(sections.size(), this, &ResourceInteractiveLoaderText::_parse_sub_resource_section, &batch);
+
+	for (int i = 0; i < sections.size(); i++) {
+
+		SubResourceSection &sr = w[i];
+
+		if (sr.error) {
+			error = sr.error;
+			error_text = sr.error_text;
+			lines = sr.error_line;
+			_printerr();
+			return error;
+		}
+
+		if (sr.res.is_valid()) {
+			for (int j = 0; j < sr.names.size(); j++) {
+				sr.res->set(sr.names[j], sr.values[j]);
+			}
+		}
+	}
+
+	lines = end_line;
+
+	if (end == size) {
+		//same as running out of file in the middle of a [sub_resource] when parsing sequentially
+		error = ERR_FILE_EOF;
+		_printerr();
+		return error;
+	}
+
+	stream.seek(start + end);
+
+	error = VariantParser::parse_tag(&stream, lines, error_text, next_tag, &rp);
+	if (error) {
+		_printerr();
+	}
+
+	return error;
+}
+
 Error ResourceInteractiveLoaderText::poll() {
 
 	if (error != OK)
@@ -463,56 +728,21 @@ Error ResourceInteractiveLoaderText::poll() {
 
 	} else if (next_tag.name == "sub_resource") {
 
-		if (!next_tag.fields.has("type")) {
-			error = ERR_FILE_CORRUPT;
-			error_text = "Missing 'type' in external resource tag";
-			_printerr();
-			return error;
-		}
+		if (ResourceFormatLoaderText::is_parallel_parsing_enabled() && stream.saved == 0) {
 
-		if (!next_tag.fields.has("id")) {
-			error = ERR_FILE_CORRUPT;
-			error_text = "Missing 'index' in external resource tag";
-			_printerr();
-			return error;
+			Error err = _parse_sub_resources_parallel();
+			if (err != ERR_SKIP) {
+				return err;
+			}
 		}
 
-		String type = next_tag.fields["type"];
-		int id = next_tag.fields["id"];
-
-		String path = local_path + "::" + itos(id);
-
-		//bool exists=ResourceCache::has(path);
-
 		Ref<Resource> res;
-
-		if (!ResourceCache::has(path)) { //only if it doesn't exist
-
-			Object *obj = ClassDB::instance(type);
-			if (!obj) {
-
-				error_text += "Can't create sub resource of type: " + type;
-				_printerr();
-				error = ERR_FILE_CORRUPT;
-				return error;
-			}
-
-			Resource *r = Object::cast_to<Resource>(obj);
-			if (!r) {
-
-				error_text += "Can't create sub resource of type, because not a resource: " + type;
-				_printerr();
-				error = ERR_FILE_CORRUPT;
-				return error;
-			}
-
-			res = Ref<Resource>(r);
-			resource_cache.push_back(res);
-			res->set_path(path);
+		error = _instance_sub_resource(next_tag, res);
+		if (error) {
+			_printerr();
+			return error;
 		}
 
-		resource_current++;
-
 		while (true) {
 
 			String assign;
@@ -727,7 +957,7 @@ Error ResourceInteractiveLoaderText::rename_dependencies(FileAccess *p_f, const
 
 	String base_path = local_path.get_base_dir();
 
-	uint64_t tag_end = f->get_position();
+	uint64_t tag_end = stream.get_position();
 
 	while (true) {
 
@@ -789,7 +1019,7 @@ Error ResourceInteractiveLoaderText::rename_dependencies(FileAccess *p_f, const
 
 			fw->store_line("[ext_resource path=\"" + path + "\" type=\"" + type + "\" id=" + itos(index) + "]");
 
-			tag_end = f->get_position();
+			tag_end = stream.get_position();
 		}
 	}
 
@@ -922,7 +1152,7 @@ Error ResourceInteractiveLoaderText::save_as_binary(FileAccess *p_f, const Strin
 	wf->store_32(0); //64 bits file, false for now
 	wf->store_32(VERSION_MAJOR);
 	wf->store_32(VERSION_MINOR);
-	static const int save_format_version = 3; //use format version 3 for saving
+	static const int save_format_version = 4; //use format version 4 for saving
 	wf->store_32(save_format_version);
 
 	bs_save_unicode_string(wf.f, is_scene ? "PackedScene" : resource_type);
@@ -930,7 +1160,7 @@ Error ResourceInteractiveLoaderText::save_as_binary(FileAccess *p_f, const Strin
 	for (int i = 0; i < 14; i++)
 		wf->store_32(0); // reserved
 
-	wf->store_32(0); //string table size, will not be in use
+	ResourceFormatSaverBinaryInstance::save_string_table(wf.f, Vector<StringName>()); //string table will not be in use
 	size_t ext_res_count_pos = wf->get_position();
 
 	wf->store_32(0); //zero ext resources, still parsing them
@@ -1143,6 +1373,7 @@ Error ResourceInteractiveLoaderText::save_as_binary(FileAccess *p_f, const Strin
 
 	wf2->close();
 
+	ResourceFormatSaverBinaryInstance::pad_to_alignment(wf.f); //resource data must start aligned
 	size_t offset_from = wf->get_position();
 	wf->seek(sub_res_count_pos); //plus one because the saved one
 	wf->store_32(local_offsets.size());
@@ -1314,6 +1545,7 @@ Error ResourceFormatLoaderText::rename_dependencies(const String &p_path, const
 }
 
 ResourceFormatLoaderText *ResourceFormatLoaderText::singleton = NULL;
+bool ResourceFormatLoaderText::parallel_parsing = false;
 
 Error ResourceFormatLoaderText::convert_file_to_binary(const String &p_src_path, const String &p_dst_path) {
 
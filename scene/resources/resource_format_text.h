@@ -109,6 +109,28 @@ class ResourceInteractiveLoaderText : public ResourceInteractiveLoader {
 
 	Ref<PackedScene> _parse_node_tag(VariantParser::ResourceParser &parser);
 
+	// Consecutive [sub_resource] sections parsed on worker threads.
+	struct SubResourceSection {
+		int begin;
+		int end;
+		int line;
+		RES res;
+		Vector<String> names;
+		Vector<Variant> values;
+		Error error;
+		String error_text;
+		int error_line;
+	};
+
+	struct SubResourceBatch {
+		const uint8_t *data;
+		SubResourceSection *sections;
+	};
+
+	Error _instance_sub_resource(const VariantParser::Tag &p_tag, RES &r_res);
+	void _parse_sub_resource_section(uint32_t p_index, SubResourceBatch *p_batch);
+	Error _parse_sub_resources_parallel();
+
 public:
 	virtual void set_local_path(const String &p_local_path);
 	virtual Ref<Resource> get_resource();
@@ -131,6 +153,11 @@ class ResourceFormatLoaderText : public ResourceFormatLoader {
 	GDCLASS(ResourceFormatLoaderText, ResourceFormatLoader)
 public:
 	static ResourceFormatLoaderText *singleton;
+	static bool parallel_parsing;
+
+	static void set_parallel_parsing(bool p_enable) { parallel_parsing = p_enable; }
+	static bool is_parallel_parsing_enabled() { return parallel_parsing; }
+
 	virtual Ref<ResourceInteractiveLoader> load_interactive(const String &p_path, const String &p_original_path = "", Error *r_error = NULL);
 	virtual void get_recognized_extensions_for_type(const String &p_type, List<String> *p_extensions) const;
 	virtual void get_recognized_extensions(List<String> *p_extensions) const;
@@ -981,6 +981,289 @@ void SurfaceTool::generate_normals(bool p_flip) {
 	}
 }
 
+// Error quadric of the planes around a vertex (Garland & Heckbert), stored as the upper half of a symmetric 4x4 matrix.
+struct SurfaceToolQuadric {
+
+	double a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+	void add(const SurfaceToolQuadric &p_q) {
+
+		a2 += p_q.a2;
+		ab += p_q.ab;
+		ac += p_q.ac;
+		ad += p_q.ad;
+		b2 += p_q.b2;
+		bc += p_q.bc;
+		bd += p_q.bd;
+		c2 += p_q.c2;
+		cd += p_q.cd;
+		d2 += p_q.d2;
+	}
+
+	void add_plane(const Plane &p_plane, double p_weight) {
+
+		double a = p_plane.normal.x, b = p_plane.normal.y, c = p_plane.normal.z, d = -p_plane.d;
+		a2 += a * a * p_weight;
+		ab += a * b * p_weight;
+		ac += a * c * p_weight;
+		ad += a * d * p_weight;
+		b2 += b * b * p_weight;
+		bc += b * c * p_weight;
+		bd += b * d * p_weight;
+		c2 += c * c * p_weight;
+		cd += c * d * p_weight;
+		d2 += d * d * p_weight;
+	}
+
+	double error(const Vector3 &p_pos) const {
+
+		double x = p_pos.x, y = p_pos.y, z = p_pos.z;
+		return a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x + b2 * y * y + 2 * bc * y * z + 2 * bd * y + c2 * z * z + 2 * cd * z + d2;
+	}
+
+	SurfaceToolQuadric() {
+		a2 = ab = ac = ad = b2 = bc = bd = c2 = cd = d2 = 0;
+	}
+};
+
+struct SurfaceToolCollapse {
+
+	int from;
+	int to;
+	double cost;
+
+	bool operator<(const SurfaceToolCollapse &p_other) const { return cost < p_other.cost; }
+};
+
+void SurfaceTool::generate_lod(float p_ratio) {
+
+	ERR_FAIL_COND(primitive != Mesh::PRIMITIVE_TRIANGLES);
+	ERR_FAIL_COND(p_ratio <= 0 || p_ratio > 1);
+
+	index();
+
+	Vector<Vertex> vertices;
+	vertices.resize(vertex_array.size());
+	int idx = 0;
+	for (List<Vertex>::Element *E = vertex_array.front(); E; E = E->next()) {
+		vertices.write[idx++] = E->get();
+	}
+
+	Vector<int> indices;
+	indices.resize(index_array.size());
+	idx = 0;
+	for (List<int>::Element *E = index_array.front(); E; E = E->next()) {
+		indices.write[idx++] = E->get();
+	}
+
+	int vertex_count = vertices.size();
+	int target_triangles = MAX(1, int(indices.size() / 3 * p_ratio));
+	if (indices.size() / 3 <= target_triangles) {
+		return;
+	}
+
+	// Vertices that are collapsed away must be free to move: those sharing their position
+	// with another vertex (normal or UV seams) and those on an open border stay where they are.
+	Vector<bool> locked;
+	locked.resize(vertex_count);
+	{
+		Map<Vector3, int> position_users;
+		for (int i = 0; i < vertex_count; i++) {
+			locked.write[i] = false;
+			Map<Vector3, int>::Element *E = position_users.find(vertices[i].vertex);
+			if (E) {
+				E->get()++;
+			} else {
+				position_users[vertices[i].vertex] = 1;
+			}
+		}
+		for (int i = 0; i < vertex_count; i++) {
+			if (position_users[vertices[i].vertex] > 1) {
+				locked.write[i] = true;
+			}
+		}
+
+		Map<uint64_t, int> edge_users;
+		for (int i = 0; i < indices.size(); i++) {
+			int a = indices[i];
+			int b = indices[(i % 3 == 2) ? i - 2 : i + 1];
+			uint64_t key = (uint64_t(MIN(a, b)) << 32) | uint64_t(MAX(a, b));
+			Map<uint64_t, int>::Element *E = edge_users.find(key);
+			if (E) {
+				E->get()++;
+			} else {
+				edge_users[key] = 1;
+			}
+		}
+		for (Map<uint64_t, int>::Element *E = edge_users.front(); E; E = E->next()) {
+			if (E->get() == 1) {
+				locked.write[E->key() >> 32] = true;
+				locked.write[E->key() & 0xFFFFFFFF] = true;
+			}
+		}
+	}
+
+	Vector<SurfaceToolQuadric> quadrics;
+	quadrics.resize(vertex_count);
+	for (int i = 0; i < indices.size(); i += 3) {
+		const Vector3 &v0 = vertices[indices[i + 0]].vertex;
+		const Vector3 &v1 = vertices[indices[i + 1]].vertex;
+		const Vector3 &v2 = vertices[indices[i + 2]].vertex;
+		Vector3 cross = (v1 - v0).cross(v2 - v0);
+		real_t area = cross.length();
+		if (area <= CMP_EPSILON) {
+			continue;
+		}
+		Plane plane(v0, cross / area);
+		for (int j = 0; j < 3; j++) {
+			quadrics.write[indices[i + j]].add_plane(plane, area);
+		}
+	}
+
+	Vector<int> remap;
+	remap.resize(vertex_count);
+	Vector<bool> touched;
+	touched.resize(vertex_count);
+	Vector<int> triangle_offsets;
+	triangle_offsets.resize(vertex_count + 1);
+	Vector<int> triangle_list;
+
+	// Each pass collapses a batch of the cheapest edges that don't touch each other, then rebuilds the index list.
+	while (indices.size() / 3 > target_triangles) {
+
+		int triangle_count = indices.size() / 3;
+
+		for (int i = 0; i <= vertex_count; i++) {
+			triangle_offsets.write[i] = 0;
+		}
+		for (int i = 0; i < indices.size(); i++) {
+			triangle_offsets.write[indices[i] + 1]++;
+		}
+		for (int i = 0; i < vertex_count; i++) {
+			triangle_offsets.write[i + 1] += triangle_offsets[i];
+		}
+		triangle_list.resize(indices.size());
+		for (int i = 0; i < vertex_count; i++) {
+			remap.write[i] = triangle_offsets[i]; // used as fill cursor here
+		}
+		for (int i = 0; i < indices.size(); i++) {
+			triangle_list.write[remap.write[indices[i]]++] = i / 3;
+		}
+
+		Vector<SurfaceToolCollapse> collapses;
+		for (int i = 0; i < indices.size(); i++) {
+			int a = indices[i];
+			int b = indices[(i % 3 == 2) ? i - 2 : i + 1];
+			if (a > b) {
+				continue; // Interior edges show up once in each direction.
+			}
+			for (int j = 0; j < 2; j++) {
+				int from = j == 0 ? a : b;
+				int to = j == 0 ? b : a;
+				if (locked[from]) {
+					continue;
+				}
+				SurfaceToolQuadric q = quadrics[from];
+				q.add(quadrics[to]);
+				SurfaceToolCollapse collapse;
+				collapse.from = from;
+				collapse.to = to;
+				collapse.cost = q.error(vertices[to].vertex);
+				collapses.push_back(collapse);
+			}
+		}
+
+		if (collapses.empty()) {
+			break;
+		}
+
+		collapses.sort();
+
+		for (int i = 0; i < vertex_count; i++) {
+			remap.write[i] = i;
+			touched.write[i] = false;
+		}
+
+		int collapse_goal = (triangle_count - target_triangles) / 2 + 1;
+		int collapsed = 0;
+
+		for (int i = 0; i < collapses.size() && collapsed < collapse_goal; i++) {
+
+			const SurfaceToolCollapse &collapse = collapses[i];
+			if (touched[collapse.from] || touched[collapse.to]) {
+				continue;
+			}
+
+			// Moving the vertex must not flip any of the triangles that survive the collapse.
+			const Vector3 &target = vertices[collapse.to].vertex;
+			bool flips = false;
+			for (int j = triangle_offsets[collapse.from]; j < triangle_offsets[collapse.from + 1] && !flips; j++) {
+				int t = triangle_list[j] * 3;
+				if (indices[t + 0] == collapse.to || indices[t + 1] == collapse.to || indices[t + 2] == collapse.to) {
+					continue;
+				}
+				Vector3 p[3];
+				Vector3 moved[3];
+				for (int k = 0; k < 3; k++) {
+					p[k] = vertices[indices[t + k]].vertex;
+					moved[k] = indices[t + k] == collapse.from ? target : p[k];
+				}
+				Vector3 before = (p[1] - p[0]).cross(p[2] - p[0]);
+				Vector3 after = (moved[1] - moved[0]).cross(moved[2] - moved[0]);
+				flips = before.dot(after) <= 0;
+			}
+			if (flips) {
+				continue;
+			}
+
+			remap.write[collapse.from] = collapse.to;
+			quadrics.write[collapse.to].add(quadrics[collapse.from]);
+
+			for (int j = triangle_offsets[collapse.from]; j < triangle_offsets[collapse.from + 1]; j++) {
+				int t = triangle_list[j] * 3;
+				for (int k = 0; k < 3; k++) {
+					touched.write[indices[t + k]] = true;
+				}
+			}
+			collapsed++;
+		}
+
+		if (collapsed == 0) {
+			break; // Nothing left that can be collapsed safely.
+		}
+
+		Vector<int> new_indices;
+		for (int i = 0; i < indices.size(); i += 3) {
+			int a = remap[indices[i + 0]];
+			int b = remap[indices[i + 1]];
+			int c = remap[indices[i + 2]];
+			if (a == b || b == c || c == a) {
+				continue;
+			}
+			new_indices.push_back(a);
+			new_indices.push_back(b);
+			new_indices.push_back(c);
+		}
+		indices = new_indices;
+	}
+
+	// Drop the vertices no triangle uses anymore.
+	for (int i = 0; i < vertex_count; i++) {
+		remap.write[i] = -1;
+	}
+	vertex_array.clear();
+	index_array.clear();
+	int used = 0;
+	for (int i = 0; i < indices.size(); i++) {
+		int v = indices[i];
+		if (remap[v] == -1) {
+			remap.write[v] = used++;
+			vertex_array.push_back(vertices[v]);
+		}
+		index_array.push_back(remap[v]);
+	}
+}
+
 void SurfaceTool::set_material(const Ref<Material> &p_material) {
 
 	material = p_material;
@@ -1021,6 +1304,7 @@ void SurfaceTool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("deindex"), &SurfaceTool::deindex);
 	ClassDB::bind_method(D_METHOD("generate_normals", "flip"), &SurfaceTool::generate_normals, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("generate_tangents"), &SurfaceTool::generate_tangents);
+	ClassDB::bind_method(D_METHOD("generate_lod", "ratio"), &SurfaceTool::generate_lod);
 
 	ClassDB::bind_method(D_METHOD("set_material", "material"), &SurfaceTool::set_material);
 
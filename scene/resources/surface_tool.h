@@ -117,6 +117,7 @@ public:
 	void deindex();
 	void generate_normals(bool p_flip = false);
 	void generate_tangents();
+	void generate_lod(float p_ratio);
 
 	void set_material(const Ref<Material> &p_material);
 
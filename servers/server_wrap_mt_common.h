@@ -43,9 +43,15 @@
 #define FUNCRID(m_type)                                                                    \
 	List<RID> m_type##_id_pool;                                                            \
 	int m_type##allocn() {                                                                 \
+		List<RID> rids;                                                                    \
 		for (int i = 0; i < pool_max_size; i++) {                                          \
-			m_type##_id_pool.push_back(server_name->m_type##_create());                    \
+			rids.push_back(server_name->m_type##_create());                                \
 		}                                                                                  \
+		alloc_mutex->lock();                                                               \
+		for (List<RID>::Element *E = rids.front(); E; E = E->next()) {                     \
+			m_type##_id_pool.push_back(E->get());                                          \
+		}                                                                                  \
+		alloc_mutex->unlock();                                                             \
 		return 0;                                                                          \
 	}                                                                                      \
 	void m_type##_free_cached_ids() {                                                      \
@@ -58,14 +64,20 @@
 		if (Thread::get_caller_id() != server_thread) {                                    \
 			RID rid;                                                                       \
 			alloc_mutex->lock();                                                           \
-			if (m_type##_id_pool.size() == 0) {                                            \
+			while (m_type##_id_pool.size() == 0) {                                         \
+				alloc_mutex->unlock();                                                     \
 				int ret;                                                                   \
 				command_queue.push_and_ret(this, &ServerNameWrapMT::m_type##allocn, &ret); \
 				SYNC_DEBUG                                                                 \
+				alloc_mutex->lock();                                                       \
 			}                                                                              \
 			rid = m_type##_id_pool.front()->get();                                         \
 			m_type##_id_pool.pop_front();                                                  \
+			bool refill = m_type##_id_pool.size() == pool_max_size / 2;                    \
 			alloc_mutex->unlock();                                                         \
+			if (refill) {                                                                  \
+				command_queue.push(this, &ServerNameWrapMT::m_type##allocn);               \
+			}                                                                              \
 			return rid;                                                                    \
 		} else {                                                                           \
 			return server_name->m_type##_create();                                         \
@@ -0,0 +1,271 @@
+/*************************************************************************/
+/*  occlusion_buffer.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#include "occlusion_buffer.h"
+
+Vector2 OcclusionBuffer::_project(const Vector3 &p_view) const {
+
+	Vector3 ndc = projection.xform(p_view);
+	return Vector2((ndc.x * 0.5 + 0.5) * width, (0.5 - ndc.y * 0.5) * height);
+}
+
+void OcclusionBuffer::begin(const Transform &p_cam_transform, const CameraMatrix &p_projection, int p_width, int p_height) {
+
+	cam_inverse = p_cam_transform.affine_inverse();
+	projection = p_projection;
+	z_near = p_projection.get_z_near();
+
+	triangles.clear();
+
+	if (width == p_width && height == p_height) {
+		return;
+	}
+
+	width = p_width;
+	height = p_height;
+
+	levels.clear();
+	int w = width;
+	int h = height;
+	while (true) {
+		Level level;
+		level.width = w;
+		level.height = h;
+		level.data.resize(w * h);
+		levels.push_back(level);
+		if (w == 1 && h == 1) {
+			break;
+		}
+		w = MAX((w + 1) / 2, 1);
+		h = MAX((h + 1) / 2, 1);
+	}
+
+	depth = levels.write[0].data.ptrw();
+}
+
+void OcclusionBuffer::add_occluder(const Transform &p_xform, const Vector3 *p_faces, int p_vertex_count) {
+
+	Transform to_view = cam_inverse * p_xform;
+
+	for (int i = 0; i + 2 < p_vertex_count; i += 3) {
+
+		Vector3 src[3] = {
+			to_view.xform(p_faces[i + 0]),
+			to_view.xform(p_faces[i + 1]),
+			to_view.xform(p_faces[i + 2])
+		};
+
+		// Clip against the near plane, a triangle becomes at most a quad.
+		Vector3 clipped[4];
+		int clipped_count = 0;
+		for (int j = 0; j < 3; j++) {
+			const Vector3 &a = src[j];
+			const Vector3 &b = src[(j + 1) % 3];
+			real_t da = -a.z - z_near;
+			real_t db = -b.z - z_near;
+			if (da >= 0) {
+				clipped[clipped_count++] = a;
+			}
+			if ((da >= 0) != (db >= 0)) {
+				clipped[clipped_count++] = a.linear_interpolate(b, da / (da - db));
+			}
+		}
+
+		for (int j = 2; j < clipped_count; j++) {
+			_add_triangle(clipped[0], clipped[j - 1], clipped[j]);
+		}
+	}
+}
+
+void OcclusionBuffer::_add_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c) {
+
+	Vector2 p[3] = { _project(p_a), _project(p_b), _project(p_c) };
+	float z[3] = { float(1.0 / -p_a.z), float(1.0 / -p_b.z), float(1.0 / -p_c.z) };
+
+	float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[2].x - p[0].x) * (p[1].y - p[0].y);
+	if (Math::absf(area) < CMP_EPSILON) {
+		return;
+	}
+	if (area < 0) {
+		// Occluders are drawn from both sides.
+		SWAP(p[1], p[2]);
+		SWAP(z[1], z[2]);
+		area = -area;
+	}
+
+	Triangle t;
+
+	t.min_x = MAX(int(Math::floor(MIN(p[0].x, MIN(p[1].x, p[2].x)))), 0);
+	t.max_x = MIN(int(Math::ceil(MAX(p[0].x, MAX(p[1].x, p[2].x)))), width - 1);
+	t.min_y = MAX(int(Math::floor(MIN(p[0].y, MIN(p[1].y, p[2].y)))), 0);
+	t.max_y = MIN(int(Math::ceil(MAX(p[0].y, MAX(p[1].y, p[2].y)))), height - 1);
+	if (t.min_x > t.max_x || t.min_y > t.max_y) {
+		return; // off screen
+	}
+
+	for (int i = 0; i < 3; i++) {
+		const Vector2 &a = p[(i + 1) % 3];
+		const Vector2 &b = p[(i + 2) % 3];
+		t.edge_a[i] = a.y - b.y;
+		t.edge_b[i] = b.x - a.x;
+		t.edge_c[i] = (b.y - a.y) * a.x - (b.x - a.x) * a.y;
+	}
+
+	// Edge i is opposite to vertex i, so it is that vertex' barycentric weight times the area.
+	float inv_area = 1.0 / area;
+	t.z_a = (t.edge_a[0] * z[0] + t.edge_a[1] * z[1] + t.edge_a[2] * z[2]) * inv_area;
+	t.z_b = (t.edge_b[0] * z[0] + t.edge_b[1] * z[1] + t.edge_b[2] * z[2]) * inv_area;
+	t.z_c = (t.edge_c[0] * z[0] + t.edge_c[1] * z[1] + t.edge_c[2] * z[2]) * inv_area;
+
+	triangles.push_back(t);
+}
+
+void OcclusionBuffer::rasterize_band(int p_band) {
+
+	int from_y = p_band * BAND_HEIGHT;
+	int to_y = MIN(from_y + BAND_HEIGHT, height) - 1;
+
+	for (int i = from_y * width; i < (to_y + 1) * width; i++) {
+		depth[i] = 0;
+	}
+
+	const Triangle *tris = triangles.ptr();
+	int tri_count = triangles.size();
+
+	for (int i = 0; i < tri_count; i++) {
+
+		const Triangle &t = tris[i];
+		int min_y = MAX(t.min_y, from_y);
+		int max_y = MIN(t.max_y, to_y);
+
+		for (int y = min_y; y <= max_y; y++) {
+
+			float py = y + 0.5f;
+			float e0 = t.edge_b[0] * py + t.edge_c[0];
+			float e1 = t.edge_b[1] * py + t.edge_c[1];
+			float e2 = t.edge_b[2] * py + t.edge_c[2];
+			float zr = t.z_b * py + t.z_c;
+			float *row = depth + y * width;
+
+			for (int x = t.min_x; x <= t.max_x; x++) {
+				float px = x + 0.5f;
+				float z = zr + t.z_a * px;
+				bool inside = (e0 + t.edge_a[0] * px >= 0) & (e1 + t.edge_a[1] * px >= 0) & (e2 + t.edge_a[2] * px >= 0);
+				row[x] = (inside & (z > row[x])) ? z : row[x];
+			}
+		}
+	}
+}
+
+void OcclusionBuffer::build_hierarchy() {
+
+	for (int l = 1; l < levels.size(); l++) {
+
+		const Level &src = levels[l - 1];
+		Level &dst = levels.write[l];
+		const float *s = src.data.ptr();
+		float *d = dst.data.ptrw();
+
+		for (int y = 0; y < dst.height; y++) {
+			int y0 = y * 2;
+			int y1 = MIN(y0 + 1, src.height - 1);
+			for (int x = 0; x < dst.width; x++) {
+				int x0 = x * 2;
+				int x1 = MIN(x0 + 1, src.width - 1);
+				// Smallest inverse depth is the furthest, which keeps the test conservative.
+				d[y * dst.width + x] = MIN(MIN(s[y0 * src.width + x0], s[y0 * src.width + x1]), MIN(s[y1 * src.width + x0], s[y1 * src.width + x1]));
+			}
+		}
+	}
+}
+
+bool OcclusionBuffer::is_aabb_occluded(const AABB &p_aabb) const {
+
+	Vector2 min_p(1e20, 1e20);
+	Vector2 max_p(-1e20, -1e20);
+	real_t nearest = 1e20;
+
+	for (int i = 0; i < 8; i++) {
+
+		Vector3 corner = p_aabb.position;
+		if (i & 1) corner.x += p_aabb.size.x;
+		if (i & 2) corner.y += p_aabb.size.y;
+		if (i & 4) corner.z += p_aabb.size.z;
+
+		Vector3 view = cam_inverse.xform(corner);
+		if (-view.z < z_near) {
+			return false; // crosses the near plane, can't be projected
+		}
+		nearest = MIN(nearest, -view.z);
+
+		Vector2 p = _project(view);
+		min_p.x = MIN(min_p.x, p.x);
+		min_p.y = MIN(min_p.y, p.y);
+		max_p.x = MAX(max_p.x, p.x);
+		max_p.y = MAX(max_p.y, p.y);
+	}
+
+	int min_x = MAX(int(Math::floor(min_p.x)), 0);
+	int max_x = MIN(int(Math::floor(max_p.x)), width - 1);
+	int min_y = MAX(int(Math::floor(min_p.y)), 0);
+	int max_y = MIN(int(Math::floor(max_p.y)), height - 1);
+	if (min_x > max_x || min_y > max_y) {
+		return false;
+	}
+
+	int l = 0;
+	while (l < levels.size() - 1 && ((max_x >> l) - (min_x >> l) >= MAX_TEST_TEXELS || (max_y >> l) - (min_y >> l) >= MAX_TEST_TEXELS)) {
+		l++;
+	}
+
+	const Level &level = levels[l];
+	const float *data = level.data.ptr();
+	// Small bias so an occluder does not hide the box it is lying on.
+	float box_z = 1.001 / nearest;
+
+	for (int y = min_y >> l; y <= (max_y >> l); y++) {
+		for (int x = min_x >> l; x <= (max_x >> l); x++) {
+			if (data[y * level.width + x] <= box_z) {
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+OcclusionBuffer::OcclusionBuffer() {
+
+	width = 0;
+	height = 0;
+	z_near = 0.05;
+	depth = NULL;
+}
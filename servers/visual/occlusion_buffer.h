@@ -0,0 +1,102 @@
+/*************************************************************************/
+/*  occlusion_buffer.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+
+#ifndef OCCLUSION_BUFFER_H
+#define OCCLUSION_BUFFER_H
+
+#include "core/math/camera_matrix.h"
+#include "core/math/transform.h"
+#include "core/vector.h"
+
+// Low resolution software depth buffer for occlusion culling. Occluder
+// triangles are rasterized on the CPU (in independent horizontal bands, so
+// the bands can be spread over threads), then a hierarchy of conservative
+// depth mipmaps is built so bounding boxes can be tested against a handful
+// of texels. Depth is stored as 1 / view depth, so 0 means nothing was drawn.
+class OcclusionBuffer {
+public:
+	enum {
+		BAND_HEIGHT = 16,
+		MAX_TEST_TEXELS = 4, // per axis, when choosing the hierarchy level to test a box against
+	};
+
+private:
+	struct Triangle {
+		// Edge functions, a * x + b * y + c, positive inside.
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+		// Inverse depth plane.
+		float z_a;
+		float z_b;
+		float z_c;
+		int min_x, max_x;
+		int min_y, max_y;
+	};
+
+	struct Level {
+		int width;
+		int height;
+		Vector<float> data;
+	};
+
+	int width;
+	int height;
+	Transform cam_inverse;
+	CameraMatrix projection;
+	real_t z_near;
+
+	Vector<Triangle> triangles;
+	Vector<Level> levels; // 0 is the depth buffer itself, each next one is half the size, keeping the furthest depth
+	float *depth; // level 0, fetched once so the bands don't touch the Vector from several threads
+
+	_FORCE_INLINE_ Vector2 _project(const Vector3 &p_view) const;
+	void _add_triangle(const Vector3 &p_a, const Vector3 &p_b, const Vector3 &p_c);
+
+public:
+	void begin(const Transform &p_cam_transform, const CameraMatrix &p_projection, int p_width, int p_height);
+	void add_occluder(const Transform &p_xform, const Vector3 *p_faces, int p_vertex_count);
+	bool has_triangles() const { return triangles.size() > 0; }
+
+	int get_band_count() const { return (height + BAND_HEIGHT - 1) / BAND_HEIGHT; }
+	void rasterize_band(int p_band);
+	void build_hierarchy();
+
+	bool is_aabb_occluded(const AABB &p_aabb) const;
+
+	int get_width() const { return width; }
+	int get_height() const { return height; }
+	const float *get_depth() const { return levels.size() ? levels[0].data.ptr() : NULL; }
+
+	OcclusionBuffer();
+};
+
+#endif // OCCLUSION_BUFFER_H
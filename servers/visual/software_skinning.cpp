@@ -0,0 +1,288 @@
+/*************************************************************************/
+/*  software_skinning.cpp                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "software_skinning.h"
+
+#include "core/math/basis.h"
+#include "core/os/memory.h"
+
+template <class B, bool W>
+static _FORCE_INLINE_ void _read_influences(const SoftwareSkinning::SkinJob &p_job, int p_vertex, uint32_t *r_bones, float *r_weights) {
+
+	const B *bones = (const B *)(p_job.vertex_data + p_job.bones_offset + p_vertex * p_job.bones_stride);
+	for (int i = 0; i < 4; i++) {
+		r_bones[i] = bones[i];
+	}
+
+	if (W) {
+		const float *weights = (const float *)(p_job.vertex_data + p_job.weights_offset + p_vertex * p_job.weights_stride);
+		for (int i = 0; i < 4; i++) {
+			r_weights[i] = weights[i];
+		}
+	} else {
+		const uint16_t *weights = (const uint16_t *)(p_job.vertex_data + p_job.weights_offset + p_vertex * p_job.weights_stride);
+		for (int i = 0; i < 4; i++) {
+			r_weights[i] = weights[i] * (1.0f / 0xFFFF);
+		}
+	}
+}
+
+template <class B, bool W>
+static void _skin_linear(const SoftwareSkinning::SkinJob &p_job, int p_from, int p_to) {
+
+	const float *bones = p_job.bones;
+	const uint32_t bone_count = p_job.bone_count;
+
+	if (bone_count == 0) {
+		memset(&p_job.result[p_from * 12], 0, (p_to - p_from) * 12 * sizeof(float));
+		return;
+	}
+
+	for (int i = p_from; i < p_to; i++) {
+
+		uint32_t influences[4];
+		float weights[4];
+		_read_influences<B, W>(p_job, i, influences, weights);
+
+		// Invalid bones are clamped and weighted out rather than skipped, so the
+		// loop has no branches and zero weights cost the same as any other.
+		float m[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+		for (int j = 0; j < 4; j++) {
+			const bool valid = influences[j] < bone_count;
+			const float *bone = &bones[(valid ? influences[j] : 0) * 12];
+			const float w = valid ? weights[j] : 0.0f;
+			for (int k = 0; k < 12; k++) {
+				m[k] += bone[k] * w;
+			}
+		}
+
+		float *dst = &p_job.result[i * 12];
+		for (int k = 0; k < 12; k++) {
+			dst[k] = m[k];
+		}
+	}
+}
+
+template <class B, bool W>
+static void _skin_dual_quaternion(const SoftwareSkinning::SkinJob &p_job, const float *p_dual_quats, int p_from, int p_to) {
+
+	const uint32_t bone_count = p_job.bone_count;
+
+	for (int i = p_from; i < p_to; i++) {
+
+		uint32_t influences[4];
+		float weights[4];
+		_read_influences<B, W>(p_job, i, influences, weights);
+
+		// Blend in the hemisphere of the first influence, so antipodal rotations don't cancel out.
+		float dq[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		const float *pivot = NULL;
+		for (int j = 0; j < 4; j++) {
+			if (weights[j] == 0 || influences[j] >= bone_count) {
+				continue;
+			}
+			const float *bone = &p_dual_quats[influences[j] * 8];
+			float w = weights[j];
+			if (!pivot) {
+				pivot = bone;
+			} else if (pivot[0] * bone[0] + pivot[1] * bone[1] + pivot[2] * bone[2] + pivot[3] * bone[3] < 0) {
+				w = -w;
+			}
+			for (int k = 0; k < 8; k++) {
+				dq[k] += bone[k] * w;
+			}
+		}
+
+		float *dst = &p_job.result[i * 12];
+
+		float len = dq[0] * dq[0] + dq[1] * dq[1] + dq[2] * dq[2] + dq[3] * dq[3];
+		if (len < CMP_EPSILON2) {
+			for (int k = 0; k < 12; k++) {
+				dst[k] = 0;
+			}
+			continue;
+		}
+
+		float inv_len = 1.0f / Math::sqrt(len);
+		const float x = dq[0] * inv_len, y = dq[1] * inv_len, z = dq[2] * inv_len, w = dq[3] * inv_len;
+		const float dx = dq[4] * inv_len, dy = dq[5] * inv_len, dz = dq[6] * inv_len, dw = dq[7] * inv_len;
+
+		// Translation is the vector part of 2 * dual * conjugate(real).
+		dst[0] = 1.0f - 2.0f * (y * y + z * z);
+		dst[1] = 2.0f * (x * y - w * z);
+		dst[2] = 2.0f * (x * z + w * y);
+		dst[3] = 2.0f * (-dw * x + dx * w - dy * z + dz * y);
+		dst[4] = 2.0f * (x * y + w * z);
+		dst[5] = 1.0f - 2.0f * (x * x + z * z);
+		dst[6] = 2.0f * (y * z - w * x);
+		dst[7] = 2.0f * (-dw * y + dy * w - dz * x + dx * z);
+		dst[8] = 2.0f * (x * z - w * y);
+		dst[9] = 2.0f * (y * z + w * x);
+		dst[10] = 1.0f - 2.0f * (x * x + y * y);
+		dst[11] = 2.0f * (-dw * z + dz * w - dx * y + dy * x);
+	}
+}
+
+void SoftwareSkinning::bones_to_dual_quaternions(const float *p_bones, int p_bone_count, float *r_dual_quats) {
+
+	for (int i = 0; i < p_bone_count; i++) {
+
+		const float *bone = &p_bones[i * 12];
+		Basis basis(bone[0], bone[1], bone[2], bone[4], bone[5], bone[6], bone[8], bone[9], bone[10]);
+		Quat q = basis.get_rotation_quat();
+		const float tx = bone[3], ty = bone[7], tz = bone[11];
+
+		float *dq = &r_dual_quats[i * 8];
+		dq[0] = q.x;
+		dq[1] = q.y;
+		dq[2] = q.z;
+		dq[3] = q.w;
+		// Dual part is 0.5 * translation * real.
+		dq[4] = 0.5f * (q.w * tx + ty * q.z - tz * q.y);
+		dq[5] = 0.5f * (q.w * ty + tz * q.x - tx * q.z);
+		dq[6] = 0.5f * (q.w * tz + tx * q.y - ty * q.x);
+		dq[7] = -0.5f * (tx * q.x + ty * q.y + tz * q.z);
+	}
+}
+
+void SoftwareSkinning::skin_linear(const SkinJob &p_job, int p_from, int p_to) {
+
+	if (p_job.bones_16_bits) {
+		if (p_job.weights_float) {
+			_skin_linear<uint16_t, true>(p_job, p_from, p_to);
+		} else {
+			_skin_linear<uint16_t, false>(p_job, p_from, p_to);
+		}
+	} else {
+		if (p_job.weights_float) {
+			_skin_linear<uint8_t, true>(p_job, p_from, p_to);
+		} else {
+			_skin_linear<uint8_t, false>(p_job, p_from, p_to);
+		}
+	}
+}
+
+void SoftwareSkinning::skin_dual_quaternion(const SkinJob &p_job, const float *p_dual_quats, int p_from, int p_to) {
+
+	if (p_job.bones_16_bits) {
+		if (p_job.weights_float) {
+			_skin_dual_quaternion<uint16_t, true>(p_job, p_dual_quats, p_from, p_to);
+		} else {
+			_skin_dual_quaternion<uint16_t, false>(p_job, p_dual_quats, p_from, p_to);
+		}
+	} else {
+		if (p_job.weights_float) {
+			_skin_dual_quaternion<uint8_t, true>(p_job, p_dual_quats, p_from, p_to);
+		} else {
+			_skin_dual_quaternion<uint8_t, false>(p_job, p_dual_quats, p_from, p_to);
+		}
+	}
+}
+
+void SoftwareSkinning::blend_shapes(const BlendShapeJob &p_job, int p_from, int p_to) {
+
+	float base_weight = 1.0;
+	if (!p_job.relative) {
+		for (int i = 0; i < p_job.shape_count; i++) {
+			base_weight -= p_job.weights[i];
+		}
+	}
+
+	float *dst = p_job.result;
+	const float *base = p_job.base;
+	for (int i = p_from; i < p_to; i++) {
+		dst[i] = base[i] * base_weight;
+	}
+
+	// One shape at a time, so each pass streams through two arrays.
+	for (int i = 0; i < p_job.shape_count; i++) {
+		const float w = p_job.weights[i];
+		if (w == 0) {
+			continue;
+		}
+		const float *shape = p_job.shapes[i];
+		for (int j = p_from; j < p_to; j++) {
+			dst[j] += shape[j] * w;
+		}
+	}
+}
+
+void SoftwareSkinning::_skin_chunk(void *p_task, uint32_t p_chunk) {
+
+	const SkinTask *task = (const SkinTask *)p_task;
+	int from = p_chunk * CHUNK_SIZE;
+	int to = MIN(from + int(CHUNK_SIZE), task->job->vertex_count);
+
+	if (task->mode == MODE_DUAL_QUATERNION) {
+		skin_dual_quaternion(*task->job, task->dual_quats, from, to);
+	} else {
+		skin_linear(*task->job, from, to);
+	}
+}
+
+void SoftwareSkinning::_blend_shape_chunk(void *p_job, uint32_t p_chunk) {
+
+	const BlendShapeJob *job = (const BlendShapeJob *)p_job;
+	int from = p_chunk * CHUNK_SIZE * 12; // about as much work as a skinning chunk
+	int to = MIN(from + int(CHUNK_SIZE) * 12, job->float_count);
+
+	blend_shapes(*job, from, to);
+}
+
+void SoftwareSkinning::skin(const SkinJob &p_job, Mode p_mode) {
+
+	SkinTask skin_task;
+	skin_task.job = &p_job;
+	skin_task.mode = p_mode;
+	skin_task.dual_quats = NULL;
+
+	if (p_mode == MODE_DUAL_QUATERNION) {
+		dual_quats.resize(p_job.bone_count * 8);
+		bones_to_dual_quaternions(p_job.bones, p_job.bone_count, dual_quats.ptrw());
+		skin_task.dual_quats = dual_quats.ptr();
+	}
+
+	work_pool.do_work((p_job.vertex_count + CHUNK_SIZE - 1) / CHUNK_SIZE, _skin_chunk, &skin_task);
+}
+
+void SoftwareSkinning::blend(const BlendShapeJob &p_job) {
+
+	work_pool.do_work((p_job.float_count + CHUNK_SIZE * 12 - 1) / (CHUNK_SIZE * 12), _blend_shape_chunk, (void *)&p_job);
+}
+
+SoftwareSkinning::SoftwareSkinning(int p_threads) {
+
+	work_pool.init(p_threads);
+}
+
+SoftwareSkinning::~SoftwareSkinning() {
+
+	work_pool.finish();
+}
@@ -0,0 +1,111 @@
+/*************************************************************************/
+/*  software_skinning.h                                                  */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2019 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2019 Godot Engine contributors (cf. AUTHORS.md)    */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SOFTWARE_SKINNING_H
+#define SOFTWARE_SKINNING_H
+
+#include "core/os/thread_work_pool.h"
+#include "core/vector.h"
+
+// CPU skinning kernels for renderers that can't skin on the GPU, kept free of
+// any graphics API so they also run (and can be tested) headless. Bones are
+// given as 12 floats each, the rows of a 3x4 matrix, which is how the
+// rasterizers already store them. Large meshes are split in chunks of
+// vertices and spread over a ThreadWorkPool.
+class SoftwareSkinning {
+public:
+	enum Mode {
+		MODE_LINEAR, // blend the bone matrices, like the GPU path does
+		MODE_DUAL_QUATERNION, // blend rigid bone transforms as dual quaternions, which keeps volume at twisting joints but ignores bone scale
+	};
+
+	enum {
+		CHUNK_SIZE = 1024, // vertices per work item
+	};
+
+	struct SkinJob {
+		const float *bones; // 12 floats per bone
+		int bone_count;
+
+		// Interleaved vertex data, with 4 bone indices (8 or 16 bits) and 4 weights (float or normalized 16 bits) per vertex.
+		const uint8_t *vertex_data;
+		int vertex_count;
+		uint32_t bones_offset;
+		uint32_t bones_stride;
+		bool bones_16_bits;
+		uint32_t weights_offset;
+		uint32_t weights_stride;
+		bool weights_float;
+
+		float *result; // 12 floats per vertex, the blended matrix rows
+	};
+
+	struct BlendShapeJob {
+		const float *base; // float_count floats
+		const float *const *shapes; // shape_count arrays of float_count floats
+		const float *weights;
+		int shape_count;
+		int float_count;
+		bool relative; // shapes hold offsets from base rather than absolute values
+
+		float *result;
+	};
+
+private:
+	struct SkinTask {
+		const SkinJob *job;
+		Mode mode;
+		const float *dual_quats; // 8 floats per bone, for MODE_DUAL_QUATERNION
+	};
+
+	ThreadWorkPool work_pool;
+	Vector<float> dual_quats;
+
+	static void _skin_chunk(void *p_task, uint32_t p_chunk);
+	static void _blend_shape_chunk(void *p_job, uint32_t p_chunk);
+
+public:
+	static void bones_to_dual_quaternions(const float *p_bones, int p_bone_count, float *r_dual_quats);
+
+	static void skin_linear(const SkinJob &p_job, int p_from, int p_to);
+	static void skin_dual_quaternion(const SkinJob &p_job, const float *p_dual_quats, int p_from, int p_to);
+	static void blend_shapes(const BlendShapeJob &p_job, int p_from, int p_to);
+
+	// Threaded versions, over the whole job.
+	void skin(const SkinJob &p_job, Mode p_mode);
+	void blend(const BlendShapeJob &p_job);
+
+	int get_thread_count() const { return work_pool.get_thread_count(); }
+
+	SoftwareSkinning(int p_threads);
+	~SoftwareSkinning();
+};
+
+#endif // SOFTWARE_SKINNING_H
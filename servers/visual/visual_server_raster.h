@@ -46,7 +46,6 @@ class VisualServerRaster : public VisualServer {
 
 	enum {
 
-		MAX_INSTANCE_CULL = 8192,
 		MAX_INSTANCE_LIGHTS = 4,
 		LIGHT_CACHE_DIRTY = -1,
 		MAX_LIGHTS_CULLED = 256,
@@ -525,6 +524,20 @@ public:
 	BIND2(scenario_set_debug, RID, ScenarioDebugMode)
 	BIND2(scenario_set_environment, RID, RID)
 	BIND3(scenario_set_reflection_atlas_size, RID, int, int)
+
+	/* ROOM API */
+
+	BIND0R(RID, room_create)
+	BIND2(room_set_scenario, RID, RID)
+	BIND2(room_set_bounds, RID, const PoolVector<Vector3> &)
+
+	/* PORTAL API */
+
+	BIND0R(RID, portal_create)
+	BIND2(portal_set_scenario, RID, RID)
+	BIND2(portal_set_polygon, RID, const PoolVector<Vector3> &)
+	BIND3(portal_set_rooms, RID, RID, RID)
+	BIND2(portal_set_enabled, RID, bool)
 	BIND2(scenario_set_fallback_environment, RID, RID)
 
 	/* INSTANCING API */
@@ -559,6 +572,7 @@ public:
 
 	BIND5(instance_geometry_set_draw_range, RID, float, float, float, float)
 	BIND2(instance_geometry_set_as_instance_lod, RID, RID)
+	BIND2(instance_geometry_set_occluder, RID, const PoolVector<Vector3> &)
 
 #undef BINDBASE
 //from now on, calls forwarded to this singleton
@@ -29,7 +29,9 @@
 /*************************************************************************/
 
 #include "visual_server_scene.h"
+#include "core/math/quick_hull.h"
 #include "core/os/os.h"
+#include "core/project_settings.h"
 #include "visual_server_globals.h"
 #include "visual_server_raster.h"
 #include <new>
@@ -38,6 +40,13 @@
 RID VisualServerScene::camera_create() {
 
 	Camera *camera = memnew(Camera);
+	for (int i = 0; i < 64; i++) {
+		if (!(lod_slots_used & (uint64_t(1) << i))) {
+			lod_slots_used |= uint64_t(1) << i;
+			camera->lod_slot = i;
+			break;
+		}
+	}
 	return camera_owner.make_rid(camera);
 }
 
@@ -118,6 +127,7 @@ void *VisualServerScene::_instance_pair(void *p_self, OctreeElementID, Instance
 
 			light->shadow_dirty = true;
 		}
+		light->shadow_casters_valid = 0;
 		geom->lighting_dirty = true;
 
 		return E; //this element should make freeing faster
@@ -195,6 +205,7 @@ void VisualServerScene::_instance_unpair(void *p_self, OctreeElementID, Instance
 		if (geom->can_cast_shadows) {
 			light->shadow_dirty = true;
 		}
+		light->shadow_casters_valid = 0; //cached casters may point to it
 		geom->lighting_dirty = true;
 
 	} else if (B->base_type == VS::INSTANCE_REFLECTION_PROBE && ((1 << A->base_type) & VS::INSTANCE_GEOMETRY_MASK)) {
@@ -289,6 +300,201 @@ void VisualServerScene::scenario_set_reflection_atlas_size(RID p_scenario, int p
 	VSG::scene_render->reflection_atlas_set_subdivision(scenario->reflection_atlas, p_subdiv);
 }
 
+/* ROOM API */
+
+bool VisualServerScene::RoomVisibility::intersects(const AABB &p_aabb, uint64_t p_pass) const {
+
+	if (pass != p_pass) {
+		return false;
+	}
+
+	for (int i = 0; i < frustums.size(); i++) {
+		if (p_aabb.intersects_convex_shape(frustums[i].ptr(), frustums[i].size())) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+RID VisualServerScene::room_create() {
+
+	Room *room = memnew(Room);
+	ERR_FAIL_COND_V(!room, RID());
+	RID room_rid = room_owner.make_rid(room);
+	room->self = room_rid;
+	return room_rid;
+}
+
+void VisualServerScene::room_set_scenario(RID p_room, RID p_scenario) {
+
+	Room *room = room_owner.get(p_room);
+	ERR_FAIL_COND(!room);
+
+	Scenario *scenario = NULL;
+	if (p_scenario.is_valid()) {
+		scenario = scenario_owner.get(p_scenario);
+		ERR_FAIL_COND(!scenario);
+	}
+
+	if (room->scenario == scenario) {
+		return;
+	}
+
+	if (room->scenario) {
+		room->scenario->rooms.remove(&room->scenario_item);
+		_scenario_rooms_changed(room->scenario);
+	}
+
+	room->scenario = scenario;
+
+	if (scenario) {
+		scenario->rooms.add(&room->scenario_item);
+		_scenario_rooms_changed(scenario);
+	}
+}
+
+void VisualServerScene::room_set_bounds(RID p_room, const PoolVector<Vector3> &p_points) {
+
+	Room *room = room_owner.get(p_room);
+	ERR_FAIL_COND(!room);
+
+	room->planes.clear();
+	room->aabb = AABB();
+
+	if (p_points.size() >= 4) {
+
+		Vector<Vector3> points;
+		points.resize(p_points.size());
+		PoolVector<Vector3>::Read r = p_points.read();
+		for (int i = 0; i < p_points.size(); i++) {
+			points.write[i] = r[i];
+		}
+
+		Geometry::MeshData md;
+		Error err = QuickHull::build(points, md);
+		ERR_FAIL_COND(err != OK);
+
+		room->aabb.position = points[0];
+		for (int i = 1; i < points.size(); i++) {
+			room->aabb.expand_to(points[i]);
+		}
+
+		Vector3 center = room->aabb.position + room->aabb.size * 0.5;
+		for (int i = 0; i < md.faces.size(); i++) {
+			Plane plane = md.faces[i].plane;
+			if (plane.is_point_over(center)) {
+				plane = -plane;
+			}
+			room->planes.push_back(plane);
+		}
+	}
+
+	if (room->scenario) {
+		_scenario_rooms_changed(room->scenario);
+	}
+}
+
+void VisualServerScene::_scenario_rooms_changed(Scenario *p_scenario) {
+
+	for (SelfList<Instance> *E = p_scenario->instances.first(); E; E = E->next()) {
+		_update_instance_rooms(E->self());
+	}
+}
+
+/* PORTAL API */
+
+RID VisualServerScene::portal_create() {
+
+	Portal *portal = memnew(Portal);
+	ERR_FAIL_COND_V(!portal, RID());
+	RID portal_rid = portal_owner.make_rid(portal);
+	portal->self = portal_rid;
+	return portal_rid;
+}
+
+void VisualServerScene::portal_set_scenario(RID p_portal, RID p_scenario) {
+
+	Portal *portal = portal_owner.get(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	if (portal->scenario) {
+		portal->scenario->portals.remove(&portal->scenario_item);
+		portal->scenario = NULL;
+	}
+
+	if (p_scenario.is_valid()) {
+		Scenario *scenario = scenario_owner.get(p_scenario);
+		ERR_FAIL_COND(!scenario);
+		portal->scenario = scenario;
+		scenario->portals.add(&portal->scenario_item);
+	}
+}
+
+void VisualServerScene::portal_set_polygon(RID p_portal, const PoolVector<Vector3> &p_points) {
+
+	Portal *portal = portal_owner.get(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	portal->points.resize(p_points.size());
+	PoolVector<Vector3>::Read r = p_points.read();
+	for (int i = 0; i < p_points.size(); i++) {
+		portal->points.write[i] = r[i];
+	}
+
+	if (portal->points.size() >= 3) {
+		portal->plane = Plane(portal->points[0], portal->points[1], portal->points[2]);
+	}
+}
+
+void VisualServerScene::portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b) {
+
+	Portal *portal = portal_owner.get(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	Room *rooms[2] = { NULL, NULL };
+	if (p_room_a.is_valid()) {
+		rooms[0] = room_owner.get(p_room_a);
+		ERR_FAIL_COND(!rooms[0]);
+	}
+	if (p_room_b.is_valid()) {
+		rooms[1] = room_owner.get(p_room_b);
+		ERR_FAIL_COND(!rooms[1]);
+	}
+	_portal_unlink(portal);
+
+	if (rooms[0] == rooms[1]) {
+		return; // a portal into the room it is in connects nothing, leave it unlinked
+	}
+
+	for (int i = 0; i < 2; i++) {
+		portal->rooms[i] = rooms[i];
+		if (rooms[i]) {
+			rooms[i]->portals.push_back(portal);
+		}
+	}
+	portal->linked = true;
+}
+
+void VisualServerScene::portal_set_enabled(RID p_portal, bool p_enabled) {
+
+	Portal *portal = portal_owner.get(p_portal);
+	ERR_FAIL_COND(!portal);
+
+	portal->enabled = p_enabled;
+}
+
+void VisualServerScene::_portal_unlink(Portal *p_portal) {
+
+	for (int i = 0; i < 2; i++) {
+		if (p_portal->rooms[i]) {
+			p_portal->rooms[i]->portals.erase(p_portal);
+			p_portal->rooms[i] = NULL;
+		}
+	}
+	p_portal->linked = false;
+}
+
 /* INSTANCING API */
 
 void VisualServerScene::_instance_queue_update(Instance *p_instance, bool p_update_aabb, bool p_update_materials) {
@@ -347,6 +553,7 @@ void VisualServerScene::instance_set_base(RID p_instance, RID p_base) {
 
 		if (scenario && instance->octree_id) {
 			scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
+			scenario->cull_list.remove(instance);
 			instance->octree_id = 0;
 		}
 
@@ -497,12 +704,19 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 	if (instance->scenario) {
 
 		instance->scenario->instances.remove(&instance->scenario_item);
+		if (instance->occluder_item.in_list()) {
+			instance->scenario->occluders.remove(&instance->occluder_item);
+		}
 
 		if (instance->octree_id) {
 			instance->scenario->octree.erase(instance->octree_id); //make dependencies generated by the octree go away
+			instance->scenario->cull_list.remove(instance);
 			instance->octree_id = 0;
 		}
 
+		instance->rooms.clear();
+		instance->room_exterior = true;
+
 		switch (instance->base_type) {
 
 			case VS::INSTANCE_LIGHT: {
@@ -541,6 +755,9 @@ void VisualServerScene::instance_set_scenario(RID p_instance, RID p_scenario) {
 		instance->scenario = scenario;
 
 		scenario->instances.add(&instance->scenario_item);
+		if (instance->occluder_faces.size()) {
+			scenario->occluders.add(&instance->occluder_item);
+		}
 
 		switch (instance->base_type) {
 
@@ -882,8 +1099,97 @@ void VisualServerScene::instance_geometry_set_material_override(RID p_instance,
 }
 
 void VisualServerScene::instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	instance->lod_begin = MAX(p_min, 0);
+	instance->lod_end = MAX(p_max, 0);
+	instance->lod_begin_hysteresis = MAX(p_min_margin, 0);
+	instance->lod_end_hysteresis = MAX(p_max_margin, 0);
+	instance->lod_visible = ~uint64_t(0);
 }
+
 void VisualServerScene::instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+
+	Instance *parent = NULL;
+	if (p_as_lod_of_instance.is_valid()) {
+		parent = instance_owner.get(p_as_lod_of_instance);
+		ERR_FAIL_COND(!parent);
+		ERR_FAIL_COND(parent == instance);
+	}
+
+	if (instance->lod_parent) {
+		instance->lod_parent->lod_children.erase(instance);
+	}
+
+	instance->lod_parent = parent;
+
+	if (parent) {
+		parent->lod_children.push_back(instance);
+	}
+}
+
+void VisualServerScene::instance_geometry_set_occluder(RID p_instance, const PoolVector<Vector3> &p_faces) {
+
+	Instance *instance = instance_owner.get(p_instance);
+	ERR_FAIL_COND(!instance);
+	ERR_FAIL_COND(p_faces.size() % 3);
+
+	instance->occluder_faces = p_faces;
+	instance->occluder_aabb = AABB();
+
+	if (p_faces.size()) {
+		PoolVector<Vector3>::Read r = p_faces.read();
+		instance->occluder_aabb.position = r[0];
+		for (int i = 1; i < p_faces.size(); i++) {
+			instance->occluder_aabb.expand_to(r[i]);
+		}
+	}
+
+	if (instance->scenario) {
+		if (p_faces.size() && !instance->occluder_item.in_list()) {
+			instance->scenario->occluders.add(&instance->occluder_item);
+		} else if (!p_faces.size() && instance->occluder_item.in_list()) {
+			instance->scenario->occluders.remove(&instance->occluder_item);
+		}
+	}
+}
+
+bool VisualServerScene::_instance_lod_visible(Instance *p_instance, const Vector3 &p_camera_pos, bool p_update_hysteresis) {
+
+	if (p_instance->lod_begin == 0 && p_instance->lod_end == 0) {
+		return true;
+	}
+
+	// All levels of a chain measure from the same instance, so they switch together.
+	const AABB &aabb = p_instance->lod_parent ? p_instance->lod_parent->transformed_aabb : p_instance->transformed_aabb;
+	float distance = p_camera_pos.distance_to(aabb.position + aabb.size * 0.5);
+
+	float begin = p_instance->lod_begin;
+	float end = p_instance->lod_end;
+	// The state is kept per camera, so cameras at different distances don't flip it for each other.
+	uint64_t slot_bit = lod_slot >= 0 ? uint64_t(1) << lod_slot : 0;
+	if (p_instance->lod_visible & slot_bit) {
+		// Once visible, the range widens by the margins so it doesn't flicker at the boundary.
+		begin -= p_instance->lod_begin_hysteresis;
+		end += p_instance->lod_end_hysteresis;
+	}
+
+	bool visible = distance >= begin && (p_instance->lod_end == 0 || distance < end);
+
+	if (p_update_hysteresis) {
+		if (visible) {
+			p_instance->lod_visible |= slot_bit;
+		} else {
+			p_instance->lod_visible &= ~slot_bit;
+		}
+	}
+
+	return visible;
 }
 
 void VisualServerScene::_update_instance(Instance *p_instance) {
@@ -896,6 +1202,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 
 		VSG::scene_render->light_instance_set_transform(light->instance, p_instance->transform);
 		light->shadow_dirty = true;
+		light->shadow_casters_valid = 0;
 	}
 
 	if (p_instance->base_type == VS::INSTANCE_REFLECTION_PROBE) {
@@ -924,6 +1231,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 			for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 				InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 				light->shadow_dirty = true;
+				light->shadow_casters_valid = 0;
 			}
 		}
 
@@ -970,6 +1278,7 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 
 		// not inside octree
 		p_instance->octree_id = p_instance->scenario->octree.create(p_instance, new_aabb, 0, pairable, base_type, pairable_mask);
+		p_instance->scenario->cull_list.add(p_instance);
 
 	} else {
 
@@ -979,6 +1288,34 @@ void VisualServerScene::_update_instance(Instance *p_instance) {
 		*/
 
 		p_instance->scenario->octree.move(p_instance->octree_id, new_aabb);
+		p_instance->scenario->cull_list.update(p_instance);
+	}
+
+	_update_instance_rooms(p_instance);
+}
+
+void VisualServerScene::_update_instance_rooms(Instance *p_instance) {
+
+	p_instance->rooms.clear();
+	p_instance->room_exterior = true;
+
+	if (!p_instance->scenario || !p_instance->octree_id) {
+		return;
+	}
+
+	const AABB &aabb = p_instance->transformed_aabb;
+
+	for (SelfList<Room> *E = p_instance->scenario->rooms.first(); E; E = E->next()) {
+
+		Room *room = E->self();
+		if (room->planes.empty() || !room->aabb.intersects(aabb) || !aabb.intersects_convex_shape(room->planes.ptr(), room->planes.size())) {
+			continue;
+		}
+
+		p_instance->rooms.push_back(room);
+		if (aabb.inside_convex_shape(room->planes.ptr(), room->planes.size())) {
+			p_instance->room_exterior = false;
+		}
 	}
 }
 
@@ -1290,6 +1627,42 @@ void VisualServerScene::_update_instance_lightmap_captures(Instance *p_instance)
 	}
 }
 
+int VisualServerScene::_light_cull_shadow_casters(InstanceLightData *p_light, int p_pass, const Vector<Plane> &p_planes) {
+
+	Vector<Instance *> &casters = p_light->shadow_casters[p_pass];
+
+	if (p_light->shadow_casters_valid & (1 << p_pass)) {
+
+		shadow_cull_skipped_count++;
+	} else {
+
+		// Anything that can cast into this pass overlaps the light, so it is already paired with it.
+		// Unpairing also drops the cache, which keeps the stored pointers valid.
+		casters.resize(0);
+		const Plane *planes = p_planes.ptr();
+		int plane_count = p_planes.size();
+
+		for (List<InstanceLightData::PairInfo>::Element *E = p_light->geometries.front(); E; E = E->next()) {
+
+			Instance *instance = E->get().geometry;
+			if (instance->transformed_aabb.intersects_convex_shape(planes, plane_count)) {
+				casters.push_back(instance);
+			}
+		}
+
+		p_light->shadow_casters_valid |= 1 << p_pass;
+		shadow_cull_count++;
+	}
+
+	int cull_count = MIN(casters.size(), instance_cull_result_size);
+	Instance *const *src = casters.ptr();
+	for (int i = 0; i < cull_count; i++) {
+		instance_shadow_cull_result[i] = src[i];
+	}
+
+	return cull_count;
+}
+
 bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario) {
 
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
@@ -1316,7 +1689,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			if (depth_range_mode == VS::LIGHT_DIRECTIONAL_SHADOW_DEPTH_RANGE_OPTIMIZED) {
 				//optimize min/max
 				Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
-				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, instance_cull_result_size, VS::INSTANCE_GEOMETRY_MASK);
 				Plane base(p_cam_transform.origin, -p_cam_transform.basis.get_axis(2));
 				//check distance max and min
 
@@ -1327,7 +1700,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 				for (int i = 0; i < cull_count; i++) {
 
 					Instance *instance = instance_shadow_cull_result[i];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !_instance_lod_visible(instance, p_cam_transform.origin, false)) {
 						continue;
 					}
 
@@ -1514,7 +1887,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 				light_frustum_planes.write[4] = Plane(z_vec, z_max + 1e6);
 				light_frustum_planes.write[5] = Plane(-z_vec, -z_min); // z_min is ok, since casters further than far-light plane are not needed
 
-				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+				int cull_count = p_scenario->octree.cull_convex(light_frustum_planes, instance_shadow_cull_result, instance_cull_result_size, VS::INSTANCE_GEOMETRY_MASK);
 
 				// a pre pass will need to be needed to determine the actual z-near to be used
 
@@ -1524,7 +1897,7 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					float min, max;
 					Instance *instance = instance_shadow_cull_result[j];
-					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+					if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !_instance_lod_visible(instance, p_cam_transform.origin, false)) {
 						cull_count--;
 						SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 						j--;
@@ -1578,13 +1951,13 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[3] = light_transform.xform(Plane(Vector3(0, 1, z).normalized(), radius));
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+					int cull_count = _light_cull_shadow_casters(light, i, planes);
 					Plane near_plane(light_transform.origin, light_transform.basis.get_axis(2) * z);
 
 					for (int j = 0; j < cull_count; j++) {
 
 						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !_instance_lod_visible(instance, p_cam_transform.origin, false) || !_instances_share_room(p_instance, instance)) {
 							cull_count--;
 							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 							j--;
@@ -1632,13 +2005,13 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Vector<Plane> planes = cm.get_projection_planes(xform);
 
-					int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+					int cull_count = _light_cull_shadow_casters(light, i, planes);
 
 					Plane near_plane(xform.origin, -xform.basis.get_axis(2));
 					for (int j = 0; j < cull_count; j++) {
 
 						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+						if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !_instance_lod_visible(instance, p_cam_transform.origin, false) || !_instances_share_room(p_instance, instance)) {
 							cull_count--;
 							SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 							j--;
@@ -1669,13 +2042,13 @@ bool VisualServerScene::_light_instance_update_shadow(Instance *p_instance, cons
 			cm.set_perspective(angle * 2.0, 1.0, 0.01, radius);
 
 			Vector<Plane> planes = cm.get_projection_planes(light_transform);
-			int cull_count = p_scenario->octree.cull_convex(planes, instance_shadow_cull_result, MAX_INSTANCE_CULL, VS::INSTANCE_GEOMETRY_MASK);
+			int cull_count = _light_cull_shadow_casters(light, 0, planes);
 
 			Plane near_plane(light_transform.origin, -light_transform.basis.get_axis(2));
 			for (int j = 0; j < cull_count; j++) {
 
 				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
+				if (!instance->visible || !((1 << instance->base_type) & VS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows || !_instance_lod_visible(instance, p_cam_transform.origin, false) || !_instances_share_room(p_instance, instance)) {
 					cull_count--;
 					SWAP(instance_shadow_cull_result[j], instance_shadow_cull_result[cull_count]);
 					j--;
@@ -1732,7 +2105,9 @@ void VisualServerScene::render_camera(RID p_camera, RID p_scenario, Size2 p_view
 		} break;
 	}
 
+	lod_slot = camera->lod_slot;
 	_prepare_scene(camera->transform, camera_matrix, ortho, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+	lod_slot = -1;
 	_render_scene(camera->transform, camera_matrix, ortho, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 #endif
 }
@@ -1811,16 +2186,390 @@ void VisualServerScene::render_camera(Ref<ARVRInterface> &p_interface, ARVRInter
 		mono_transform *= apply_z_shift;
 
 		// now prepare our scene with our adjusted transform projection matrix
+		lod_slot = camera->lod_slot;
 		_prepare_scene(mono_transform, combined_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		lod_slot = -1;
 	} else if (p_eye == ARVRInterface::EYE_MONO) {
 		// For mono render, prepare as per usual
+		lod_slot = camera->lod_slot;
 		_prepare_scene(cam_transform, camera_matrix, false, camera->env, camera->visible_layers, p_scenario, p_shadow_atlas, RID());
+		lod_slot = -1;
 	}
 
 	// And render our scene...
 	_render_scene(cam_transform, camera_matrix, false, camera->env, p_scenario, p_shadow_atlas, RID(), -1);
 };
 
+void VisualServerScene::InstanceCullList::add(Instance *p_instance) {
+
+	ERR_FAIL_COND(p_instance->cull_index != -1);
+
+	p_instance->cull_index = instances.size();
+	instances.push_back(p_instance);
+	type_masks.push_back(1 << p_instance->base_type);
+	for (int i = 0; i < 6; i++) {
+		bounds[i].push_back(0);
+	}
+	update(p_instance);
+}
+
+void VisualServerScene::InstanceCullList::update(Instance *p_instance) {
+
+	int index = p_instance->cull_index;
+	ERR_FAIL_INDEX(index, instances.size());
+
+	const AABB &aabb = p_instance->transformed_aabb;
+	bounds[0].write[index] = aabb.position.x;
+	bounds[1].write[index] = aabb.position.y;
+	bounds[2].write[index] = aabb.position.z;
+	bounds[3].write[index] = aabb.position.x + aabb.size.x;
+	bounds[4].write[index] = aabb.position.y + aabb.size.y;
+	bounds[5].write[index] = aabb.position.z + aabb.size.z;
+}
+
+void VisualServerScene::InstanceCullList::remove(Instance *p_instance) {
+
+	int index = p_instance->cull_index;
+	ERR_FAIL_INDEX(index, instances.size());
+
+	// Move the last entry into the hole.
+	int last = instances.size() - 1;
+	if (index != last) {
+		Instance *moved = instances[last];
+		instances.write[index] = moved;
+		type_masks.write[index] = type_masks[last];
+		for (int i = 0; i < 6; i++) {
+			bounds[i].write[index] = bounds[i][last];
+		}
+		moved->cull_index = index;
+	}
+
+	instances.resize(last);
+	type_masks.resize(last);
+	for (int i = 0; i < 6; i++) {
+		bounds[i].resize(last);
+	}
+	p_instance->cull_index = -1;
+}
+
+void VisualServerScene::_cull_chunk(void *p_job, uint32_t p_chunk) {
+
+	CullJob *job = (CullJob *)p_job;
+	const InstanceCullList *list = job->list;
+	int from = p_chunk * CULL_CHUNK_SIZE;
+	int count = MIN(int(CULL_CHUNK_SIZE), list->instances.size() - from);
+
+	uint8_t inside[CULL_CHUNK_SIZE];
+
+	const uint32_t *masks = list->type_masks.ptr() + from;
+	for (int i = 0; i < count; i++) {
+		inside[i] = (masks[i] & job->mask) != 0;
+	}
+
+	const real_t *min_bounds[3] = { list->bounds[0].ptr() + from, list->bounds[1].ptr() + from, list->bounds[2].ptr() + from };
+	const real_t *max_bounds[3] = { list->bounds[3].ptr() + from, list->bounds[4].ptr() + from, list->bounds[5].ptr() + from };
+
+	for (int p = 0; p < job->plane_count; p++) {
+
+		// A box is outside a plane when its corner furthest against the normal is in front of it.
+		const Plane &plane = job->planes[p];
+		const real_t *x = plane.normal.x > 0 ? min_bounds[0] : max_bounds[0];
+		const real_t *y = plane.normal.y > 0 ? min_bounds[1] : max_bounds[1];
+		const real_t *z = plane.normal.z > 0 ? min_bounds[2] : max_bounds[2];
+		const real_t nx = plane.normal.x;
+		const real_t ny = plane.normal.y;
+		const real_t nz = plane.normal.z;
+		const real_t d = plane.d;
+
+		for (int i = 0; i < count; i++) {
+			inside[i] &= (nx * x[i] + ny * y[i] + nz * z[i] - d) <= 0;
+		}
+	}
+
+	Instance *const *instances = list->instances.ptr() + from;
+	Instance **result = job->result + from;
+	uint32_t result_count = 0;
+	for (int i = 0; i < count; i++) {
+		if (inside[i]) {
+			result[result_count++] = instances[i];
+		}
+	}
+	job->chunk_result_counts[p_chunk] = result_count;
+}
+
+void VisualServerScene::_cull_result_reserve(Scenario *p_scenario) {
+
+	int needed = p_scenario->cull_list.instances.size();
+	if (needed <= instance_cull_result_size) {
+		return;
+	}
+
+	int size = MAX(instance_cull_result_size, 1024);
+	while (size < needed) {
+		size <<= 1;
+	}
+
+	instance_cull_result = (Instance **)memrealloc(instance_cull_result, size * sizeof(Instance *));
+	instance_shadow_cull_result = (Instance **)memrealloc(instance_shadow_cull_result, size * sizeof(Instance *));
+	instance_cull_result_size = size;
+}
+
+int VisualServerScene::_cull_convex(Scenario *p_scenario, const Vector<Plane> &p_planes, Instance **r_result, uint32_t p_mask) {
+
+	const InstanceCullList &list = p_scenario->cull_list;
+	if (list.instances.empty()) {
+		return 0;
+	}
+
+	uint32_t chunk_count = (list.instances.size() + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE;
+	if (cull_chunk_result_counts.size() < int(chunk_count)) {
+		cull_chunk_result_counts.resize(chunk_count);
+	}
+
+	CullJob job;
+	job.list = &list;
+	job.planes = p_planes.ptr();
+	job.plane_count = p_planes.size();
+	job.mask = p_mask;
+	job.result = r_result;
+	job.chunk_result_counts = cull_chunk_result_counts.ptrw();
+
+	cull_work_pool.do_work(chunk_count, _cull_chunk, &job);
+
+	// Chunks wrote their results at their own offsets, pack them in order.
+	int count = 0;
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		Instance **chunk_result = r_result + i * CULL_CHUNK_SIZE;
+		uint32_t chunk_result_count = job.chunk_result_counts[i];
+		if (r_result + count != chunk_result) {
+			memmove(r_result + count, chunk_result, chunk_result_count * sizeof(Instance *));
+		}
+		count += chunk_result_count;
+	}
+
+	return count;
+}
+
+void VisualServerScene::_occlusion_rasterize_band(void *p_buffer, uint32_t p_band) {
+
+	((OcclusionBuffer *)p_buffer)->rasterize_band(p_band);
+}
+
+void VisualServerScene::_occlusion_test_chunk(void *p_job, uint32_t p_chunk) {
+
+	OcclusionTestJob *job = (OcclusionTestJob *)p_job;
+	int from = p_chunk * CULL_CHUNK_SIZE;
+	int to = MIN(from + int(CULL_CHUNK_SIZE), job->count);
+
+	for (int i = from; i < to; i++) {
+		Instance *ins = job->instances[i];
+		// Only geometry is hidden, lights and probes still affect what is visible.
+		job->occluded[i] = ((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && job->buffer->is_aabb_occluded(ins->transformed_aabb);
+	}
+}
+
+void VisualServerScene::_occlusion_cull(Scenario *p_scenario, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, const Vector<Plane> &p_planes, uint32_t p_visible_layers) {
+
+	int width = occlusion_buffer_width;
+	int height = CLAMP(int(width / p_cam_projection.get_aspect()), 1, width * 4);
+
+	occlusion_buffer.begin(p_cam_transform, p_cam_projection, width, height);
+
+	for (SelfList<Instance> *E = p_scenario->occluders.first(); E; E = E->next()) {
+
+		Instance *ins = E->self();
+		if (!ins->visible || !(ins->layer_mask & p_visible_layers)) {
+			continue;
+		}
+
+		AABB aabb = ins->transform.xform(ins->occluder_aabb);
+		if (!aabb.intersects_convex_shape(p_planes.ptr(), p_planes.size())) {
+			continue;
+		}
+
+		PoolVector<Vector3>::Read r = ins->occluder_faces.read();
+		occlusion_buffer.add_occluder(ins->transform, r.ptr(), ins->occluder_faces.size());
+	}
+
+	if (!occlusion_buffer.has_triangles()) {
+		return;
+	}
+
+	cull_work_pool.do_work(occlusion_buffer.get_band_count(), _occlusion_rasterize_band, &occlusion_buffer);
+
+	occlusion_buffer.build_hierarchy();
+
+	if (occlusion_results.size() < instance_cull_count) {
+		occlusion_results.resize(instance_cull_count);
+	}
+
+	OcclusionTestJob job;
+	job.buffer = &occlusion_buffer;
+	job.instances = instance_cull_result;
+	job.occluded = occlusion_results.ptrw();
+	job.count = instance_cull_count;
+
+	cull_work_pool.do_work((instance_cull_count + CULL_CHUNK_SIZE - 1) / CULL_CHUNK_SIZE, _occlusion_test_chunk, &job);
+
+	int count = 0;
+	for (int i = 0; i < instance_cull_count; i++) {
+		if (!job.occluded[i]) {
+			instance_cull_result[count++] = instance_cull_result[i];
+		}
+	}
+	instance_cull_count = count;
+}
+
+void VisualServerScene::_portal_traverse(Scenario *p_scenario, Room **p_path, int p_depth, const Vector3 &p_cam_pos, const Vector<Plane> &p_planes, const Plane &p_far) {
+
+	Room *room = p_path[p_depth];
+	RoomVisibility &visibility = room ? room->visibility : p_scenario->exterior_visibility;
+	if (visibility.pass != render_pass) {
+		visibility.pass = render_pass;
+		visibility.frustums.clear();
+	}
+	visibility.frustums.push_back(p_planes);
+
+	if (p_depth == MAX_PORTAL_DEPTH) {
+		return;
+	}
+
+	for (SelfList<Portal> *E = p_scenario->portals.first(); E; E = E->next()) {
+
+		Portal *portal = E->self();
+		if (!portal->linked || !portal->enabled || portal->points.size() < 3) {
+			continue;
+		}
+
+		Room *next;
+		if (portal->rooms[0] == room) {
+			next = portal->rooms[1];
+		} else if (portal->rooms[1] == room) {
+			next = portal->rooms[0];
+		} else {
+			continue;
+		}
+
+		bool visited = false;
+		for (int i = 0; i <= p_depth; i++) {
+			if (p_path[i] == next) {
+				visited = true;
+				break;
+			}
+		}
+		if (visited) {
+			continue;
+		}
+
+		Vector<Plane> planes;
+		real_t cam_distance = portal->plane.distance_to(p_cam_pos);
+
+		if (Math::abs(cam_distance) < 0.05) {
+			// Standing in the doorway, the portal is seen edge on and can't narrow anything.
+			planes = p_planes;
+		} else {
+
+			Vector<Vector3> polygon = portal->points;
+			for (int i = 0; i < p_planes.size() && polygon.size() >= 3; i++) {
+				polygon = Geometry::clip_polygon(polygon, p_planes[i]);
+			}
+			if (polygon.size() < 3) {
+				continue; // not seen through the current frustum
+			}
+
+			Vector3 center;
+			for (int i = 0; i < polygon.size(); i++) {
+				center += polygon[i];
+			}
+			center /= polygon.size();
+
+			// One plane from the camera through every edge of what is left of the portal.
+			for (int i = 0; i < polygon.size(); i++) {
+				const Vector3 &a = polygon[i];
+				const Vector3 &b = polygon[(i + 1) % polygon.size()];
+				if (a.distance_squared_to(b) < CMP_EPSILON2) {
+					continue;
+				}
+				Plane edge(p_cam_pos, a, b);
+				if (edge.is_point_over(center)) {
+					edge = -edge;
+				}
+				planes.push_back(edge);
+			}
+
+			// Nothing on the camera side of the portal is seen through it.
+			planes.push_back(cam_distance > 0 ? portal->plane : -portal->plane);
+			planes.push_back(p_far);
+		}
+
+		p_path[p_depth + 1] = next;
+		_portal_traverse(p_scenario, p_path, p_depth + 1, p_cam_pos, planes, p_far);
+	}
+}
+
+void VisualServerScene::_portal_cull(Scenario *p_scenario, const Transform &p_cam_transform, const Vector<Plane> &p_planes) {
+
+	Room *path[MAX_PORTAL_DEPTH + 1];
+	path[0] = NULL; // exterior, unless the camera is in a room
+
+	for (SelfList<Room> *E = p_scenario->rooms.first(); E; E = E->next()) {
+
+		Room *room = E->self();
+		if (room->planes.empty() || !room->aabb.has_point(p_cam_transform.origin)) {
+			continue;
+		}
+
+		bool inside = true;
+		for (int i = 0; i < room->planes.size(); i++) {
+			if (room->planes[i].is_point_over(p_cam_transform.origin)) {
+				inside = false;
+				break;
+			}
+		}
+
+		if (inside) {
+			path[0] = room;
+			break;
+		}
+	}
+
+	_portal_traverse(p_scenario, path, 0, p_cam_transform.origin, p_planes, p_planes[CameraMatrix::PLANE_FAR]);
+}
+
+bool VisualServerScene::_instance_portal_visible(Scenario *p_scenario, Instance *p_instance) {
+
+	const AABB &aabb = p_instance->transformed_aabb;
+
+	if (p_instance->room_exterior && p_scenario->exterior_visibility.intersects(aabb, render_pass)) {
+		return true;
+	}
+
+	for (int i = 0; i < p_instance->rooms.size(); i++) {
+		if (p_instance->rooms[i]->visibility.intersects(aabb, render_pass)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool VisualServerScene::_instances_share_room(Instance *p_a, Instance *p_b) {
+
+	if (p_a->room_exterior && p_b->room_exterior) {
+		return true;
+	}
+
+	for (int i = 0; i < p_a->rooms.size(); i++) {
+		for (int j = 0; j < p_b->rooms.size(); j++) {
+			if (p_a->rooms[i] == p_b->rooms[j]) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
 void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe) {
 	// Note, in stereo rendering:
 	// - p_cam_transform will be a transform in the middle of our two eyes
@@ -1841,7 +2590,16 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 	float z_far = p_cam_projection.get_z_far();
 
 	/* STEP 2 - CULL */
-	instance_cull_count = scenario->octree.cull_convex(planes, instance_cull_result, MAX_INSTANCE_CULL);
+	_cull_result_reserve(scenario);
+	instance_cull_count = _cull_convex(scenario, planes, instance_cull_result);
+	if (occlusion_culling && !p_cam_orthogonal && scenario->occluders.first()) {
+		_occlusion_cull(scenario, p_cam_transform, p_cam_projection, planes, p_visible_layers);
+	}
+
+	bool portal_culling = scenario->rooms.first() != NULL;
+	if (portal_culling) {
+		_portal_cull(scenario, p_cam_transform, planes);
+	}
 	light_cull_count = 0;
 
 	reflection_probe_cull_count = 0;
@@ -1866,7 +2624,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 
 		bool keep = false;
 
-		if ((camera_layer_mask & ins->layer_mask) == 0) {
+		if ((camera_layer_mask & ins->layer_mask) == 0 || (portal_culling && !_instance_portal_visible(scenario, ins))) {
 
 			//failure
 		} else if (ins->base_type == VS::INSTANCE_LIGHT && ins->visible) {
@@ -1922,7 +2680,7 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 				gi_probe_update_list.add(&gi_probe->update_element);
 			}
 
-		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY) {
+		} else if (((1 << ins->base_type) & VS::INSTANCE_GEOMETRY_MASK) && ins->visible && ins->cast_shadows != VS::SHADOW_CASTING_SETTING_SHADOWS_ONLY && _instance_lod_visible(ins, p_cam_transform.origin, true)) {
 
 			keep = true;
 
@@ -2142,6 +2900,8 @@ void VisualServerScene::_prepare_scene(const Transform p_cam_transform, const Ca
 			if (redraw) {
 				//must redraw!
 				light->shadow_dirty = _light_instance_update_shadow(ins, p_cam_transform, p_cam_projection, p_cam_orthogonal, p_shadow_atlas, scenario);
+			} else {
+				shadow_redraw_skipped_count++;
 			}
 		}
 	}
@@ -3412,6 +4172,7 @@ void VisualServerScene::_update_dirty_instance(Instance *p_instance) {
 				for (List<Instance *>::Element *E = geom->lighting.front(); E; E = E->next()) {
 					InstanceLightData *light = static_cast<InstanceLightData *>(E->get()->base_data);
 					light->shadow_dirty = true;
+					light->shadow_casters_valid = 0;
 				}
 
 				geom->can_cast_shadows = can_cast_shadows;
@@ -3444,6 +4205,9 @@ bool VisualServerScene::free(RID p_rid) {
 	if (camera_owner.owns(p_rid)) {
 
 		Camera *camera = camera_owner.get(p_rid);
+		if (camera->lod_slot >= 0) {
+			lod_slots_used &= ~(uint64_t(1) << camera->lod_slot);
+		}
 
 		camera_owner.free(p_rid);
 		memdelete(camera);
@@ -3455,11 +4219,39 @@ bool VisualServerScene::free(RID p_rid) {
 		while (scenario->instances.first()) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
+		while (scenario->rooms.first()) {
+			room_set_scenario(scenario->rooms.first()->self()->self, RID());
+		}
+		while (scenario->portals.first()) {
+			portal_set_scenario(scenario->portals.first()->self()->self, RID());
+		}
 		VSG::scene_render->free(scenario->reflection_probe_shadow_atlas);
 		VSG::scene_render->free(scenario->reflection_atlas);
 		scenario_owner.free(p_rid);
 		memdelete(scenario);
 
+	} else if (room_owner.owns(p_rid)) {
+
+		Room *room = room_owner.get(p_rid);
+
+		room_set_scenario(p_rid, RID());
+		while (room->portals.size()) {
+			_portal_unlink(room->portals.front()->get());
+		}
+
+		room_owner.free(p_rid);
+		memdelete(room);
+
+	} else if (portal_owner.owns(p_rid)) {
+
+		Portal *portal = portal_owner.get(p_rid);
+
+		portal_set_scenario(p_rid, RID());
+		_portal_unlink(portal);
+
+		portal_owner.free(p_rid);
+		memdelete(portal);
+
 	} else if (instance_owner.owns(p_rid)) {
 		// delete the instance
 
@@ -3472,6 +4264,12 @@ bool VisualServerScene::free(RID p_rid) {
 		instance_set_base(p_rid, RID());
 		instance_geometry_set_material_override(p_rid, RID());
 		instance_attach_skeleton(p_rid, RID());
+		instance_geometry_set_as_instance_lod(p_rid, RID());
+
+		while (instance->lod_children.size()) {
+			instance->lod_children.front()->get()->lod_parent = NULL;
+			instance->lod_children.pop_front();
+		}
 
 		update_dirty_instances(); //in case something changed this
 
@@ -3495,6 +4293,29 @@ VisualServerScene::VisualServerScene() {
 	probe_bake_thread_exit = false;
 #endif
 
+	instance_cull_result = NULL;
+	instance_shadow_cull_result = NULL;
+	instance_cull_result_size = 0;
+
+	lod_slots_used = 0;
+	lod_slot = -1;
+
+	shadow_cull_count = 0;
+	shadow_cull_skipped_count = 0;
+	shadow_redraw_skipped_count = 0;
+
+	occlusion_culling = GLOBAL_DEF("rendering/occlusion_culling/enabled", false);
+	occlusion_buffer_width = GLOBAL_DEF("rendering/occlusion_culling/buffer_width", 256);
+	ProjectSettings::get_singleton()->set_custom_property_info("rendering/occlusion_culling/buffer_width", PropertyInfo(Variant::INT, "rendering/occlusion_culling/buffer_width", PROPERTY_HINT_RANGE, "64,1024,1"));
+	occlusion_buffer_width = CLAMP(occlusion_buffer_width, 64, 1024);
+
+#ifndef NO_THREADS
+	if (GLOBAL_DEF("rendering/threads/parallel_culling", true)) {
+		int thread_count = CLAMP(OS::get_singleton()->get_processor_count() - 1, 0, 7);
+		cull_work_pool.init(thread_count);
+	}
+#endif
+
 	render_pass = 1;
 	singleton = this;
 }
@@ -3509,5 +4330,11 @@ VisualServerScene::~VisualServerScene() {
 	memdelete(probe_bake_sem);
 	memdelete(probe_bake_mutex);
 
+	cull_work_pool.finish();
 #endif
+
+	if (instance_cull_result) {
+		memfree(instance_cull_result);
+		memfree(instance_shadow_cull_result);
+	}
 }
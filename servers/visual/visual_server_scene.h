@@ -37,40 +37,24 @@
 #include "core/math/octree.h"
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
+#include "core/os/thread_work_pool.h"
 #include "core/self_list.h"
 #include "servers/arvr/arvr_interface.h"
+#include "servers/visual/occlusion_buffer.h"
 
 class VisualServerScene {
 public:
 	enum {
 
-		MAX_INSTANCE_CULL = 65536,
 		MAX_LIGHTS_CULLED = 4096,
 		MAX_REFLECTION_PROBES_CULLED = 4096,
-		MAX_ROOM_CULL = 32,
-		MAX_EXTERIOR_PORTALS = 128,
+		MAX_PORTAL_DEPTH = 8,
 	};
 
 	uint64_t render_pass;
 
 	static VisualServerScene *singleton;
 
-// FIXME: Kept as reference for future implementation
-#if 0
-	struct Portal {
-
-		bool enabled;
-		float disable_distance;
-		Color disable_color;
-		float connect_range;
-		Vector<Point2> shape;
-		Rect2 bounds;
-
-
-		Portal() { enabled=true; disable_distance=50; disable_color=Color(); connect_range=0.8; }
-	};
-#endif
-
 	/* CAMERA API */
 
 	struct Camera : public RID_Data {
@@ -86,6 +70,7 @@ public:
 		uint32_t visible_layers;
 		bool vaspect;
 		RID env;
+		int lod_slot; // bit of Instance::lod_visible holding this camera's draw range state, -1 if none was free
 
 		Transform transform;
 
@@ -98,10 +83,13 @@ public:
 			zfar = 100;
 			size = 1.0;
 			vaspect = false;
+			lod_slot = -1;
 		}
 	};
 
 	mutable RID_Owner<Camera> camera_owner;
+	uint64_t lod_slots_used;
+	int lod_slot; // slot of the camera being rendered, -1 when there is none
 
 	virtual RID camera_create();
 	virtual void camera_set_perspective(RID p_camera, float p_fovy_degrees, float p_z_near, float p_z_far);
@@ -114,6 +102,33 @@ public:
 	/* SCENARIO API */
 
 	struct Instance;
+	struct Room;
+	struct Portal;
+
+	// Rooms reached by the portal traversal in a render pass, with the frustums they were seen through.
+	struct RoomVisibility {
+
+		uint64_t pass;
+		Vector<Vector<Plane> > frustums;
+
+		bool intersects(const AABB &p_aabb, uint64_t p_pass) const;
+
+		RoomVisibility() { pass = 0; }
+	};
+
+	// Flat copy of the bounds of every instance in a scenario, one array per component, so the
+	// camera frustum can be tested with a linear loop the compiler vectorizes and that splits
+	// into independent chunks for the cull threads.
+	struct InstanceCullList {
+
+		Vector<Instance *> instances;
+		Vector<uint32_t> type_masks;
+		Vector<real_t> bounds[6]; // min x, y, z, max x, y, z
+
+		void add(Instance *p_instance);
+		void update(Instance *p_instance);
+		void remove(Instance *p_instance);
+	};
 
 	struct Scenario : RID_Data {
 
@@ -121,6 +136,7 @@ public:
 		RID self;
 
 		Octree<Instance, true> octree;
+		InstanceCullList cull_list;
 
 		List<Instance *> directional_lights;
 		RID environment;
@@ -129,6 +145,11 @@ public:
 		RID reflection_atlas;
 
 		SelfList<Instance>::List instances;
+		SelfList<Instance>::List occluders;
+
+		SelfList<Room>::List rooms;
+		SelfList<Portal>::List portals;
+		RoomVisibility exterior_visibility; // anything not fully inside a room
 
 		Scenario() { debug = VS::SCENARIO_DEBUG_DISABLED; }
 	};
@@ -145,6 +166,69 @@ public:
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment);
 	virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv);
 
+	/* ROOM API */
+
+	struct Room : RID_Data {
+
+		RID self;
+		Scenario *scenario;
+		SelfList<Room> scenario_item;
+
+		Vector<Plane> planes; // convex bounds, normals pointing out
+		AABB aabb;
+		List<Portal *> portals;
+
+		RoomVisibility visibility;
+
+		Room() :
+				scenario_item(this) {
+
+			scenario = NULL;
+		}
+	};
+
+	mutable RID_Owner<Room> room_owner;
+
+	virtual RID room_create();
+	virtual void room_set_scenario(RID p_room, RID p_scenario);
+	virtual void room_set_bounds(RID p_room, const PoolVector<Vector3> &p_points);
+
+	/* PORTAL API */
+
+	struct Portal : RID_Data {
+
+		RID self;
+		Scenario *scenario;
+		SelfList<Portal> scenario_item;
+
+		Vector<Vector3> points; // convex polygon, world space
+		Plane plane;
+		bool enabled;
+		bool linked;
+		Room *rooms[2]; // NULL is the exterior
+
+		Portal() :
+				scenario_item(this) {
+
+			scenario = NULL;
+			enabled = true;
+			linked = false;
+			rooms[0] = NULL;
+			rooms[1] = NULL;
+		}
+	};
+
+	mutable RID_Owner<Portal> portal_owner;
+
+	virtual RID portal_create();
+	virtual void portal_set_scenario(RID p_portal, RID p_scenario);
+	virtual void portal_set_polygon(RID p_portal, const PoolVector<Vector3> &p_points);
+	virtual void portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b);
+	virtual void portal_set_enabled(RID p_portal, bool p_enabled);
+
+	void _portal_unlink(Portal *p_portal);
+	void _scenario_rooms_changed(Scenario *p_scenario);
+
 	/* INSTANCING API */
 
 	struct InstanceBaseData {
@@ -157,8 +241,10 @@ public:
 		RID self;
 		//scenario stuff
 		OctreeElementID octree_id;
+		int cull_index;
 		Scenario *scenario;
 		SelfList<Instance> scenario_item;
+		SelfList<Instance> occluder_item;
 
 		//aabb stuff
 		bool update_aabb;
@@ -176,7 +262,15 @@ public:
 		float lod_end;
 		float lod_begin_hysteresis;
 		float lod_end_hysteresis;
-		RID lod_instance;
+		Instance *lod_parent; // draw range distance is measured from this instance, if set
+		List<Instance *> lod_children;
+		uint64_t lod_visible; // last draw range result per camera lod slot, used for hysteresis
+
+		PoolVector<Vector3> occluder_faces; // local space triangles drawn into the occlusion buffer
+		AABB occluder_aabb;
+
+		Vector<Room *> rooms; // rooms the bounds touch
+		bool room_exterior; // not fully inside any room, so also seen from outside
 
 		uint64_t last_render_pass;
 		uint64_t last_frame_pass;
@@ -197,9 +291,11 @@ public:
 
 		Instance() :
 				scenario_item(this),
+				occluder_item(this),
 				update_item(this) {
 
 			octree_id = 0;
+			cull_index = -1;
 			scenario = NULL;
 
 			update_aabb = false;
@@ -214,6 +310,10 @@ public:
 			lod_end = 0;
 			lod_begin_hysteresis = 0;
 			lod_end_hysteresis = 0;
+			lod_parent = NULL;
+			lod_visible = ~uint64_t(0);
+
+			room_exterior = true;
 
 			last_render_pass = 0;
 			last_frame_pass = 0;
@@ -301,11 +401,18 @@ public:
 
 		List<PairInfo> geometries;
 
+		// Paired geometries touching each shadow pass (paraboloid half, cube face or spot frustum),
+		// kept until the light, a shadow caster or the pairs change. Bit N of shadow_casters_valid is set
+		// while shadow_casters[N] is up to date.
+		Vector<Instance *> shadow_casters[6];
+		uint32_t shadow_casters_valid;
+
 		Instance *baked_light;
 
 		InstanceLightData() {
 
 			shadow_dirty = true;
+			shadow_casters_valid = 0;
 			D = NULL;
 			last_version = 0;
 			baked_light = NULL;
@@ -435,8 +542,9 @@ public:
 	};
 
 	int instance_cull_count;
-	Instance *instance_cull_result[MAX_INSTANCE_CULL];
-	Instance *instance_shadow_cull_result[MAX_INSTANCE_CULL]; //used for generating shadowmaps
+	Instance **instance_cull_result;
+	Instance **instance_shadow_cull_result; //used for generating shadowmaps
+	int instance_cull_result_size; // grows to fit the largest scenario rendered
 	Instance *light_cull_result[MAX_LIGHTS_CULLED];
 	RID light_instance_cull_result[MAX_LIGHTS_CULLED];
 	int light_cull_count;
@@ -444,6 +552,10 @@ public:
 	RID reflection_probe_instance_cull_result[MAX_REFLECTION_PROBES_CULLED];
 	int reflection_probe_cull_count;
 
+	uint64_t shadow_cull_count; // omni and spot shadow passes culled from the light pairs
+	uint64_t shadow_cull_skipped_count; // passes that reused the cached casters instead
+	uint64_t shadow_redraw_skipped_count; // shadowed lights whose atlas shadow was reused as is
+
 	RID_Owner<Instance> instance_owner;
 
 	// from can be mesh, light,  area and portal so far.
@@ -477,12 +589,59 @@ public:
 
 	virtual void instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin);
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance);
+	virtual void instance_geometry_set_occluder(RID p_instance, const PoolVector<Vector3> &p_faces);
 
 	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
+	void _update_instance_rooms(Instance *p_instance);
+
+	enum {
+		CULL_CHUNK_SIZE = 1024,
+	};
+
+	struct CullJob {
+
+		const InstanceCullList *list;
+		const Plane *planes;
+		int plane_count;
+		uint32_t mask;
+		Instance **result; // each chunk writes at its own offset
+		uint32_t *chunk_result_counts;
+	};
+
+	struct OcclusionTestJob {
+
+		const OcclusionBuffer *buffer;
+		Instance *const *instances;
+		uint8_t *occluded;
+		int count;
+	};
+
+	ThreadWorkPool cull_work_pool;
+	Vector<uint32_t> cull_chunk_result_counts;
+
+	bool occlusion_culling;
+	int occlusion_buffer_width;
+	OcclusionBuffer occlusion_buffer;
+	Vector<uint8_t> occlusion_results;
+
+	static void _cull_chunk(void *p_job, uint32_t p_chunk);
+	void _cull_result_reserve(Scenario *p_scenario);
+	int _cull_convex(Scenario *p_scenario, const Vector<Plane> &p_planes, Instance **r_result, uint32_t p_mask = 0xFFFFFFFF);
+
+	static void _occlusion_rasterize_band(void *p_buffer, uint32_t p_band);
+	static void _occlusion_test_chunk(void *p_job, uint32_t p_chunk);
+	void _occlusion_cull(Scenario *p_scenario, const Transform &p_cam_transform, const CameraMatrix &p_cam_projection, const Vector<Plane> &p_planes, uint32_t p_visible_layers);
+
+	void _portal_traverse(Scenario *p_scenario, Room **p_path, int p_depth, const Vector3 &p_cam_pos, const Vector<Plane> &p_planes, const Plane &p_far);
+	void _portal_cull(Scenario *p_scenario, const Transform &p_cam_transform, const Vector<Plane> &p_planes);
+	_FORCE_INLINE_ bool _instance_portal_visible(Scenario *p_scenario, Instance *p_instance);
+	_FORCE_INLINE_ bool _instances_share_room(Instance *p_a, Instance *p_b);
 
+	_FORCE_INLINE_ bool _instance_lod_visible(Instance *p_instance, const Vector3 &p_camera_pos, bool p_update_hysteresis);
+	int _light_cull_shadow_casters(InstanceLightData *p_light, int p_pass, const Vector<Plane> &p_planes);
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_shadow_atlas, Scenario *p_scenario);
 
 	void _prepare_scene(const Transform p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, RID p_force_environment, uint32_t p_visible_layers, RID p_scenario, RID p_shadow_atlas, RID p_reflection_probe);
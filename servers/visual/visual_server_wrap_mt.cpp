@@ -93,6 +93,10 @@ void VisualServerWrapMT::sync() {
 
 void VisualServerWrapMT::draw(bool p_swap_buffers, double frame_step) {
 
+	frame_sync_count = command_queue.get_sync_count();
+	frame_command_queue_peak = command_queue.get_max_used();
+	command_queue.reset_stats();
+
 	if (create_thread) {
 
 		atomic_increment(&draw_pending);
@@ -153,6 +157,8 @@ void VisualServerWrapMT::finish() {
 	viewport_free_cached_ids();
 	environment_free_cached_ids();
 	scenario_free_cached_ids();
+	room_free_cached_ids();
+	portal_free_cached_ids();
 	instance_free_cached_ids();
 	canvas_free_cached_ids();
 	canvas_item_free_cached_ids();
@@ -180,6 +186,8 @@ VisualServerWrapMT::VisualServerWrapMT(VisualServer *p_contained, bool p_create_
 	draw_thread_up = false;
 	alloc_mutex = Mutex::create();
 	pool_max_size = GLOBAL_GET("memory/limits/multithreaded_server/rid_pool_prealloc");
+	frame_sync_count = 0;
+	frame_command_queue_peak = 0;
 
 	if (!p_create_thread) {
 		server_thread = Thread::get_caller_id();
@@ -64,6 +64,9 @@ class VisualServerWrapMT : public VisualServer {
 
 	int pool_max_size;
 
+	uint32_t frame_sync_count;
+	uint32_t frame_command_queue_peak;
+
 	//#define DEBUG_SYNC
 
 	static VisualServerWrapMT *singleton_mt;
@@ -449,6 +452,20 @@ public:
 	FUNC3(scenario_set_reflection_atlas_size, RID, int, int)
 	FUNC2(scenario_set_fallback_environment, RID, RID)
 
+	/* ROOM API */
+
+	FUNCRID(room)
+	FUNC2(room_set_scenario, RID, RID)
+	FUNC2(room_set_bounds, RID, const PoolVector<Vector3> &)
+
+	/* PORTAL API */
+
+	FUNCRID(portal)
+	FUNC2(portal_set_scenario, RID, RID)
+	FUNC2(portal_set_polygon, RID, const PoolVector<Vector3> &)
+	FUNC3(portal_set_rooms, RID, RID, RID)
+	FUNC2(portal_set_enabled, RID, bool)
+
 	/* INSTANCING API */
 	// from can be mesh, light,  area and portal so far.
 	FUNCRID(instance)
@@ -481,6 +498,7 @@ public:
 
 	FUNC5(instance_geometry_set_draw_range, RID, float, float, float, float)
 	FUNC2(instance_geometry_set_as_instance_lod, RID, RID)
+	FUNC2(instance_geometry_set_occluder, RID, const PoolVector<Vector3> &)
 
 	/* CANVAS (2D) */
 
@@ -596,6 +614,11 @@ public:
 
 	//this passes directly to avoid stalling
 	virtual int get_render_info(RenderInfo p_info) {
+		if (p_info == INFO_SERVER_SYNCS_IN_FRAME) {
+			return frame_sync_count;
+		} else if (p_info == INFO_COMMAND_QUEUE_MEM_PEAK_IN_FRAME) {
+			return frame_command_queue_peak;
+		}
 		return visual_server->get_render_info(p_info);
 	}
 
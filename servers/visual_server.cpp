@@ -1925,6 +1925,16 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("scenario_set_debug", "scenario", "debug_mode"), &VisualServer::scenario_set_debug);
 	ClassDB::bind_method(D_METHOD("scenario_set_environment", "scenario", "environment"), &VisualServer::scenario_set_environment);
 	ClassDB::bind_method(D_METHOD("scenario_set_reflection_atlas_size", "scenario", "size", "subdiv"), &VisualServer::scenario_set_reflection_atlas_size);
+
+	ClassDB::bind_method(D_METHOD("room_create"), &VisualServer::room_create);
+	ClassDB::bind_method(D_METHOD("room_set_scenario", "room", "scenario"), &VisualServer::room_set_scenario);
+	ClassDB::bind_method(D_METHOD("room_set_bounds", "room", "points"), &VisualServer::room_set_bounds);
+
+	ClassDB::bind_method(D_METHOD("portal_create"), &VisualServer::portal_create);
+	ClassDB::bind_method(D_METHOD("portal_set_scenario", "portal", "scenario"), &VisualServer::portal_set_scenario);
+	ClassDB::bind_method(D_METHOD("portal_set_polygon", "portal", "points"), &VisualServer::portal_set_polygon);
+	ClassDB::bind_method(D_METHOD("portal_set_rooms", "portal", "room_a", "room_b"), &VisualServer::portal_set_rooms);
+	ClassDB::bind_method(D_METHOD("portal_set_enabled", "portal", "enabled"), &VisualServer::portal_set_enabled);
 	ClassDB::bind_method(D_METHOD("scenario_set_fallback_environment", "scenario", "environment"), &VisualServer::scenario_set_fallback_environment);
 
 #ifndef _3D_DISABLED
@@ -1949,6 +1959,7 @@ void VisualServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_material_override", "instance", "material"), &VisualServer::instance_geometry_set_material_override);
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_draw_range", "instance", "min", "max", "min_margin", "max_margin"), &VisualServer::instance_geometry_set_draw_range);
 	ClassDB::bind_method(D_METHOD("instance_geometry_set_as_instance_lod", "instance", "as_lod_of_instance"), &VisualServer::instance_geometry_set_as_instance_lod);
+	ClassDB::bind_method(D_METHOD("instance_geometry_set_occluder", "instance", "faces"), &VisualServer::instance_geometry_set_occluder);
 
 	ClassDB::bind_method(D_METHOD("instances_cull_aabb", "aabb", "scenario"), &VisualServer::_instances_cull_aabb_bind, DEFVAL(RID()));
 	ClassDB::bind_method(D_METHOD("instances_cull_ray", "from", "to", "scenario"), &VisualServer::_instances_cull_ray_bind, DEFVAL(RID()));
@@ -2251,6 +2262,8 @@ void VisualServer::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_VIDEO_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_TEXTURE_MEM_USED);
 	BIND_ENUM_CONSTANT(INFO_VERTEX_MEM_USED);
+	BIND_ENUM_CONSTANT(INFO_SERVER_SYNCS_IN_FRAME);
+	BIND_ENUM_CONSTANT(INFO_COMMAND_QUEUE_MEM_PEAK_IN_FRAME);
 
 	BIND_ENUM_CONSTANT(FEATURE_SHADERS);
 	BIND_ENUM_CONSTANT(FEATURE_MULTITHREADED);
@@ -2405,6 +2418,11 @@ VisualServer::VisualServer() {
 	GLOBAL_DEF("rendering/quality/shading/force_blinn_over_ggx", false);
 	GLOBAL_DEF("rendering/quality/shading/force_blinn_over_ggx.mobile", true);
 
+	GLOBAL_DEF("rendering/quality/skinning/force_software_skinning", false);
+	GLOBAL_DEF("rendering/quality/skinning/software_skinning_dual_quaternion", false);
+	GLOBAL_DEF("rendering/threads/parallel_skinning", true);
+	GLOBAL_DEF("rendering/threads/parallel_cpu_particles", true);
+
 	GLOBAL_DEF("rendering/quality/depth_prepass/enable", true);
 	GLOBAL_DEF("rendering/quality/depth_prepass/disable_for_vendors", "PowerVR,Mali,Adreno,Apple");
 
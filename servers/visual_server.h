@@ -783,6 +783,20 @@ public:
 	virtual void scenario_set_debug(RID p_scenario, ScenarioDebugMode p_debug_mode) = 0;
 	virtual void scenario_set_environment(RID p_scenario, RID p_environment) = 0;
 	virtual void scenario_set_reflection_atlas_size(RID p_scenario, int p_size, int p_subdiv) = 0;
+
+	/* ROOM API */
+
+	virtual RID room_create() = 0;
+	virtual void room_set_scenario(RID p_room, RID p_scenario) = 0;
+	virtual void room_set_bounds(RID p_room, const PoolVector<Vector3> &p_points) = 0;
+
+	/* PORTAL API */
+
+	virtual RID portal_create() = 0;
+	virtual void portal_set_scenario(RID p_portal, RID p_scenario) = 0;
+	virtual void portal_set_polygon(RID p_portal, const PoolVector<Vector3> &p_points) = 0;
+	virtual void portal_set_rooms(RID p_portal, RID p_room_a, RID p_room_b) = 0;
+	virtual void portal_set_enabled(RID p_portal, bool p_enabled) = 0;
 	virtual void scenario_set_fallback_environment(RID p_scenario, RID p_environment) = 0;
 
 	/* INSTANCING API */
@@ -854,6 +868,7 @@ public:
 
 	virtual void instance_geometry_set_draw_range(RID p_instance, float p_min, float p_max, float p_min_margin, float p_max_margin) = 0;
 	virtual void instance_geometry_set_as_instance_lod(RID p_instance, RID p_as_lod_of_instance) = 0;
+	virtual void instance_geometry_set_occluder(RID p_instance, const PoolVector<Vector3> &p_faces) = 0;
 
 	/* CANVAS (2D) */
 
@@ -1008,6 +1023,8 @@ public:
 		INFO_VIDEO_MEM_USED,
 		INFO_TEXTURE_MEM_USED,
 		INFO_VERTEX_MEM_USED,
+		INFO_SERVER_SYNCS_IN_FRAME,
+		INFO_COMMAND_QUEUE_MEM_PEAK_IN_FRAME,
 	};
 
 	virtual int get_render_info(RenderInfo p_info) = 0;